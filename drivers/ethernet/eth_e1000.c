@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <ethernet/eth_stats.h>
 #include <zephyr/drivers/pcie/pcie.h>
 #include <zephyr/irq.h>
+#include <zephyr/sys/barrier.h>
 #include "eth_e1000_priv.h"
 
 #if defined(CONFIG_ETH_E1000_PTP_CLOCK)
@@ -39,6 +40,21 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define hexdump(args...)
 #endif
 
+BUILD_ASSERT(CONFIG_ETH_E1000_TX_DESC_COUNT % 8 == 0,
+	     "TX ring length must be a multiple of 128 bytes");
+BUILD_ASSERT(CONFIG_ETH_E1000_RX_DESC_COUNT % 8 == 0,
+	     "RX ring length must be a multiple of 128 bytes");
+BUILD_ASSERT(CONFIG_ETH_E1000_RX_BUF_COUNT > CONFIG_ETH_E1000_RX_DESC_COUNT,
+	     "Some RX buffers must be left for the frames held by the stack");
+
+/* Time to wait for the device to release enough TX descriptors for a
+ * frame. The device is not making progress if none are released in that
+ * time, and the frame is dropped.
+ */
+#define TX_AVAIL_WAIT K_MSEC(100)
+
+#define INC_WRAP(idx, size) ((idx) = ((idx) + 1) % (size))
+
 static const char *e1000_reg_to_string(enum e1000_reg_t r)
 {
 #define _(_x)	case _x: return #_x
@@ -99,94 +115,212 @@ static const struct device *e1000_get_ptp_clock(const struct device *dev)
 }
 #endif
 
-static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
+/* Release the fragments of the descriptors the device is done with */
+static void e1000_tx_reclaim(struct e1000_dev *dev)
 {
-	hexdump(buf, len, "%zu byte(s)", len);
+	k_spinlock_key_t key = k_spin_lock(&dev->tx_lock);
+	unsigned int count = 0U;
 
-	dev->tx.addr = POINTER_TO_INT(buf);
-	dev->tx.len = len;
-	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	while (dev->tx_tail != dev->tx_head) {
+		volatile struct e1000_tx *desc = &dev->tx[dev->tx_tail];
 
-	iow32(dev, TDT, 1);
+		if (!(desc->sta & TDESC_STA_DD)) {
+			break;
+		}
 
-	while (!(dev->tx.sta)) {
-		k_yield();
+		LOG_DBG("tx[%u].sta: 0x%02hx", dev->tx_tail, desc->sta);
+
+		net_pkt_frag_unref(dev->tx_frags[dev->tx_tail]);
+		dev->tx_frags[dev->tx_tail] = NULL;
+		desc->sta = 0U;
+
+		INC_WRAP(dev->tx_tail, CONFIG_ETH_E1000_TX_DESC_COUNT);
+		count++;
 	}
 
-	LOG_DBG("tx.sta: 0x%02hx", dev->tx.sta);
+	k_spin_unlock(&dev->tx_lock, key);
 
-	return (dev->tx.sta & TDESC_STA_DD) ? 0 : -EIO;
+	if (count > 0U) {
+		k_sem_give(&dev->tx_done);
+	}
 }
 
+/* One descriptor is always kept free to tell a full ring from an empty one */
+static inline unsigned int e1000_tx_free(struct e1000_dev *dev)
+{
+	return (dev->tx_tail + CONFIG_ETH_E1000_TX_DESC_COUNT - dev->tx_head - 1U) %
+	       CONFIG_ETH_E1000_TX_DESC_COUNT;
+}
+
+/* The fragments are sent from where they are, each one with its own
+ * descriptor. They are referenced until the device is done with them.
+ *
+ * The descriptors the device is done with are reclaimed here as well as
+ * from the interrupt, and the sender only waits when the ring is full.
+ * The frame is not split, it waits until there are descriptors for all
+ * its fragments.
+ */
 static int e1000_send(const struct device *ddev, struct net_pkt *pkt)
 {
 	struct e1000_dev *dev = ddev->data;
-	size_t len = net_pkt_get_len(pkt);
+	unsigned int count = 0U;
+	struct net_buf *frag;
+	k_spinlock_key_t key;
+	k_timepoint_t end;
+	unsigned int idx;
+
+	for (frag = pkt->buffer; frag != NULL; frag = frag->frags) {
+		if (frag->len != 0U) {
+			count++;
+		}
+	}
 
-	if (net_pkt_read(pkt, dev->txb, len)) {
-		return -EIO;
+	if (count == 0U) {
+		return -EINVAL;
 	}
 
-	return e1000_tx(dev, dev->txb, len);
-}
+	if (count >= CONFIG_ETH_E1000_TX_DESC_COUNT) {
+		LOG_ERR("Frame of %u fragments does not fit the TX ring", count);
+		return -EMSGSIZE;
+	}
 
-static struct net_pkt *e1000_rx(struct e1000_dev *dev)
-{
-	struct net_pkt *pkt = NULL;
-	void *buf;
-	ssize_t len;
+	end = sys_timepoint_calc(TX_AVAIL_WAIT);
 
-	LOG_DBG("rx.sta: 0x%02hx", dev->rx.sta);
+	while (true) {
+		e1000_tx_reclaim(dev);
 
-	if (!(dev->rx.sta & RDESC_STA_DD)) {
-		LOG_ERR("RX descriptor not ready");
-		goto out;
-	}
+		key = k_spin_lock(&dev->tx_lock);
+
+		if (e1000_tx_free(dev) >= count) {
+			break;
+		}
 
-	buf = INT_TO_POINTER((uint32_t)dev->rx.addr);
-	len = dev->rx.len - 4;
+		k_spin_unlock(&dev->tx_lock, key);
 
-	if (len <= 0) {
-		LOG_ERR("Invalid RX descriptor length: %hu", dev->rx.len);
-		goto out;
+		if (k_sem_take(&dev->tx_done, sys_timepoint_timeout(end)) != 0) {
+			LOG_DBG("No free TX descriptors");
+			return -ENOBUFS;
+		}
 	}
 
-	hexdump(buf, len, "%zd byte(s)", len);
+	idx = dev->tx_head;
 
-	pkt = net_pkt_rx_alloc_with_buffer(dev->iface, len, AF_UNSPEC, 0,
-					   K_NO_WAIT);
-	if (!pkt) {
-		LOG_ERR("Out of buffers");
-		goto out;
-	}
+	for (frag = pkt->buffer; frag != NULL; frag = frag->frags) {
+		volatile struct e1000_tx *desc = &dev->tx[idx];
+
+		if (frag->len == 0U) {
+			continue;
+		}
+
+		hexdump(frag->data, frag->len, "%hu byte(s)", frag->len);
+
+		dev->tx_frags[idx] = net_buf_ref(frag);
+
+		desc->addr = POINTER_TO_UINT(frag->data);
+		desc->len = frag->len;
+		desc->sta = 0U;
+		desc->cmd = TDESC_RS | (--count == 0U ? TDESC_EOP : 0U);
 
-	if (net_pkt_write(pkt, buf, len)) {
-		LOG_ERR("Out of memory for received frame");
-		net_pkt_unref(pkt);
-		pkt = NULL;
+		INC_WRAP(idx, CONFIG_ETH_E1000_TX_DESC_COUNT);
 	}
 
-out:
-	return pkt;
+	dev->tx_head = idx;
+
+	barrier_dmem_fence_full();
+
+	iow32(dev, TDT, idx);
+
+	k_spin_unlock(&dev->tx_lock, key);
+
+	return 0;
 }
 
-static void e1000_isr(const struct device *ddev)
+/* The filled buffers are passed to the stack and new ones put in their
+ * place. If there is none, the frame is dropped and its buffers stay in
+ * the ring.
+ */
+static void e1000_rx(struct e1000_dev *dev)
 {
-	struct e1000_dev *dev = ddev->data;
-	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
+	unsigned int idx = dev->rx_next;
+	unsigned int last = idx;
 
-	icr &= ~(ICR_TXDW | ICR_TXQE);
+	while (dev->rx[idx].sta & RDESC_STA_DD) {
+		volatile struct e1000_rx *desc = &dev->rx[idx];
+		struct net_buf *buf = dev->rx_bufs[idx];
+		struct net_buf *new_buf = NULL;
+
+		LOG_DBG("rx[%u].sta: 0x%02hx", idx, desc->sta);
+
+		if (!dev->rx_drop && desc->err == 0U) {
+			if (dev->rx_pkt == NULL) {
+				dev->rx_pkt = net_pkt_rx_alloc_on_iface(dev->iface,
+									K_NO_WAIT);
+			}
+
+			if (dev->rx_pkt != NULL) {
+				new_buf = net_buf_alloc(dev->rx_pool, K_NO_WAIT);
+			}
+		}
 
-	if (icr & ICR_RXO) {
-		struct net_pkt *pkt = e1000_rx(dev);
+		if (new_buf != NULL) {
+			net_buf_add(buf, desc->len);
+			hexdump(buf->data, buf->len, "%hu byte(s)", buf->len);
 
-		icr &= ~ICR_RXO;
+			net_pkt_frag_add(dev->rx_pkt, buf);
 
-		if (pkt) {
-			net_recv_data(get_iface(dev), pkt);
+			dev->rx_bufs[idx] = new_buf;
+			buf = new_buf;
 		} else {
-			eth_stats_update_errors_rx(get_iface(dev));
+			dev->rx_drop = true;
 		}
+
+		if (desc->sta & RDESC_STA_EOP) {
+			if (dev->rx_drop) {
+				LOG_ERR("Out of buffers or bad frame, err: 0x%02hx",
+					desc->err);
+				eth_stats_update_errors_rx(get_iface(dev));
+
+				if (dev->rx_pkt != NULL) {
+					net_pkt_unref(dev->rx_pkt);
+				}
+			} else if (net_recv_data(get_iface(dev), dev->rx_pkt) < 0) {
+				net_pkt_unref(dev->rx_pkt);
+			}
+
+			dev->rx_pkt = NULL;
+			dev->rx_drop = false;
+		}
+
+		desc->addr = POINTER_TO_UINT(buf->data);
+		desc->sta = 0U;
+
+		last = idx;
+		INC_WRAP(idx, CONFIG_ETH_E1000_RX_DESC_COUNT);
+	}
+
+	if (idx != dev->rx_next) {
+		barrier_dmem_fence_full();
+
+		/* Hand the descriptors back, up to the last one processed */
+		iow32(dev, RDT, last);
+
+		dev->rx_next = idx;
+	}
+}
+
+static void e1000_isr(const struct device *ddev)
+{
+	struct e1000_dev *dev = ddev->data;
+	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
+
+	if (icr & (ICR_TXDW | ICR_TXQE)) {
+		e1000_tx_reclaim(dev);
+		icr &= ~(ICR_TXDW | ICR_TXQE);
+	}
+
+	if (icr & (ICR_RXDMT0 | ICR_RXO | ICR_RXT0)) {
+		e1000_rx(dev);
+		icr &= ~(ICR_RXDMT0 | ICR_RXO | ICR_RXT0);
 	}
 
 	if (icr) {
@@ -213,30 +347,41 @@ int e1000_probe(const struct device *ddev)
 	device_map(&dev->address, mbar.phys_addr, mbar.size,
 		   K_MEM_CACHE_NONE);
 
-	/* Setup TX descriptor */
+	/* Setup TX descriptors, one is always kept free to tell a full ring
+	 * from an empty one.
+	 */
+
+	k_sem_init(&dev->tx_done, 0, 1);
 
-	iow32(dev, TDBAL, (uint32_t)POINTER_TO_UINT(&dev->tx));
-	iow32(dev, TDBAH, (uint32_t)((POINTER_TO_UINT(&dev->tx) >> 16) >> 16));
-	iow32(dev, TDLEN, 1*16);
+	iow32(dev, TDBAL, (uint32_t)POINTER_TO_UINT(dev->tx));
+	iow32(dev, TDBAH, (uint32_t)((POINTER_TO_UINT(dev->tx) >> 16) >> 16));
+	iow32(dev, TDLEN, (uint32_t)sizeof(dev->tx));
 
 	iow32(dev, TDH, 0);
 	iow32(dev, TDT, 0);
 
-	iow32(dev, TCTL, TCTL_EN);
+	iow32(dev, TCTL, TCTL_EN | TCTL_PSP);
 
-	/* Setup RX descriptor */
+	/* Setup RX descriptors, the device owns all but the last one */
 
-	dev->rx.addr = POINTER_TO_INT(dev->rxb);
-	dev->rx.len = sizeof(dev->rxb);
+	for (size_t i = 0; i < ARRAY_SIZE(dev->rx); i++) {
+		dev->rx_bufs[i] = net_buf_alloc(dev->rx_pool, K_NO_WAIT);
+		if (dev->rx_bufs[i] == NULL) {
+			LOG_ERR("Out of RX buffers");
+			return -ENOMEM;
+		}
+
+		dev->rx[i].addr = POINTER_TO_UINT(dev->rx_bufs[i]->data);
+	}
 
-	iow32(dev, RDBAL, (uint32_t)POINTER_TO_UINT(&dev->rx));
-	iow32(dev, RDBAH, (uint32_t)((POINTER_TO_UINT(&dev->rx) >> 16) >> 16));
-	iow32(dev, RDLEN, 1*16);
+	iow32(dev, RDBAL, (uint32_t)POINTER_TO_UINT(dev->rx));
+	iow32(dev, RDBAH, (uint32_t)((POINTER_TO_UINT(dev->rx) >> 16) >> 16));
+	iow32(dev, RDLEN, (uint32_t)sizeof(dev->rx));
 
 	iow32(dev, RDH, 0);
-	iow32(dev, RDT, 1);
+	iow32(dev, RDT, (uint32_t)ARRAY_SIZE(dev->rx) - 1);
 
-	iow32(dev, IMS, IMS_RXO);
+	iow32(dev, IMS, IMS_RXT0 | IMS_RXO | IMS_TXDW);
 
 	ral = ior32(dev, RAL);
 	rah = ior32(dev, RAH);
@@ -287,8 +432,14 @@ static const struct ethernet_api e1000_api = {
 #define E1000_PCI_INIT(inst)						\
 	DEVICE_PCIE_INST_DECLARE(inst);					\
 									\
+	NET_BUF_POOL_FIXED_DEFINE(e1000_rx_pool_##inst,			\
+				  CONFIG_ETH_E1000_RX_BUF_COUNT,	\
+				  E1000_RX_BUF_SIZE,			\
+				  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL); \
+									\
 	static struct e1000_dev dev_##inst = {				\
 		DEVICE_PCIE_INST_INIT(inst, pcie),			\
+		.rx_pool = &e1000_rx_pool_##inst,			\
 	};								\
 									\
 	static void e1000_config_##inst(const struct e1000_dev *dev)	\
@@ -300,7 +451,7 @@ static const struct ethernet_api e1000_api = {
 									\
 		irq_enable(DT_INST_IRQN(inst));				\
 		iow32(dev, CTRL, CTRL_SLU); /* Set link up */		\
-		iow32(dev, RCTL, RCTL_EN | RCTL_MPE);			\
+		iow32(dev, RCTL, RCTL_EN | RCTL_MPE | RCTL_SECRC);	\
 	}								\
 									\
 	static const struct e1000_config config_##inst = {		\
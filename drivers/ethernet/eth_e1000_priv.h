@@ -14,22 +14,32 @@ extern "C" {
 #define CTRL_SLU	(1 << 6) /* Set Link Up */
 
 #define TCTL_EN		(1 << 1)
+#define TCTL_PSP	(1 << 3) /* Pad Short Packets */
 #define RCTL_EN		(1 << 1)
 
 #define ICR_TXDW	     (1) /* Transmit Descriptor Written Back */
 #define ICR_TXQE	(1 << 1) /* Transmit Queue Empty */
+#define ICR_RXDMT0	(1 << 4) /* Rx Descriptor Minimum Threshold Reached */
 #define ICR_RXO		(1 << 6) /* Receiver Overrun */
+#define ICR_RXT0	(1 << 7) /* Receiver Timer Interrupt */
 
+#define IMS_TXDW	     (1) /* Transmit Descriptor Written Back */
 #define IMS_RXO		(1 << 6) /* Receiver FIFO Overrun */
+#define IMS_RXT0	(1 << 7) /* Receiver Timer Interrupt */
 
 #define RCTL_MPE	(1 << 4) /* Multicast Promiscuous Enabled */
+#define RCTL_SECRC	(1 << 26) /* Strip Ethernet CRC */
 
 #define TDESC_EOP	     (1) /* End Of Packet */
 #define TDESC_RS	(1 << 3) /* Report Status */
 
 #define RDESC_STA_DD	     (1) /* Descriptor Done */
+#define RDESC_STA_EOP	(1 << 1) /* End Of Packet */
 #define TDESC_STA_DD	     (1) /* Descriptor Done */
 
+/* Size of the receive buffers, RCTL.BSIZE is left at its default */
+#define E1000_RX_BUF_SIZE 2048
+
 #define ETH_ALEN 6	/* TODO: Add a global reusable definition in OS */
 
 enum e1000_reg_t {
@@ -75,10 +85,26 @@ struct e1000_rx {
 };
 
 struct e1000_dev {
-	volatile struct e1000_tx tx __aligned(16);
-	volatile struct e1000_rx rx __aligned(16);
+	volatile struct e1000_tx tx[CONFIG_ETH_E1000_TX_DESC_COUNT] __aligned(16);
+	volatile struct e1000_rx rx[CONFIG_ETH_E1000_RX_DESC_COUNT] __aligned(16);
 	mm_reg_t address;
 
+	/* Fragments referenced by the TX descriptors until they are sent */
+	struct net_buf *tx_frags[CONFIG_ETH_E1000_TX_DESC_COUNT];
+	struct k_sem tx_done; /* Given when descriptors are reclaimed */
+	struct k_spinlock tx_lock;
+	unsigned int tx_head; /* Next descriptor to fill */
+	unsigned int tx_tail; /* Oldest descriptor not reclaimed */
+
+	/* Buffers the RX descriptors point to, loaned to the stack once
+	 * filled.
+	 */
+	struct net_buf_pool *rx_pool;
+	struct net_buf *rx_bufs[CONFIG_ETH_E1000_RX_DESC_COUNT];
+	struct net_pkt *rx_pkt; /* Frame spanning several descriptors */
+	bool rx_drop; /* Rest of the frame is dropped */
+	unsigned int rx_next; /* Next descriptor the device fills */
+
 	/* BDF & DID/VID */
 	struct pcie_dev *pcie;
 
@@ -88,8 +114,6 @@ struct e1000_dev {
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
-	uint8_t txb[NET_ETH_MTU];
-	uint8_t rxb[NET_ETH_MTU];
 #if defined(CONFIG_ETH_E1000_PTP_CLOCK)
 	const struct device *ptp_clock;
 	double clk_ratio;
@@ -78,6 +78,8 @@ static void loopback_init(struct net_if *iface)
 static float loopback_packet_drop_ratio = 0.0f;
 static float loopback_packet_drop_state = 0.0f;
 static int loopback_packet_dropped_count;
+static int loopback_packet_drop_burst = 1;
+static int loopback_packet_drop_pending;
 
 int loopback_set_packet_drop_ratio(float ratio)
 {
@@ -88,6 +90,15 @@ int loopback_set_packet_drop_ratio(float ratio)
 	return 0;
 }
 
+int loopback_set_packet_drop_burst(int count)
+{
+	if (count < 1) {
+		return -EINVAL;
+	}
+	loopback_packet_drop_burst = count;
+	return 0;
+}
+
 int loopback_get_num_dropped_packets(void)
 {
 	return loopback_packet_dropped_count;
@@ -95,6 +106,262 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+#define LOOPBACK_DELAY_QUEUE_LEN CONFIG_NET_PKT_RX_COUNT
+
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	k_timepoint_t due;
+};
+
+/* Packets due in the order they were sent */
+struct loopback_delay_line {
+	struct loopback_delayed_pkt queue[LOOPBACK_DELAY_QUEUE_LEN];
+	uint32_t head;
+	uint32_t tail;
+};
+
+/* The packets over the bottleneck, and the other ones that pass them */
+static struct loopback_delay_line loopback_delay_lines[2];
+static uint32_t loopback_delay_ms;
+static struct k_spinlock loopback_delay_lock;
+
+/* Bottleneck of the link, the time it has sent the queued packets at */
+static uint32_t loopback_bandwidth_kbps;
+static uint32_t loopback_queue_size;
+static uint16_t loopback_bottleneck_port;
+static uint64_t loopback_link_free_us;
+static uint64_t loopback_queue_delay_sum;
+static uint32_t loopback_queue_delay_count;
+static uint32_t loopback_queue_delay_max;
+
+static void loopback_delay_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_work_handler);
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_delay_ms = delay_ms;
+	return 0;
+}
+
+int loopback_set_bandwidth(uint32_t kbps, uint32_t queue_size, uint16_t port)
+{
+	k_spinlock_key_t key;
+
+	if (kbps > 0 && queue_size < CONFIG_NET_LOOPBACK_MTU) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	loopback_bandwidth_kbps = kbps;
+	loopback_queue_size = queue_size;
+	loopback_bottleneck_port = port;
+	loopback_queue_delay_sum = 0;
+	loopback_queue_delay_count = 0;
+	loopback_queue_delay_max = 0;
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	return 0;
+}
+
+int loopback_get_queue_delay(uint32_t *avg_us, uint32_t *max_us)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (avg_us != NULL) {
+		*avg_us = loopback_queue_delay_count > 0 ?
+			  loopback_queue_delay_sum / loopback_queue_delay_count : 0;
+	}
+
+	if (max_us != NULL) {
+		*max_us = loopback_queue_delay_max;
+	}
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	return 0;
+}
+
+/* Whether the packet goes over the bottleneck */
+static bool loopback_is_limited(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	uint16_t port;
+	uint8_t proto;
+	int ret;
+
+	if (loopback_bandwidth_kbps == 0) {
+		return false;
+	}
+
+	if (loopback_bottleneck_port == 0) {
+		return true;
+	}
+
+	if (net_pkt_family(pkt) == AF_INET6) {
+		proto = NET_IPV6_HDR(pkt)->nexthdr;
+	} else {
+		proto = NET_IPV4_HDR(pkt)->proto;
+	}
+
+	if (proto != IPPROTO_TCP && proto != IPPROTO_UDP) {
+		return false;
+	}
+
+	/* The destination port follows the source port in both headers */
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			   sizeof(uint16_t));
+	if (ret == 0) {
+		ret = net_pkt_read_be16(pkt, &port);
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret == 0 && port == loopback_bottleneck_port;
+}
+
+/* Time the packet leaves the bottleneck at, or 0 if the queue is full */
+static uint64_t loopback_link_send(uint64_t now_us, size_t len)
+{
+	uint32_t queued_us = 0;
+
+	if (loopback_link_free_us > now_us) {
+		queued_us = loopback_link_free_us - now_us;
+	}
+
+	if ((uint64_t)queued_us * loopback_bandwidth_kbps / 8000 + len > loopback_queue_size) {
+		return 0;
+	}
+
+	loopback_link_free_us = MAX(loopback_link_free_us, now_us) +
+				(uint64_t)len * 8000 / loopback_bandwidth_kbps;
+
+	loopback_queue_delay_sum += queued_us;
+	loopback_queue_delay_count++;
+	loopback_queue_delay_max = MAX(loopback_queue_delay_max, queued_us);
+
+	return loopback_link_free_us;
+}
+
+/* Run the work when the first of the packets is due, called locked */
+static void loopback_delay_schedule(void)
+{
+	struct loopback_delayed_pkt *first = NULL;
+
+	ARRAY_FOR_EACH_PTR(loopback_delay_lines, line) {
+		struct loopback_delayed_pkt *entry;
+
+		if (line->tail == line->head) {
+			continue;
+		}
+
+		entry = &line->queue[line->head % LOOPBACK_DELAY_QUEUE_LEN];
+		if (first == NULL || sys_timepoint_cmp(entry->due, first->due) < 0) {
+			first = entry;
+		}
+	}
+
+	if (first != NULL) {
+		k_work_reschedule(&loopback_delay_work, sys_timepoint_timeout(first->due));
+	}
+}
+
+static int loopback_delay_pkt(struct net_pkt *pkt)
+{
+	uint64_t now_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	struct loopback_delayed_pkt *entry;
+	struct loopback_delay_line *line;
+	uint64_t delay_us = 0;
+	k_spinlock_key_t key;
+	bool limited;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	limited = loopback_is_limited(pkt);
+	line = &loopback_delay_lines[limited ? 0 : 1];
+
+	if (line->tail - line->head == LOOPBACK_DELAY_QUEUE_LEN) {
+		k_spin_unlock(&loopback_delay_lock, key);
+		return -ENOMEM;
+	}
+
+	if (limited) {
+		uint64_t departure_us = loopback_link_send(now_us, net_pkt_get_len(pkt));
+
+		if (departure_us == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			return -ENOBUFS;
+		}
+
+		delay_us = departure_us - now_us;
+	}
+
+	delay_us += (uint64_t)loopback_delay_ms * USEC_PER_MSEC;
+
+	entry = &line->queue[line->tail++ % LOOPBACK_DELAY_QUEUE_LEN];
+	entry->pkt = pkt;
+	entry->due = sys_timepoint_calc(K_USEC(delay_us));
+
+	/* The packet can be due before the ones of the other line */
+	if (line->tail - line->head == 1) {
+		loopback_delay_schedule();
+	}
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	return 0;
+}
+
+/* Deliver the packets whose delay has passed, in the order they were sent */
+static void loopback_delay_work_handler(struct k_work *work)
+{
+	struct loopback_delayed_pkt *entry;
+	k_spinlock_key_t key;
+	struct net_pkt *pkt;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		pkt = NULL;
+
+		key = k_spin_lock(&loopback_delay_lock);
+
+		ARRAY_FOR_EACH_PTR(loopback_delay_lines, line) {
+			if (line->tail == line->head) {
+				continue;
+			}
+
+			entry = &line->queue[line->head % LOOPBACK_DELAY_QUEUE_LEN];
+			if (sys_timepoint_expired(entry->due)) {
+				pkt = entry->pkt;
+				line->head++;
+				break;
+			}
+		}
+
+		if (pkt == NULL) {
+			loopback_delay_schedule();
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -103,6 +370,13 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 	ARG_UNUSED(dev);
 
 #ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP
+	/* Drop the rest of a burst */
+	if (loopback_packet_drop_pending > 0) {
+		loopback_packet_drop_pending--;
+		loopback_packet_dropped_count++;
+		return 0;
+	}
+
 	/* Drop packets based on the loopback_packet_drop_ratio
 	 * a ratio of 0.2 will drop one every 5 packets
 	 */
@@ -111,6 +385,7 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		/* Administrate we dropped a packet */
 		loopback_packet_drop_state -= 1.0f;
 		loopback_packet_dropped_count++;
+		loopback_packet_drop_pending = loopback_packet_drop_burst - 1;
 		return 0;
 	}
 #endif
@@ -151,6 +426,19 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	if (loopback_delay_ms > 0 || loopback_bandwidth_kbps > 0) {
+		res = loopback_delay_pkt(cloned);
+		if (res < 0) {
+			/* Queue full, like a congested link */
+			net_pkt_unref(cloned);
+			res = 0;
+		}
+
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
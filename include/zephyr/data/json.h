@@ -8,6 +8,7 @@
 #define ZEPHYR_INCLUDE_DATA_JSON_H_
 
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/atomic.h>
 #include <stddef.h>
 #include <zephyr/toolchain.h>
 #include <zephyr/types.h>
@@ -44,6 +45,7 @@ enum json_tokens {
 	JSON_TOK_ENCODED_OBJ = '4',
 	JSON_TOK_INT64 = '5',
 	JSON_TOK_UINT64 = '6',
+	JSON_TOK_KEYED_OBJECT = '7',
 	JSON_TOK_TRUE = 't',
 	JSON_TOK_FALSE = 'f',
 	JSON_TOK_NULL = 'n',
@@ -74,6 +76,7 @@ struct json_obj_token {
 	size_t length;
 };
 
+struct json_obj_key_table;
 
 struct json_obj_descr {
 	const char *field_name;
@@ -108,9 +111,33 @@ struct json_obj_descr {
 			const struct json_obj_descr *element_descr;
 			size_t n_elements;
 		} array;
+		struct {
+			struct json_obj_key_table *table;
+		} keyed;
 	};
 };
 
+/**
+ * @brief Hash table indexing the field names of an object descriptor
+ *
+ * Lets the parser find the descriptor of each key in constant time rather
+ * than by comparing it with every field name, and allows up to
+ * CONFIG_JSON_OBJ_KEY_TABLE_MAX_FIELDS fields. Define it with
+ * JSON_OBJ_KEY_TABLE_DEFINE(). The slots are filled the first time the
+ * table is used.
+ */
+struct json_obj_key_table {
+	/** Descriptor array indexed by the table */
+	const struct json_obj_descr *descr;
+	/** Number of elements in the descriptor array */
+	size_t descr_len;
+	/** @cond INTERNAL_HIDDEN */
+	uint16_t *slots;
+	size_t num_slots;
+	atomic_t state;
+	/** @endcond */
+};
+
 /**
  * @brief Function pointer type to append bytes to a buffer while
  * encoding JSON data.
@@ -568,6 +595,131 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 		}, \
 	}
 
+/** @cond INTERNAL_HIDDEN */
+#define Z_JSON_KEY_TABLE_SLOTS(name_) _json_key_table_slots_##name_
+#define Z_JSON_KEYED_FIELDS_WORDS DIV_ROUND_UP(CONFIG_JSON_OBJ_KEY_TABLE_MAX_FIELDS, 32)
+/** @endcond */
+
+/**
+ * @brief Define a hash table of the field names of an object descriptor
+ *
+ * The table has at least twice as many slots as there are descriptors, each
+ * taking two bytes of RAM, so that the parser finds the descriptor matching
+ * a key in constant time. This pays off for objects with many fields, and
+ * lifts the limit of 63 fields of json_obj_parse(), up to
+ * CONFIG_JSON_OBJ_KEY_TABLE_MAX_FIELDS. Parse objects with such a table with
+ * json_obj_parse_keyed(), or use it for nested objects with
+ * JSON_OBJ_DESCR_KEYED_OBJECT() or JSON_OBJ_DESCR_KEYED_OBJ_ARRAY(). Like the
+ * descriptor arrays, the table is static to the file defining it.
+ *
+ * Here's an example of use:
+ *
+ *      struct telemetry {
+ *          int32_t temperature;
+ *          int32_t pressure;
+ *          ...
+ *      };
+ *
+ *      static const struct json_obj_descr telemetry_descr[] = {
+ *          JSON_OBJ_DESCR_PRIM(struct telemetry, temperature, JSON_TOK_NUMBER),
+ *          JSON_OBJ_DESCR_PRIM(struct telemetry, pressure, JSON_TOK_NUMBER),
+ *          ...
+ *      };
+ *
+ *      JSON_OBJ_KEY_TABLE_DEFINE(telemetry_keys, telemetry_descr);
+ *
+ * @param name_ Name of the key table
+ * @param descr_ Array of json_obj_descr to index
+ */
+#define JSON_OBJ_KEY_TABLE_DEFINE(name_, descr_) \
+	BUILD_ASSERT(ARRAY_SIZE(descr_) <= CONFIG_JSON_OBJ_KEY_TABLE_MAX_FIELDS, \
+		     "too many fields, see CONFIG_JSON_OBJ_KEY_TABLE_MAX_FIELDS"); \
+	static uint16_t Z_JSON_KEY_TABLE_SLOTS(name_)[NHPOT(2 * ARRAY_SIZE(descr_))]; \
+	static struct json_obj_key_table name_ = { \
+		.descr = descr_, \
+		.descr_len = ARRAY_SIZE(descr_), \
+		.slots = Z_JSON_KEY_TABLE_SLOTS(name_), \
+		.num_slots = ARRAY_SIZE(Z_JSON_KEY_TABLE_SLOTS(name_)), \
+	}
+
+/**
+ * @brief Helper macro to declare a descriptor for an object value whose
+ * fields are looked up through a key table
+ *
+ * @param struct_ Struct packing the values
+ * @param field_name_ Field name in the struct
+ * @param key_table_ Key table of the subobject, defined with
+ * JSON_OBJ_KEY_TABLE_DEFINE()
+ *
+ * @see JSON_OBJ_DESCR_OBJECT
+ */
+#define JSON_OBJ_DESCR_KEYED_OBJECT(struct_, field_name_, key_table_) \
+	{ \
+		.field_name = (#field_name_), \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
+		.field_name_len = (sizeof(#field_name_) - 1), \
+		.type = JSON_TOK_KEYED_OBJECT, \
+		.offset = offsetof(struct_, field_name_), \
+		.keyed = { \
+			.table = &(key_table_), \
+		}, \
+	}
+
+/**
+ * @brief Variant of JSON_OBJ_DESCR_KEYED_OBJECT that can be used when the
+ *        structure and JSON field names differ.
+ *
+ * @param struct_ Struct packing the values
+ * @param json_field_name_ String, field name in JSON strings
+ * @param struct_field_name_ Field name in the struct
+ * @param key_table_ Key table of the subobject, defined with
+ * JSON_OBJ_KEY_TABLE_DEFINE()
+ *
+ * @see JSON_OBJ_DESCR_KEYED_OBJECT
+ */
+#define JSON_OBJ_DESCR_KEYED_OBJECT_NAMED(struct_, json_field_name_, \
+					  struct_field_name_, key_table_) \
+	{ \
+		.field_name = (json_field_name_), \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
+		.field_name_len = (sizeof(json_field_name_) - 1), \
+		.type = JSON_TOK_KEYED_OBJECT, \
+		.offset = offsetof(struct_, struct_field_name_), \
+		.keyed = { \
+			.table = &(key_table_), \
+		}, \
+	}
+
+/**
+ * @brief Helper macro to declare a descriptor for an array of objects whose
+ * fields are looked up through a key table
+ *
+ * @param struct_ Struct packing the values
+ * @param field_name_ Field name in the struct containing the array
+ * @param max_len_ Maximum number of elements in the array
+ * @param len_field_ Field name in the struct for the number of elements
+ * in the array
+ * @param key_table_ Key table of the elements, defined with
+ * JSON_OBJ_KEY_TABLE_DEFINE()
+ *
+ * @see JSON_OBJ_DESCR_OBJ_ARRAY
+ */
+#define JSON_OBJ_DESCR_KEYED_OBJ_ARRAY(struct_, field_name_, max_len_, \
+				       len_field_, key_table_) \
+	{ \
+		.field_name = (#field_name_), \
+		.align_shift = Z_ALIGN_SHIFT(struct_), \
+		.field_name_len = sizeof(#field_name_) - 1, \
+		.type = JSON_TOK_ARRAY_START, \
+		.offset = offsetof(struct_, field_name_), \
+		.array = { \
+			.element_descr = Z_JSON_ELEMENT_DESCR(struct_, len_field_, \
+				JSON_TOK_KEYED_OBJECT, \
+				.keyed = { .table = &(key_table_) }), \
+			.n_elements = (max_len_), \
+		}, \
+	}
+
 /**
  * @brief Parses the JSON-encoded object pointed to by @a json, with
  * size @a len, according to the descriptor pointed to by @a descr.
@@ -602,6 +754,29 @@ int64_t json_obj_parse(char *json, size_t len,
 	const struct json_obj_descr *descr, size_t descr_len,
 	void *val);
 
+/**
+ * @brief Parses a JSON-encoded object, looking its keys up in a key table
+ *
+ * Same as json_obj_parse(), but finds the descriptor of each key in
+ * constant time through @a table, which also allows objects with more than
+ * 63 fields. If a key shows up more than once, the first value is kept, as
+ * json_obj_parse() does.
+ *
+ * @param json Pointer to JSON-encoded value to be parsed
+ * @param len Length of JSON-encoded value
+ * @param table Key table of the object, defined with
+ * JSON_OBJ_KEY_TABLE_DEFINE()
+ * @param val Pointer to the struct to hold the decoded values
+ * @param decoded_fields Bitmap of DIV_ROUND_UP(descr_len, 32) words set to
+ * the decoded fields on success (bit 0 of the first word is set if first
+ * field in the descriptor has been properly decoded, etc), or NULL
+ *
+ * @return 0 if the object has been successfully parsed. A negative value
+ * indicates an error (as defined on errno.h).
+ */
+int json_obj_parse_keyed(char *json, size_t len, struct json_obj_key_table *table,
+			 void *val, uint32_t *decoded_fields);
+
 /**
  * @brief Parses the JSON-encoded array pointed to by @a json, with
  * size @a len, according to the descriptor pointed to by @a descr.
@@ -672,6 +847,139 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+#if defined(CONFIG_JSON_LIBRARY) || defined(__DOXYGEN__)
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Longest key or number the stream parser buffers, field names being at
+ * most 127 characters long.
+ */
+#define JSON_STREAM_TOKEN_SIZE 128
+
+struct json_stream_frame {
+	/* Object: field descriptors, array: element descriptor */
+	const struct json_obj_descr *descr;
+	/* Object: struct holding the values, array: next element */
+	void *val;
+	union {
+		struct {
+			struct json_obj_key_table *table;
+			size_t descr_len;
+			int64_t decoded_fields;
+			/* Keyed object: fields decoded already */
+			uint32_t keyed_fields[Z_JSON_KEYED_FIELDS_WORDS];
+			int field;
+		} obj;
+		struct {
+			void *end;
+			size_t *elements;
+			ptrdiff_t elem_size;
+		} arr;
+	};
+	uint8_t type;
+	uint8_t expect;
+};
+
+/** @endcond */
+
+/**
+ * @brief Incremental JSON object parser state
+ *
+ * Holds everything needed to resume parsing where the previous chunk of
+ * data ended, in a constant amount of memory whatever the document size.
+ * Its members are private.
+ *
+ * @see json_stream_init
+ */
+struct json_stream {
+	/** @cond INTERNAL_HIDDEN */
+	struct json_stream_frame frames[CONFIG_JSON_STREAM_MAX_DEPTH];
+	char tok[JSON_STREAM_TOKEN_SIZE];
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+	size_t str_start;
+	const struct json_obj_descr *value_descr;
+	void *value_field;
+	const char *literal;
+	int error;
+	uint16_t tok_len;
+	uint16_t skip_depth;
+	uint8_t depth;
+	uint8_t lex;
+	uint8_t sink;
+	uint8_t hex;
+	bool capture;
+	bool done;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an incremental JSON object parser
+ *
+ * Prepares @a stream to parse a JSON-encoded object provided in chunks of
+ * arbitrary size with json_stream_feed(), for instance as they are
+ * received from a socket or found in a net_buf fragment chain, so that the
+ * whole object never needs to be held in memory. Values are stored in the
+ * struct pointed to by @a val according to the same descriptors as
+ * json_obj_parse(), with the same limitations.
+ *
+ * As the chunks don't outlive the calls to json_stream_feed(), string
+ * values, as well as JSON_TOK_FLOAT, JSON_TOK_OPAQUE and JSON_TOK_OBJ_ARRAY
+ * values, are copied to @a buf, which the decoded fields then point to.
+ * Other values need no storage besides @a val.
+ *
+ * @param stream Parser state, to be passed to json_stream_feed()
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be less
+ * than 63 due to implementation detail reasons.
+ * @param val Pointer to the struct to hold the decoded values
+ * @param buf Buffer to hold the decoded strings, may be NULL if none are
+ * expected
+ * @param buf_size Size of @a buf, in bytes
+ *
+ * @return 0 on success, -EINVAL if @a descr_len is too big.
+ */
+int json_stream_init(struct json_stream *stream, const struct json_obj_descr *descr,
+		     size_t descr_len, void *val, char *buf, size_t buf_size);
+
+/**
+ * @brief Feed a chunk of JSON-encoded data to an incremental parser
+ *
+ * Parses @a len bytes of data at @a data, continuing from where the
+ * previous chunk ended. Chunk boundaries can fall anywhere, including in
+ * the middle of a key or value. Data following the end of the object is
+ * ignored.
+ *
+ * @param stream Parser state, initialized with json_stream_init()
+ * @param data Chunk of JSON-encoded data
+ * @param len Length of the chunk, in bytes
+ *
+ * @retval 0 if more data is needed to complete the object
+ * @retval 1 if the object is complete
+ * @retval -EINVAL if the data isn't a valid JSON object matching the
+ * descriptors
+ * @retval -ENOSPC if an array has more elements than its descriptor allows
+ * @retval -ENOMEM if the string buffer is too small, or the object nested
+ * deeper than CONFIG_JSON_STREAM_MAX_DEPTH
+ *
+ * Once an error is returned, subsequent calls return it as well.
+ */
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Get the outcome of an incremental parse
+ *
+ * @param stream Parser state, initialized with json_stream_init()
+ *
+ * @return < 0 if error, including -EINVAL if the object isn't complete yet,
+ * bitmap of decoded fields on success (bit 0 is set if first field in the
+ * descriptor has been properly decoded, etc).
+ */
+int64_t json_stream_finish(struct json_stream *stream);
+
+#endif /* CONFIG_JSON_LIBRARY */
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
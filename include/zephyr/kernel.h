@@ -5702,10 +5702,22 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Room for the per-CPU caches kept in the heap metadata */
+#define Z_HEAP_CACHE_SIZE						\
+	ROUND_UP(CONFIG_MP_MAX_NUM_CPUS *				\
+		 ROUND_UP(ROUND_UP(sizeof(struct k_spinlock), sizeof(void *)) + \
+			  CONFIG_SYS_HEAP_CACHE_CLASSES * sizeof(void *) + \
+			  ROUND_UP(CONFIG_SYS_HEAP_CACHE_CLASSES, 4) + 8,	\
+			  sizeof(void *)), 8)
+#else
+#define Z_HEAP_CACHE_SIZE 0
+#endif
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
-#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+#define Z_HEAP_MIN_SIZE (((sizeof(void *) > 4) ? 56 : 44) + Z_HEAP_CACHE_SIZE)
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -5856,6 +5868,43 @@ void *k_calloc(size_t nmemb, size_t size);
  */
 void *k_realloc(void *ptr, size_t size);
 
+/**
+ * @brief Statistics of the memory behind k_malloc()
+ *
+ * The slab fields are only filled in with CONFIG_HEAP_MEM_POOL_SLABS and
+ * are zero otherwise.
+ */
+struct k_malloc_stats {
+	/** Total memory of the size class slabs, in bytes */
+	size_t slab_bytes;
+	/** Memory currently allocated from the slabs, in bytes */
+	size_t slab_used_bytes;
+	/** Free memory in the system heap, in bytes */
+	size_t heap_free_bytes;
+	/** Largest block the system heap can currently allocate, in bytes */
+	size_t heap_largest_free_bytes;
+	/** Number of requests served from a slab */
+	uint32_t slab_hits;
+	/** Number of requests falling back to the heap as their slab was full */
+	uint32_t slab_misses;
+	/** Number of requests too big for any size class */
+	uint32_t large_allocs;
+};
+
+/**
+ * @brief Get the statistics of the memory behind k_malloc()
+ *
+ * Only available when there is a system heap. The fragmentation of the system
+ * heap can be derived from the ratio between the largest free block and the
+ * total free memory.
+ *
+ * @param stats Pointer to struct to copy statistics into
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a stats is NULL
+ */
+int k_malloc_stats_get(struct k_malloc_stats *stats);
+
 /** @} */
 
 /* polling API - PRIVATE */
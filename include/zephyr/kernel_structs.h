@@ -157,7 +157,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -213,7 +213,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -298,11 +298,17 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  With
+	 * CONFIG_TIMEOUT_QUEUE_WHEEL this is the absolute expiry tick.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Index of the per-CPU timeout queue this timeout is armed on */
+	uint8_t queue;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
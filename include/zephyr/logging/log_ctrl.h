@@ -295,6 +295,22 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Get the number of messages dropped on a CPU.
+ *
+ * Requires CONFIG_LOG_PER_CPU_BUFFERS option. A message is counted on the CPU
+ * which was logging when it was dropped, the count is not cleared when the
+ * backends are notified of the drops.
+ *
+ * @param cpu CPU index.
+ * @param[out] cnt Number of messages dropped since the logging initialization.
+ *
+ * @retval -EINVAL if the CPU index is out of range.
+ * @retval -ENOTSUP if per-CPU buffers are not enabled.
+ * @retval 0 successfully read the number of dropped messages.
+ */
+int log_cpu_dropped_get(unsigned int cpu, uint32_t *cnt);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
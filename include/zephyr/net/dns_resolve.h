@@ -420,6 +420,12 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+		/** Query for the same name and type that was sent to the
+		 * servers, whose answer is also delivered to this one.
+		 * NULL if this query was sent itself.
+		 */
+		struct dns_pending_query *leader;
 	} queries[DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
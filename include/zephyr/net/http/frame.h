@@ -61,6 +61,9 @@ enum http2_frame_type {
 #define HTTP2_PRIORITY_FRAME_LEN 5
 #define HTTP2_RST_STREAM_FRAME_LEN 4
 
+/* Default SETTINGS_MAX_FRAME_SIZE, the largest frame a peer always accepts */
+#define HTTP2_DEFAULT_MAX_FRAME_SIZE 16384
+
 /** @endcond */
 
 /** HTTP2 settings field */
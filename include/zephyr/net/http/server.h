@@ -490,6 +490,12 @@ struct http_client_ctx {
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (uint8_t supported_compression));
 /** @endcond */
 
+/** @cond INTERNAL_HIDDEN */
+	/** Entity tags of the If-None-Match request header. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE,
+		   (char if_none_match[HTTP_SERVER_MAX_HEADER_LEN]));
+/** @endcond */
+
 	/** Flag indicating that HTTP2 preface was sent. */
 	bool preface_sent : 1;
 
@@ -511,6 +517,9 @@ struct http_client_ctx {
 	/** Flag indicating accept encoding is being processed. */
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (bool accept_encoding_next: 1));
 
+	/** Flag indicating If-None-Match is being processed. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE, (bool if_none_match_next: 1));
+
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
 };
@@ -544,6 +553,14 @@ int http_server_start(void);
  */
 int http_server_stop(void);
 
+/** @brief Drop the files cached for static file system resources.
+ *
+ * To be called after modifying the files served by static file system
+ * resources, so that the next requests read them again. Only available with
+ * @kconfig{CONFIG_HTTP_SERVER_STATIC_FS_CACHE}.
+ */
+void http_server_static_fs_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,9 @@ struct http_service_desc {
 	struct http_resource_desc *res_begin;
 	struct http_resource_desc *res_end;
 	struct http_resource_detail *res_fallback;
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TREE)
+	uint16_t *res_tree;
+#endif
 #if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
 	const sec_tag_t *sec_tag_list;
 	size_t sec_tag_list_size;
@@ -85,6 +88,8 @@ struct http_service_desc {
 				_res_fallback, _res_begin,                                         \
 				_res_end, ...)                                                     \
 	static int _name##_fd = -1;                                                                \
+	IF_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_TREE,                                               \
+		   (static uint16_t _name##_res_tree = UINT16_MAX;))                               \
 	const STRUCT_SECTION_ITERABLE(http_service_desc, _name) = {                                \
 		.host = _host,                                                                     \
 		.port = (uint16_t *)(_port),                                                       \
@@ -95,6 +100,8 @@ struct http_service_desc {
 		.res_begin = (_res_begin),                                                         \
 		.res_end = (_res_end),                                                             \
 		.res_fallback = (_res_fallback),                                                   \
+		IF_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_TREE,                                       \
+			   (.res_tree = &_name##_res_tree,))                                       \
 		COND_CODE_1(CONFIG_NET_SOCKETS_SOCKOPT_TLS,                                        \
 			    (.sec_tag_list = COND_CODE_0(NUM_VA_ARGS_LESS_1(__VA_ARGS__), (NULL),  \
 							 (GET_ARG_N(1, __VA_ARGS__))),), ())       \
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief IPv4 routing table
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_IPV4_ROUTE_H_
+#define ZEPHYR_INCLUDE_NET_IPV4_ROUTE_H_
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/net/net_ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief IPv4 routing table
+ * @defgroup ipv4_route IPv4 routing table
+ * @since 4.2
+ * @version 0.1.0
+ * @ingroup networking
+ * @{
+ */
+
+struct net_if;
+
+/** Lifetime of an IPv4 route that does not expire */
+#define NET_IPV4_ROUTE_INFINITE_LIFETIME UINT32_MAX
+
+/**
+ * @brief Copy of an IPv4 route, taken while the routing table is locked.
+ */
+struct net_ipv4_route_info {
+	/** Network interface of the route */
+	struct net_if *iface;
+
+	/** IPv4 prefix of the route */
+	struct in_addr addr;
+
+	/** Gateway for the destinations of the prefix */
+	struct in_addr gw;
+
+	/** Remaining lifetime in seconds, or NET_IPV4_ROUTE_INFINITE_LIFETIME */
+	uint32_t lifetime;
+
+	/** IPv4 prefix length */
+	uint8_t prefix_len;
+};
+
+/**
+ * @brief Callback used while iterating over the IPv4 routes.
+ *
+ * @param route Copy of the route.
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*net_ipv4_route_cb_t)(const struct net_ipv4_route_info *route,
+				    void *user_data);
+
+/**
+ * @brief Add a route to the IPv4 routing table.
+ *
+ * If there is already a route to the same prefix on the interface, only its
+ * gateway and lifetime are updated. The route is removed when its lifetime
+ * expires or when the interface goes down.
+ *
+ * @param iface Network interface that this route is tied to.
+ * @param addr IPv4 prefix. The bits after the prefix length are ignored.
+ * @param prefix_len Length of the IPv4 prefix, 0 for a default route.
+ * @param gw Gateway for the destinations of the prefix.
+ * @param lifetime Lifetime of the route in seconds, or
+ *        NET_IPV4_ROUTE_INFINITE_LIFETIME.
+ *
+ * @return 0 if ok, -EINVAL if the arguments are invalid, -ENOMEM if the
+ *         routing table is full.
+ */
+#if defined(CONFIG_NET_IPV4_ROUTE)
+int net_ipv4_route_add(struct net_if *iface, const struct in_addr *addr,
+		       uint8_t prefix_len, const struct in_addr *gw,
+		       uint32_t lifetime);
+#else
+static inline int net_ipv4_route_add(struct net_if *iface, const struct in_addr *addr,
+				     uint8_t prefix_len, const struct in_addr *gw,
+				     uint32_t lifetime)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(prefix_len);
+	ARG_UNUSED(gw);
+	ARG_UNUSED(lifetime);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_IPV4_ROUTE */
+
+/**
+ * @brief Delete a route from the IPv4 routing table.
+ *
+ * @param iface Network interface of the route.
+ * @param addr IPv4 prefix of the route.
+ * @param prefix_len Length of the IPv4 prefix.
+ *
+ * @return 0 if ok, -ENOENT if there is no such route.
+ */
+#if defined(CONFIG_NET_IPV4_ROUTE)
+int net_ipv4_route_del(struct net_if *iface, const struct in_addr *addr,
+		       uint8_t prefix_len);
+#else
+static inline int net_ipv4_route_del(struct net_if *iface, const struct in_addr *addr,
+				     uint8_t prefix_len)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(prefix_len);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_IPV4_ROUTE */
+
+/**
+ * @brief Lookup the IPv4 route with the longest prefix matching a destination.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ * @param route Copy of the matching route, set only if one is found.
+ *
+ * @return True if a route was found, false otherwise.
+ */
+#if defined(CONFIG_NET_IPV4_ROUTE)
+bool net_ipv4_route_lookup(struct net_if *iface, const struct in_addr *dst,
+			   struct net_ipv4_route_info *route);
+#else
+static inline bool net_ipv4_route_lookup(struct net_if *iface, const struct in_addr *dst,
+					 struct net_ipv4_route_info *route)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(route);
+
+	return false;
+}
+#endif /* CONFIG_NET_IPV4_ROUTE */
+
+/**
+ * @brief Go through all the IPv4 routes and call callback for each route.
+ *
+ * The routing table is locked while the callback runs.
+ *
+ * @param cb User-supplied callback function to call.
+ * @param user_data User specified data.
+ *
+ * @return Number of routes found.
+ */
+#if defined(CONFIG_NET_IPV4_ROUTE)
+int net_ipv4_route_foreach(net_ipv4_route_cb_t cb, void *user_data);
+#else
+static inline int net_ipv4_route_foreach(net_ipv4_route_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return 0;
+}
+#endif /* CONFIG_NET_IPV4_ROUTE */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_IPV4_ROUTE_H_ */
@@ -25,6 +25,18 @@ extern "C" {
  */
 int loopback_set_packet_drop_ratio(float ratio);
 
+/**
+ * @brief Set the number of consecutive packets dropped at a time
+ *
+ * Each drop caused by the packet drop rate drops this many packets in a
+ * row, to simulate burst losses. The default is 1.
+ *
+ * @param[in] count Number of packets, at least 1
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_drop_burst(int count);
+
 /**
  * @brief Get the number of dropped packets
  *
@@ -33,6 +45,51 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+/**
+ * @brief Set the delay of the packets
+ *
+ * The packets are delivered in the order they are sent, after the delay.
+ * Packets sent while CONFIG_NET_PKT_RX_COUNT packets are delayed already
+ * are dropped.
+ *
+ * @param[in] delay_ms Delay in milliseconds, 0 for no delay
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_delay(uint32_t delay_ms);
+
+/**
+ * @brief Limit the bandwidth of the link
+ *
+ * The packets are sent over the link one after the other at the given
+ * rate, before the delay set with loopback_set_packet_delay(). Packets
+ * that find more than the given amount of data waiting for the link are
+ * dropped. The queueing delay statistics are reset.
+ *
+ * The bottleneck can be limited to the packets to one TCP or UDP port, so
+ * that the acknowledgments of a transfer to that port are not queued
+ * behind its data, as on a link with a separate channel per direction.
+ *
+ * @param[in] kbps Bandwidth in kilobits per second, 0 for no limit
+ * @param[in] queue_size Size of the queue in bytes
+ * @param[in] port Destination port of the limited packets, 0 for all packets
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_bandwidth(uint32_t kbps, uint32_t queue_size, uint16_t port);
+
+/**
+ * @brief Get the time the packets waited for the link
+ *
+ * @param[out] avg_us Average queueing delay in microseconds
+ * @param[out] max_us Largest queueing delay in microseconds
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_get_queue_delay(uint32_t *avg_us, uint32_t *max_us);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -101,6 +101,8 @@ enum net_event_ipv4_cmd {
 	NET_EVENT_IPV4_CMD_ACD_FAILED,
 	NET_EVENT_IPV4_CMD_ACD_CONFLICT,
 	NET_EVENT_IPV4_CMD_PMTU_CHANGED,
+	NET_EVENT_IPV4_CMD_ROUTE_ADD,
+	NET_EVENT_IPV4_CMD_ROUTE_DEL,
 };
 
 /* L4 network events */
@@ -310,6 +312,16 @@ enum net_event_l4_cmd {
 #define NET_EVENT_IPV4_PMTU_CHANGED				\
 	(_NET_EVENT_IPV4_BASE | NET_EVENT_IPV4_CMD_PMTU_CHANGED)
 
+/** Event emitted when an IPv4 route is added to the routing table, or when
+ *  the gateway of a route changes.
+ */
+#define NET_EVENT_IPV4_ROUTE_ADD				\
+	(_NET_EVENT_IPV4_BASE | NET_EVENT_IPV4_CMD_ROUTE_ADD)
+
+/** Event emitted when an IPv4 route is removed from the routing table. */
+#define NET_EVENT_IPV4_ROUTE_DEL				\
+	(_NET_EVENT_IPV4_BASE | NET_EVENT_IPV4_CMD_ROUTE_DEL)
+
 /** Event emitted when the system is considered to be connected.
  * The connected in this context means that the network interface is up,
  * and the interface has either IPv4 or IPv6 address assigned to it.
@@ -485,6 +497,23 @@ struct net_event_ipv4_pmtu_info {
 	uint16_t mtu;
 };
 
+/**
+ * @brief Network Management event information structure
+ * Used to pass information on network events like
+ *   NET_EVENT_IPV4_ROUTE_ADD and
+ *   NET_EVENT_IPV4_ROUTE_DEL
+ * when CONFIG_NET_MGMT_EVENT_INFO enabled and event generator pass the
+ * information.
+ */
+struct net_event_ipv4_route {
+	/** IPv4 address of the gateway */
+	struct in_addr gw;
+	/** IPv4 prefix of the route */
+	struct in_addr addr;
+	/** IPv4 prefix length */
+	uint8_t prefix_len;
+};
+
 /**
  * @brief Network Management event information structure
  * Used to pass information on network event
@@ -77,6 +77,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only block until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -237,6 +239,11 @@ extern "C" {
  *  will take place in consecutive send()/recv() call.
  */
 #define TLS_DTLS_HANDSHAKE_ON_CONNECT 18
+/** Read-only socket option to get the statistics of the TLS/DTLS session
+ *  caches and session tickets, shared by all the sockets.
+ *  The option accepts a pointer to a @ref tls_session_cache_stats structure.
+ */
+#define TLS_SESSION_CACHE_STATS 19
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -266,6 +273,20 @@ extern "C" {
 #define TLS_DTLS_CID_STATUS_UPLINK		2 /**< CID is in use by peer */
 #define TLS_DTLS_CID_STATUS_BIDIRECTIONAL	3 /**< CID is in use by us and peer */
 /** @} */ /* for @name */
+
+/** Statistics returned by the @ref TLS_SESSION_CACHE_STATS socket option. */
+struct tls_session_cache_stats {
+	uint32_t client_hits;      /**< Stored sessions offered by clients */
+	uint32_t client_misses;    /**< Client handshakes without a stored session */
+	uint32_t server_hits;      /**< Sessions resumed by servers from their cache */
+	uint32_t server_misses;    /**< Session IDs not found by servers */
+	uint32_t tickets_issued;   /**< Session tickets issued by servers */
+	uint32_t tickets_accepted; /**< Sessions resumed by servers from a ticket */
+	uint32_t tickets_rejected; /**< Invalid or expired session tickets */
+	uint32_t expired;          /**< Stored sessions dropped past their lifetime */
+	uint32_t evicted;          /**< Stored sessions replaced to make room */
+};
+
 /** @} */ /* for @defgroup */
 
 /**
@@ -501,6 +522,54 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send several messages on a socket
+ *
+ * @details
+ * Sends the messages of @p msgvec one after the other, as zsock_sendmsg()
+ * would, but looks up the socket and takes its lock only once. The number
+ * of bytes sent for each message is stored in its @c msg_len field.
+ * See the Linux sendmmsg(2) manual page for a description.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to send on
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if none could be
+ *         sent. An error on a later message ends the batch early.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags);
+
+/**
+ * @brief Receive several messages from a socket
+ *
+ * @details
+ * Receives up to @p vlen messages into @p msgvec, as zsock_recvmsg() would,
+ * but looks up the socket and takes its lock only once. The number of
+ * bytes received for each message is stored in its @c msg_len field.
+ * With @ref ZSOCK_MSG_WAITFORONE, the messages following the first one are
+ * only received if they are already queued. Like on Linux, @p timeout is
+ * only checked after each message has been received.
+ * See the Linux recvmmsg(2) manual page for a description.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to receive from
+ * @param msgvec Messages to receive into
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags, as for zsock_recvmsg(), and @ref ZSOCK_MSG_WAITFORONE
+ * @param timeout Time after which no more messages are received, or NULL
+ *
+ * @return Number of messages received, or -1 with errno set if none could
+ *         be received. An error on a later message ends the batch early.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags, struct timespec *timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -923,6 +992,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm of the connection, by name (char[]) */
+#define TCP_CONGESTION 5
 
 /** @} */
 
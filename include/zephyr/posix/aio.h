@@ -15,6 +15,17 @@
 extern "C" {
 #endif
 
+#define AIO_ALLDONE     0
+#define AIO_CANCELED    1
+#define AIO_NOTCANCELED 2
+
+#define LIO_NOP    0
+#define LIO_READ   1
+#define LIO_WRITE  2
+
+#define LIO_NOWAIT 0
+#define LIO_WAIT   1
+
 struct aiocb {
 	int aio_fildes;
 	off_t aio_offset;
@@ -23,6 +34,10 @@ struct aiocb {
 	int aio_reqprio;
 	struct sigevent aio_sigevent;
 	int aio_lio_opcode;
+
+	/* Private, status of the request */
+	int _aio_error;
+	ssize_t _aio_return;
 };
 
 #if _POSIX_C_SOURCE >= 200112L
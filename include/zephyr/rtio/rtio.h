@@ -555,6 +555,9 @@ struct rtio_iodev {
 /** An operation to sends I3C CCC */
 #define RTIO_OP_I3C_CCC (RTIO_OP_I3C_CONFIGURE+1)
 
+/** An operation that flushes the data written to an iodev to its storage */
+#define RTIO_OP_FSYNC (RTIO_OP_I3C_CCC+1)
+
 /**
  * @brief Prepare a nop (no op) submission
  */
@@ -568,6 +571,21 @@ static inline void rtio_sqe_prep_nop(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare an fsync op submission
+ */
+static inline void rtio_sqe_prep_fsync(struct rtio_sqe *sqe,
+				       const struct rtio_iodev *iodev,
+				       int8_t prio,
+				       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FSYNC;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->userdata = userdata;
+}
+
 /**
  * @brief Prepare a read op submission
  */
@@ -211,6 +211,37 @@ void *zvfs_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 bool zvfs_get_obj_lock_and_cond(void *obj, const struct fd_op_vtable *vtable, struct k_mutex **lock,
 			     struct k_condvar **cond);
 
+/**
+ * @brief Get the epoll registrations of a file descriptor.
+ *
+ * For use by the ZVFS epoll implementation, which keeps the list consistent
+ * under its own lock.
+ *
+ * @param fd File descriptor previously returned by zvfs_reserve_fd()
+ *
+ * @return List of registrations or NULL, with errno set
+ */
+sys_slist_t *zvfs_get_fd_epoll_list(int fd);
+
+/**
+ * @brief Remove a file descriptor from all epoll instances.
+ *
+ * Called when the file descriptor is closed.
+ *
+ * @param fd File descriptor being closed
+ */
+void zvfs_epoll_close_fd(int fd);
+
+/**
+ * @brief Arm the edge triggered epoll registrations of a file descriptor.
+ *
+ * Called when an operation on the file descriptor failed with EAGAIN, so
+ * that the next time it becomes ready is reported.
+ *
+ * @param fd File descriptor
+ */
+void zvfs_epoll_rearm_fd(int fd);
+
 /**
  * @brief Call ioctl vmethod on an object using varargs.
  *
@@ -280,6 +311,8 @@ enum {
 	ZFD_IOCTL_STAT,
 	ZFD_IOCTL_TRUNCATE,
 	ZFD_IOCTL_MMAP,
+	ZFD_IOCTL_PREAD,
+	ZFD_IOCTL_PWRITE,
 
 	/* Codes above 0x5400 and below 0x5500 are reserved for termios, FIO, etc */
 	ZFD_IOCTL_FIONREAD = 0x541B,
@@ -18,6 +18,7 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
 
 /* A common structure used to report runtime memory usage statistics */
 
@@ -25,6 +26,12 @@ struct sys_memory_stats {
 	size_t  free_bytes;
 	size_t  allocated_bytes;
 	size_t  max_allocated_bytes;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Only filled in for heaps, see CONFIG_SYS_HEAP_CACHE */
+	size_t  cached_bytes;
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+#endif
 };
 
 #ifdef __cplusplus
@@ -218,6 +218,82 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
  */
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem);
 
+/** @brief Get the free space of a sys_heap
+ *
+ * Returns the total number of free bytes in the heap, and the size of
+ * the largest block that can currently be allocated from it.  Their
+ * ratio gives the fragmentation of the heap.  This walks the free
+ * lists, so unlike other sys_heap functions its runtime is linear in
+ * the number of free chunks.  It is intended for statistics.
+ *
+ * @param heap Heap to inspect
+ * @param free_bytes Total number of free bytes
+ * @param largest_free_bytes Size in bytes of the largest free block
+ */
+void sys_heap_free_space_get(struct sys_heap *heap, size_t *free_bytes,
+			     size_t *largest_free_bytes);
+
+/** @brief Allocate memory from the per-CPU cache of a sys_heap
+ *
+ * Takes a block of the size class fitting @a bytes from the cache of
+ * recently freed small blocks kept for the current CPU, without
+ * touching the heap itself.  Requests too big or too aligned for any
+ * size class are never served from the cache.
+ *
+ * Unlike other sys_heap functions, the cache needs no external
+ * locking: it has a spinlock of its own, which only another CPU
+ * draining it contends.  It must be called from supervisor mode.
+ *
+ * @param heap Heap from which to allocate
+ * @param align Alignment in bytes, 0 if none, may include a rewind bit
+ *              as for sys_heap_aligned_alloc()
+ * @param bytes Number of bytes requested
+ * @return Pointer to cached memory, or NULL if the cache has none
+ */
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Allocate memory from a sys_heap after a cache miss
+ *
+ * Behaves like sys_heap_aligned_alloc(), except that requests fitting
+ * a cached size class are rounded up to it when possible, so that the
+ * block can be kept in the cache once freed.  Before failing, the
+ * blocks cached by all CPUs are returned to the heap.  The caller must
+ * hold the lock protecting the heap.
+ *
+ * @param heap Heap from which to allocate
+ * @param align Alignment in bytes, 0 if none, may include a rewind bit
+ *              as for sys_heap_aligned_alloc()
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_cache_miss_alloc(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Free memory into the per-CPU cache of a sys_heap
+ *
+ * Keeps a block exactly matching one of the cached size classes in the
+ * cache of the current CPU, unless that size class is already full.
+ * The block remains allocated from the heap point of view.  Like
+ * sys_heap_cache_alloc(), this needs no external locking.
+ *
+ * @param heap Heap the block was allocated from
+ * @param mem Pointer to memory allocated from this heap
+ * @return true if the block was cached, false if it must be freed
+ *         with sys_heap_free()
+ */
+bool sys_heap_cache_free(struct sys_heap *heap, void *mem);
+
+/** @brief Return the blocks cached by all CPUs to a sys_heap
+ *
+ * Frees all blocks held by the per-CPU caches back into the heap,
+ * typically after an allocation failed, so that no free memory stays
+ * stranded in the cache of another CPU.  The caller must hold the lock
+ * protecting the heap.
+ *
+ * @param heap Heap to flush the cache of
+ * @return true if any block was returned to the heap
+ */
+bool sys_heap_cache_flush(struct sys_heap *heap);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
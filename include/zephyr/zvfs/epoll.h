@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN  ZVFS_POLLIN
+#define ZVFS_EPOLLPRI ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT ZVFS_POLLOUT
+#define ZVFS_EPOLLERR ZVFS_POLLERR
+#define ZVFS_EPOLLHUP ZVFS_POLLHUP
+
+/** Report the descriptor once, then disable it until it is modified */
+#define ZVFS_EPOLLONESHOT BIT(30)
+/** Report the descriptor only when it becomes ready */
+#define ZVFS_EPOLLET BIT(31)
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	union zvfs_epoll_data data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a set of file descriptors registered with
+ * @ref zvfs_epoll_ctl and reports the ones that are ready through
+ * @ref zvfs_epoll_wait. Unlike poll(), the registrations persist between
+ * calls and only the descriptors that became ready are looked at, so the
+ * cost of a wait does not depend on the number of idle descriptors.
+ *
+ * Sockets and eventfds can be registered. Offloaded sockets and other epoll
+ * instances are not supported.
+ *
+ * @param flags Must be 0
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll instance
+ *
+ * Descriptors are level triggered by default, they are reported by every
+ * @ref zvfs_epoll_wait call while they are ready. With @ref ZVFS_EPOLLET a
+ * descriptor is reported once when it becomes ready, and then again only
+ * after an operation on it failed with EAGAIN. With @ref ZVFS_EPOLLONESHOT
+ * it is reported once and then disabled until modified.
+ *
+ * A descriptor is removed from all epoll instances when it is closed.
+ *
+ * @param epfd Epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd File descriptor to add, modify or remove
+ * @param ev Events to wait for and data to report, ignored for
+ *        ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *ev);
+
+/**
+ * @brief Wait for file descriptors of an epoll instance to be ready
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array to store the ready descriptors
+ * @param maxevents Number of entries in @p events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready descriptors, 0 on timeout or -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
@@ -41,6 +41,15 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 			 "Only one CPU allowed in mask when PIN_ONLY");
 #endif /* defined(CONFIG_ASSERT) && defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	int cpu = z_thread_timeout_cpu(thread);
+
+	/* A pending thread now pinned elsewhere gets its timeout moved along */
+	if ((ret == 0) && (cpu >= 0)) {
+		z_migrate_timeout(&thread->base.timeout, cpu);
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 	return ret;
 }
 
@@ -18,8 +18,10 @@
 #define _priq_run_yield         z_priq_simple_yield
 # if defined(CONFIG_SCHED_CPU_MASK)
 #  define _priq_run_best	z_priq_simple_mask_best
+#  define _priq_run_next	z_priq_simple_mask_next
 # else
 #  define _priq_run_best	z_priq_simple_best
+#  define _priq_run_next	z_priq_simple_next
 # endif /* CONFIG_SCHED_CPU_MASK */
 /* Scalable Scheduling */
 #elif defined(CONFIG_SCHED_SCALABLE)
@@ -28,6 +30,7 @@
 #define _priq_run_remove	z_priq_rb_remove
 #define _priq_run_yield         z_priq_rb_yield
 #define _priq_run_best		z_priq_rb_best
+#define _priq_run_next		z_priq_rb_next
  /* Multi Queue Scheduling */
 #elif defined(CONFIG_SCHED_MULTIQ)
 #define _priq_run_init		z_priq_mq_init
@@ -35,6 +38,7 @@
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_yield         z_priq_mq_yield
 #define _priq_run_best		z_priq_mq_best
+#define _priq_run_next		z_priq_mq_next
 #endif
 
 /* Scalable Wait Queue */
@@ -166,6 +170,17 @@ static ALWAYS_INLINE struct k_thread *z_priq_simple_best(sys_dlist_t *pq)
 	return thread;
 }
 
+/* Best thread queued behind @p thread, which must be in @p pq */
+static ALWAYS_INLINE struct k_thread *z_priq_simple_next(sys_dlist_t *pq, struct k_thread *thread)
+{
+	sys_dnode_t *n = sys_dlist_peek_next(pq, &thread->base.qnode_dlist);
+
+	if (n != NULL) {
+		return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+	}
+	return NULL;
+}
+
 #ifdef CONFIG_SCHED_CPU_MASK
 static ALWAYS_INLINE struct k_thread *z_priq_simple_mask_best(sys_dlist_t *pq)
 {
@@ -181,6 +196,22 @@ static ALWAYS_INLINE struct k_thread *z_priq_simple_mask_best(sys_dlist_t *pq)
 	}
 	return NULL;
 }
+
+static ALWAYS_INLINE struct k_thread *z_priq_simple_mask_next(sys_dlist_t *pq,
+							      struct k_thread *thread)
+{
+	sys_dnode_t *n = sys_dlist_peek_next(pq, &thread->base.qnode_dlist);
+
+	while (n != NULL) {
+		struct k_thread *t = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+
+		if ((t->base.cpu_mask & BIT(_current_cpu->id)) != 0) {
+			return t;
+		}
+		n = sys_dlist_peek_next(pq, n);
+	}
+	return NULL;
+}
 #endif /* CONFIG_SCHED_CPU_MASK */
 
 #if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
@@ -245,6 +276,23 @@ static ALWAYS_INLINE struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	}
 	return thread;
 }
+
+/* The tree has no successor lookup, so this walks it in order.  It
+ * is only used off the fast path.
+ */
+static ALWAYS_INLINE struct k_thread *z_priq_rb_next(struct _priq_rb *pq, struct k_thread *thread)
+{
+	struct k_thread *t;
+	bool found = false;
+
+	RB_FOR_EACH_CONTAINER(&pq->tree, t, base.qnode_rb) {
+		if (found) {
+			return t;
+		}
+		found = (t == thread);
+	}
+	return NULL;
+}
 #endif
 
 struct prio_info {
@@ -346,4 +394,20 @@ static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return NULL;
 }
 
+static ALWAYS_INLINE struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread)
+{
+	struct prio_info pos = get_prio_info(thread->base.prio);
+	sys_dnode_t *n = sys_dlist_peek_next(&pq->queues[pos.offset_prio],
+					     &thread->base.qnode_dlist);
+
+	for (unsigned int i = pos.offset_prio + 1U; (n == NULL) && (i < K_NUM_THREAD_PRIO); i++) {
+		n = sys_dlist_peek_head(&pq->queues[i]);
+	}
+
+	if (n != NULL) {
+		return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+	}
+	return NULL;
+}
+
 #endif /* ZEPHYR_KERNEL_INCLUDE_PRIORITY_Q_H_ */
@@ -13,6 +13,7 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
 
 #include <stdbool.h>
 
@@ -25,6 +26,9 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->queue = 0U;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -32,6 +36,31 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 
 int z_abort_timeout(struct _timeout *to);
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Arm a timeout on the queue of a given CPU, or the current one if @cpu is -1 */
+void z_add_timeout_on_cpu(struct _timeout *to, _timeout_func_t fn,
+			  k_timeout_t timeout, int cpu);
+
+/* Move an armed timeout to the queue of another CPU, keeping its expiry */
+void z_migrate_timeout(struct _timeout *to, int cpu);
+
+/* CPU a thread is pinned to, or -1 if it may run on several */
+static inline int z_thread_timeout_cpu(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t mask = thread->base.cpu_mask & BIT_MASK(CONFIG_MP_MAX_NUM_CPUS);
+
+	if ((mask != 0U) && ((mask & (mask - 1U)) == 0U)) {
+		return u32_count_trailing_zeros(mask);
+	}
+#else
+	ARG_UNUSED(thread);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return -1;
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
 	return !sys_dnode_is_linked(&to->node);
@@ -46,7 +75,13 @@ extern void z_thread_timeout(struct _timeout *timeout);
 
 static inline void z_add_thread_timeout(struct k_thread *thread, k_timeout_t ticks)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Keep the timeout on the CPU the thread will be woken up on */
+	z_add_timeout_on_cpu(&thread->base.timeout, z_thread_timeout, ticks,
+			     z_thread_timeout_cpu(thread));
+#else
 	z_add_timeout(&thread->base.timeout, z_thread_timeout, ticks);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 }
 
 static inline void z_abort_thread_timeout(struct k_thread *thread)
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+#define ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+
+/**
+ * @file
+ * @brief Hierarchical timer wheel backend for the kernel timeout queue
+ *
+ * Timeouts are hashed into one of CONFIG_TIMEOUT_WHEEL_LEVELS levels of
+ * 32 slots each, according to the most significant 5-bit digit in which
+ * their absolute expiry tick differs from the current wheel time.  Level 0
+ * slots therefore hold timeouts expiring on one exact tick, while a slot at
+ * level N spans 32^N ticks and gets cascaded into the lower levels when the
+ * wheel time reaches its start.  Timeouts beyond the range of the top level
+ * are kept on an unsorted overflow list.
+ *
+ * Insertion and removal are O(1).  The earliest expiry is cached; when the
+ * cache is invalidated, finding it again only scans the first occupied slot.
+ *
+ * With this backend, the @c dticks field of struct _timeout holds the
+ * absolute expiry tick rather than a delta to the previous timeout.
+ *
+ * None of these functions take locks, the caller is responsible for
+ * serializing access to the wheel.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define Z_TIMEOUT_WHEEL_SLOT_BITS 5
+#define Z_TIMEOUT_WHEEL_SLOTS     BIT(Z_TIMEOUT_WHEEL_SLOT_BITS)
+
+struct z_timeout_wheel {
+	/* Tick all slot positions are relative to */
+	uint64_t now;
+
+	/* Cached earliest timeout, only meaningful if next_valid is set */
+	struct _timeout *next;
+	bool next_valid;
+
+	/* One bit per non-empty slot; also tells which slot lists are
+	 * initialized, so the wheel can live in zeroed memory.
+	 */
+	uint32_t pending[CONFIG_TIMEOUT_WHEEL_LEVELS];
+	sys_dlist_t slots[CONFIG_TIMEOUT_WHEEL_LEVELS][Z_TIMEOUT_WHEEL_SLOTS];
+
+	/* Timeouts beyond the range of the top level */
+	sys_dlist_t overflow;
+};
+
+#define Z_TIMEOUT_WHEEL_INITIALIZER(obj) \
+	{ \
+		.next_valid = true, \
+		.overflow = SYS_DLIST_STATIC_INIT(&(obj).overflow), \
+	}
+
+/**
+ * @brief Initialize a timeout wheel at a given tick
+ *
+ * @param wheel Timeout wheel
+ * @param now Current tick
+ */
+void z_timeout_wheel_init(struct z_timeout_wheel *wheel, uint64_t now);
+
+/**
+ * @brief Insert a timeout into the wheel
+ *
+ * The absolute expiry tick must already be stored in @a to->dticks and must
+ * not be earlier than the wheel time.
+ *
+ * @param wheel Timeout wheel
+ * @param to Timeout to insert
+ */
+void z_timeout_wheel_insert(struct z_timeout_wheel *wheel, struct _timeout *to);
+
+/**
+ * @brief Remove a timeout from the wheel
+ *
+ * @param wheel Timeout wheel
+ * @param to Armed timeout to remove
+ */
+void z_timeout_wheel_remove(struct z_timeout_wheel *wheel, struct _timeout *to);
+
+/**
+ * @brief Get the timeout expiring first
+ *
+ * @param wheel Timeout wheel
+ *
+ * @return Timeout with the earliest expiry tick, or NULL if the wheel is empty
+ */
+struct _timeout *z_timeout_wheel_first(struct z_timeout_wheel *wheel);
+
+/**
+ * @brief Get the next timeout expiring no later than a given tick
+ *
+ * Moves the wheel time forward as far as the expiry of the returned timeout,
+ * cascading higher level slots on the way.  Timeouts expiring on the same
+ * tick are returned in the order they were inserted.
+ *
+ * @param wheel Timeout wheel
+ * @param limit Last tick to consider
+ *
+ * @return Timeout due at or before @a limit, or NULL if there is none
+ */
+struct _timeout *z_timeout_wheel_first_due(struct z_timeout_wheel *wheel, uint64_t limit);
+
+/**
+ * @brief Move the wheel time forward
+ *
+ * No timeout may be due before @a tick.  Timeouts due exactly at @a tick
+ * are left armed, to be retrieved with z_timeout_wheel_first_due().
+ *
+ * @param wheel Timeout wheel
+ * @param tick New wheel time
+ */
+void z_timeout_wheel_advance(struct z_timeout_wheel *wheel, uint64_t tick);
+
+/**
+ * @brief Move the wheel time, preserving the remaining time of armed timeouts
+ *
+ * Intended for test code rewinding or forwarding the tick counter. This is
+ * O(n) in the number of armed timeouts.
+ *
+ * @param wheel Timeout wheel
+ * @param tick New wheel time
+ */
+void z_timeout_wheel_rebase(struct z_timeout_wheel *wheel, uint64_t tick);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_ */
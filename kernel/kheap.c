@@ -72,6 +72,13 @@ static void *z_heap_alloc_helper(struct k_heap *heap, size_t align, size_t bytes
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	ret = sys_heap_cache_alloc(&heap->heap, align, bytes);
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -79,7 +86,11 @@ static void *z_heap_alloc_helper(struct k_heap *heap, size_t align, size_t bytes
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
+#ifdef CONFIG_SYS_HEAP_CACHE
+		ret = sys_heap_cache_miss_alloc(&heap->heap, align, bytes);
+#else
 		ret = sys_heap_allocator(&heap->heap, align, bytes);
+#endif
 
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -190,6 +201,15 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Don't hold on to memory somebody is waiting for */
+	if ((z_waitq_head(&heap->wait_q) == NULL) &&
+	    sys_heap_cache_free(&heap->heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
@@ -38,9 +38,20 @@ static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
 	 * No point calling k_heap_malloc/k_heap_aligned_alloc with K_NO_WAIT.
 	 * Better bypass them and go directly to sys_heap_*() instead.
 	 */
-	key = k_spin_lock(&heap->lock);
-	mem = sys_heap_allocator(&heap->heap, __align, size);
-	k_spin_unlock(&heap->lock, key);
+	mem = NULL;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	mem = sys_heap_cache_alloc(&heap->heap, __align, size);
+#endif
+
+	if (mem == NULL) {
+		key = k_spin_lock(&heap->lock);
+#ifdef CONFIG_SYS_HEAP_CACHE
+		mem = sys_heap_cache_miss_alloc(&heap->heap, __align, size);
+#else
+		mem = sys_heap_allocator(&heap->heap, __align, size);
+#endif
+		k_spin_unlock(&heap->lock, key);
+	}
 
 	if (mem == NULL) {
 		return NULL;
@@ -55,10 +66,94 @@ static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
 	return mem;
 }
 
+#if defined(CONFIG_HEAP_MEM_POOL_SLABS) && (K_HEAP_MEM_POOL_SIZE > 0)
+#define MALLOC_SLABS
+
+#define SLAB_CLASSES       CONFIG_HEAP_MEM_POOL_SLAB_CLASSES
+#define SLAB_BLOCK_SIZE(n) (CONFIG_HEAP_MEM_POOL_SLAB_MIN_SIZE << (n))
+#define SLAB_MAX_SIZE      SLAB_BLOCK_SIZE(SLAB_CLASSES - 1)
+#define SLAB_NUM_BLOCKS(n) \
+	(ROUND_UP(CONFIG_HEAP_MEM_POOL_SLAB_SIZE, SLAB_MAX_SIZE) / SLAB_BLOCK_SIZE(n))
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HEAP_MEM_POOL_SLAB_MIN_SIZE),
+	     "slab block sizes must be powers of two");
+
+/* Blocks are aligned on their size, so the slab of a size class can also
+ * serve aligned requests up to that size.
+ */
+#define SLAB_DEFINE(n, _) \
+	K_MEM_SLAB_DEFINE_STATIC(malloc_slab_##n, SLAB_BLOCK_SIZE(n), \
+				 SLAB_NUM_BLOCKS(n), SLAB_BLOCK_SIZE(n));
+
+LISTIFY(SLAB_CLASSES, SLAB_DEFINE, ())
+
+#define SLAB_REF(n, _) &malloc_slab_##n
+
+static struct k_mem_slab *const malloc_slabs[SLAB_CLASSES] = {
+	LISTIFY(SLAB_CLASSES, SLAB_REF, (,))
+};
+
+static atomic_t slab_hits;
+static atomic_t slab_misses;
+static atomic_t large_allocs;
+
+static void *slab_alloc(size_t align, size_t size)
+{
+	size_t bytes = MAX(size, align);
+	void *mem;
+	int n;
+
+	for (n = 0; n < SLAB_CLASSES; n++) {
+		if (bytes <= SLAB_BLOCK_SIZE(n)) {
+			break;
+		}
+	}
+
+	if (n == SLAB_CLASSES) {
+		atomic_inc(&large_allocs);
+		return NULL;
+	}
+
+	if (k_mem_slab_alloc(malloc_slabs[n], &mem, K_NO_WAIT) != 0) {
+		atomic_inc(&slab_misses);
+		return NULL;
+	}
+
+	atomic_inc(&slab_hits);
+
+	return mem;
+}
+
+static struct k_mem_slab *slab_of(void *ptr)
+{
+	for (int n = 0; n < SLAB_CLASSES; n++) {
+		struct k_mem_slab *slab = malloc_slabs[n];
+
+		size_t size = slab->info.num_blocks * slab->info.block_size;
+
+		if (((char *)ptr >= slab->buffer) && ((char *)ptr < slab->buffer + size)) {
+			return slab;
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* CONFIG_HEAP_MEM_POOL_SLABS && K_HEAP_MEM_POOL_SIZE > 0 */
+
 void k_free(void *ptr)
 {
 	struct k_heap **heap_ref;
 
+#ifdef MALLOC_SLABS
+	struct k_mem_slab *slab = slab_of(ptr);
+
+	if (slab != NULL) {
+		k_mem_slab_free(slab, ptr);
+		return;
+	}
+#endif
+
 	if (ptr != NULL) {
 		heap_ref = ptr;
 		--heap_ref;
@@ -77,11 +172,25 @@ void k_free(void *ptr)
 K_HEAP_DEFINE(_system_heap, K_HEAP_MEM_POOL_SIZE);
 #define _SYSTEM_HEAP (&_system_heap)
 
+static void *z_system_alloc_helper(size_t align, size_t size,
+				   sys_heap_allocator_t sys_heap_allocator)
+{
+#ifdef MALLOC_SLABS
+	void *ret = slab_alloc(align, size);
+
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
+	return z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_allocator);
+}
+
 void *k_aligned_alloc(size_t align, size_t size)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP);
 
-	void *ret = z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_aligned_alloc);
+	void *ret = z_system_alloc_helper(align, size, sys_heap_aligned_alloc);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP, ret);
 
@@ -92,7 +201,7 @@ void *k_malloc(size_t size)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_malloc, _SYSTEM_HEAP);
 
-	void *ret = z_alloc_helper(_SYSTEM_HEAP, 0, size, sys_heap_noalign_alloc);
+	void *ret = z_system_alloc_helper(0, size, sys_heap_noalign_alloc);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_malloc, _SYSTEM_HEAP, ret);
 
@@ -135,6 +244,26 @@ void *k_realloc(void *ptr, size_t size)
 	if (ptr == NULL) {
 		return k_malloc(size);
 	}
+
+#ifdef MALLOC_SLABS
+	struct k_mem_slab *slab = slab_of(ptr);
+
+	if (slab != NULL) {
+		/* Keep the block if big enough, slab blocks can't be resized */
+		if (size <= slab->info.block_size) {
+			return ptr;
+		}
+
+		ret = k_malloc(size);
+		if (ret != NULL) {
+			memcpy(ret, ptr, slab->info.block_size);
+			k_mem_slab_free(slab, ptr);
+		}
+
+		return ret;
+	}
+#endif
+
 	heap_ref = ptr;
 	ptr = --heap_ref;
 	heap = *heap_ref;
@@ -168,6 +297,38 @@ void k_thread_system_pool_assign(struct k_thread *thread)
 {
 	thread->resource_pool = _SYSTEM_HEAP;
 }
+
+int k_malloc_stats_get(struct k_malloc_stats *stats)
+{
+	struct k_heap *heap = _SYSTEM_HEAP;
+	k_spinlock_key_t key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+
+#ifdef MALLOC_SLABS
+	for (int n = 0; n < SLAB_CLASSES; n++) {
+		struct k_mem_slab *slab = malloc_slabs[n];
+
+		stats->slab_bytes += slab->info.num_blocks * slab->info.block_size;
+		stats->slab_used_bytes += k_mem_slab_num_used_get(slab) * slab->info.block_size;
+	}
+
+	stats->slab_hits = atomic_get(&slab_hits);
+	stats->slab_misses = atomic_get(&slab_misses);
+	stats->large_allocs = atomic_get(&large_allocs);
+#endif
+
+	key = k_spin_lock(&heap->lock);
+	sys_heap_free_space_get(&heap->heap, &stats->heap_free_bytes,
+				&stats->heap_largest_free_bytes);
+	k_spin_unlock(&heap->lock, key);
+
+	return 0;
+}
 #else
 #define _SYSTEM_HEAP	NULL
 #endif /* K_HEAP_MEM_POOL_SIZE */
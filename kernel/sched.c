@@ -58,6 +58,23 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	 */
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
+	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_RUNQ_WORK_STEALING)
+	/* Queue the thread where it last ran, where its working set
+	 * is most likely to still be cached.  Neither the CPU it last
+	 * ran on nor its CPU mask can change while it is queued, so
+	 * this is also where runq_remove() will find it.
+	 */
+	int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	int m = thread->base.cpu_mask & BIT_MASK(CONFIG_MP_MAX_NUM_CPUS);
+
+	if (((m & BIT(cpu)) == 0) && (m != 0)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 	return &_kernel.cpus[cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
@@ -67,11 +84,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
@@ -93,9 +110,53 @@ static ALWAYS_INLINE void runq_yield(void)
 	_priq_run_yield(curr_cpu_runq());
 }
 
+#ifdef CONFIG_SCHED_RUNQ_WORK_STEALING
+/* Look for a thread of strictly higher priority than @p thread (the
+ * best one from the local queue, possibly NULL) in the other CPUs'
+ * queues.  Ties keep the local thread.  With SCHED_CPU_MASK, the
+ * simple backend only returns threads allowed on this CPU.
+ */
+static ALWAYS_INLINE struct k_thread *runq_steal(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int id = _current_cpu->id;
+
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		unsigned int cpu = (id + i) % num_cpus;
+		void *pq = &_kernel.cpus[cpu].ready_q.runq;
+		struct k_thread *t = _priq_run_best(pq);
+
+#if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) &&                                                         \
+	(CONFIG_NUM_COOP_PRIORITIES > CONFIG_NUM_METAIRQ_PRIORITIES)
+		/* That CPU promised to resume this thread after its
+		 * meta-IRQ thread is done, the threads behind it may
+		 * still be taken.
+		 */
+		if ((t != NULL) && (t == _kernel.cpus[cpu].metairq_preempted)) {
+			t = _priq_run_next(pq, t);
+		}
+#endif
+
+		if (t == NULL) {
+			continue;
+		}
+
+		if ((thread == NULL) || (z_sched_prio_cmp(t, thread) > 0)) {
+			thread = t;
+		}
+	}
+
+	return thread;
+}
+#endif /* CONFIG_SCHED_RUNQ_WORK_STEALING */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_RUNQ_WORK_STEALING
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_RUNQ_WORK_STEALING */
 }
 
 /* _current is never in the run queue until context switch on
@@ -947,13 +1008,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
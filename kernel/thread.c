@@ -754,6 +754,9 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+
+	/* Also tells which run queue a thread that never ran goes to */
+	thread_base->cpu = 0U;
 #endif /* CONFIG_SMP */
 
 #ifdef CONFIG_TIMESLICE_PER_THREAD
@@ -12,22 +12,58 @@
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
 
-static uint64_t curr_tick;
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#include <timeout_wheel.h>
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+struct timeout_queue {
+	/*
+	 * The timeout code shall take no locks other than its own (the
+	 * queue locks), nor shall it call any other subsystem while
+	 * holding them.
+	 */
+	struct k_spinlock lock;
+
+	uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+	/* Ticks left to process in the currently-executing sys_clock_announce() */
+	int announce_remaining;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	struct z_timeout_wheel wheel;
+#else
+	sys_dlist_t list;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+};
 
 /*
- * The timeout code shall take no locks other than its own (timeout_lock), nor
- * shall it call any other subsystem while holding this lock.
+ * With CONFIG_TIMEOUT_QUEUE_PER_CPU, each CPU arms timeouts on a queue of
+ * its own.  sys_clock_announce() hands the announced ticks to every queue
+ * before running any callback, then expires the queues one after the
+ * other, each under its own lock only.  Timeouts expire in order within a
+ * queue, not across queues.
  */
-static struct k_spinlock timeout_lock;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+#define NUM_QUEUES CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_QUEUES 1
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#define TIMEOUT_QUEUE_INIT(i, _) \
+	{ .wheel = Z_TIMEOUT_WHEEL_INITIALIZER(timeout_queues[i].wheel) }
+#else
+#define TIMEOUT_QUEUE_INIT(i, _) \
+	{ .list = SYS_DLIST_STATIC_INIT(&timeout_queues[i].list) }
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static struct timeout_queue timeout_queues[NUM_QUEUES] = {
+	LISTIFY(NUM_QUEUES, TIMEOUT_QUEUE_INIT, (,))
+};
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
-/* Ticks left to process in the currently-executing sys_clock_announce() */
-static int announce_remaining;
-
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 unsigned int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 
@@ -40,30 +76,201 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+/*
+ * Timeout queue backends. Both keep the timeouts ordered relative to the
+ * curr_tick of their queue and provide the same set of (unlocked) helpers:
+ *
+ * - first(): earliest timeout, or NULL
+ * - insert_timeout(): arm a timeout expiring @ticks after curr_tick
+ * - remove_timeout(): disarm a timeout
+ * - timeout_rem(): ticks from curr_tick until a timeout expires
+ * - first_due(): next timeout expiring within @ticks of curr_tick, to be
+ *   passed to expire_timeout() once curr_tick has been moved to its expiry
+ * - advance_timeouts(): account for curr_tick moving forward by @ticks
+ *   without any timeout expiring before it
+ */
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+static struct _timeout *first(struct timeout_queue *q)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	return z_timeout_wheel_first(&q->wheel);
+}
+
+static void insert_timeout(struct timeout_queue *q, struct _timeout *to,
+			   k_ticks_t ticks)
+{
+	to->dticks = q->curr_tick + ticks;
+	z_timeout_wheel_insert(&q->wheel, to);
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	z_timeout_wheel_remove(&q->wheel, t);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_queue *q,
+			     const struct _timeout *timeout)
+{
+	return timeout->dticks - q->curr_tick;
+}
+
+static struct _timeout *first_due(struct timeout_queue *q, int32_t ticks)
+{
+	return z_timeout_wheel_first_due(&q->wheel, q->curr_tick + ticks);
+}
+
+static void expire_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	remove_timeout(q, t);
+}
+
+static void advance_timeouts(struct timeout_queue *q, int32_t ticks)
+{
+	z_timeout_wheel_advance(&q->wheel, q->curr_tick + ticks);
+}
+
+#else
+
+static struct _timeout *first(struct timeout_queue *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_queue *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static void insert_timeout(struct timeout_queue *q, struct _timeout *to,
+			   k_ticks_t ticks)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_queue *q,
+			     const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static struct _timeout *first_due(struct timeout_queue *q, int32_t ticks)
+{
+	struct _timeout *t = first(q);
+
+	return ((t != NULL) && (t->dticks <= ticks)) ? t : NULL;
+}
+
+static void expire_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	/* curr_tick has already moved to the expiry of t, so the next
+	 * timeout must not inherit its delta.
+	 */
+	t->dticks = 0;
+	remove_timeout(q, t);
+}
+
+static void advance_timeouts(struct timeout_queue *q, int32_t ticks)
+{
+	struct _timeout *t = first(q);
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static inline struct timeout_queue *local_queue(void)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Being migrated right after this only costs some locality */
+	return &timeout_queues[arch_curr_cpu()->id];
+#else
+	return &timeout_queues[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+/* Lock the queue an armed timeout is on */
+static struct timeout_queue *lock_timeout_queue(const struct _timeout *to,
+						k_spinlock_key_t *key)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	for (;;) {
+		struct timeout_queue *q = &timeout_queues[to->queue];
+
+		*key = k_spin_lock(&q->lock);
+		if (q == &timeout_queues[to->queue]) {
+			return q;
+		}
+
+		/* Migrated while we were spinning */
+		k_spin_unlock(&q->lock, *key);
+	}
+#else
+	ARG_UNUSED(to);
+
+	*key = k_spin_lock(&timeout_queues[0].lock);
+
+	return &timeout_queues[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU) || defined(CONFIG_ZTEST)
+static void lock_all_queues(k_spinlock_key_t key[NUM_QUEUES])
+{
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		key[i] = k_spin_lock(&timeout_queues[i].lock);
+	}
+}
+
+static void unlock_all_queues(k_spinlock_key_t key[NUM_QUEUES])
+{
+	for (int i = NUM_QUEUES - 1; i >= 0; i--) {
+		k_spin_unlock(&timeout_queues[i].lock, key[i]);
+	}
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU || CONFIG_ZTEST */
+
+static int32_t elapsed(struct timeout_queue *q)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
 	 * scheduled relatively to the currently firing timeout's original tick
@@ -81,28 +288,123 @@ static int32_t elapsed(void)
 	 * will be non-zero while sys_clock_announce() is executing and zero
 	 * otherwise.
 	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+	return q->announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
-static int32_t next_timeout(void)
+static int32_t next_timeout(struct timeout_queue *q)
 {
-	struct _timeout *to = first();
-	int32_t ticks_elapsed = elapsed();
+	struct _timeout *to = first(q);
+	int32_t ticks_elapsed = elapsed(q);
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_rem(q, to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_rem(q, to) - ticks_elapsed);
 	}
 
 	return ret;
 }
 
-void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
-		   k_timeout_t timeout)
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/*
+ * Absolute tick the system timer is programmed to announce, truncated to
+ * an atomic_val_t.  CPUs only ever move it earlier, from the queue whose
+ * first timeout changed, until the ticks up to it have been announced:
+ * it is then stale and the next queue to program the timer replaces it.
+ * Timeouts aborted or moved later only cost a spurious announcement.
+ */
+static atomic_t programmed_expiry;
+
+/* Ticks from @from to @to on the wrapping timeline of programmed_expiry */
+static inline atomic_val_t expiry_delta(atomic_val_t from, atomic_val_t to)
+{
+	return (atomic_val_t)((unsigned long)to - (unsigned long)from);
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+/* Next expiry of a queue, sampled under its lock for program_timeout() */
+struct timeout_expiry {
+	int32_t ticks;
+	uint64_t tick;
+	uint64_t announced;
+};
+
+/*
+ * Must be called with the queue locked whenever its first timeout changed
+ * outside of sys_clock_announce().  With per-CPU queues, the system timer
+ * is shared by all queues: the caller then has to call program_timeout()
+ * with @next once the queue is unlocked, as indicated by the return value.
+ */
+static bool update_next_timeout(struct timeout_queue *q,
+				struct timeout_expiry *next)
+{
+	next->ticks = next_timeout(q);
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	next->announced = q->curr_tick + q->announce_remaining;
+	next->tick = q->curr_tick + elapsed(q) +
+		     ((next->ticks == (int32_t)K_TICKS_FOREVER) ? INT_MAX : next->ticks);
+
+	return true;
+#else
+	sys_clock_set_timeout(next->ticks, false);
+
+	return false;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/*
+ * Program the system timer for the next expiry of a queue, unless it is
+ * already programmed to announce an earlier tick not announced yet.
+ * Whoever programs the timer then checks that programmed_expiry has not
+ * moved meanwhile, and programs it again otherwise, so the last value
+ * stored is also the last one programmed.
+ */
+static void program_timeout(const struct timeout_expiry *next)
+{
+	atomic_val_t expiry = (atomic_val_t)next->tick;
+	atomic_val_t prev;
+	int32_t ticks = next->ticks;
+
+	do {
+		prev = atomic_get(&programmed_expiry);
+		if ((expiry_delta(prev, expiry) >= 0) &&
+		    (expiry_delta((atomic_val_t)next->announced, prev) > 0)) {
+			return;
+		}
+	} while (!atomic_cas(&programmed_expiry, prev, expiry));
+
+	for (;;) {
+		atomic_val_t delta;
+
+		sys_clock_set_timeout(ticks, false);
+
+		prev = expiry;
+		expiry = atomic_get(&programmed_expiry);
+		if (expiry == prev) {
+			break;
+		}
+
+		delta = expiry_delta((atomic_val_t)sys_clock_tick_get(), expiry);
+		ticks = (delta >= INT_MAX) ? MAX_WAIT : MAX(0, (int32_t)delta);
+	}
+}
+#else
+static inline void program_timeout(const struct timeout_expiry *next)
 {
+	ARG_UNUSED(next);
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+static void add_timeout(struct timeout_queue *q, struct _timeout *to,
+			_timeout_func_t fn, k_timeout_t timeout)
+{
+	struct timeout_expiry next;
+	bool program = false;
+
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return;
 	}
@@ -114,94 +416,130 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+	K_SPINLOCK(&q->lock) {
+		k_ticks_t ticks;
 
 		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			ticks = timeout.ticks + 1 + elapsed(q);
 		} else {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - q->curr_tick);
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+		to->queue = q - timeout_queues;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+		insert_timeout(q, to, ticks);
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
+		if (to == first(q) && q->announce_remaining == 0) {
+			program = update_next_timeout(q, &next);
 		}
+	}
 
-		if (to == first() && announce_remaining == 0) {
-			sys_clock_set_timeout(next_timeout(), false);
-		}
+	if (program) {
+		program_timeout(&next);
 	}
 }
 
-int z_abort_timeout(struct _timeout *to)
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
 {
-	int ret = -EINVAL;
+	add_timeout(local_queue(), to, fn, timeout);
+}
 
-	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+void z_add_timeout_on_cpu(struct _timeout *to, _timeout_func_t fn,
+			  k_timeout_t timeout, int cpu)
+{
+	__ASSERT_NO_MSG(cpu < NUM_QUEUES);
 
-			remove_timeout(to);
-			ret = 0;
-			if (is_first) {
-				sys_clock_set_timeout(next_timeout(), false);
-			}
-		}
+	add_timeout((cpu < 0) ? local_queue() : &timeout_queues[cpu],
+		    to, fn, timeout);
+}
+
+void z_migrate_timeout(struct _timeout *to, int cpu)
+{
+	k_spinlock_key_t key[NUM_QUEUES];
+	struct timeout_queue *from;
+	struct timeout_queue *dest = &timeout_queues[cpu];
+
+	__ASSERT_NO_MSG((cpu >= 0) && (cpu < NUM_QUEUES));
+
+	/* The queues may not have processed the same announced ticks yet,
+	 * so the timeout keeps its expiry tick rather than its remaining
+	 * ticks.  Moving timeouts is rare, just take all the locks rather
+	 * than ordering two.  The timer is already programmed for that
+	 * tick or an earlier one.
+	 */
+	lock_all_queues(key);
+
+	from = sys_dnode_is_linked(&to->node) ? &timeout_queues[to->queue] : dest;
+	if (from != dest) {
+		k_ticks_t ticks = MAX(1, (k_ticks_t)(from->curr_tick + timeout_rem(from, to) -
+						     dest->curr_tick));
+
+		remove_timeout(from, to);
+		to->queue = cpu;
+		insert_timeout(dest, to, ticks);
 	}
 
-	return ret;
+	unlock_all_queues(key);
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+int z_abort_timeout(struct _timeout *to)
 {
-	k_ticks_t ticks = 0;
+	int ret = -EINVAL;
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_timeout_queue(to, &key);
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
+	if (sys_dnode_is_linked(&to->node)) {
+		bool is_first = (to == first(q));
+
+		remove_timeout(q, to);
+		ret = 0;
+		/* With per-CPU queues, the timer is left to announce a tick
+		 * that may no longer be needed rather than reprogrammed
+		 */
+		if (is_first && (NUM_QUEUES == 1)) {
+			struct timeout_expiry next;
+
+			(void)update_next_timeout(q, &next);
 		}
 	}
 
-	return ticks;
+	k_spin_unlock(&q->lock, key);
+
+	return ret;
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_timeout_queue(timeout, &key);
 
-	K_SPINLOCK(&timeout_lock) {
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
-		}
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks = timeout_rem(q, timeout) - elapsed(q);
 	}
 
+	k_spin_unlock(&q->lock, key);
+
 	return ticks;
 }
 
 k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_timeout_queue(timeout, &key);
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick;
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
-		}
+	ticks = q->curr_tick;
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks += timeout_rem(q, timeout);
 	}
 
+	k_spin_unlock(&q->lock, key);
+
 	return ticks;
 }
 
@@ -209,57 +547,113 @@ int32_t z_get_next_timeout_expiry(void)
 {
 	int32_t ret = (int32_t) K_TICKS_FOREVER;
 
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout();
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		K_SPINLOCK(&timeout_queues[i].lock) {
+			int32_t next = next_timeout(&timeout_queues[i]);
+
+			if ((ret == (int32_t)K_TICKS_FOREVER) ||
+			    ((next != (int32_t)K_TICKS_FOREVER) && (next < ret))) {
+				ret = next;
+			}
+		}
 	}
 	return ret;
 }
 
-void sys_clock_announce(int32_t ticks)
+/*
+ * Hand announced ticks to a queue.  A queue with no timeout due within them
+ * is moved forward at once.  Otherwise they are left in announce_remaining,
+ * so that the queue counts as being announced until announce_queue() has
+ * expired its timeouts: timeouts armed on it meanwhile are relative to
+ * curr_tick, as from within a callback.  Returns whether announce_queue()
+ * has to be called.
+ */
+static bool start_announce(struct timeout_queue *q, int32_t ticks)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	struct timeout_expiry next;
+	bool program = false;
+	bool expire = false;
+
+	K_SPINLOCK(&q->lock) {
+		/* We release the lock around the callbacks below, so on SMP
+		 * systems someone might be already running the loop.  Don't
+		 * race (which will cause parallel execution of "sequential"
+		 * timeouts and confuse apps), just increment the tick count
+		 * and return.
+		 */
+		if (IS_ENABLED(CONFIG_SMP) && (q->announce_remaining != 0)) {
+			q->announce_remaining += ticks;
+		} else if (first_due(q, ticks) == NULL) {
+			advance_timeouts(q, ticks);
+			q->curr_tick += ticks;
+			program = update_next_timeout(q, &next);
+		} else {
+			q->announce_remaining = ticks;
+			expire = true;
+		}
+	}
 
-	/* We release the lock around the callbacks below, so on SMP
-	 * systems someone might be already running the loop.  Don't
-	 * race (which will cause parallel execution of "sequential"
-	 * timeouts and confuse apps), just increment the tick count
-	 * and return.
-	 */
-	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
-		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
-		return;
+	if (program) {
+		program_timeout(&next);
 	}
 
-	announce_remaining = ticks;
+	return expire;
+}
 
+/*
+ * Expire the timeouts of a queue due within its announced ticks.  Only that
+ * queue is locked, so the other CPUs keep arming, aborting and expiring
+ * timeouts on theirs meanwhile.
+ */
+static void announce_queue(struct timeout_queue *q)
+{
+	struct timeout_expiry next;
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
 	struct _timeout *t;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+	for (t = first_due(q, q->announce_remaining);
+	     t != NULL;
+	     t = first_due(q, q->announce_remaining)) {
+		int dt = timeout_rem(q, t);
 
-		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		q->curr_tick += dt;
+		expire_timeout(q, t);
 
-		k_spin_unlock(&timeout_lock, key);
+		k_spin_unlock(&q->lock, key);
 		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
-		announce_remaining -= dt;
+		key = k_spin_lock(&q->lock);
+		q->announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
+	advance_timeouts(q, q->announce_remaining);
+	q->curr_tick += q->announce_remaining;
+	q->announce_remaining = 0;
+
+	bool program = update_next_timeout(q, &next);
+
+	k_spin_unlock(&q->lock, key);
+
+	if (program) {
+		program_timeout(&next);
 	}
+}
 
-	curr_tick += announce_remaining;
-	announce_remaining = 0;
+void sys_clock_announce(int32_t ticks)
+{
+	bool expire[NUM_QUEUES];
 
-	sys_clock_set_timeout(next_timeout(), false);
+	/* sys_clock_elapsed() restarts from the announced tick, so no queue
+	 * may still look idle at its previous tick once callbacks run
+	 */
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		expire[i] = start_announce(&timeout_queues[i], ticks);
+	}
 
-	k_spin_unlock(&timeout_lock, key);
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		if (expire[i]) {
+			announce_queue(&timeout_queues[i]);
+		}
+	}
 
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
@@ -269,9 +663,10 @@ void sys_clock_announce(int32_t ticks)
 int64_t sys_clock_tick_get(void)
 {
 	uint64_t t = 0U;
+	struct timeout_queue *q = local_queue();
 
-	K_SPINLOCK(&timeout_lock) {
-		t = curr_tick + elapsed();
+	K_SPINLOCK(&q->lock) {
+		t = q->curr_tick + elapsed(q);
 	}
 	return t;
 }
@@ -281,7 +676,7 @@ uint32_t sys_clock_tick_get_32(void)
 #ifdef CONFIG_TICKLESS_KERNEL
 	return (uint32_t)sys_clock_tick_get();
 #else
-	return (uint32_t)curr_tick;
+	return (uint32_t)timeout_queues[0].curr_tick;
 #endif /* CONFIG_TICKLESS_KERNEL */
 }
 
@@ -338,7 +733,18 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	k_spinlock_key_t key[NUM_QUEUES];
+
+	lock_all_queues(key);
+
+	for (int i = 0; i < NUM_QUEUES; i++) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		z_timeout_wheel_rebase(&timeout_queues[i].wheel, tick);
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+		timeout_queues[i].curr_tick = tick;
+	}
+
+	unlock_all_queues(key);
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
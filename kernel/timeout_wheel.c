@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/dlist.h>
+#include <timeout_wheel.h>
+
+#define SLOT_BITS   Z_TIMEOUT_WHEEL_SLOT_BITS
+#define SLOT_MASK   (Z_TIMEOUT_WHEEL_SLOTS - 1U)
+#define LEVELS      CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_BITS  (SLOT_BITS * LEVELS)
+
+BUILD_ASSERT(WHEEL_BITS < 64, "too many timer wheel levels");
+
+static inline uint64_t expiry_of(const struct _timeout *to)
+{
+	return (uint64_t)to->dticks;
+}
+
+static inline struct _timeout *to_timeout(sys_dnode_t *node)
+{
+	return CONTAINER_OF(node, struct _timeout, node);
+}
+
+/* Level a timeout expiring at @expiry belongs to, LEVELS for the overflow
+ * list: that is the position of the most significant digit in which the
+ * expiry differs from the wheel time.
+ */
+static int timeout_level(const struct z_timeout_wheel *wheel, uint64_t expiry)
+{
+	uint64_t diff = expiry ^ wheel->now;
+	int level;
+
+	if (diff == 0ULL) {
+		return 0;
+	}
+
+	level = (63 - u64_count_leading_zeros(diff)) / SLOT_BITS;
+
+	return MIN(level, LEVELS);
+}
+
+static inline unsigned int timeout_slot(uint64_t expiry, int level)
+{
+	return (unsigned int)(expiry >> (level * SLOT_BITS)) & SLOT_MASK;
+}
+
+/* First tick covered by @slot of @level, given the current wheel time */
+static uint64_t slot_start(const struct z_timeout_wheel *wheel, int level,
+			   unsigned int slot)
+{
+	unsigned int shift = level * SLOT_BITS;
+	uint64_t high = wheel->now & ~(BIT64(shift + SLOT_BITS) - 1ULL);
+
+	return high | ((uint64_t)slot << shift);
+}
+
+static int lowest_pending_level(const struct z_timeout_wheel *wheel)
+{
+	for (int level = 0; level < LEVELS; level++) {
+		if (wheel->pending[level] != 0U) {
+			return level;
+		}
+	}
+
+	return -1;
+}
+
+static void place(struct z_timeout_wheel *wheel, struct _timeout *to)
+{
+	uint64_t expiry = expiry_of(to);
+	int level = timeout_level(wheel, expiry);
+	unsigned int slot;
+	sys_dlist_t *list;
+
+	if (level == LEVELS) {
+		sys_dlist_append(&wheel->overflow, &to->node);
+		return;
+	}
+
+	slot = timeout_slot(expiry, level);
+	list = &wheel->slots[level][slot];
+
+	if ((wheel->pending[level] & BIT(slot)) == 0U) {
+		sys_dlist_init(list);
+		wheel->pending[level] |= BIT(slot);
+	}
+
+	sys_dlist_append(list, &to->node);
+}
+
+/* Must be called with the wheel time at the start of the slot: every
+ * timeout in it then belongs to a lower level.
+ */
+static void cascade_slot(struct z_timeout_wheel *wheel, int level,
+			 unsigned int slot)
+{
+	sys_dlist_t *list = &wheel->slots[level][slot];
+	sys_dnode_t *node;
+
+	wheel->pending[level] &= ~BIT(slot);
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		place(wheel, to_timeout(node));
+	}
+}
+
+static void cascade_overflow(struct z_timeout_wheel *wheel)
+{
+	struct _timeout *to, *tmp;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&wheel->overflow, to, tmp, node) {
+		if (timeout_level(wheel, expiry_of(to)) < LEVELS) {
+			sys_dlist_remove(&to->node);
+			place(wheel, to);
+		}
+	}
+}
+
+/* Earliest timeout in a list, or the first inserted one on ties */
+static struct _timeout *list_min(sys_dlist_t *list)
+{
+	struct _timeout *best = NULL;
+	struct _timeout *to;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, to, node) {
+		if ((best == NULL) || (expiry_of(to) < expiry_of(best))) {
+			best = to;
+		}
+	}
+
+	return best;
+}
+
+static struct _timeout *find_first(struct z_timeout_wheel *wheel)
+{
+	int level = lowest_pending_level(wheel);
+	unsigned int slot;
+	sys_dlist_t *list;
+
+	if (level < 0) {
+		return list_min(&wheel->overflow);
+	}
+
+	/* Occupied slots at a level never precede the current digit of the
+	 * wheel time, so the lowest one holds the earliest timeouts.
+	 */
+	slot = u32_count_trailing_zeros(wheel->pending[level]);
+	list = &wheel->slots[level][slot];
+
+	if (level == 0) {
+		return to_timeout(sys_dlist_peek_head(list));
+	}
+
+	return list_min(list);
+}
+
+void z_timeout_wheel_init(struct z_timeout_wheel *wheel, uint64_t now)
+{
+	wheel->now = now;
+	wheel->next = NULL;
+	wheel->next_valid = true;
+
+	for (int level = 0; level < LEVELS; level++) {
+		wheel->pending[level] = 0U;
+	}
+
+	sys_dlist_init(&wheel->overflow);
+}
+
+void z_timeout_wheel_insert(struct z_timeout_wheel *wheel, struct _timeout *to)
+{
+	__ASSERT(expiry_of(to) >= wheel->now, "timeout expires in the past");
+
+	place(wheel, to);
+
+	if (wheel->next_valid &&
+	    ((wheel->next == NULL) || (expiry_of(to) < expiry_of(wheel->next)))) {
+		wheel->next = to;
+	}
+}
+
+void z_timeout_wheel_remove(struct z_timeout_wheel *wheel, struct _timeout *to)
+{
+	uint64_t expiry = expiry_of(to);
+	int level = timeout_level(wheel, expiry);
+
+	sys_dlist_remove(&to->node);
+
+	if (level < LEVELS) {
+		unsigned int slot = timeout_slot(expiry, level);
+
+		if (sys_dlist_is_empty(&wheel->slots[level][slot])) {
+			wheel->pending[level] &= ~BIT(slot);
+		}
+	}
+
+	if (wheel->next == to) {
+		wheel->next_valid = false;
+	}
+}
+
+struct _timeout *z_timeout_wheel_first(struct z_timeout_wheel *wheel)
+{
+	if (!wheel->next_valid) {
+		wheel->next = find_first(wheel);
+		wheel->next_valid = true;
+	}
+
+	return wheel->next;
+}
+
+struct _timeout *z_timeout_wheel_first_due(struct z_timeout_wheel *wheel, uint64_t limit)
+{
+	for (;;) {
+		int level = lowest_pending_level(wheel);
+		unsigned int slot;
+		uint64_t start;
+
+		if (level < 0) {
+			struct _timeout *to = list_min(&wheel->overflow);
+
+			if (to == NULL) {
+				return NULL;
+			}
+
+			start = expiry_of(to) & ~(BIT64(WHEEL_BITS) - 1ULL);
+			if (start > limit) {
+				return NULL;
+			}
+
+			wheel->now = start;
+			cascade_overflow(wheel);
+			continue;
+		}
+
+		slot = u32_count_trailing_zeros(wheel->pending[level]);
+		start = slot_start(wheel, level, slot);
+		if (start > limit) {
+			return NULL;
+		}
+
+		wheel->now = start;
+		if (level == 0) {
+			return to_timeout(sys_dlist_peek_head(&wheel->slots[0][slot]));
+		}
+
+		cascade_slot(wheel, level, slot);
+	}
+}
+
+void z_timeout_wheel_advance(struct z_timeout_wheel *wheel, uint64_t tick)
+{
+	struct _timeout *due = z_timeout_wheel_first_due(wheel, tick);
+
+	__ASSERT((due == NULL) || (expiry_of(due) == tick), "timeout %p is overdue", due);
+	ARG_UNUSED(due);
+
+	wheel->now = tick;
+}
+
+void z_timeout_wheel_rebase(struct z_timeout_wheel *wheel, uint64_t tick)
+{
+	uint64_t delta = tick - wheel->now;
+	sys_dlist_t armed;
+	sys_dnode_t *node;
+
+	sys_dlist_init(&armed);
+
+	for (int level = 0; level < LEVELS; level++) {
+		while (wheel->pending[level] != 0U) {
+			unsigned int slot = u32_count_trailing_zeros(wheel->pending[level]);
+			sys_dlist_t *list = &wheel->slots[level][slot];
+
+			wheel->pending[level] &= ~BIT(slot);
+			while ((node = sys_dlist_get(list)) != NULL) {
+				sys_dlist_append(&armed, node);
+			}
+		}
+	}
+
+	while ((node = sys_dlist_get(&wheel->overflow)) != NULL) {
+		sys_dlist_append(&armed, node);
+	}
+
+	wheel->now = tick;
+	wheel->next_valid = false;
+
+	while ((node = sys_dlist_get(&armed)) != NULL) {
+		struct _timeout *to = to_timeout(node);
+
+		to->dticks = (int64_t)(expiry_of(to) + delta);
+		place(wheel, to);
+	}
+}
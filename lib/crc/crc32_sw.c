@@ -6,6 +6,32 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc_tables.h"
+
+#if defined(CONFIG_CRC_HW_INSTRUCTIONS) && defined(__ARM_FEATURE_CRC32) && \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_acle.h>
+#include <string.h>
+
+#define CRC32_IEEE_HW 1
+
+static uint32_t crc32_ieee_hw(uint32_t crc, const uint8_t *data, size_t len)
+{
+	uint64_t word;
+
+	for (; len >= sizeof(word); len -= sizeof(word), data += sizeof(word)) {
+		memcpy(&word, data, sizeof(word));
+		crc = __crc32d(crc, word);
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = __crc32b(crc, *data);
+	}
+
+	return crc;
+}
+#endif
+
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
@@ -13,6 +39,11 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#if defined(CRC32_IEEE_HW)
+	return ~crc32_ieee_hw(~crc, data, len);
+#elif defined(CRC_SLICES)
+	return ~crc32_tables_update(crc32_ieee_slice_tables, ~crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU,
@@ -31,4 +62,5 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 	}
 
 	return (~crc);
+#endif
 }
@@ -6,6 +6,64 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc_tables.h"
+
+#if defined(CONFIG_CRC_HW_INSTRUCTIONS) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#include <string.h>
+
+#define CRC32C_HW 1
+
+static uint32_t crc32c_hw(uint32_t crc, const uint8_t *data, size_t len)
+{
+#ifdef __x86_64__
+	uint64_t crc64 = crc;
+	uint64_t word;
+
+	for (; len >= sizeof(word); len -= sizeof(word), data += sizeof(word)) {
+		memcpy(&word, data, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+	}
+
+	crc = crc64;
+#else
+	uint32_t word;
+
+	for (; len >= sizeof(word); len -= sizeof(word), data += sizeof(word)) {
+		memcpy(&word, data, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+	}
+#endif
+
+	for (; len > 0; len--, data++) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+
+	return crc;
+}
+#elif defined(CONFIG_CRC_HW_INSTRUCTIONS) && defined(__ARM_FEATURE_CRC32) && \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_acle.h>
+#include <string.h>
+
+#define CRC32C_HW 1
+
+static uint32_t crc32c_hw(uint32_t crc, const uint8_t *data, size_t len)
+{
+	uint64_t word;
+
+	for (; len >= sizeof(word); len -= sizeof(word), data += sizeof(word)) {
+		memcpy(&word, data, sizeof(word));
+		crc = __crc32cd(crc, word);
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = __crc32cb(crc, *data);
+	}
+
+	return crc;
+}
+#elif !defined(CRC_SLICES)
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
 static const uint32_t crc32c_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
@@ -13,6 +71,7 @@ static const uint32_t crc32c_table[16] = {
 	0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
 };
+#endif
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -31,10 +90,16 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		crc = CRC32C_INIT;
 	}
 
+#if defined(CRC32C_HW)
+	crc = crc32c_hw(crc, data, len);
+#elif defined(CRC_SLICES)
+	crc = crc32_tables_update(crc32c_slice_tables, crc, data, len);
+#else
 	for (size_t i = 0; i < len; i++) {
 		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
 		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
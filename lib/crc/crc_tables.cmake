@@ -0,0 +1,31 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Generate the slice-by-N CRC tables selected in Kconfig.
+#
+# Sets <out_var> to the generated source, to be built by the caller, or to an
+# empty string if no slice-by-N tables are selected. Used by lib/crc and by the
+# crc unit tests, which do not build lib/crc.
+function(crc_tables out_var)
+  if(CONFIG_CRC_TABLES_SLICE_BY_8)
+    set(slices 8)
+  elseif(CONFIG_CRC_TABLES_SLICE_BY_4)
+    set(slices 4)
+  else()
+    set(${out_var} "" PARENT_SCOPE)
+    return()
+  endif()
+
+  set(tables_c ${CMAKE_CURRENT_BINARY_DIR}/crc_tables.c)
+
+  add_custom_command(
+    OUTPUT ${tables_c}
+    COMMAND
+    ${PYTHON_EXECUTABLE}
+    ${ZEPHYR_BASE}/scripts/build/gen_crc_tables.py
+    --slices ${slices}
+    -o ${tables_c}
+    DEPENDS ${ZEPHYR_BASE}/scripts/build/gen_crc_tables.py
+  )
+
+  set(${out_var} ${tables_c} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Slice-by-N tables shared by the reflected CRC implementations.
+ *
+ * Table k holds the CRC of byte n followed by k zero bytes, so that N bytes
+ * of input take N lookups which don't depend on each other, instead of N
+ * dependent ones. The tables are generated at build time by
+ * scripts/build/gen_crc_tables.py as const arrays, and take N KiB (32 bit
+ * CRCs) or N/2 KiB (16 bit CRCs) of ROM. Unused ones are garbage collected
+ * by the linker.
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC_TABLES_H_
+#define ZEPHYR_LIB_CRC_CRC_TABLES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(CONFIG_CRC_TABLES_SLICE_BY_8)
+#define CRC_SLICES 8
+#elif defined(CONFIG_CRC_TABLES_SLICE_BY_4)
+#define CRC_SLICES 4
+#endif
+
+#ifdef CRC_SLICES
+
+extern const uint32_t crc32_ieee_slice_tables[CRC_SLICES][256];
+extern const uint32_t crc32c_slice_tables[CRC_SLICES][256];
+extern const uint16_t crc16_ccitt_slice_tables[CRC_SLICES][256];
+
+static inline uint32_t crc32_tables_update(const uint32_t tables[CRC_SLICES][256],
+					   uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (; len >= CRC_SLICES; len -= CRC_SLICES, data += CRC_SLICES) {
+		crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+		       ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+
+		crc = tables[CRC_SLICES - 1][crc & 0xffU] ^
+		      tables[CRC_SLICES - 2][(crc >> 8) & 0xffU] ^
+		      tables[CRC_SLICES - 3][(crc >> 16) & 0xffU] ^
+		      tables[CRC_SLICES - 4][crc >> 24];
+
+		for (int k = 4; k < CRC_SLICES; k++) {
+			crc ^= tables[CRC_SLICES - 1 - k][data[k]];
+		}
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xffU];
+	}
+
+	return crc;
+}
+
+static inline uint16_t crc16_tables_update(const uint16_t tables[CRC_SLICES][256],
+					   uint16_t crc, const uint8_t *data, size_t len)
+{
+	for (; len >= CRC_SLICES; len -= CRC_SLICES, data += CRC_SLICES) {
+		crc ^= (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+
+		crc = tables[CRC_SLICES - 1][crc & 0xffU] ^
+		      tables[CRC_SLICES - 2][crc >> 8];
+
+		for (int k = 2; k < CRC_SLICES; k++) {
+			crc ^= tables[CRC_SLICES - 1 - k][data[k]];
+		}
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xffU];
+	}
+
+	return crc;
+}
+
+#endif /* CRC_SLICES */
+
+#endif /* ZEPHYR_LIB_CRC_CRC_TABLES_H_ */
@@ -21,16 +21,6 @@ static inline void increase_allocated_bytes(struct z_heap *h, size_t num_bytes)
 }
 #endif
 
-static void *chunk_mem(struct z_heap *h, chunkid_t c)
-{
-	chunk_unit_t *buf = chunk_buf(h);
-	uint8_t *ret = ((uint8_t *)&buf[c]) + chunk_header_bytes(h);
-
-	CHECK(!(((uintptr_t)ret) & (big_heap(h) ? 7 : 3)));
-
-	return ret;
-}
-
 static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
@@ -148,18 +138,6 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
-/*
- * Return the closest chunk ID corresponding to given memory pointer.
- * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
- * where wanted alignment might not always correspond to a chunk header
- * boundary.
- */
-static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
-{
-	uint8_t *mem = p, *base = (uint8_t *)chunk_buf(h);
-	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
-}
-
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
@@ -524,6 +502,31 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	return ptr2;
 }
 
+void sys_heap_free_space_get(struct sys_heap *heap, size_t *free_bytes,
+			     size_t *largest_free_bytes)
+{
+	struct z_heap *h = heap->heap;
+	chunksz_t largest = 0;
+
+	*free_bytes = 0;
+	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
+		chunkid_t first = h->buckets[b].next;
+		chunkid_t c = first;
+
+		if (first == 0) {
+			continue;
+		}
+
+		do {
+			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+			largest = MAX(largest, chunk_size(h, c));
+			c = next_free_chunk(h, c);
+		} while (c != first);
+	}
+
+	*largest_free_bytes = (largest != 0) ? chunksz_to_bytes(h, largest) : 0;
+}
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	IF_ENABLED(CONFIG_MSAN, (__sanitizer_dtor_callback(mem, bytes)));
@@ -559,6 +562,10 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	memset(h->cache, 0, sizeof(h->cache));
+#endif
+
 #if CONFIG_SYS_HEAP_ARRAY_SIZE
 	sys_heap_array_save(heap);
 #endif
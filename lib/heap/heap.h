@@ -65,6 +65,24 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+#include <zephyr/spinlock.h>
+
+/* Per-CPU cache of small allocated chunks, see heap_cache.c.  The
+ * cached chunks stay marked as used and are linked through the first
+ * word of their memory.  The lock is only ever contended when another
+ * CPU drains the cache.  Z_HEAP_CACHE_SIZE in kernel.h has to be kept in
+ * line with its size.
+ */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	void *blocks[CONFIG_SYS_HEAP_CACHE_CLASSES];
+	uint8_t count[CONFIG_SYS_HEAP_CACHE_CLASSES];
+	uint32_t hits;
+	uint32_t misses;
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +91,9 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct z_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -247,6 +268,28 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT - chunk_header_bytes(h);
 }
 
+static inline void *chunk_mem(struct z_heap *h, chunkid_t c)
+{
+	chunk_unit_t *buf = chunk_buf(h);
+	uint8_t *ret = ((uint8_t *)&buf[c]) + chunk_header_bytes(h);
+
+	CHECK(!(((uintptr_t)ret) & (big_heap(h) ? 7 : 3)));
+
+	return ret;
+}
+
+/*
+ * Return the closest chunk ID corresponding to given memory pointer.
+ * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
+ * where wanted alignment might not always correspond to a chunk header
+ * boundary.
+ */
+static inline chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
+{
+	uint8_t *mem = p, *base = (uint8_t *)chunk_buf(h);
+	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
+}
+
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
@@ -279,4 +322,9 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Total size of the chunks held by the per-CPU caches */
+size_t heap_cache_bytes(struct z_heap *h);
+#endif
+
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include "heap.h"
+
+/* Small allocations are rounded up to one of CONFIG_SYS_HEAP_CACHE_CLASSES
+ * power-of-two size classes.  When freed, chunks of exactly a class size
+ * are kept on a per-CPU list for that class, up to
+ * CONFIG_SYS_HEAP_CACHE_DEPTH of them, and handed out again to the next
+ * request of that class on the same CPU.  Cached chunks are never split
+ * or merged and stay marked as used in the heap, which therefore doesn't
+ * need to be locked to access the cache.  Each cache has a lock of its
+ * own, which only gets contended when an allocation about to fail
+ * drains the caches of all CPUs.
+ */
+
+/* Z_HEAP_MIN_SIZE only reserves Z_HEAP_CACHE_SIZE bytes for the caches */
+BUILD_ASSERT(sizeof(struct z_heap_cache) * CONFIG_MP_MAX_NUM_CPUS <= Z_HEAP_CACHE_SIZE,
+	     "Z_HEAP_CACHE_SIZE does not cover struct z_heap_cache");
+
+static inline chunksz_t class_chunksz(struct z_heap *h, int cls)
+{
+	return bytes_to_chunksz(h, (size_t)CONFIG_SYS_HEAP_CACHE_MIN_SIZE << cls);
+}
+
+static inline struct z_heap_cache *curr_cache(struct z_heap *h)
+{
+#ifdef CONFIG_SMP
+	/* Being migrated right after this only costs some locality, the
+	 * cache lock still protects the cache of the previous CPU.
+	 */
+	return &h->cache[arch_curr_cpu()->id];
+#else
+	return &h->cache[0];
+#endif /* CONFIG_SMP */
+}
+
+/* Returns the size class fitting a request, or -1 if it isn't cacheable */
+static int alloc_class(struct z_heap *h, size_t align, size_t bytes)
+{
+	chunksz_t sz;
+
+	if ((bytes == 0U) || (align > chunk_header_bytes(h)) || size_too_big(h, bytes)) {
+		return -1;
+	}
+
+	sz = bytes_to_chunksz(h, bytes);
+	for (int cls = 0; cls < CONFIG_SYS_HEAP_CACHE_CLASSES; cls++) {
+		if (sz <= class_chunksz(h, cls)) {
+			return cls;
+		}
+	}
+
+	return -1;
+}
+
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_cache *cache;
+	int cls = alloc_class(h, align, bytes);
+	void *mem;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	cache = curr_cache(h);
+
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	mem = cache->blocks[cls];
+	if (mem != NULL) {
+		cache->blocks[cls] = *(void **)mem;
+		cache->count[cls]--;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return mem;
+}
+
+static void *miss_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	int cls = alloc_class(h, align, bytes);
+	void *mem = NULL;
+
+	/* Take a whole size class so that the block is cached when freed,
+	 * but don't let the rounding fail an allocation that would fit.
+	 */
+	if (cls >= 0) {
+		mem = sys_heap_alloc(heap, chunksz_to_bytes(h, class_chunksz(h, cls)));
+	}
+	if (mem == NULL) {
+		mem = sys_heap_aligned_alloc(heap, align, bytes);
+	}
+
+	return mem;
+}
+
+void *sys_heap_cache_miss_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	void *mem = miss_alloc(heap, align, bytes);
+
+	if ((mem == NULL) && sys_heap_cache_flush(heap)) {
+		mem = miss_alloc(heap, align, bytes);
+	}
+
+	return mem;
+}
+
+bool sys_heap_cache_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_cache *cache;
+	bool cached = false;
+	chunkid_t c;
+	int cls;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	/* Aligned allocations may not start at the chunk memory */
+	c = mem_to_chunkid(h, mem);
+	if (chunk_mem(h, c) != mem) {
+		return false;
+	}
+
+	__ASSERT(chunk_used(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+
+	for (cls = 0; cls < CONFIG_SYS_HEAP_CACHE_CLASSES; cls++) {
+		if (chunk_size(h, c) == class_chunksz(h, cls)) {
+			break;
+		}
+	}
+	if (cls == CONFIG_SYS_HEAP_CACHE_CLASSES) {
+		return false;
+	}
+
+	cache = curr_cache(h);
+
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if (cache->count[cls] < CONFIG_SYS_HEAP_CACHE_DEPTH) {
+		*(void **)mem = cache->blocks[cls];
+		cache->blocks[cls] = mem;
+		cache->count[cls]++;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return cached;
+}
+
+bool sys_heap_cache_flush(struct sys_heap *heap)
+{
+	struct z_heap *h = heap->heap;
+	bool flushed = false;
+
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		struct z_heap_cache *cache = &h->cache[cpu];
+		void *blocks[CONFIG_SYS_HEAP_CACHE_CLASSES];
+
+		/* Detach the lists, so that the cache isn't locked while
+		 * the blocks go back to the heap.
+		 */
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		for (int cls = 0; cls < CONFIG_SYS_HEAP_CACHE_CLASSES; cls++) {
+			blocks[cls] = cache->blocks[cls];
+			cache->blocks[cls] = NULL;
+			cache->count[cls] = 0U;
+		}
+
+		k_spin_unlock(&cache->lock, key);
+
+		for (int cls = 0; cls < CONFIG_SYS_HEAP_CACHE_CLASSES; cls++) {
+			while (blocks[cls] != NULL) {
+				void *mem = blocks[cls];
+
+				blocks[cls] = *(void **)mem;
+				sys_heap_free(heap, mem);
+				flushed = true;
+			}
+		}
+	}
+
+	return flushed;
+}
+
+size_t heap_cache_bytes(struct z_heap *h)
+{
+	size_t bytes = 0;
+
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		for (int cls = 0; cls < CONFIG_SYS_HEAP_CACHE_CLASSES; cls++) {
+			bytes += h->cache[cpu].count[cls] *
+				 chunksz_to_bytes(h, class_chunksz(h, cls));
+		}
+	}
+
+	return bytes;
+}
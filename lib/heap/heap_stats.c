@@ -19,6 +19,18 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	stats->allocated_bytes = heap->heap->allocated_bytes;
 	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached blocks are still allocated from the heap point of view */
+	stats->cached_bytes = heap_cache_bytes(heap->heap);
+	stats->allocated_bytes -= stats->cached_bytes;
+	stats->cache_hits = 0U;
+	stats->cache_misses = 0U;
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		stats->cache_hits += heap->heap->cache[cpu].hits;
+		stats->cache_misses += heap->heap->cache[cpu].misses;
+	}
+#endif
+
 	return 0;
 }
 
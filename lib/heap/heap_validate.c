@@ -97,6 +97,9 @@ bool sys_heap_validate(struct sys_heap *heap)
 
 	get_alloc_info(h, &allocated_bytes, &free_bytes);
 	sys_heap_runtime_stats_get(heap, &stat);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	stat.allocated_bytes += stat.cached_bytes;
+#endif
 	if ((stat.allocated_bytes != allocated_bytes) ||
 	    (stat.free_bytes != free_bytes)) {
 		return false;
@@ -34,6 +34,10 @@ struct fd_entry {
 	struct k_condvar cond;
 	size_t offset;
 	uint32_t mode;
+#if defined(CONFIG_ZVFS_EPOLL)
+	/* epoll registrations of the descriptor */
+	sys_slist_t epoll;
+#endif
 };
 
 #if defined(CONFIG_POSIX_DEVICE_IO)
@@ -236,6 +240,17 @@ void *zvfs_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 	return entry->obj;
 }
 
+#if defined(CONFIG_ZVFS_EPOLL)
+sys_slist_t *zvfs_get_fd_epoll_list(int fd)
+{
+	if (_check_fd(fd) < 0) {
+		return NULL;
+	}
+
+	return &fdtable[fd].epoll;
+}
+#endif /* defined(CONFIG_ZVFS_EPOLL) */
+
 int zvfs_reserve_fd(void)
 {
 	int fd;
@@ -251,6 +266,9 @@ int zvfs_reserve_fd(void)
 		fdtable[fd].offset = 0;
 		k_mutex_init(&fdtable[fd].lock);
 		k_condvar_init(&fdtable[fd].cond);
+#if defined(CONFIG_ZVFS_EPOLL)
+		sys_slist_init(&fdtable[fd].epoll);
+#endif
 	}
 
 	k_mutex_unlock(&fdtable_lock);
@@ -335,10 +353,19 @@ static ssize_t zvfs_rw(int fd, void *buf, size_t sz, bool is_write, const size_t
 	if (from_offset != NULL && !prw) {
 		/*
 		 * Seekable file types should support pread() / pwrite() and per-fd offset passing.
-		 * Otherwise, it's a bug.
+		 * Files keeping their own position may implement them through ioctl() instead.
 		 */
-		errno = ENOTSUP;
-		res = -1;
+		if (fdtable[fd].vtable->ioctl == NULL) {
+			errno = ENOTSUP;
+			res = -1;
+		} else {
+			res = zvfs_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj,
+						      is_write ? ZFD_IOCTL_PWRITE : ZFD_IOCTL_PREAD,
+						      buf, sz, *from_offset);
+			if ((res < 0) && (errno == EOPNOTSUPP)) {
+				errno = ENOTSUP;
+			}
+		}
 		goto unlock;
 	}
 
@@ -371,6 +398,10 @@ static ssize_t zvfs_rw(int fd, void *buf, size_t sz, bool is_write, const size_t
 unlock:
 	k_mutex_unlock(&fdtable[fd].lock);
 
+	if (IS_ENABLED(CONFIG_ZVFS_EPOLL) && res < 0 && errno == EAGAIN) {
+		zvfs_epoll_rearm_fd(fd);
+	}
+
 	return res;
 }
 
@@ -392,6 +423,10 @@ int zvfs_close(int fd)
 		return -1;
 	}
 
+	if (IS_ENABLED(CONFIG_ZVFS_EPOLL)) {
+		zvfs_epoll_close_fd(fd);
+	}
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 	if (fdtable[fd].vtable->close != NULL) {
 		/* close() is optional - e.g. stdinout_fd_op_vtable */
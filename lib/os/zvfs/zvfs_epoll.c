@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Each registered descriptor keeps its k_poll_events, filled in once by the
+ * POLL_PREPARE ioctl of its vtable, and waits on them with a k_work_poll.
+ * When one of them fires, the trigger handler queues the descriptor on the
+ * ready list of its epoll instance and wakes the waiter. zvfs_epoll_wait()
+ * then only looks at the queued descriptors: those found not ready any more
+ * are armed again, the others are reported.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* TLS sockets wait for the handshake besides the data */
+#define ZVFS_EPOLL_ITEM_EVENTS 3
+
+#define ZVFS_EPOLL_POLL_EVENTS (ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT)
+#define ZVFS_EPOLL_ALWAYS      (ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+enum zvfs_epoll_item_state {
+	/* Waiting for the descriptor to become ready */
+	ZVFS_EPOLL_ITEM_ARMED,
+	/* Queued on the ready list */
+	ZVFS_EPOLL_ITEM_READY,
+	/* Reported, waiting for EAGAIN (edge triggered) or a modification */
+	ZVFS_EPOLL_ITEM_IDLE,
+};
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	/* Ready list of the instance */
+	sys_dnode_t ready_node;
+	/* Registrations of the instance */
+	sys_dnode_t ep_node;
+	/* Registrations of the descriptor, or the graveyard */
+	sys_snode_t fd_node;
+	struct zvfs_epoll *ep;
+	struct k_work_poll work;
+	struct k_poll_event pev[ZVFS_EPOLL_ITEM_EVENTS];
+	union zvfs_epoll_data data;
+	uint32_t events;
+	int fd;
+	uint8_t state;
+	bool zombie;
+};
+
+struct zvfs_epoll {
+	sys_dlist_t ready;
+	sys_dlist_t items;
+	struct k_sem wait_sem;
+	bool in_use;
+};
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+K_MEM_SLAB_DEFINE_STATIC(epoll_items, sizeof(struct zvfs_epoll_item),
+			 CONFIG_ZVFS_EPOLL_ITEM_MAX, 8);
+
+/* Protects all instances and registrations. Taken before the lock of a
+ * registered descriptor, never while holding it.
+ */
+static K_MUTEX_DEFINE(epoll_lock);
+
+/* Removed items whose work item is still in use by the work queue */
+static sys_slist_t epoll_graveyard;
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+/* eventfds report errors through errno, sockets through the return value */
+static inline int epoll_ioctl_err(int ret)
+{
+	return (ret == -1) ? -errno : ret;
+}
+
+static void epoll_item_queue(struct zvfs_epoll_item *item)
+{
+	item->state = ZVFS_EPOLL_ITEM_READY;
+	sys_dlist_append(&item->ep->ready, &item->ready_node);
+	k_sem_give(&item->ep->wait_sem);
+}
+
+static void epoll_trigger_handler(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+	struct zvfs_epoll_item *item = CONTAINER_OF(pwork, struct zvfs_epoll_item, work);
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	if (item->zombie) {
+		/* The work queue still owns the item until we return */
+		sys_slist_append(&epoll_graveyard, &item->fd_node);
+	} else if (item->state == ZVFS_EPOLL_ITEM_ARMED) {
+		epoll_item_queue(item);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+static void epoll_reap(void)
+{
+	struct zvfs_epoll_item *item;
+	sys_snode_t *prev = NULL;
+	sys_snode_t *node;
+	sys_snode_t *next;
+
+	SYS_SLIST_FOR_EACH_NODE_SAFE(&epoll_graveyard, node, next) {
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, fd_node);
+
+		if (k_work_busy_get(&item->work.work) != 0) {
+			prev = node;
+			continue;
+		}
+
+		sys_slist_remove(&epoll_graveyard, prev, node);
+		k_mem_slab_free(&epoll_items, item);
+	}
+}
+
+/* Wait for the descriptor to become ready, or queue it if it already is */
+static int epoll_item_arm(struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->events & ZVFS_EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event *pev = item->pev;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	item->state = ZVFS_EPOLL_ITEM_IDLE;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->pev + ARRAY_SIZE(item->pev));
+	k_mutex_unlock(lock);
+
+	if (ret == -EALREADY) {
+		epoll_item_queue(item);
+		return 0;
+	} else if (ret == -EXDEV) {
+		/* Offloaded sockets have their own poll implementation */
+		return -EPERM;
+	} else if (ret < 0) {
+		return epoll_ioctl_err(ret);
+	}
+
+	if (pev == item->pev) {
+		/* Nothing to wait for */
+		return 0;
+	}
+
+	/* Queue it right away rather than through the work queue */
+	if (k_poll(item->pev, pev - item->pev, K_NO_WAIT) == 0) {
+		epoll_item_queue(item);
+		return 0;
+	}
+
+	item->state = ZVFS_EPOLL_ITEM_ARMED;
+
+	ret = k_work_poll_submit(&item->work, item->pev, pev - item->pev, K_FOREVER);
+	if (ret < 0) {
+		item->state = ZVFS_EPOLL_ITEM_IDLE;
+	}
+
+	return ret;
+}
+
+/* Check the descriptor without waiting and return the events to report */
+static uint32_t epoll_item_check(struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->events & ZVFS_EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event *pev = item->pev;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return ZVFS_EPOLLERR;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->pev + ARRAY_SIZE(item->pev));
+	if (ret == 0 || ret == -EALREADY) {
+		if (pev != item->pev) {
+			(void)k_poll(item->pev, pev - item->pev, K_NO_WAIT);
+		}
+
+		pev = item->pev;
+		ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	}
+
+	k_mutex_unlock(lock);
+
+	if (ret == -EAGAIN) {
+		/* TLS handshake progress, no data yet */
+		return 0;
+	} else if (ret < 0) {
+		return ZVFS_EPOLLERR;
+	}
+
+	return pfd.revents & (item->events | ZVFS_EPOLL_ALWAYS);
+}
+
+/* Drop an item that was already unlinked from its instance and descriptor */
+static void epoll_item_release(struct zvfs_epoll_item *item)
+{
+	if (item->state == ZVFS_EPOLL_ITEM_READY) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	if (item->state == ZVFS_EPOLL_ITEM_ARMED && k_work_poll_cancel(&item->work) < 0) {
+		/* Already triggered, the handler retires the item */
+		item->zombie = true;
+		return;
+	}
+
+	if (k_work_busy_get(&item->work.work) != 0) {
+		sys_slist_append(&epoll_graveyard, &item->fd_node);
+		return;
+	}
+
+	k_mem_slab_free(&epoll_items, item);
+}
+
+static struct zvfs_epoll_item *epoll_item_find(struct zvfs_epoll *ep, sys_slist_t *fd_items)
+{
+	struct zvfs_epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(fd_items, item, fd_node) {
+		if (item->ep == ep) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+static int epoll_item_add(struct zvfs_epoll *ep, sys_slist_t *fd_items, int fd,
+			  const struct zvfs_epoll_event *ev)
+{
+	struct zvfs_epoll_item *item;
+	int ret;
+
+	if (k_mem_slab_alloc(&epoll_items, (void **)&item, K_NO_WAIT) < 0) {
+		return -ENOMEM;
+	}
+
+	memset(item, 0, sizeof(*item));
+	k_work_poll_init(&item->work, epoll_trigger_handler);
+	item->ep = ep;
+	item->fd = fd;
+	item->events = ev->events;
+	item->data = ev->data;
+
+	ret = epoll_item_arm(item);
+	if (ret < 0) {
+		k_mem_slab_free(&epoll_items, item);
+		return ret;
+	}
+
+	sys_slist_append(fd_items, &item->fd_node);
+	sys_dlist_append(&ep->items, &item->ep_node);
+
+	return 0;
+}
+
+static int epoll_item_mod(struct zvfs_epoll_item *item, const struct zvfs_epoll_event *ev)
+{
+	item->events = ev->events;
+	item->data = ev->data;
+
+	switch (item->state) {
+	case ZVFS_EPOLL_ITEM_ARMED:
+		if (k_work_poll_cancel(&item->work) < 0) {
+			/* Already triggered, it is checked with the new events */
+			return 0;
+		}
+
+		return epoll_item_arm(item);
+	case ZVFS_EPOLL_ITEM_IDLE:
+		return epoll_item_arm(item);
+	default:
+		return 0;
+	}
+}
+
+/* Report the queued descriptors that are still ready */
+static int epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events, int maxevents)
+{
+	struct zvfs_epoll_item *item;
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+	uint32_t revents;
+	int count = 0;
+
+	sys_dlist_init(&pending);
+
+	while ((node = sys_dlist_get(&ep->ready)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while (count < maxevents && (node = sys_dlist_get(&pending)) != NULL) {
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, ready_node);
+
+		revents = epoll_item_check(item);
+		if (revents == 0) {
+			if (epoll_item_arm(item) == 0) {
+				continue;
+			}
+
+			revents = ZVFS_EPOLLERR;
+		}
+
+		events[count].events = revents;
+		events[count].data = item->data;
+		count++;
+
+		if ((item->events & (ZVFS_EPOLLET | ZVFS_EPOLLONESHOT)) != 0) {
+			item->state = ZVFS_EPOLL_ITEM_IDLE;
+		} else {
+			/* Level triggered, check it again on the next call */
+			item->state = ZVFS_EPOLL_ITEM_READY;
+			sys_dlist_append(&ep->ready, node);
+		}
+	}
+
+	/* Descriptors not looked at come first the next time */
+	while ((node = sys_dlist_peek_tail(&pending)) != NULL) {
+		sys_dlist_remove(node);
+		sys_dlist_prepend(&ep->ready, node);
+	}
+
+	return count;
+}
+
+void zvfs_epoll_close_fd(int fd)
+{
+	struct zvfs_epoll_item *item;
+	sys_slist_t *fd_items;
+	sys_snode_t *node;
+
+	fd_items = zvfs_get_fd_epoll_list(fd);
+	if (fd_items == NULL || sys_slist_is_empty(fd_items)) {
+		return;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	while ((node = sys_slist_get(fd_items)) != NULL) {
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, fd_node);
+		sys_dlist_remove(&item->ep_node);
+		epoll_item_release(item);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+void zvfs_epoll_rearm_fd(int fd)
+{
+	struct zvfs_epoll_item *item;
+	sys_slist_t *fd_items;
+	int prev_errno = errno;
+
+	fd_items = zvfs_get_fd_epoll_list(fd);
+	if (fd_items == NULL || sys_slist_is_empty(fd_items)) {
+		errno = prev_errno;
+		return;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(fd_items, item, fd_node) {
+		if (item->state == ZVFS_EPOLL_ITEM_IDLE &&
+		    (item->events & (ZVFS_EPOLLET | ZVFS_EPOLLONESHOT)) == ZVFS_EPOLLET) {
+			(void)epoll_item_arm(item);
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	errno = prev_errno;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	struct zvfs_epoll_item *item;
+	sys_slist_t *fd_items;
+	sys_dnode_t *node;
+	int err;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	while ((node = sys_dlist_get(&ep->items)) != NULL) {
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, ep_node);
+
+		fd_items = zvfs_get_fd_epoll_list(item->fd);
+		if (fd_items != NULL) {
+			(void)sys_slist_find_and_remove(fd_items, &item->fd_node);
+		}
+
+		epoll_item_release(item);
+	}
+
+	ep->in_use = false;
+
+	err = sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	/* Let a waiter notice the instance is gone */
+	k_sem_give(&ep->wait_sem);
+
+	k_mutex_unlock(&epoll_lock);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &epolls[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	sys_dlist_init(&ep->ready);
+	sys_dlist_init(&ep->items);
+	k_sem_init(&ep->wait_sem, 0, 1);
+	ep->in_use = true;
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *ev)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll *ep;
+	sys_slist_t *fd_items;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL && ev == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	if (zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL) == NULL) {
+		return -1;
+	}
+
+	if (vtable == &zvfs_epoll_fd_vtable) {
+		/* Nesting epoll instances is not supported */
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd_items = zvfs_get_fd_epoll_list(fd);
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	epoll_reap();
+
+	if (!ep->in_use) {
+		ret = -EBADF;
+		goto unlock;
+	}
+
+	item = epoll_item_find(ep, fd_items);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		ret = epoll_item_add(ep, fd_items, fd, ev);
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		ret = epoll_item_mod(item, ev);
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		(void)sys_slist_find_and_remove(fd_items, &item->fd_node);
+		sys_dlist_remove(&item->ep_node);
+		epoll_item_release(item);
+		ret = 0;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+unlock:
+	k_mutex_unlock(&epoll_lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	while (true) {
+		epoll_reap();
+
+		if (!ep->in_use) {
+			errno = EBADF;
+			ret = -1;
+			break;
+		}
+
+		ret = epoll_collect(ep, events, maxevents);
+		if (ret > 0 || sys_timepoint_expired(end)) {
+			break;
+		}
+
+		k_mutex_unlock(&epoll_lock);
+		(void)k_sem_take(&ep->wait_sem, sys_timepoint_timeout(end));
+		(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	return ret;
+}
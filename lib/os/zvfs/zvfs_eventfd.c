@@ -459,6 +459,10 @@ int zvfs_eventfd_read(int fd, zvfs_eventfd_t *value)
 	ret = zvfs_eventfd_rw_op(obj, value, sizeof(zvfs_eventfd_t), zvfs_eventfd_read_locked);
 	__ASSERT_NO_MSG(ret == -1 || ret == sizeof(zvfs_eventfd_t));
 	if (ret < 0) {
+		if (IS_ENABLED(CONFIG_ZVFS_EPOLL) && errno == EAGAIN) {
+			zvfs_epoll_rearm_fd(fd);
+		}
+
 		return -1;
 	}
 
@@ -478,6 +482,10 @@ int zvfs_eventfd_write(int fd, zvfs_eventfd_t value)
 	ret = zvfs_eventfd_rw_op(obj, &value, sizeof(zvfs_eventfd_t), zvfs_eventfd_write_locked);
 	__ASSERT_NO_MSG(ret == -1 || ret == sizeof(zvfs_eventfd_t));
 	if (ret < 0) {
+		if (IS_ENABLED(CONFIG_ZVFS_EPOLL) && errno == EAGAIN) {
+			zvfs_epoll_rearm_fd(fd);
+		}
+
 		return -1;
 	}
 
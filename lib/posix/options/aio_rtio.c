@@ -0,0 +1,501 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/posix/aio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/work.h>
+#include <zephyr/sys/fdtable.h>
+
+LOG_MODULE_REGISTER(posix_aio);
+
+/*
+ * Requests are queued to an RTIO context whose iodev hands them over to the
+ * RTIO work queue, where the blocking file operation is carried out. Each
+ * request owns one of CONFIG_POSIX_AIO_MAX slots until it completes, which
+ * bounds the number of submission queue entries and work items in use.
+ */
+
+ssize_t zvfs_read(int fd, void *buf, size_t sz, const size_t *from_offset);
+ssize_t zvfs_write(int fd, const void *buf, size_t sz, const size_t *from_offset);
+int zvfs_fsync(int fd);
+
+/* Completion of a lio_listio(), for its sigevent */
+struct aio_list {
+	struct sigevent sig;
+	atomic_t pending;
+};
+
+struct aio_req {
+	struct aiocb *aiocbp;
+	struct aio_list *list;
+};
+
+/* A work item is only released once the request it carried out has completed */
+BUILD_ASSERT(CONFIG_RTIO_WORKQ_POOL_ITEMS >= CONFIG_POSIX_AIO_MAX + CONFIG_RTIO_WORKQ_THREADS_POOL,
+	     "CONFIG_RTIO_WORKQ_POOL_ITEMS too small for CONFIG_POSIX_AIO_MAX");
+
+static struct aio_req aio_reqs[CONFIG_POSIX_AIO_MAX];
+static struct aio_list aio_lists[CONFIG_POSIX_AIO_MAX];
+
+static K_MUTEX_DEFINE(aio_lock);
+static K_CONDVAR_DEFINE(aio_cond);
+
+static void aio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe);
+
+static const struct rtio_iodev_api aio_iodev_api = {
+	.submit = aio_iodev_submit,
+};
+
+RTIO_IODEV_DEFINE(aio_iodev, &aio_iodev_api, NULL);
+RTIO_DEFINE(aio_rtio, CONFIG_POSIX_AIO_MAX, 1);
+
+static void aio_notify(const struct sigevent *sig)
+{
+	/* Like timers, call the notification function for signals too */
+	if (sig->sigev_notify == SIGEV_NONE || sig->sigev_notify_function == NULL) {
+		return;
+	}
+
+	LOG_DBG("calling sigev_notify_function %p", sig->sigev_notify_function);
+	sig->sigev_notify_function(sig->sigev_value);
+}
+
+static bool aio_sigevent_valid(const struct sigevent *sig)
+{
+	switch (sig->sigev_notify) {
+	case SIGEV_NONE:
+	case SIGEV_SIGNAL:
+	case SIGEV_THREAD:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Sets errno to EBADF if the file descriptor isn't open */
+static bool aio_fd_valid(int fd)
+{
+	const struct fd_op_vtable *vtable;
+
+	return zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL) != NULL;
+}
+
+/* Transfers at the offset of the request, like pread() and pwrite(), so
+ * the position of the file descriptor is left alone. Writes to a file
+ * opened with O_APPEND go to its end.
+ */
+static ssize_t aio_transfer(uint8_t op, struct aiocb *aiocbp)
+{
+	int fd = aiocbp->aio_fildes;
+	size_t offset = (size_t)aiocbp->aio_offset;
+
+	switch (op) {
+	case RTIO_OP_FSYNC:
+		return zvfs_fsync(fd);
+	case RTIO_OP_RX:
+		return zvfs_read(fd, (void *)aiocbp->aio_buf, aiocbp->aio_nbytes, &offset);
+	default:
+		return zvfs_write(fd, (const void *)aiocbp->aio_buf, aiocbp->aio_nbytes, &offset);
+	}
+}
+
+static void aio_list_put(struct aio_list *list)
+{
+	/* The entry is free again once pending drops to 0 */
+	struct sigevent sig = list->sig;
+
+	if (atomic_dec(&list->pending) == 1) {
+		aio_notify(&sig);
+	}
+}
+
+static void aio_complete(struct aio_req *req, ssize_t ret, int err)
+{
+	struct aiocb *aiocbp = req->aiocbp;
+	struct aio_list *list = req->list;
+	struct sigevent sig;
+
+	/* The control block may be reused as soon as it's marked as done */
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	sig = aiocbp->aio_sigevent;
+	aiocbp->_aio_return = ret;
+	aiocbp->_aio_error = err;
+	req->aiocbp = NULL;
+	req->list = NULL;
+	k_condvar_broadcast(&aio_cond);
+	k_mutex_unlock(&aio_lock);
+
+	aio_notify(&sig);
+
+	if (list != NULL) {
+		aio_list_put(list);
+	}
+}
+
+static void aio_work_handler(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct aio_req *req = iodev_sqe->sqe.userdata;
+	ssize_t ret;
+	int err;
+
+	ret = aio_transfer(iodev_sqe->sqe.op, req->aiocbp);
+	err = (ret < 0) ? errno : 0;
+
+	/* Release the submission before the slot, which may be reused at once */
+	if (ret < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, -err);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, (int)MIN(ret, INT_MAX));
+	}
+
+	aio_complete(req, ret, err);
+}
+
+static void aio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct aio_req *req = iodev_sqe->sqe.userdata;
+	struct rtio_work_req *work = rtio_work_req_alloc();
+
+	if (work == NULL) {
+		LOG_DBG("no RTIO work item for %p", req->aiocbp);
+		rtio_iodev_sqe_err(iodev_sqe, -EAGAIN);
+		aio_complete(req, -1, EAGAIN);
+		return;
+	}
+
+	rtio_work_req_submit(work, iodev_sqe, aio_work_handler);
+}
+
+static struct aio_req *aio_req_alloc(void)
+{
+	ARRAY_FOR_EACH_PTR(aio_reqs, req) {
+		if (req->aiocbp == NULL) {
+			return req;
+		}
+	}
+
+	return NULL;
+}
+
+/* Queues a request, the caller holds aio_lock and submits the queue */
+static int aio_enqueue(struct aiocb *aiocbp, uint8_t op, struct aio_list *list)
+{
+	struct aio_req *req;
+	struct rtio_sqe *sqe;
+	int8_t prio;
+
+	if (aiocbp == NULL || !aio_sigevent_valid(&aiocbp->aio_sigevent) ||
+	    aiocbp->aio_reqprio < 0 || aiocbp->aio_offset < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (!aio_fd_valid(aiocbp->aio_fildes)) {
+		return -1;
+	}
+
+	req = aio_req_alloc();
+	sqe = (req != NULL) ? rtio_sqe_acquire(&aio_rtio) : NULL;
+	if (sqe == NULL) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* A positive aio_reqprio lowers the priority of the request */
+	prio = (aiocbp->aio_reqprio > 0) ? RTIO_PRIO_LOW : RTIO_PRIO_NORM;
+
+	switch (op) {
+	case RTIO_OP_RX:
+		rtio_sqe_prep_read(sqe, &aio_iodev, prio, (uint8_t *)aiocbp->aio_buf,
+				   MIN(aiocbp->aio_nbytes, UINT32_MAX), req);
+		break;
+	case RTIO_OP_TX:
+		rtio_sqe_prep_write(sqe, &aio_iodev, prio, (const uint8_t *)aiocbp->aio_buf,
+				    MIN(aiocbp->aio_nbytes, UINT32_MAX), req);
+		break;
+	default:
+		rtio_sqe_prep_fsync(sqe, &aio_iodev, prio, req);
+		break;
+	}
+
+	/* Completion is tracked in the control block, not the completion queue */
+	sqe->flags |= RTIO_SQE_NO_RESPONSE;
+
+	req->aiocbp = aiocbp;
+	req->list = list;
+	aiocbp->_aio_error = EINPROGRESS;
+	aiocbp->_aio_return = 0;
+
+	return 0;
+}
+
+static int aio_submit(struct aiocb *aiocbp, uint8_t op)
+{
+	int ret;
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	ret = aio_enqueue(aiocbp, op, NULL);
+	if (ret == 0) {
+		(void)rtio_submit(&aio_rtio, 0);
+	}
+	k_mutex_unlock(&aio_lock);
+
+	return ret;
+}
+
+static bool aio_in_progress(int fildes, const struct aiocb *aiocbp)
+{
+	ARRAY_FOR_EACH_PTR(aio_reqs, req) {
+		if (req->aiocbp != NULL && req->aiocbp->aio_fildes == fildes &&
+		    (aiocbp == NULL || req->aiocbp == aiocbp)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Requests are handed over to the work queue as soon as they are submitted,
+ * so they can't be canceled anymore.
+ */
+int aio_cancel(int fildes, struct aiocb *aiocbp)
+{
+	int ret;
+
+	if (!aio_fd_valid(fildes)) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	ret = aio_in_progress(fildes, aiocbp) ? AIO_NOTCANCELED : AIO_ALLDONE;
+	k_mutex_unlock(&aio_lock);
+
+	return ret;
+}
+
+int aio_error(const struct aiocb *aiocbp)
+{
+	int ret;
+
+	if (aiocbp == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	ret = aiocbp->_aio_error;
+	k_mutex_unlock(&aio_lock);
+
+	return ret;
+}
+
+int aio_fsync(int op, struct aiocb *aiocbp)
+{
+	/* fs_sync() flushes data and metadata alike, O_SYNC and O_DSYNC are the same */
+	ARG_UNUSED(op);
+
+	return aio_submit(aiocbp, RTIO_OP_FSYNC);
+}
+
+int aio_read(struct aiocb *aiocbp)
+{
+	return aio_submit(aiocbp, RTIO_OP_RX);
+}
+
+ssize_t aio_return(struct aiocb *aiocbp)
+{
+	ssize_t ret;
+
+	if (aiocbp == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+
+	if (aiocbp->_aio_error == EINPROGRESS) {
+		errno = EINVAL;
+		ret = -1;
+	} else if (aiocbp->_aio_error != 0) {
+		errno = aiocbp->_aio_error;
+		ret = -1;
+	} else {
+		ret = aiocbp->_aio_return;
+	}
+
+	k_mutex_unlock(&aio_lock);
+
+	return ret;
+}
+
+static bool aio_any_done(const struct aiocb *const list[], int nent)
+{
+	for (int i = 0; i < nent; i++) {
+		if (list[i] != NULL && list[i]->_aio_error != EINPROGRESS) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int aio_suspend(const struct aiocb *const list[], int nent, const struct timespec *timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	int ret = 0;
+
+	if (list == NULL || nent < 0 ||
+	    (timeout != NULL && (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+				 timeout->tv_nsec >= NSEC_PER_SEC))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		end = sys_timepoint_calc(K_USEC((int64_t)timeout->tv_sec * USEC_PER_SEC +
+						DIV_ROUND_UP(timeout->tv_nsec, NSEC_PER_USEC)));
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+
+	while (!aio_any_done(list, nent)) {
+		if (k_condvar_wait(&aio_cond, &aio_lock, sys_timepoint_timeout(end)) != 0) {
+			errno = EAGAIN;
+			ret = -1;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&aio_lock);
+
+	return ret;
+}
+
+int aio_write(struct aiocb *aiocbp)
+{
+	return aio_submit(aiocbp, RTIO_OP_TX);
+}
+
+static struct aio_list *aio_list_alloc(const struct sigevent *sig)
+{
+	ARRAY_FOR_EACH_PTR(aio_lists, list) {
+		if (atomic_cas(&list->pending, 0, 1)) {
+			list->sig = *sig;
+			return list;
+		}
+	}
+
+	return NULL;
+}
+
+int lio_listio(int mode, struct aiocb *const ZRESTRICT list[], int nent,
+	       struct sigevent *ZRESTRICT sig)
+{
+	struct aio_list *notify = NULL;
+	bool queued = false;
+	int ret = 0;
+	uint8_t op;
+
+	if ((mode != LIO_WAIT && mode != LIO_NOWAIT) || list == NULL || nent < 0 ||
+	    nent > AIO_LISTIO_MAX ||
+	    (mode == LIO_NOWAIT && sig != NULL && !aio_sigevent_valid(sig))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+
+	/* Holds one reference until all requests are queued */
+	if (mode == LIO_NOWAIT && sig != NULL && sig->sigev_notify != SIGEV_NONE) {
+		notify = aio_list_alloc(sig);
+		if (notify == NULL) {
+			k_mutex_unlock(&aio_lock);
+			errno = EAGAIN;
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < nent; i++) {
+		if (list[i] == NULL || list[i]->aio_lio_opcode == LIO_NOP) {
+			continue;
+		}
+
+		if (list[i]->aio_lio_opcode == LIO_READ) {
+			op = RTIO_OP_RX;
+		} else if (list[i]->aio_lio_opcode == LIO_WRITE) {
+			op = RTIO_OP_TX;
+		} else {
+			list[i]->_aio_error = EINVAL;
+			ret = -1;
+			continue;
+		}
+
+		if (notify != NULL) {
+			atomic_inc(&notify->pending);
+		}
+
+		if (aio_enqueue(list[i], op, notify) < 0) {
+			list[i]->_aio_error = errno;
+			list[i]->_aio_return = -1;
+			ret = -1;
+
+			if (notify != NULL) {
+				atomic_dec(&notify->pending);
+			}
+
+			continue;
+		}
+
+		queued = true;
+	}
+
+	/* The whole list goes to the work queue in a single submission */
+	if (queued) {
+		(void)rtio_submit(&aio_rtio, 0);
+	}
+
+	k_mutex_unlock(&aio_lock);
+
+	if (notify != NULL) {
+		aio_list_put(notify);
+	}
+
+	if (mode == LIO_WAIT) {
+		(void)k_mutex_lock(&aio_lock, K_FOREVER);
+
+		for (int i = 0; i < nent; i++) {
+			while (list[i] != NULL && list[i]->aio_lio_opcode != LIO_NOP &&
+			       list[i]->_aio_error == EINPROGRESS) {
+				(void)k_condvar_wait(&aio_cond, &aio_lock, K_FOREVER);
+			}
+
+			if (list[i] != NULL && list[i]->aio_lio_opcode != LIO_NOP &&
+			    list[i]->_aio_error != 0) {
+				ret = -1;
+			}
+		}
+
+		k_mutex_unlock(&aio_lock);
+
+		if (ret < 0) {
+			errno = EIO;
+		}
+	} else if (ret < 0) {
+		errno = EAGAIN;
+	}
+
+	return ret;
+}
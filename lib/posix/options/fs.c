@@ -148,6 +148,44 @@ static int fs_close_vmeth(void *obj)
 	return rc;
 }
 
+/*
+ * Reads or writes at an offset, leaving the position of the file where it
+ * was, like pread() and pwrite(). The caller holds the lock of the file
+ * descriptor. Writes to a file opened with O_APPEND still go to its end, as
+ * file systems move there before each write.
+ */
+static int fs_prw(struct posix_fs_desc *ptr, bool is_write, void *buf, size_t count,
+		  size_t offset)
+{
+	off_t pos = fs_tell(&ptr->file);
+	int rc;
+	int ret;
+
+	if (pos < 0) {
+		return pos;
+	}
+
+	count = MIN(count, INT_MAX);
+
+	rc = fs_seek(&ptr->file, (off_t)offset, FS_SEEK_SET);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (is_write) {
+		rc = fs_write(&ptr->file, buf, count);
+	} else {
+		rc = fs_read(&ptr->file, buf, count);
+	}
+
+	ret = fs_seek(&ptr->file, pos, FS_SEEK_SET);
+	if ((rc >= 0) && (ret < 0)) {
+		rc = ret;
+	}
+
+	return rc;
+}
+
 static int fs_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 {
 	int rc = 0;
@@ -171,6 +209,19 @@ static int fs_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		}
 		break;
 	}
+	case ZFD_IOCTL_PREAD:
+	case ZFD_IOCTL_PWRITE: {
+		void *buf;
+		size_t count;
+		size_t offset;
+
+		buf = va_arg(args, void *);
+		count = va_arg(args, size_t);
+		offset = va_arg(args, size_t);
+
+		rc = fs_prw(ptr, request == ZFD_IOCTL_PWRITE, buf, count, offset);
+		break;
+	}
 	case ZFD_IOCTL_TRUNCATE: {
 		off_t length;
 
@@ -520,12 +520,109 @@ static bool equivalent_types(enum json_tokens type1, enum json_tokens type2)
 		return true;
 	}
 
+	if (type1 == JSON_TOK_OBJECT_START && type2 == JSON_TOK_KEYED_OBJECT) {
+		return true;
+	}
+
 	return type1 == type2;
 }
 
+enum {
+	KEY_TABLE_EMPTY,
+	KEY_TABLE_FILLING,
+	KEY_TABLE_READY,
+};
+
+/* FNV-1a */
+static uint32_t key_hash(const char *key, size_t len)
+{
+	uint32_t hash = 2166136261U;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= (uint8_t)key[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static bool key_matches(const struct json_obj_descr *descr, const char *key,
+			size_t key_len)
+{
+	return key_len == descr->field_name_len &&
+	       memcmp(key, descr->field_name, key_len) == 0;
+}
+
+/* Open addressing with linear probing. The table has at least twice as many
+ * slots as descriptors, so it never fills up. Like obj_parse(), the first
+ * descriptor of a field name wins.
+ */
+static void key_table_fill(struct json_obj_key_table *table)
+{
+	size_t mask = table->num_slots - 1;
+	const struct json_obj_descr *descr;
+	size_t slot;
+
+	for (size_t i = 0; i < table->descr_len; i++) {
+		descr = &table->descr[i];
+		slot = key_hash(descr->field_name, descr->field_name_len) & mask;
+
+		while (table->slots[slot] != 0U &&
+		       !key_matches(&table->descr[table->slots[slot] - 1U],
+				    descr->field_name, descr->field_name_len)) {
+			slot = (slot + 1) & mask;
+		}
+
+		if (table->slots[slot] == 0U) {
+			table->slots[slot] = i + 1U;
+		}
+	}
+}
+
+/* Returns the index of the descriptor of @a key, or -1 */
+static int key_table_lookup(struct json_obj_key_table *table, const char *key,
+			    size_t key_len)
+{
+	size_t mask = table->num_slots - 1;
+	size_t slot;
+	int i;
+
+	if (atomic_get(&table->state) != KEY_TABLE_READY) {
+		if (atomic_cas(&table->state, KEY_TABLE_EMPTY, KEY_TABLE_FILLING)) {
+			key_table_fill(table);
+			atomic_set(&table->state, KEY_TABLE_READY);
+		} else {
+			/* Being filled by another thread, scan the descriptors */
+			for (i = 0; i < table->descr_len; i++) {
+				if (key_matches(&table->descr[i], key, key_len)) {
+					return i;
+				}
+			}
+
+			return -1;
+		}
+	}
+
+	slot = key_hash(key, key_len) & mask;
+
+	while (table->slots[slot] != 0U) {
+		i = table->slots[slot] - 1U;
+
+		if (key_matches(&table->descr[i], key, key_len)) {
+			return i;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return -1;
+}
+
 static int64_t obj_parse(struct json_obj *obj,
 			 const struct json_obj_descr *descr, size_t descr_len,
 			 void *val);
+static int obj_parse_keyed(struct json_obj *obj, struct json_obj_key_table *table,
+			   void *val, uint32_t *decoded_fields);
 static int arr_parse(struct json_obj *obj,
 		     const struct json_obj_descr *elem_descr,
 		     size_t max_elements, void *field, void *val);
@@ -546,6 +643,8 @@ static int64_t decode_value(struct json_obj *obj,
 		return obj_parse(obj, descr->object.sub_descr,
 				 descr->object.sub_descr_len,
 				 field);
+	case JSON_TOK_KEYED_OBJECT:
+		return obj_parse_keyed(obj, descr->keyed.table, field, NULL);
 	case JSON_TOK_ARRAY_START:
 		return arr_parse(obj, descr->array.element_descr,
 				 descr->array.n_elements, field, val);
@@ -600,6 +699,25 @@ static int64_t decode_value(struct json_obj *obj,
 	}
 }
 
+static ptrdiff_t get_elem_size(const struct json_obj_descr *descr);
+
+static ptrdiff_t get_obj_size(const struct json_obj_descr *descr, size_t descr_len)
+{
+	ptrdiff_t total = 0;
+	uint32_t align_shift = 0;
+	size_t i;
+
+	for (i = 0; i < descr_len; i++) {
+		total += get_elem_size(&descr[i]);
+
+		if (descr[i].align_shift > align_shift) {
+			align_shift = descr[i].align_shift;
+		}
+	}
+
+	return ROUND_UP(total, 1 << align_shift);
+}
+
 static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
 {
 	switch (descr->type) {
@@ -629,21 +747,10 @@ static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
 
 		return size;
 	}
-	case JSON_TOK_OBJECT_START: {
-		ptrdiff_t total = 0;
-		uint32_t align_shift = 0;
-		size_t i;
-
-		for (i = 0; i < descr->object.sub_descr_len; i++) {
-			total += get_elem_size(&descr->object.sub_descr[i]);
-
-			if (descr->object.sub_descr[i].align_shift > align_shift) {
-				align_shift = descr->object.sub_descr[i].align_shift;
-			}
-		}
-
-		return ROUND_UP(total, 1 << align_shift);
-	}
+	case JSON_TOK_OBJECT_START:
+		return get_obj_size(descr->object.sub_descr, descr->object.sub_descr_len);
+	case JSON_TOK_KEYED_OBJECT:
+		return get_obj_size(descr->keyed.table->descr, descr->keyed.table->descr_len);
 	default:
 		return -EINVAL;
 	}
@@ -792,6 +899,50 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 	return -EINVAL;
 }
 
+static int obj_parse_keyed(struct json_obj *obj, struct json_obj_key_table *table,
+			   void *val, uint32_t *decoded_fields)
+{
+	uint32_t decoded[Z_JSON_KEYED_FIELDS_WORDS] = { 0 };
+	const struct json_obj_descr *descr;
+	struct json_obj_key_value kv;
+	int ret;
+	int i;
+
+	while (!obj_next(obj, &kv)) {
+		if (kv.value.type == JSON_TOK_OBJECT_END) {
+			if (decoded_fields != NULL) {
+				memcpy(decoded_fields, decoded,
+				       DIV_ROUND_UP(table->descr_len, 32) * sizeof(uint32_t));
+			}
+
+			return 0;
+		}
+
+		i = key_table_lookup(table, kv.key, kv.key_len);
+
+		/* Skip field, if no descriptor was found or it has been decoded already */
+		if (i < 0 || (decoded[i / 32] & BIT(i % 32)) != 0U) {
+			ret = skip_field(obj, &kv);
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
+		}
+
+		descr = &table->descr[i];
+
+		ret = decode_value(obj, descr, &kv.value, (char *)val + descr->offset, val);
+		if (ret < 0) {
+			return ret;
+		}
+
+		decoded[i / 32] |= BIT(i % 32);
+	}
+
+	return -EINVAL;
+}
+
 int64_t json_obj_parse(char *payload, size_t len,
 		       const struct json_obj_descr *descr, size_t descr_len,
 		       void *val)
@@ -809,6 +960,25 @@ int64_t json_obj_parse(char *payload, size_t len,
 	return obj_parse(&obj, descr, descr_len, val);
 }
 
+int json_obj_parse_keyed(char *json, size_t len, struct json_obj_key_table *table,
+			 void *val, uint32_t *decoded_fields)
+{
+	struct json_obj obj;
+	int ret;
+
+	if (decoded_fields != NULL) {
+		memset(decoded_fields, 0,
+		       DIV_ROUND_UP(table->descr_len, 32) * sizeof(uint32_t));
+	}
+
+	ret = obj_init(&obj, json, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return obj_parse_keyed(&obj, table, val, decoded_fields);
+}
+
 int json_arr_parse(char *payload, size_t len,
 		   const struct json_obj_descr *descr, void *val)
 {
@@ -856,6 +1026,747 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+/* The incremental parser lexes one byte at a time, keeping the partial
+ * token in struct json_stream, and replaces the recursion of obj_parse()
+ * and arr_parse() with a stack of frames. Unknown values are skipped by
+ * counting brackets, like skip_field() does.
+ */
+enum {
+	STREAM_LEX_NONE,
+	STREAM_LEX_STRING,
+	STREAM_LEX_ESCAPE,
+	STREAM_LEX_NUMBER,
+	STREAM_LEX_LITERAL,
+};
+
+/* Where the characters of the current string go */
+enum {
+	STREAM_SINK_NONE,
+	STREAM_SINK_TOK,
+	STREAM_SINK_BUF,
+};
+
+enum {
+	STREAM_EXPECT_KEY_OR_END,
+	STREAM_EXPECT_KEY,
+	STREAM_EXPECT_COLON,
+	STREAM_EXPECT_VALUE_OR_END,
+	STREAM_EXPECT_VALUE,
+	STREAM_EXPECT_COMMA_OR_END,
+};
+
+static inline struct json_stream_frame *stream_frame(struct json_stream *s)
+{
+	return &s->frames[s->depth - 1];
+}
+
+static int stream_buf_append(struct json_stream *s, char chr)
+{
+	if (s->buf_used >= s->buf_size) {
+		return -ENOMEM;
+	}
+
+	s->buf[s->buf_used++] = chr;
+
+	return 0;
+}
+
+/* A token longer than the buffer is flagged by a full tok_len */
+static void stream_tok_append(struct json_stream *s, char chr)
+{
+	if (s->tok_len < sizeof(s->tok)) {
+		s->tok[s->tok_len++] = chr;
+	}
+}
+
+static int stream_store(struct json_stream *s, char chr)
+{
+	switch (s->sink) {
+	case STREAM_SINK_TOK:
+		stream_tok_append(s, chr);
+		return 0;
+	case STREAM_SINK_BUF:
+		return stream_buf_append(s, chr);
+	default:
+		return 0;
+	}
+}
+
+static int stream_push_obj(struct json_stream *s, const struct json_obj_descr *descr,
+			   size_t descr_len, struct json_obj_key_table *table, void *val)
+{
+	struct json_stream_frame *frame;
+
+	if (s->depth == ARRAY_SIZE(s->frames)) {
+		return -ENOMEM;
+	}
+
+	frame = &s->frames[s->depth++];
+	frame->type = JSON_TOK_OBJECT_START;
+	frame->expect = STREAM_EXPECT_KEY_OR_END;
+	frame->descr = descr;
+	frame->val = val;
+	frame->obj.table = table;
+	frame->obj.descr_len = descr_len;
+	frame->obj.decoded_fields = 0;
+	if (table != NULL) {
+		memset(frame->obj.keyed_fields, 0, sizeof(frame->obj.keyed_fields));
+	}
+	frame->obj.field = -1;
+
+	return 0;
+}
+
+/* Same element bookkeeping as arr_parse() */
+static int stream_push_arr(struct json_stream *s, const struct json_obj_descr *descr,
+			   void *field, void *val)
+{
+	const struct json_obj_descr *elem_descr = descr->array.element_descr;
+	struct json_stream_frame *frame;
+	ptrdiff_t elem_size;
+
+	if (s->depth == ARRAY_SIZE(s->frames)) {
+		return -ENOMEM;
+	}
+
+	frame = &s->frames[s->depth++];
+	frame->arr.elements = (size_t *)((char *)val + elem_descr->offset);
+
+	/* For nested arrays, skip parent descriptor to get elements */
+	if (elem_descr->type == JSON_TOK_ARRAY_START) {
+		elem_descr = elem_descr->array.element_descr;
+	}
+
+	elem_size = get_elem_size(elem_descr);
+
+	__ASSERT_NO_MSG(elem_size > 0);
+
+	*frame->arr.elements = 0;
+	frame->type = JSON_TOK_ARRAY_START;
+	frame->expect = STREAM_EXPECT_VALUE_OR_END;
+	frame->descr = elem_descr;
+	frame->val = field;
+	frame->arr.end = (char *)field + elem_size * descr->array.n_elements;
+	frame->arr.elem_size = elem_size;
+
+	return 0;
+}
+
+/* Checks that a value may start here and finds out where it goes */
+static int stream_value_begin(struct json_stream *s)
+{
+	struct json_stream_frame *frame;
+
+	if (s->skip_depth > 0) {
+		return 0;
+	}
+
+	if (s->depth == 0) {
+		return -EINVAL;
+	}
+
+	frame = stream_frame(s);
+
+	if (frame->type == JSON_TOK_OBJECT_START) {
+		/* The key already picked the descriptor */
+		return frame->expect == STREAM_EXPECT_VALUE ? 0 : -EINVAL;
+	}
+
+	if (frame->expect != STREAM_EXPECT_VALUE &&
+	    frame->expect != STREAM_EXPECT_VALUE_OR_END) {
+		return -EINVAL;
+	}
+
+	if (frame->val == frame->arr.end) {
+		return -ENOSPC;
+	}
+
+	s->value_descr = frame->descr;
+	s->value_field = frame->val;
+
+	return 0;
+}
+
+static int stream_value_end(struct json_stream *s)
+{
+	struct json_stream_frame *frame = stream_frame(s);
+
+	if (frame->type == JSON_TOK_OBJECT_START) {
+		if (frame->obj.field < 0) {
+			/* Skipped value */
+		} else if (frame->obj.table != NULL) {
+			frame->obj.keyed_fields[frame->obj.field / 32] |=
+				BIT(frame->obj.field % 32);
+		} else {
+			frame->obj.decoded_fields |= (int64_t)1 << frame->obj.field;
+		}
+	} else {
+		(*frame->arr.elements)++;
+		frame->val = (char *)frame->val + frame->arr.elem_size;
+	}
+
+	frame->expect = STREAM_EXPECT_COMMA_OR_END;
+	s->value_descr = NULL;
+
+	return 0;
+}
+
+static int stream_decode(struct json_stream *s, enum json_tokens type,
+			 const struct json_obj_descr *descr, void *field)
+{
+	struct json_token token = {
+		.start = s->tok,
+		.end = s->tok + s->tok_len,
+	};
+
+	switch (descr->type) {
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE: {
+		bool *v = field;
+
+		*v = type == JSON_TOK_TRUE;
+
+		return 0;
+	}
+	case JSON_TOK_NUMBER:
+	case JSON_TOK_INT64:
+	case JSON_TOK_UINT64:
+		if (s->tok_len >= sizeof(s->tok)) {
+			return -EINVAL;
+		}
+
+		if (descr->type == JSON_TOK_INT64) {
+			return decode_int64(&token, field);
+		} else if (descr->type == JSON_TOK_UINT64) {
+			return decode_uint64(&token, field);
+		}
+
+		return decode_num(&token, field);
+	case JSON_TOK_FLOAT: {
+		struct json_obj_token *obj_token = field;
+
+		if (s->tok_len >= sizeof(s->tok)) {
+			return -EINVAL;
+		}
+
+		if (s->tok_len > s->buf_size - s->buf_used) {
+			return -ENOMEM;
+		}
+
+		obj_token->start = s->buf + s->buf_used;
+		obj_token->length = s->tok_len;
+		memcpy(obj_token->start, s->tok, s->tok_len);
+		s->buf_used += s->tok_len;
+
+		return 0;
+	}
+	case JSON_TOK_OPAQUE: {
+		struct json_obj_token *obj_token = field;
+
+		obj_token->start = s->buf + s->str_start;
+		obj_token->length = s->buf_used - s->str_start;
+
+		return 0;
+	}
+	case JSON_TOK_STRING: {
+		char **str = field;
+		int ret;
+
+		ret = stream_buf_append(s, '\0');
+		if (ret < 0) {
+			return ret;
+		}
+
+		*str = s->buf + s->str_start;
+
+		return 0;
+	}
+	default:
+		return -EINVAL;
+	}
+}
+
+static int stream_scalar(struct json_stream *s, enum json_tokens type)
+{
+	const struct json_obj_descr *descr = s->value_descr;
+	int ret;
+
+	if (s->skip_depth > 0) {
+		return 0;
+	}
+
+	/* Like obj_next() and arr_next(), reject null values */
+	if (type == JSON_TOK_NULL) {
+		return -EINVAL;
+	}
+
+	/* Otherwise a value of an unknown field */
+	if (descr != NULL) {
+		if (!equivalent_types(type, descr->type)) {
+			return -EINVAL;
+		}
+
+		ret = stream_decode(s, type, descr, s->value_field);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return stream_value_end(s);
+}
+
+static int stream_key(struct json_stream *s)
+{
+	struct json_stream_frame *frame = stream_frame(s);
+	const struct json_obj_descr *descr = frame->descr;
+
+	frame->obj.field = -1;
+	frame->expect = STREAM_EXPECT_COLON;
+	s->value_descr = NULL;
+
+	if (s->tok_len >= sizeof(s->tok)) {
+		return 0;
+	}
+
+	if (frame->obj.table != NULL) {
+		int i = key_table_lookup(frame->obj.table, s->tok, s->tok_len);
+
+		/* Field has been decoded already, skip */
+		if (i >= 0 && (frame->obj.keyed_fields[i / 32] & BIT(i % 32)) == 0U) {
+			frame->obj.field = i;
+			s->value_descr = &descr[i];
+			s->value_field = (char *)frame->val + descr[i].offset;
+		}
+
+		return 0;
+	}
+
+	for (size_t i = 0; i < frame->obj.descr_len; i++) {
+		/* Field has been decoded already, skip */
+		if (frame->obj.decoded_fields & ((int64_t)1 << i)) {
+			continue;
+		}
+
+		if (s->tok_len != descr[i].field_name_len ||
+		    memcmp(s->tok, descr[i].field_name, s->tok_len)) {
+			continue;
+		}
+
+		frame->obj.field = i;
+		s->value_descr = &descr[i];
+		s->value_field = (char *)frame->val + descr[i].offset;
+		break;
+	}
+
+	return 0;
+}
+
+static int stream_string_begin(struct json_stream *s)
+{
+	struct json_stream_frame *frame;
+	int ret;
+
+	s->lex = STREAM_LEX_STRING;
+	s->hex = 0;
+	s->sink = STREAM_SINK_NONE;
+
+	if (s->skip_depth > 0) {
+		return 0;
+	}
+
+	if (s->depth > 0) {
+		frame = stream_frame(s);
+
+		if (frame->type == JSON_TOK_OBJECT_START &&
+		    (frame->expect == STREAM_EXPECT_KEY_OR_END ||
+		     frame->expect == STREAM_EXPECT_KEY)) {
+			s->sink = STREAM_SINK_TOK;
+			s->tok_len = 0;
+			return 0;
+		}
+	}
+
+	ret = stream_value_begin(s);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Strings of any other type are rejected once complete */
+	if (s->value_descr != NULL &&
+	    (s->value_descr->type == JSON_TOK_STRING ||
+	     s->value_descr->type == JSON_TOK_OPAQUE)) {
+		s->sink = STREAM_SINK_BUF;
+		s->str_start = s->buf_used;
+	}
+
+	return 0;
+}
+
+static int stream_string_end(struct json_stream *s)
+{
+	if (s->skip_depth > 0) {
+		return 0;
+	}
+
+	if (s->sink == STREAM_SINK_TOK) {
+		return stream_key(s);
+	}
+
+	return stream_scalar(s, JSON_TOK_STRING);
+}
+
+static int stream_open(struct json_stream *s, char chr)
+{
+	const struct json_obj_descr *descr;
+	struct json_stream_frame *frame;
+	void *val;
+	int ret;
+
+	if (s->skip_depth > 0) {
+		if (s->skip_depth == UINT16_MAX) {
+			return -ENOMEM;
+		}
+
+		s->skip_depth++;
+		return 0;
+	}
+
+	/* The top level object, set up by json_stream_init() */
+	if (s->depth == 0) {
+		if (chr != JSON_TOK_OBJECT_START) {
+			return -EINVAL;
+		}
+
+		s->depth = 1;
+		return 0;
+	}
+
+	ret = stream_value_begin(s);
+	if (ret < 0) {
+		return ret;
+	}
+
+	descr = s->value_descr;
+	if (descr == NULL) {
+		s->skip_depth = 1;
+		return 0;
+	}
+
+	if (!equivalent_types((enum json_tokens)chr, descr->type)) {
+		return -EINVAL;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_OBJECT_START:
+		return stream_push_obj(s, descr->object.sub_descr,
+				       descr->object.sub_descr_len, NULL, s->value_field);
+	case JSON_TOK_KEYED_OBJECT:
+		return stream_push_obj(s, descr->keyed.table->descr,
+				       descr->keyed.table->descr_len, descr->keyed.table,
+				       s->value_field);
+	case JSON_TOK_ARRAY_START:
+		/* Elements of arrays hold the length of their nested arrays */
+		frame = stream_frame(s);
+		val = frame->type == JSON_TOK_OBJECT_START ? frame->val : s->value_field;
+
+		return stream_push_arr(s, descr, s->value_field, val);
+	case JSON_TOK_OBJ_ARRAY:
+		/* Copy the array as is, from here to the matching bracket */
+		s->str_start = s->buf_used;
+		s->capture = true;
+		s->skip_depth = 1;
+
+		return stream_buf_append(s, chr);
+	default:
+		return -EINVAL;
+	}
+}
+
+static int stream_close(struct json_stream *s, char chr)
+{
+	struct json_stream_frame *frame;
+
+	if (s->skip_depth > 0) {
+		if (--s->skip_depth > 0) {
+			return 0;
+		}
+
+		if (s->capture) {
+			struct json_obj_token *obj_token = s->value_field;
+
+			obj_token->start = s->buf + s->str_start;
+			obj_token->length = s->buf_used - s->str_start;
+			s->capture = false;
+		}
+
+		return stream_value_end(s);
+	}
+
+	if (s->depth == 0) {
+		return -EINVAL;
+	}
+
+	frame = stream_frame(s);
+
+	if (chr == JSON_TOK_OBJECT_END) {
+		if (frame->type != JSON_TOK_OBJECT_START ||
+		    (frame->expect != STREAM_EXPECT_KEY_OR_END &&
+		     frame->expect != STREAM_EXPECT_COMMA_OR_END)) {
+			return -EINVAL;
+		}
+	} else {
+		if (frame->type != JSON_TOK_ARRAY_START ||
+		    (frame->expect != STREAM_EXPECT_VALUE_OR_END &&
+		     frame->expect != STREAM_EXPECT_COMMA_OR_END)) {
+			return -EINVAL;
+		}
+	}
+
+	if (--s->depth == 0) {
+		s->done = true;
+		return 0;
+	}
+
+	return stream_value_end(s);
+}
+
+static int stream_punct(struct json_stream *s, char chr)
+{
+	struct json_stream_frame *frame;
+
+	if (s->skip_depth > 0) {
+		return 0;
+	}
+
+	if (s->depth == 0) {
+		return -EINVAL;
+	}
+
+	frame = stream_frame(s);
+
+	if (chr == JSON_TOK_COLON) {
+		if (frame->expect != STREAM_EXPECT_COLON) {
+			return -EINVAL;
+		}
+
+		frame->expect = STREAM_EXPECT_VALUE;
+		return 0;
+	}
+
+	if (frame->expect != STREAM_EXPECT_COMMA_OR_END) {
+		return -EINVAL;
+	}
+
+	frame->expect = frame->type == JSON_TOK_OBJECT_START ?
+			STREAM_EXPECT_KEY : STREAM_EXPECT_VALUE;
+
+	return 0;
+}
+
+static int stream_literal_begin(struct json_stream *s, char chr)
+{
+	int ret;
+
+	ret = stream_value_begin(s);
+	if (ret < 0) {
+		return ret;
+	}
+
+	switch (chr) {
+	case 't':
+		s->literal = "rue";
+		break;
+	case 'f':
+		s->literal = "alse";
+		break;
+	default:
+		s->literal = "ull";
+		break;
+	}
+
+	/* Remember which literal it is */
+	s->tok[0] = chr;
+	s->lex = STREAM_LEX_LITERAL;
+
+	return 0;
+}
+
+static int stream_number_end(struct json_stream *s)
+{
+	s->lex = STREAM_LEX_NONE;
+
+	/* A minus sign must be followed by digits */
+	if (s->tok_len == 1 && s->tok[0] == '-') {
+		return -EINVAL;
+	}
+
+	return stream_scalar(s, JSON_TOK_NUMBER);
+}
+
+static int stream_byte(struct json_stream *s, char chr)
+{
+	int ret;
+
+	switch (s->lex) {
+	case STREAM_LEX_STRING:
+		if (s->hex > 0) {
+			if (isxdigit((unsigned char)chr) == 0) {
+				return -EINVAL;
+			}
+
+			s->hex--;
+			return stream_store(s, chr);
+		}
+
+		if (chr == '"') {
+			s->lex = STREAM_LEX_NONE;
+			return stream_string_end(s);
+		}
+
+		if (chr == '\\') {
+			s->lex = STREAM_LEX_ESCAPE;
+		} else if (chr == '\0') {
+			return -EINVAL;
+		}
+
+		return stream_store(s, chr);
+	case STREAM_LEX_ESCAPE:
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			break;
+		case 'u':
+			s->hex = 4;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		s->lex = STREAM_LEX_STRING;
+		return stream_store(s, chr);
+	case STREAM_LEX_LITERAL:
+		if (chr != *s->literal) {
+			return -EINVAL;
+		}
+
+		if (*++s->literal != '\0') {
+			return 0;
+		}
+
+		s->lex = STREAM_LEX_NONE;
+		return stream_scalar(s, (enum json_tokens)s->tok[0]);
+	case STREAM_LEX_NUMBER:
+		if (isdigit((unsigned char)chr) != 0 || chr == '.') {
+			stream_tok_append(s, chr);
+			return 0;
+		}
+
+		ret = stream_number_end(s);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The character after the number starts the next token */
+		break;
+	default:
+		break;
+	}
+
+	switch (chr) {
+	case '{':
+	case '[':
+		return stream_open(s, chr);
+	case '}':
+	case ']':
+		return stream_close(s, chr);
+	case ',':
+	case ':':
+		return stream_punct(s, chr);
+	case '"':
+		return stream_string_begin(s);
+	case 't':
+	case 'f':
+	case 'n':
+		return stream_literal_begin(s, chr);
+	default:
+		if (isspace((unsigned char)chr) != 0) {
+			return 0;
+		}
+
+		if (isdigit((unsigned char)chr) != 0 || chr == '-') {
+			ret = stream_value_begin(s);
+			if (ret < 0) {
+				return ret;
+			}
+
+			s->tok[0] = chr;
+			s->tok_len = 1;
+			s->lex = STREAM_LEX_NUMBER;
+
+			return 0;
+		}
+
+		return -EINVAL;
+	}
+}
+
+int json_stream_init(struct json_stream *stream, const struct json_obj_descr *descr,
+		     size_t descr_len, void *val, char *buf, size_t buf_size)
+{
+	if (descr_len >= (sizeof(int64_t) * CHAR_BIT - 1)) {
+		return -EINVAL;
+	}
+
+	memset(stream, 0, sizeof(*stream));
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+
+	/* Only entered once the opening brace shows up */
+	(void)stream_push_obj(stream, descr, descr_len, NULL, val);
+	stream->depth = 0;
+
+	return 0;
+}
+
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len)
+{
+	for (size_t i = 0; i < len && stream->error == 0 && !stream->done; i++) {
+		if (stream->capture) {
+			stream->error = stream_buf_append(stream, data[i]);
+			if (stream->error < 0) {
+				break;
+			}
+		}
+
+		stream->error = stream_byte(stream, data[i]);
+	}
+
+	if (stream->error < 0) {
+		return stream->error;
+	}
+
+	return stream->done ? 1 : 0;
+}
+
+int64_t json_stream_finish(struct json_stream *stream)
+{
+	if (stream->error < 0) {
+		return stream->error;
+	}
+
+	if (!stream->done) {
+		return -EINVAL;
+	}
+
+	return stream->frames[0].obj.decoded_fields;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -1148,6 +2059,10 @@ static int encode(const struct json_obj_descr *descr, const void *val,
 		return json_obj_encode(descr->object.sub_descr,
 				       descr->object.sub_descr_len,
 				       ptr, append_bytes, data);
+	case JSON_TOK_KEYED_OBJECT:
+		return json_obj_encode(descr->keyed.table->descr,
+				       descr->keyed.table->descr_len,
+				       ptr, append_bytes, data);
 	case JSON_TOK_NUMBER:
 		return num_encode(ptr, append_bytes, data);
 	case JSON_TOK_INT64:
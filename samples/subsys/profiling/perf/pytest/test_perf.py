@@ -6,13 +6,24 @@
 
 import logging
 import re
+import time
+from pathlib import Path
 
+import pytest
 from twister_harness import DeviceAdapter, Shell
+from twister_harness.helpers.utils import find_in_config
 
 logger = logging.getLogger(__name__)
 
 
+def perf_aggregate(dut: DeviceAdapter) -> bool:
+    config = Path(dut.device_config.app_build_dir) / 'zephyr' / '.config'
+    return find_in_config(config, 'CONFIG_PROFILING_PERF_AGGREGATE') == 'y'
+
+
 def test_shell_perf(dut: DeviceAdapter, shell: Shell):
+    if perf_aggregate(dut):
+        pytest.skip('perf printbuf is replaced by perf folded')
 
     shell.base_timeout=10
 
@@ -36,3 +47,40 @@ def test_shell_perf(dut: DeviceAdapter, shell: Shell):
     while i < length:
         i += int(lines[i], 16) + 1
         assert i <= length, 'one of the samples is not true to size'
+
+
+def test_shell_perf_folded(dut: DeviceAdapter, shell: Shell):
+    if not perf_aggregate(dut):
+        pytest.skip('perf folded requires CONFIG_PROFILING_PERF_AGGREGATE')
+
+    shell.base_timeout=10
+
+    logger.info('send "perf start 99" command')
+    lines = shell.exec_command('perf start 99')
+    assert 'Enabled perf' in lines, 'expected response not found'
+
+    time.sleep(1)
+
+    logger.info('send "perf stop" command')
+    lines = shell.exec_command('perf stop')
+    if not any('Perf done!' in line for line in lines):
+        dut.readlines_until(regex='.*Perf done!', print_output=True)
+    logger.info('response is valid')
+
+    logger.info('send "perf info" command')
+    lines = shell.exec_command('perf info')
+    match = next(filter(None, (re.match(r"Perf samples: (\d+), lost: (\d+)", line)
+                               for line in lines)), None)
+    assert match is not None, 'expected response not found'
+    samples = int(match.group(1))
+    assert samples != 0, 'no sample'
+
+    logger.info('send "perf folded" command')
+    lines = shell.exec_command('perf folded')
+    stacks = [re.match(r"(\S.*) (\d+)$", line) for line in lines]
+    stacks = [stack for stack in stacks if stack is not None]
+    assert len(stacks) != 0, 'no stack'
+    assert sum(int(stack.group(2)) for stack in stacks) == samples, \
+        'sample counts do not add up'
+    assert any('func_0' in stack.group(1).split(';') for stack in stacks), \
+        'sampled functions not found'
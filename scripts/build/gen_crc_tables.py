@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the slice-by-N lookup tables of lib/crc as const arrays, so that
+they are placed in ROM instead of being computed in RAM at run time.
+
+Table k holds the CRC of byte n followed by k zero bytes, for the
+reflected polynomials of crc32_ieee(), crc32_c() and crc16_ccitt().
+"""
+
+import argparse
+import os
+
+# Name, reflected polynomial and width in bits of each table set
+CRCS = [
+    ('crc32_ieee_slice_tables', 0xEDB88320, 32),
+    ('crc32c_slice_tables', 0x82F63B78, 32),
+    ('crc16_ccitt_slice_tables', 0x8408, 16),
+]
+
+
+def front_matter(slices):
+    return f'''/*
+ * This file is generated by {os.path.basename(__file__)} --slices {slices}
+ */
+
+#include <stdint.h>
+'''
+
+
+def slice_tables(poly, slices):
+    tables = [[0] * 256 for _ in range(slices)]
+
+    for n in range(256):
+        crc = n
+        for _ in range(8):
+            crc = (crc >> 1) ^ (poly if crc & 1 else 0)
+        tables[0][n] = crc
+
+    for k in range(1, slices):
+        for n in range(256):
+            crc = tables[k - 1][n]
+            tables[k][n] = (crc >> 8) ^ tables[0][crc & 0xFF]
+
+    return tables
+
+
+def gen_crc_tables(slices, output):
+    os.makedirs(os.path.dirname(output), exist_ok=True)
+
+    with open(output, 'w') as outf:
+        print(front_matter(slices), file=outf)
+
+        for name, poly, width in CRCS:
+            digits = width // 4
+            per_line = 8 if width == 16 else 4
+
+            print(f'const uint{width}_t {name}[{slices}][256] = {{', file=outf)
+            for table in slice_tables(poly, slices):
+                print('\t{', file=outf)
+                for i in range(0, 256, per_line):
+                    values = ', '.join(f'0x{v:0{digits}x}U' for v in table[i:i + per_line])
+                    print(f'\t\t{values},', file=outf)
+                print('\t},', file=outf)
+            print('};\n', file=outf)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(allow_abbrev=False)
+    parser.add_argument(
+        '-s',
+        '--slices',
+        dest='slices',
+        type=int,
+        choices=[4, 8],
+        required=True,
+        help='number of bytes processed per iteration')
+    parser.add_argument(
+        '-o',
+        '--output',
+        dest='output',
+        required=True,
+        help='output file (e.g. build/zephyr/include/generated/crc/crc_tables.c)')
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    gen_crc_tables(args.slices, args.output)
+
+
+if __name__ == '__main__':
+    main()
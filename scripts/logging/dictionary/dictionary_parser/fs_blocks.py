@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Decoder of the compressed log files written by the file system backend
+
+With CONFIG_LOG_BACKEND_FS_COMPRESS, the log files are a sequence of
+blocks, each made of an 8-byte header followed by the block data:
+
+- 2 bytes: magic, "ZL"
+- 1 byte: 0 if the data is stored as is, 1 if it is LZ4 compressed
+- 1 byte: reserved
+- 2 bytes: little endian length of the decompressed data
+- 2 bytes: little endian length of the data following the header
+"""
+
+import logging
+import struct
+
+BLOCK_MAGIC = b"ZL"
+BLOCK_HDR_FMT = "<2sBBHH"
+BLOCK_HDR_SIZE = struct.calcsize(BLOCK_HDR_FMT)
+BLOCK_STORED = 0
+BLOCK_LZ4 = 1
+
+logger = logging.getLogger("parser")
+
+
+def lz4_block_decompress(data, raw_len):
+    """Decompress data in the LZ4 block format"""
+    out = bytearray()
+    idx = 0
+
+    while idx < len(data):
+        token = data[idx]
+        idx += 1
+
+        lit_len = token >> 4
+        if lit_len == 15:
+            while True:
+                length = data[idx]
+                idx += 1
+                lit_len += length
+                if length != 255:
+                    break
+
+        out += data[idx:idx + lit_len]
+        idx += lit_len
+
+        # The last sequence only has literals
+        if idx >= len(data):
+            break
+
+        offset = data[idx] | (data[idx + 1] << 8)
+        idx += 2
+        if offset == 0 or offset > len(out):
+            raise ValueError(f"invalid match offset {offset}")
+
+        match_len = token & 0xF
+        if match_len == 15:
+            while True:
+                length = data[idx]
+                idx += 1
+                match_len += length
+                if length != 255:
+                    break
+        match_len += 4
+
+        # The match may overlap the bytes it produces
+        start = len(out) - offset
+        for i in range(match_len):
+            out.append(out[start + i])
+
+    if len(out) != raw_len:
+        raise ValueError(f"decompressed {len(out)} bytes instead of {raw_len}")
+
+    return bytes(out)
+
+
+def decode_blocks(data):
+    """
+    Decode the blocks of a compressed log file and return the log data.
+
+    Blocks which cannot be decoded, for example the last one written before
+    a power loss, are skipped up to the next block header.
+    """
+    logdata = b''
+    idx = 0
+
+    while idx + BLOCK_HDR_SIZE <= len(data):
+        magic, block_type, _, raw_len, data_len = \
+            struct.unpack_from(BLOCK_HDR_FMT, data, idx)
+        block = data[idx + BLOCK_HDR_SIZE:idx + BLOCK_HDR_SIZE + data_len]
+
+        try:
+            if magic != BLOCK_MAGIC or len(block) != data_len:
+                raise ValueError("invalid block header")
+
+            if block_type == BLOCK_STORED and raw_len == data_len:
+                logdata += block
+            elif block_type == BLOCK_LZ4:
+                logdata += lz4_block_decompress(block, raw_len)
+            else:
+                raise ValueError(f"invalid block type {block_type}")
+        except (ValueError, IndexError) as e:
+            logger.warning("WARNING: skipping corrupted block at offset %d: %s", idx, e)
+            idx = data.find(BLOCK_MAGIC, idx + 1)
+            if idx < 0:
+                break
+            continue
+
+        idx += BLOCK_HDR_SIZE + data_len
+
+    return logdata
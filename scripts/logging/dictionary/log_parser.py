@@ -19,6 +19,7 @@ import sys
 
 import dictionary_parser
 import parserlib
+from dictionary_parser.fs_blocks import decode_blocks
 
 LOGGER_FORMAT = "%(message)s"
 logger = logging.getLogger("parser")
@@ -31,18 +32,21 @@ def parse_args():
     argparser = argparse.ArgumentParser(allow_abbrev=False)
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", nargs="+",
+                           help="Log Data file(s), from the oldest to the newest")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--compressed", action="store_true",
+                           help="Log Data files are compressed by the file system backend")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
     return argparser.parse_args()
 
 
-def read_log_file(args):
+def read_log_file(args, logfile):
     """
     Read the log from file
     """
@@ -53,11 +57,11 @@ def read_log_file(args):
     if args.hex:
         if args.rawhex:
             # Simply log file with only hexadecimal data
-            logdata = dictionary_parser.utils.convert_hex_file_to_bin(args.logfile)
+            logdata = dictionary_parser.utils.convert_hex_file_to_bin(logfile)
         else:
             hexdata = ''
 
-            with open(args.logfile, "r", encoding="iso-8859-1") as hexfile:
+            with open(logfile, "r", encoding="iso-8859-1") as hexfile:
                 for line in hexfile.readlines():
                     hexdata += line.strip()
 
@@ -90,14 +94,17 @@ def read_log_file(args):
 
             logdata = binascii.unhexlify(hexdata[:idx])
     else:
-        logfile = open(args.logfile, "rb")
-        if not logfile:
-            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", args.logfile)
+        binfile = open(logfile, "rb")
+        if not binfile:
+            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", logfile)
             sys.exit(1)
 
-        logdata = logfile.read()
+        logdata = binfile.read()
 
-        logfile.close()
+        binfile.close()
+
+    if args.compressed:
+        logdata = decode_blocks(logdata)
 
     return logdata
 
@@ -112,10 +119,14 @@ def main():
     else:
         logger.setLevel(logging.INFO)
 
-    logdata = read_log_file(args)
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
-        sys.exit(1)
+    logdata = b''
+    for logfile in args.logfile:
+        filedata = read_log_file(args, logfile)
+        if filedata is None:
+            logger.error("ERROR: cannot read log from file: %s, exiting...", logfile)
+            sys.exit(1)
+
+        logdata += filedata
 
     parserlib.parser(logdata, args.dbfile, logger)
 
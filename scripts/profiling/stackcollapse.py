@@ -12,8 +12,12 @@ This translate stack samples captured by perf subsystem into format
 used by flamegraph.pl. Translation uses .elf file to get function names
 from addresses
 
+The input is either the output of perf printbuf, or the stacks aggregated
+with CONFIG_PROFILING_PERF_AGGREGATE, printed by perf folded, in which the
+addresses left unresolved on the target are translated.
+
 Usage:
-    ./script/perf/stackcollapse.py <file with perf printbuf output> <ELF file>
+    ./script/perf/stackcollapse.py <file with perf printbuf or folded output> <ELF file>
 """
 
 import re
@@ -54,12 +58,36 @@ def collapse(buf, elf):
         buf = buf[8 + 8 * count:]
 
 
+def resolve_folded(lines, elf):
+    for line in lines:
+        match = re.match(r"(\S.*) (\d+)$", line)
+        if match is None:
+            continue
+
+        funcs = match.group(1).split(";")
+        line = funcs[0]
+        prev_func = None
+        # the first element is the thread, the frames follow, outermost first
+        for func in funcs[1:]:
+            if func.startswith("0x"):
+                func = addr_to_sym(int(func, 16), elf)
+            if prev_func != func:
+                prev_func = func
+                line += ";" + func
+
+        print(line, match.group(2))
+
+
 if __name__ == "__main__":
     elf = ELFFile(open(sys.argv[2], "rb"))
     with open(sys.argv[1], "r") as f:
         inp = f.read()
 
     lines = inp.splitlines()
+    if not lines[0].startswith("Perf buf length"):
+        resolve_folded(lines, elf)
+        sys.exit(0)
+
     assert int(re.match(r"Perf buf length (\d+)", lines[0]).group(1)) == len(lines) - 1
     buf = binascii.unhexlify("".join(lines[1:]))
     collapse(buf, elf)
@@ -66,4 +66,37 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_COMPRESS
+	bool "Compress log files"
+	depends on LOG_BACKEND_FS_OUTPUT_DICTIONARY
+	help
+	  When enabled, the log output is gathered in blocks which are
+	  compressed in the LZ4 block format before being written to the log
+	  files, which reduces the amount of data written to the flash.
+	  A block is written when it is full, on panic, or after
+	  LOG_BACKEND_FS_COMPRESS_FLUSH_TIMEOUT once logging goes idle. The
+	  log files are decoded with the dictionary log parser using its
+	  --compressed option.
+
+config LOG_BACKEND_FS_COMPRESS_BLOCK_SIZE
+	int "Size of the compressed blocks"
+	depends on LOG_BACKEND_FS_COMPRESS
+	default 1024
+	range 64 32768
+	help
+	  Size of the log output gathered before compressing it (in bytes).
+	  Larger blocks compress better and are written less often. A
+	  compressed block must fit in a log file.
+
+config LOG_BACKEND_FS_COMPRESS_FLUSH_TIMEOUT
+	int "Flush timeout of the compressed blocks (in milliseconds)"
+	depends on LOG_BACKEND_FS_COMPRESS
+	default 1000
+	help
+	  Time after the log processing went idle before the complete
+	  messages of a block which is not full are written. This bounds the
+	  time a message can be lost on reset, while smaller blocks compress
+	  less well. Zero means that blocks are only written when they are
+	  full or on panic.
+
 endif # LOG_BACKEND_FS
@@ -10,7 +10,9 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_std.h>
 #include <assert.h>
+#include <string.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/sys/byteorder.h>
 
 #define MAX_PATH_LEN 256
 #define MAX_FLASH_WRITE_SIZE 256
@@ -136,7 +138,18 @@ static int check_log_file_exist(int num)
 	return rc;
 }
 
-int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+static void file_sync(void)
+{
+	if (backend_state == BACKEND_FS_OK) {
+		int rc = fs_sync(&fs_file);
+
+		if (rc != 0) {
+			backend_state = BACKEND_FS_CORRUPTED;
+		}
+	}
+}
+
+static int write_to_file(uint8_t *data, size_t length)
 {
 	int rc;
 	struct fs_file_t *f = &fs_file;
@@ -209,6 +222,266 @@ on_error:
 	return length;
 }
 
+#ifdef CONFIG_LOG_BACKEND_FS_COMPRESS
+/*
+ * The log output is gathered in blocks which are compressed in the LZ4 block
+ * format and written to the log files prefixed with a block header. A block
+ * ends on a message boundary whenever possible, so that each log file can be
+ * decoded on its own once the older ones are removed. The files are decoded
+ * with scripts/logging/dictionary/log_parser.py --compressed.
+ */
+#define BLOCK_SIZE CONFIG_LOG_BACKEND_FS_COMPRESS_BLOCK_SIZE
+#define BLOCK_HDR_SIZE 8
+#define BLOCK_MAGIC_0 'Z'
+#define BLOCK_MAGIC_1 'L'
+#define BLOCK_STORED 0
+#define BLOCK_LZ4 1
+
+/* LZ4 worst case, when the data cannot be compressed */
+#define LZ_BOUND(len) ((len) + (len) / 255 + 16)
+#define LZ_HASH_BITS 10
+#define LZ_MIN_MATCH 4
+/* Matches start 12 bytes and end 5 bytes before the end of the block at least */
+#define LZ_MF_LIMIT 12
+#define LZ_LAST_LITERALS 5
+
+BUILD_ASSERT(BLOCK_HDR_SIZE + LZ_BOUND(BLOCK_SIZE) <= CONFIG_LOG_BACKEND_FS_FILE_SIZE,
+	     "Compressed block does not fit in a log file.");
+
+static K_MUTEX_DEFINE(block_mutex);
+static uint8_t block_buf[BLOCK_SIZE];
+static uint8_t block_out[BLOCK_HDR_SIZE + LZ_BOUND(BLOCK_SIZE)];
+/* Position + 1 of the last occurrence of each hashed sequence */
+static uint16_t lz_table[1 << LZ_HASH_BITS];
+static size_t block_len;
+static size_t block_msg_end;
+
+static inline uint32_t lz_hash(const uint8_t *p)
+{
+	return (sys_get_le32(p) * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t *lz_put_length(uint8_t *op, size_t len)
+{
+	for (; len >= 255; len -= 255) {
+		*op++ = 255;
+	}
+	*op++ = len;
+
+	return op;
+}
+
+/* Output the literals and, if match_len is not 0, the match following them */
+static uint8_t *lz_put_sequence(uint8_t *op, const uint8_t *lit, size_t lit_len,
+				size_t offset, size_t match_len)
+{
+	uint8_t *token = op++;
+
+	*token = MIN(lit_len, 15) << 4;
+	if (lit_len >= 15) {
+		op = lz_put_length(op, lit_len - 15);
+	}
+
+	memcpy(op, lit, lit_len);
+	op += lit_len;
+
+	if (match_len != 0) {
+		sys_put_le16(offset, op);
+		op += 2;
+
+		match_len -= LZ_MIN_MATCH;
+		*token |= MIN(match_len, 15);
+		if (match_len >= 15) {
+			op = lz_put_length(op, match_len - 15);
+		}
+	}
+
+	return op;
+}
+
+/* Greedy LZ4 block compression, dst must hold LZ_BOUND(len) bytes */
+static size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst)
+{
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *end = src + len;
+	uint8_t *op = dst;
+
+	memset(lz_table, 0, sizeof(lz_table));
+
+	while (len > LZ_MF_LIMIT && ip < end - LZ_MF_LIMIT) {
+		uint32_t h = lz_hash(ip);
+		size_t pos = lz_table[h];
+		const uint8_t *mp = ip + LZ_MIN_MATCH;
+		const uint8_t *ref;
+
+		lz_table[h] = ip - src + 1;
+		if (pos == 0 || memcmp(&src[pos - 1], ip, LZ_MIN_MATCH) != 0) {
+			ip++;
+			continue;
+		}
+
+		ref = &src[pos - 1 + LZ_MIN_MATCH];
+		while (mp < end - LZ_LAST_LITERALS && *mp == *ref) {
+			mp++;
+			ref++;
+		}
+
+		op = lz_put_sequence(op, anchor, ip - anchor, mp - ref, mp - ip);
+		ip = mp;
+		anchor = mp;
+	}
+
+	op = lz_put_sequence(op, anchor, end - anchor, 0, 0);
+
+	return op - dst;
+}
+
+static void write_block(uint8_t *data, size_t length)
+{
+	int attempts = CONFIG_LOG_BACKEND_FS_FILES_LIMIT;
+
+	/* Nothing is written when the oldest log file is removed to make room */
+	while ((length > 0) && (attempts > 0)) {
+		int rc = write_to_file(data, length);
+
+		if (rc <= 0) {
+			attempts--;
+			continue;
+		}
+
+		data += rc;
+		length -= rc;
+	}
+}
+
+static void block_flush(void)
+{
+	size_t len = (block_msg_end > 0) ? block_msg_end : block_len;
+	size_t out_len = lz_compress(block_buf, len, &block_out[BLOCK_HDR_SIZE]);
+	uint8_t type = BLOCK_LZ4;
+
+	if (out_len >= len) {
+		memcpy(&block_out[BLOCK_HDR_SIZE], block_buf, len);
+		out_len = len;
+		type = BLOCK_STORED;
+	}
+
+	block_out[0] = BLOCK_MAGIC_0;
+	block_out[1] = BLOCK_MAGIC_1;
+	block_out[2] = type;
+	block_out[3] = 0;
+	sys_put_le16(len, &block_out[4]);
+	sys_put_le16(out_len, &block_out[6]);
+
+	write_block(block_out, BLOCK_HDR_SIZE + out_len);
+
+	/* Keep the start of the message which did not fit */
+	block_len -= len;
+	memmove(block_buf, &block_buf[len], block_len);
+	block_msg_end = 0;
+}
+
+static inline void block_lock(void)
+{
+	k_mutex_lock(&block_mutex, K_FOREVER);
+}
+
+static inline void block_unlock(void)
+{
+	k_mutex_unlock(&block_mutex);
+}
+
+/* Write the complete messages of a block which is not full yet */
+static void block_flush_timeout(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	block_lock();
+
+	if (block_msg_end > 0) {
+		block_flush();
+		file_sync();
+	}
+
+	block_unlock();
+}
+
+static K_WORK_DELAYABLE_DEFINE(block_flush_work, block_flush_timeout);
+
+/* Called once a complete message was output */
+static inline void block_msg_end_set(void)
+{
+	block_msg_end = block_len;
+}
+
+/* Called when the logging thread has no more messages to process */
+static void block_idle(void)
+{
+	if ((CONFIG_LOG_BACKEND_FS_COMPRESS_FLUSH_TIMEOUT > 0) && (block_msg_end > 0)) {
+		/* Not rescheduled when already pending, so that a steady
+		 * trickle of messages does not delay the write forever.
+		 */
+		(void)k_work_schedule(&block_flush_work,
+				      K_MSEC(CONFIG_LOG_BACKEND_FS_COMPRESS_FLUSH_TIMEOUT));
+	}
+}
+
+/* Write everything left in the block, including an incomplete message */
+static void block_flush_all(void)
+{
+	(void)k_work_cancel_delayable(&block_flush_work);
+
+	while (block_len > 0) {
+		block_flush();
+	}
+}
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len;
+
+	ARG_UNUSED(ctx);
+
+	if (block_len == sizeof(block_buf)) {
+		block_flush();
+	}
+
+	len = MIN(length, sizeof(block_buf) - block_len);
+	memcpy(&block_buf[block_len], data, len);
+	block_len += len;
+
+	return len;
+}
+#else
+static inline void block_msg_end_set(void)
+{
+}
+
+static inline void block_lock(void)
+{
+}
+
+static inline void block_unlock(void)
+{
+}
+
+static inline void block_idle(void)
+{
+}
+
+static inline void block_flush_all(void)
+{
+}
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	return write_to_file(data, length);
+}
+#endif /* CONFIG_LOG_BACKEND_FS_COMPRESS */
+
 static int get_log_file_id(struct fs_dirent *ent)
 {
 	size_t len;
@@ -441,6 +714,7 @@ static void panic(struct log_backend const *const backend)
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
+	block_flush_all();
 	log_backend_deactivate(backend);
 }
 
@@ -448,11 +722,16 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
+	block_lock();
+
 	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
 		log_dict_output_dropped_process(&log_output, cnt);
 	} else {
 		log_backend_std_dropped(&log_output, cnt);
 	}
+
+	block_msg_end_set();
+	block_unlock();
 }
 
 static void process(const struct log_backend *const backend,
@@ -462,7 +741,10 @@ static void process(const struct log_backend *const backend,
 
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
+	block_lock();
 	log_output_func(&log_output, &msg->log, flags);
+	block_msg_end_set();
+	block_unlock();
 }
 
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
@@ -475,13 +757,10 @@ static void notify(const struct log_backend *const backend, enum log_backend_evt
 		   union log_backend_evt_arg *arg)
 {
 	if (event == LOG_BACKEND_EVT_PROCESS_THREAD_DONE) {
-		if (backend_state == BACKEND_FS_OK) {
-			int rc = fs_sync(&fs_file);
-
-			if (rc != 0) {
-				backend_state = BACKEND_FS_CORRUPTED;
-			}
-		}
+		block_lock();
+		file_sync();
+		block_idle();
+		block_unlock();
 	}
 }
 
@@ -139,6 +139,20 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* The first CPU uses log_buffer, the other ones have their own buffer. Each
+ * buffer has a message pointer, so that z_log_msg_claim_oldest() merges them.
+ */
+#define NUM_CPU_BUFFERS (CONFIG_MP_MAX_NUM_CPUS - 1)
+
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_msg_ptr_cpu, NUM_CPU_BUFFERS);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       log_buffer_cpu, NUM_CPU_BUFFERS);
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	buf32_cpu[NUM_CPU_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+static atomic_t cpu_dropped_cnt[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -623,6 +637,12 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 void z_log_dropped(bool buffered)
 {
 	atomic_inc(&dropped_cnt);
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	unsigned int key = arch_irq_lock();
+
+	atomic_inc(&cpu_dropped_cnt[_current_cpu->id]);
+	arch_irq_unlock(key);
+#endif
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -649,6 +669,52 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < NUM_CPU_BUFFERS; i++) {
+		config.buf = buf32_cpu[i];
+		mpsc_pbuf_init(&log_buffer_cpu[i], &config);
+		log_msg_ptr_cpu[i].msg = NULL;
+	}
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		atomic_clear(&cpu_dropped_cnt[i]);
+	}
+#endif
+}
+
+/* Buffer of the CPU the caller runs on. The caller may migrate afterwards,
+ * the message is committed to the buffer it was allocated from.
+ */
+static struct mpsc_pbuf_buffer *local_log_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	unsigned int key = arch_irq_lock();
+	unsigned int id = _current_cpu->id;
+
+	arch_irq_unlock(key);
+
+	if (id > 0) {
+		return &log_buffer_cpu[id - 1];
+	}
+#endif
+
+	return &log_buffer;
+}
+
+static struct mpsc_pbuf_buffer *msg_buffer(struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < NUM_CPU_BUFFERS; i++) {
+		if (((uint32_t *)msg >= buf32_cpu[i]) &&
+		    ((uint32_t *)msg < &buf32_cpu[i][ARRAY_SIZE(buf32_cpu[i])])) {
+			return &log_buffer_cpu[i];
+		}
+	}
+#endif
+
+	return &log_buffer;
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -666,7 +732,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_log_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -698,7 +764,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -711,7 +777,9 @@ union log_msg_generic *z_log_msg_local_claim(void)
 
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+/* If there are buffers dedicated for each link or CPU, claim the oldest message (lowest
+ * timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
 	union log_msg_generic *msg = NULL;
@@ -785,7 +853,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -820,7 +889,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -902,6 +972,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < NUM_CPU_BUFFERS; i++) {
+		uint32_t cpu_size, cpu_usage;
+
+		mpsc_pbuf_get_utilization(&log_buffer_cpu[i], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#endif
+
 	return 0;
 }
 
@@ -913,7 +993,39 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	uint32_t cpu_max;
+	int err = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+
+	/* Sum of the maximums of each buffer, reached at different times */
+	for (int i = 0; (err == 0) && (i < NUM_CPU_BUFFERS); i++) {
+		err = mpsc_pbuf_get_max_utilization(&log_buffer_cpu[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
+}
+
+int log_cpu_dropped_get(unsigned int cpu, uint32_t *cnt)
+{
+	__ASSERT_NO_MSG(cnt != NULL);
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (cpu >= CONFIG_MP_MAX_NUM_CPUS) {
+		return -EINVAL;
+	}
+
+	*cnt = (uint32_t)atomic_get(&cpu_dropped_cnt[cpu]);
+
+	return 0;
+#else
+	ARG_UNUSED(cpu);
+
+	return -ENOTSUP;
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
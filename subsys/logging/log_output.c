@@ -16,6 +16,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -90,28 +91,68 @@ static int level_to_rfc5424_severity(uint32_t level)
 	return ret;
 }
 
-static int out_func(int c, void *ctx)
+/* Characters produced by cbprintf are gathered in a span and passed on at
+ * once. In deferred mode the span is the free part of the output buffer, in
+ * immediate mode it is on the stack of the logging context and is handed to
+ * the backend each time it fills up.
+ */
+struct out_span {
+	const struct log_output *output;
+	uint8_t *buf;
+	size_t size;
+	size_t len;
+#ifdef CONFIG_LOG_MODE_IMMEDIATE
+	uint8_t local[CONFIG_LOG_OUTPUT_IMMEDIATE_SPAN_SIZE];
+#endif
+};
+
+static void out_span_start(struct out_span *span, const struct log_output *output)
 {
-	const struct log_output *out_ctx = (const struct log_output *)ctx;
-	int idx;
+	span->output = output;
+	span->len = 0;
 
-	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
-		/* Backend must be thread safe in synchronous operation. */
-		/* Need that step for big endian */
-		char x = (char)c;
+#ifdef CONFIG_LOG_MODE_IMMEDIATE
+	span->buf = span->local;
+	span->size = sizeof(span->local);
+#else
+	if (output->control_block->offset == output->size) {
+		log_output_flush(output);
+	}
+
+	span->buf = &output->buf[output->control_block->offset];
+	span->size = output->size - output->control_block->offset;
+#endif
+}
 
-		out_ctx->func((uint8_t *)&x, 1, out_ctx->control_block->ctx);
-		return 0;
+static void out_span_end(struct out_span *span)
+{
+	const struct log_output *output = span->output;
+
+	if (span->len == 0) {
+		return;
 	}
 
-	if (out_ctx->control_block->offset == out_ctx->size) {
-		log_output_flush(out_ctx);
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		/* Backend must be thread safe in synchronous operation. */
+		log_output_write(output->func, span->buf, span->len, output->control_block->ctx);
+	} else {
+		atomic_add(&output->control_block->offset, span->len);
+		__ASSERT_NO_MSG(output->control_block->offset <= output->size);
 	}
 
-	idx = atomic_inc(&out_ctx->control_block->offset);
-	out_ctx->buf[idx] = (uint8_t)c;
+	span->len = 0;
+}
+
+static int out_func(int c, void *ctx)
+{
+	struct out_span *span = (struct out_span *)ctx;
+
+	if (span->len == span->size) {
+		out_span_end(span);
+		out_span_start(span, span->output);
+	}
 
-	__ASSERT_NO_MSG(out_ctx->control_block->offset <= out_ctx->size);
+	span->buf[span->len++] = (uint8_t)c;
 
 	return 0;
 }
@@ -126,15 +167,52 @@ static int cr_out_func(int c, void *ctx)
 	return 0;
 }
 
+/* Output of data which needs no formatting, in as few chunks as possible. */
+static void out_write(const struct log_output *output, const uint8_t *data, size_t len)
+{
+	struct log_output_control_block *cb = output->control_block;
+	size_t chunk;
+
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		/* Backend must be thread safe in synchronous operation. */
+		log_output_write(output->func, (uint8_t *)data, len, cb->ctx);
+		return;
+	}
+
+	while (len != 0) {
+		if (cb->offset == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(len, output->size - cb->offset);
+		memcpy(&output->buf[cb->offset], data, chunk);
+		atomic_add(&cb->offset, chunk);
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+static int print_str(const struct log_output *output, const char *str)
+{
+	size_t len = strlen(str);
+
+	out_write(output, (const uint8_t *)str, len);
+
+	return len;
+}
+
 static int print_formatted(const struct log_output *output,
 			   const char *fmt, ...)
 {
+	struct out_span span;
 	va_list args;
 	int length = 0;
 
+	out_span_start(&span, output);
 	va_start(args, fmt);
-	length = cbvprintf(out_func, (void *)output, fmt, args);
+	length = cbvprintf(out_func, &span, fmt, args);
 	va_end(args);
+	out_span_end(&span);
 
 	return length;
 }
@@ -277,7 +355,7 @@ static void color_print(const struct log_output *output,
 	if (color) {
 		const char *log_color = start && (colors[level] != NULL) ?
 				colors[level] : LOG_COLOR_CODE_DEFAULT;
-		print_formatted(output, "%s", log_color);
+		print_str(output, log_color);
 	}
 }
 
@@ -345,9 +423,9 @@ static void newline_print(const struct log_output *ctx, uint32_t flags)
 	}
 
 	if ((flags & LOG_OUTPUT_FLAG_CRLF_LFONLY) != 0U) {
-		print_formatted(ctx, "\n");
+		print_str(ctx, "\n");
 	} else {
-		print_formatted(ctx, "\r\n");
+		print_str(ctx, "\r\n");
 	}
 }
 
@@ -355,40 +433,53 @@ static void hexdump_line_print(const struct log_output *output,
 			       const uint8_t *data, uint32_t length,
 			       int prefix_offset, uint32_t flags)
 {
+	static const char hex[] = "0123456789abcdef";
+	/* Hexadecimal and character columns, each with a space every 8 bytes */
+	uint8_t line[4 * HEXDUMP_BYTES_IN_LINE + 1 + 2 * (HEXDUMP_BYTES_IN_LINE / 8 - 1)];
+	size_t pos = 0;
+
 	newline_print(output, flags);
 
-	for (int i = 0; i < prefix_offset; i++) {
-		print_formatted(output, " ");
+	while (prefix_offset > 0) {
+		size_t chunk = MIN((size_t)prefix_offset, sizeof(line));
+
+		memset(line, ' ', chunk);
+		out_write(output, line, chunk);
+		prefix_offset -= chunk;
 	}
 
 	for (int i = 0; i < HEXDUMP_BYTES_IN_LINE; i++) {
 		if (i > 0 && !(i % 8)) {
-			print_formatted(output, " ");
+			line[pos++] = ' ';
 		}
 
 		if (i < length) {
-			print_formatted(output, "%02x ", data[i]);
+			line[pos++] = hex[data[i] >> 4];
+			line[pos++] = hex[data[i] & 0xf];
 		} else {
-			print_formatted(output, "   ");
+			line[pos++] = ' ';
+			line[pos++] = ' ';
 		}
+		line[pos++] = ' ';
 	}
 
-	print_formatted(output, "|");
+	line[pos++] = '|';
 
 	for (int i = 0; i < HEXDUMP_BYTES_IN_LINE; i++) {
 		if (i > 0 && !(i % 8)) {
-			print_formatted(output, " ");
+			line[pos++] = ' ';
 		}
 
 		if (i < length) {
 			unsigned char c = (unsigned char)data[i];
 
-			print_formatted(output, "%c",
-			      isprint((int)c) != 0 ? c : '.');
+			line[pos++] = isprint((int)c) != 0 ? c : '.';
 		} else {
-			print_formatted(output, " ");
+			line[pos++] = ' ';
 		}
 	}
+
+	out_write(output, line, pos);
 }
 
 static void log_msg_hexdump(const struct log_output *output,
@@ -666,7 +757,12 @@ void log_output_process(const struct log_output *output,
 	}
 
 	if (package) {
-		int err = cbpprintf(cb, (void *)output, (void *)package);
+		struct out_span span;
+		int err;
+
+		out_span_start(&span, output);
+		err = cbpprintf(cb, &span, (void *)package);
+		out_span_end(&span);
 
 		(void)err;
 		__ASSERT_NO_MSG(err >= 0);
@@ -116,6 +116,106 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define CONN_HASH_BUCKETS CONFIG_NET_CONN_HASH_BUCKETS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONN_HASH_BUCKETS),
+	     "CONFIG_NET_CONN_HASH_BUCKETS must be a power of two");
+
+/* Connections with a remote address and both ports, by all of them */
+static sys_slist_t conn_hash_connected[CONN_HASH_BUCKETS];
+
+/* Other connections with a local port, by that port */
+static sys_slist_t conn_hash_bound[CONN_HASH_BUCKETS];
+
+/* Connections without a local port, and the ones which are not UDP or TCP */
+static sys_slist_t conn_hash_wild;
+
+static uint32_t conn_seq;
+
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t value)
+{
+	hash = (hash ^ value) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 15);
+}
+
+static sys_slist_t *conn_hash_bound_list(uint16_t proto, uint16_t local_port)
+{
+	uint32_t hash = conn_hash_mix(proto, local_port);
+
+	return &conn_hash_bound[hash & (CONN_HASH_BUCKETS - 1)];
+}
+
+static sys_slist_t *conn_hash_connected_list(uint16_t proto, uint8_t family,
+					     const uint8_t *remote_addr,
+					     uint16_t remote_port,
+					     uint16_t local_port)
+{
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) : sizeof(struct in_addr);
+	uint32_t hash = conn_hash_mix(proto, ((uint32_t)local_port << 16) | remote_port);
+
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash, UNALIGNED_GET((const uint32_t *)&remote_addr[i]));
+	}
+
+	return &conn_hash_connected[hash & (CONN_HASH_BUCKETS - 1)];
+}
+
+/* List of the connections with these end points, the ports are in network
+ * byte order. Identical connections are always in the same list.
+ */
+static sys_slist_t *conn_hash_list(uint16_t proto, uint8_t family,
+				   const struct sockaddr *remote_addr,
+				   uint16_t remote_port,
+				   uint16_t local_port)
+{
+	if ((family != AF_INET && family != AF_INET6 && family != AF_UNSPEC) ||
+	    local_port == 0) {
+		return &conn_hash_wild;
+	}
+
+	if (remote_addr != NULL && remote_port != 0) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == AF_INET6 &&
+		    !net_ipv6_is_addr_unspecified(&net_sin6(remote_addr)->sin6_addr)) {
+			return conn_hash_connected_list(
+				proto, AF_INET6, net_sin6(remote_addr)->sin6_addr.s6_addr,
+				remote_port, local_port);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    remote_addr->sa_family == AF_INET &&
+		    net_sin(remote_addr)->sin_addr.s_addr != 0) {
+			return conn_hash_connected_list(
+				proto, AF_INET, net_sin(remote_addr)->sin_addr.s4_addr,
+				remote_port, local_port);
+		}
+	}
+
+	return conn_hash_bound_list(proto, local_port);
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	conn->hash_list = conn_hash_list(conn->proto, conn->family,
+					 (conn->flags & NET_CONN_REMOTE_ADDR_SET) ?
+						&conn->remote_addr : NULL,
+					 net_sin(&conn->remote_addr)->sin_port,
+					 net_sin(&conn->local_addr)->sin_port);
+
+	sys_slist_prepend(conn->hash_list, &conn->hash_node);
+}
+
+static void conn_hash_remove(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +241,10 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+#if defined(CONFIG_NET_CONN_HASH)
+	conn->seq = conn_seq++;
+#endif
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -167,7 +271,14 @@ static struct net_conn *conn_find_handler(struct net_if *iface,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_t *list = conn_hash_list(proto, family, remote_addr,
+					   htons(remote_port), htons(local_port));
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, conn, tmp, hash_node) {
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+#endif
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -452,6 +563,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -476,9 +588,16 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The new remote end point may move the connection to another list */
+	conn_hash_remove(conn);
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -534,6 +653,124 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+/* Is the TCP/UDP connection matching the packet's addresses and ports? */
+static bool conn_ip_endpoints_match(struct net_conn *conn, struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && net_pkt_family(pkt) == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Same checks and priorities as the walk of all the connections in
+ * net_conn_input(), for a unicast UDP or TCP packet.
+ */
+static bool conn_hash_match(struct net_conn *conn, struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr, uint8_t proto,
+			    uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	if (conn->context != NULL &&
+	    net_context_is_bound_to_iface(conn->context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		return false; /* wrong interface */
+	}
+
+	if (conn->family != AF_UNSPEC && conn->family != pkt_family &&
+	    !(IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6) &&
+	      conn->family == AF_INET6 && pkt_family == AF_INET && !conn->v6only)) {
+		return false; /* wrong protocol family */
+	}
+
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	if (conn->family != AF_INET && conn->family != AF_INET6 &&
+	    conn->family != AF_UNSPEC) {
+		return false;
+	}
+
+	return conn_ip_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto,
+					 uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+	sys_slist_t *lists[] = {
+		conn_hash_connected_list(proto, pkt_family,
+					 pkt_family == AF_INET6 ? ip_hdr->ipv6->src :
+								  ip_hdr->ipv4->src,
+					 src_port, dst_port),
+		conn_hash_bound_list(proto, dst_port),
+		&conn_hash_wild,
+	};
+	struct net_conn *best_match = NULL;
+	struct net_conn *conn;
+
+	ARRAY_FOR_EACH(lists, i) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (!conn_hash_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+				continue;
+			}
+
+			/* The newest of the highest ranked connections wins, as
+			 * it comes first in the list of used connections.
+			 */
+			if (best_match == NULL ||
+			    NET_CONN_RANK(conn->flags) > NET_CONN_RANK(best_match->flags) ||
+			    (NET_CONN_RANK(conn->flags) == NET_CONN_RANK(best_match->flags) &&
+			     (int32_t)(conn->seq - best_match->seq) > 0)) {
+				best_match = conn;
+			}
+		}
+	}
+
+	return best_match;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -710,6 +947,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if ((pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP) && !is_mcast_pkt) {
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+		goto lookup_done;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -798,43 +1043,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 			/* Is the candidate connection matching the packet's TCP/UDP
 			 * address and port?
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			if (!conn_ip_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -878,6 +1088,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+#if defined(CONFIG_NET_CONN_HASH)
+lookup_done:
+#endif
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -965,6 +1178,15 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash_connected[i]);
+		sys_slist_init(&conn_hash_bound[i]);
+	}
+
+	sys_slist_init(&conn_hash_wild);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -82,6 +82,17 @@ struct net_conn {
 
 	/** Is v4-mapping-to-v6 enabled for this connection */
 	uint8_t v6only : 1;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal hash table node */
+	sys_snode_t hash_node;
+
+	/** Hash table list the connection is in */
+	sys_slist_t *hash_list;
+
+	/** Registration order, newer connections win ties */
+	uint32_t seq;
+#endif
 };
 
 /**
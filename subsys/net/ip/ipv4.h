@@ -19,6 +19,7 @@
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_context.h>
+#include <zephyr/net/ipv4_route.h>
 
 #define NET_IPV4_IHL_MASK 0x0F
 #define NET_IPV4_DSCP_MASK 0xFC
@@ -388,6 +389,20 @@ void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data);
  */
 enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt);
 
+/**
+ * @brief Delete all the IPv4 routes of a network interface.
+ *
+ * @param iface Network interface that is going down.
+ */
+#if defined(CONFIG_NET_IPV4_ROUTE)
+void net_ipv4_route_del_iface(struct net_if *iface);
+#else
+static inline void net_ipv4_route_del_iface(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+#endif /* CONFIG_NET_IPV4_ROUTE */
+
 #if defined(CONFIG_NET_NATIVE_IPV4)
 /**
  * @brief Initialises IPv4
@@ -0,0 +1,393 @@
+/** @file
+ * @brief IPv4 routing table.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_event.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_timeout.h>
+#include <zephyr/net/ipv4_route.h>
+#include "net_private.h"
+#include "ipv4.h"
+#include "route_lpm.h"
+
+struct net_ipv4_route {
+	/** Network interface of the route. */
+	struct net_if *iface;
+
+	/** IPv4 prefix of the route. */
+	struct in_addr addr;
+
+	/** Gateway for the destinations of the prefix. */
+	struct in_addr gw;
+
+	/** Lifetime of the route, unless it is infinite. */
+	struct net_timeout lifetime;
+
+	/** IPv4 prefix length. */
+	uint8_t prefix_len;
+
+	/** Does the route never expire. */
+	bool is_infinite;
+
+	/** Is this entry in use or not */
+	bool is_used;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Membership of the longest prefix match trie of the routes. */
+	struct net_route_lpm_entry lpm;
+#endif
+};
+
+static struct net_ipv4_route routes[CONFIG_NET_IPV4_MAX_ROUTES];
+
+static K_MUTEX_DEFINE(lock);
+
+/* Routes with a finite lifetime */
+static sys_slist_t active_route_lifetime_timers;
+
+static void route_lifetime_timeout(struct k_work *work);
+
+/* Timer that removes the expired routes */
+static K_WORK_DELAYABLE_DEFINE(route_lifetime_timer, route_lifetime_timeout);
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+static struct net_route_lpm route_lpm = NET_ROUTE_LPM_INIT(32);
+#endif
+
+static inline uint32_t prefix_mask(uint8_t prefix_len)
+{
+	return prefix_len == 0U ? 0U : htonl(UINT32_MAX << (32U - prefix_len));
+}
+
+static inline bool is_prefix(const struct in_addr *addr, const struct in_addr *prefix,
+			     uint8_t prefix_len)
+{
+	uint32_t mask = prefix_mask(prefix_len);
+
+	return (UNALIGNED_GET(&addr->s_addr) & mask) == (prefix->s_addr & mask);
+}
+
+static void route_notify(uint32_t event, struct net_ipv4_route *route)
+{
+#if defined(CONFIG_NET_MGMT_EVENT_INFO)
+	struct net_event_ipv4_route info;
+
+	net_ipaddr_copy(&info.gw, &route->gw);
+	net_ipaddr_copy(&info.addr, &route->addr);
+	info.prefix_len = route->prefix_len;
+
+	net_mgmt_event_notify_with_info(event, route->iface, (void *)&info,
+					sizeof(struct net_event_ipv4_route));
+#else
+	net_mgmt_event_notify(event, route->iface);
+#endif
+}
+
+/* Must be called with the lock held */
+static void route_set_lifetime(struct net_ipv4_route *route, uint32_t lifetime)
+{
+	(void)sys_slist_find_and_remove(&active_route_lifetime_timers,
+					&route->lifetime.node);
+
+	if (lifetime == NET_IPV4_ROUTE_INFINITE_LIFETIME) {
+		route->is_infinite = true;
+		return;
+	}
+
+	route->is_infinite = false;
+
+	net_timeout_set(&route->lifetime, lifetime, k_uptime_get_32());
+	sys_slist_append(&active_route_lifetime_timers, &route->lifetime.node);
+	k_work_reschedule(&route_lifetime_timer, K_NO_WAIT);
+}
+
+/* Must be called with the lock held */
+static void route_remove(struct net_ipv4_route *route)
+{
+	if (!route->is_infinite) {
+		(void)sys_slist_find_and_remove(&active_route_lifetime_timers,
+						&route->lifetime.node);
+	}
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_lpm_del(&route_lpm, &route->lpm);
+#endif
+
+	route->is_used = false;
+
+	NET_DBG("Deleted route to %s/%u (iface %d)",
+		net_sprint_ipv4_addr(&route->addr), route->prefix_len,
+		net_if_get_by_iface(route->iface));
+
+	route_notify(NET_EVENT_IPV4_ROUTE_DEL, route);
+}
+
+static void route_lifetime_timeout(struct k_work *work)
+{
+	uint32_t next_update = UINT32_MAX;
+	uint32_t current_time = k_uptime_get_32();
+	struct net_ipv4_route *current, *next;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&active_route_lifetime_timers,
+					  current, next, lifetime.node) {
+		uint32_t this_update = net_timeout_evaluate(&current->lifetime,
+							    current_time);
+
+		if (this_update == 0U) {
+			NET_DBG("Route to %s/%u expired",
+				net_sprint_ipv4_addr(&current->addr), current->prefix_len);
+			route_remove(current);
+			continue;
+		}
+
+		if (this_update < next_update) {
+			next_update = this_update;
+		}
+	}
+
+	if (next_update != UINT32_MAX) {
+		k_work_reschedule(&route_lifetime_timer, K_MSEC(next_update));
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+int net_ipv4_route_add(struct net_if *iface, const struct in_addr *addr,
+		       uint8_t prefix_len, const struct in_addr *gw,
+		       uint32_t lifetime)
+{
+	struct net_ipv4_route *route = NULL;
+	int ret = 0;
+
+	if (iface == NULL || addr == NULL || gw == NULL || prefix_len > 32U) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(routes, entry) {
+		if (!entry->is_used) {
+			if (route == NULL) {
+				route = entry;
+			}
+
+			continue;
+		}
+
+		if (entry->iface == iface && entry->prefix_len == prefix_len &&
+		    is_prefix(addr, &entry->addr, prefix_len)) {
+			route_set_lifetime(entry, lifetime);
+
+			if (!net_ipv4_addr_cmp(&entry->gw, gw)) {
+				net_ipaddr_copy(&entry->gw, gw);
+				route_notify(NET_EVENT_IPV4_ROUTE_ADD, entry);
+			}
+
+			goto out;
+		}
+	}
+
+	if (route == NULL) {
+		NET_DBG("IPv4 routing table is full");
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	route->iface = iface;
+	net_ipaddr_copy(&route->addr, addr);
+	route->addr.s_addr &= prefix_mask(prefix_len);
+	net_ipaddr_copy(&route->gw, gw);
+	route->prefix_len = prefix_len;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	ret = net_route_lpm_add(&route_lpm, &route->lpm, (const uint8_t *)&route->addr,
+				prefix_len);
+	if (ret < 0) {
+		NET_ERR("Cannot add route to the prefix trie!");
+		goto out;
+	}
+#endif
+
+	route_set_lifetime(route, lifetime);
+	route->is_used = true;
+
+	NET_DBG("Added route to %s/%u via %s (iface %d)",
+		net_sprint_ipv4_addr(&route->addr), prefix_len,
+		net_sprint_ipv4_addr(gw), net_if_get_by_iface(iface));
+
+	route_notify(NET_EVENT_IPV4_ROUTE_ADD, route);
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int net_ipv4_route_del(struct net_if *iface, const struct in_addr *addr,
+		       uint8_t prefix_len)
+{
+	int ret = -ENOENT;
+
+	if (iface == NULL || addr == NULL || prefix_len > 32U) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(routes, route) {
+		if (route->is_used && route->iface == iface &&
+		    route->prefix_len == prefix_len &&
+		    is_prefix(addr, &route->addr, prefix_len)) {
+			route_remove(route);
+			ret = 0;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void net_ipv4_route_del_iface(struct net_if *iface)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(routes, route) {
+		if (route->is_used && route->iface == iface) {
+			route_remove(route);
+		}
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+struct route_lpm_match {
+	struct net_if *iface;
+	struct net_ipv4_route *found;
+};
+
+static void route_lpm_match_cb(struct net_route_lpm_entry *entry, void *user_data)
+{
+	struct net_ipv4_route *route = CONTAINER_OF(entry, struct net_ipv4_route, lpm);
+	struct route_lpm_match *match = user_data;
+
+	if (match->iface && route->iface != match->iface) {
+		return;
+	}
+
+	/* Same choice as the table walk below */
+	if (match->found == NULL || route->prefix_len > match->found->prefix_len ||
+	    route > match->found) {
+		match->found = route;
+	}
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+/* Must be called with the lock held */
+static struct net_ipv4_route *route_lookup(struct net_if *iface,
+					   const struct in_addr *addr)
+{
+	struct net_ipv4_route *found = NULL;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	struct route_lpm_match match = {
+		.iface = iface,
+	};
+
+	net_route_lpm_lookup(&route_lpm, (const uint8_t *)addr, route_lpm_match_cb, &match);
+	found = match.found;
+#else
+	/* Of the routes with the same prefix length, the last one wins */
+	ARRAY_FOR_EACH_PTR(routes, route) {
+		if (!route->is_used || (iface && route->iface != iface)) {
+			continue;
+		}
+
+		if ((found == NULL || route->prefix_len >= found->prefix_len) &&
+		    is_prefix(addr, &route->addr, route->prefix_len)) {
+			found = route;
+		}
+	}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+	return found;
+}
+
+/* Must be called with the lock held */
+static void route_copy(struct net_ipv4_route_info *info, struct net_ipv4_route *route,
+		       uint32_t now)
+{
+	info->iface = route->iface;
+	net_ipaddr_copy(&info->addr, &route->addr);
+	net_ipaddr_copy(&info->gw, &route->gw);
+	info->prefix_len = route->prefix_len;
+
+	if (route->is_infinite) {
+		info->lifetime = NET_IPV4_ROUTE_INFINITE_LIFETIME;
+	} else {
+		info->lifetime = net_timeout_remaining(&route->lifetime, now);
+	}
+}
+
+bool net_ipv4_route_lookup(struct net_if *iface, const struct in_addr *dst,
+			   struct net_ipv4_route_info *route)
+{
+	struct net_ipv4_route *found;
+	struct in_addr addr;
+
+	net_ipaddr_copy(&addr, dst);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	found = route_lookup(iface, &addr);
+	if (found != NULL) {
+		route_copy(route, found, k_uptime_get_32());
+	}
+
+	k_mutex_unlock(&lock);
+
+	return found != NULL;
+}
+
+int net_ipv4_route_foreach(net_ipv4_route_cb_t cb, void *user_data)
+{
+	struct net_ipv4_route_info info;
+	uint32_t now = k_uptime_get_32();
+	int count = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(routes, route) {
+		if (!route->is_used) {
+			continue;
+		}
+
+		route_copy(&info, route, now);
+		cb(&info, user_data);
+		count++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return count;
+}
@@ -5653,6 +5653,7 @@ static void notify_iface_down(struct net_if *iface)
 	net_if_flag_clear(iface, NET_IF_RUNNING);
 	net_mgmt_event_notify(NET_EVENT_IF_DOWN, iface);
 	net_virtual_disable(iface);
+	net_ipv4_route_del_iface(iface);
 
 	if (!net_if_is_offloaded(iface) &&
 	    !(l2_flags_get(iface) & NET_L2_POINT_TO_POINT)) {
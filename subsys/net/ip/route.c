@@ -32,7 +32,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes;
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -263,19 +263,72 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+static struct net_route_lpm route_lpm = NET_ROUTE_LPM_INIT(128);
+
+struct route_lpm_match {
+	struct net_if *iface;
+	struct net_route_entry *found;
+};
+
+static void route_lpm_match_cb(struct net_route_lpm_entry *entry, void *user_data)
+{
+	struct net_route_entry *route = CONTAINER_OF(entry, struct net_route_entry, lpm);
+	struct route_lpm_match *match = user_data;
+
+	if (match->iface && route->iface != match->iface) {
+		return;
+	}
+
+	/* The routes come from the shortest prefix to the longest one. Of the
+	 * routes with the same prefix, pick the one a walk of the route table
+	 * would find last.
+	 */
+	if (match->found == NULL || route->prefix_len > match->found->prefix_len ||
+	    route > match->found) {
+		match->found = route;
+	}
+}
+
+static struct net_route_entry *route_lpm_lookup(struct net_if *iface,
+						const struct in6_addr *dst)
+{
+	struct route_lpm_match match = {
+		.iface = iface,
+	};
+
+	net_route_lpm_lookup(&route_lpm, dst->s6_addr, route_lpm_match_cb, &match);
+
+	return match.found;
+}
+
+#define route_lpm_add(route) \
+	net_route_lpm_add(&route_lpm, &(route)->lpm, (route)->addr.s6_addr, \
+			  (route)->prefix_len)
+#define route_lpm_del(route) net_route_lpm_del(&route_lpm, &(route)->lpm)
+#else
+#define route_lpm_add(route) 0
+#define route_lpm_del(route)
+#endif /* CONFIG_NET_ROUTE_LPM */
+
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
-	int i;
+	struct net_route_entry *found = NULL;
 
 	net_ipv6_nbr_lock();
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	found = route_lpm_lookup(iface, dst);
+#else
+	struct net_route_entry *route;
+	uint8_t longest_match = 0U;
+	int i;
+
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -297,6 +350,7 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 			longest_match = route->prefix_len;
 		}
 	}
+#endif /* CONFIG_NET_ROUTE_LPM */
 
 	if (found) {
 		net_route_info("Found", found, dst);
@@ -393,9 +447,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -442,9 +496,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (route_lpm_add(route) < 0) {
+		NET_ERR("Cannot add route to the prefix trie!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +648,11 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	route_lpm_del(route);
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -1131,5 +1197,6 @@ void net_route_init(void)
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
+	sys_dlist_init(&routes);
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
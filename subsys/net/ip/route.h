@@ -15,11 +15,13 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
 
 #include "nbr.h"
+#include "route_lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,7 +49,7 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
@@ -68,6 +70,11 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Membership of the longest prefix match trie of the routes. */
+	struct net_route_lpm_entry lpm;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
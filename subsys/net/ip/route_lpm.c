@@ -0,0 +1,219 @@
+/** @file
+ * @brief Longest prefix match trie of routes.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "route_lpm.h"
+
+#define ROUTE_LPM_MAX_ROUTES						\
+	(COND_CODE_1(CONFIG_NET_ROUTE, (CONFIG_NET_MAX_ROUTES), (0)) +	\
+	 COND_CODE_1(CONFIG_NET_IPV4_ROUTE, (CONFIG_NET_IPV4_MAX_ROUTES), (0)))
+
+/* Path compressed binary trie of the route prefixes. A node holds the routes
+ * whose prefix is exactly the node prefix, and a node without routes always
+ * has two children, so a trie of N routes never has more than 2 * N - 1 nodes.
+ * The nodes of the IPv6 and IPv4 tries come from the same slab.
+ */
+struct net_route_lpm_node {
+	struct net_route_lpm_node *parent;
+	struct net_route_lpm_node *child[2];
+	sys_slist_t routes;
+	uint8_t prefix[16];
+	uint8_t prefix_len;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(route_lpm_slab, sizeof(struct net_route_lpm_node),
+			 2 * ROUTE_LPM_MAX_ROUTES, sizeof(void *));
+
+static inline uint8_t route_lpm_bit(const uint8_t *addr, uint8_t bit)
+{
+	return (addr[bit / 8U] >> (7U - bit % 8U)) & 1U;
+}
+
+/* Number of leading bits, at most max_len, that two addresses have in common */
+static uint8_t route_lpm_common_len(const uint8_t *addr1, const uint8_t *addr2,
+				    uint8_t max_len)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; len < max_len; i++) {
+		uint8_t diff = addr1[i] ^ addr2[i];
+
+		if (diff == 0U) {
+			len += 8U;
+			continue;
+		}
+
+		while ((diff & 0x80) == 0U) {
+			diff <<= 1;
+			len++;
+		}
+
+		break;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct net_route_lpm_node *route_lpm_node_alloc(const uint8_t *prefix,
+							uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node;
+
+	if (k_mem_slab_alloc(&route_lpm_slab, (void **)&node, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	memset(node, 0, sizeof(*node));
+	memcpy(node->prefix, prefix, DIV_ROUND_UP(prefix_len, 8U));
+	node->prefix_len = prefix_len;
+	sys_slist_init(&node->routes);
+
+	return node;
+}
+
+static inline struct net_route_lpm_node **route_lpm_link(struct net_route_lpm *trie,
+							 struct net_route_lpm_node *node)
+{
+	struct net_route_lpm_node *parent = node->parent;
+
+	if (parent == NULL) {
+		return &trie->root;
+	}
+
+	return &parent->child[parent->child[1] == node];
+}
+
+int net_route_lpm_add(struct net_route_lpm *trie,
+		      struct net_route_lpm_entry *entry,
+		      const uint8_t *prefix, uint8_t prefix_len)
+{
+	struct net_route_lpm_node **link = &trie->root;
+	struct net_route_lpm_node *parent = NULL;
+	struct net_route_lpm_node *node, *new, *split;
+	uint8_t len = 0U;
+
+	if (prefix_len > trie->addr_len) {
+		return -EINVAL;
+	}
+
+	while ((node = *link) != NULL) {
+		len = route_lpm_common_len(node->prefix, prefix,
+					   MIN(node->prefix_len, prefix_len));
+		if (len < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			goto found;
+		}
+
+		parent = node;
+		link = &node->child[route_lpm_bit(prefix, node->prefix_len)];
+	}
+
+	new = route_lpm_node_alloc(prefix, prefix_len);
+	if (new == NULL) {
+		return -ENOMEM;
+	}
+
+	new->parent = parent;
+
+	if (node != NULL && len == prefix_len) {
+		/* The route prefix is a prefix of the node one */
+		new->child[route_lpm_bit(node->prefix, len)] = node;
+		node->parent = new;
+	} else if (node != NULL) {
+		/* The prefixes diverge above the node, join them there */
+		split = route_lpm_node_alloc(prefix, len);
+		if (split == NULL) {
+			k_mem_slab_free(&route_lpm_slab, new);
+			return -ENOMEM;
+		}
+
+		split->parent = parent;
+		split->child[route_lpm_bit(node->prefix, len)] = node;
+		split->child[route_lpm_bit(prefix, len)] = new;
+		node->parent = split;
+		new->parent = split;
+		*link = split;
+		node = new;
+		goto found;
+	}
+
+	*link = new;
+	node = new;
+
+found:
+	sys_slist_append(&node->routes, &entry->node);
+	entry->lpm = node;
+
+	return 0;
+}
+
+void net_route_lpm_del(struct net_route_lpm *trie,
+		       struct net_route_lpm_entry *entry)
+{
+	struct net_route_lpm_node *node = entry->lpm;
+	struct net_route_lpm_node *parent, *child;
+
+	if (node == NULL) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->routes, &entry->node);
+	entry->lpm = NULL;
+
+	/* Remove the nodes that no longer hold routes or join two branches */
+	while (node != NULL && sys_slist_is_empty(&node->routes) &&
+	       (node->child[0] == NULL || node->child[1] == NULL)) {
+		parent = node->parent;
+		child = node->child[0] != NULL ? node->child[0] : node->child[1];
+
+		*route_lpm_link(trie, node) = child;
+		if (child != NULL) {
+			child->parent = parent;
+		}
+
+		k_mem_slab_free(&route_lpm_slab, node);
+
+		if (child != NULL) {
+			break;
+		}
+
+		/* The parent lost a child */
+		node = parent;
+	}
+}
+
+void net_route_lpm_lookup(struct net_route_lpm *trie, const uint8_t *addr,
+			  net_route_lpm_cb_t cb, void *user_data)
+{
+	struct net_route_lpm_node *node = trie->root;
+	struct net_route_lpm_entry *entry;
+
+	while (node != NULL &&
+	       route_lpm_common_len(node->prefix, addr, node->prefix_len) ==
+	       node->prefix_len) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, entry, node) {
+			cb(entry, user_data);
+		}
+
+		if (node->prefix_len == trie->addr_len) {
+			break;
+		}
+
+		node = node->child[route_lpm_bit(addr, node->prefix_len)];
+	}
+}
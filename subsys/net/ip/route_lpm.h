@@ -0,0 +1,93 @@
+/** @file
+ * @brief Longest prefix match trie of routes
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ROUTE_LPM_H
+#define __ROUTE_LPM_H
+
+#include <zephyr/types.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct net_route_lpm_node;
+
+/**
+ * @brief Longest prefix match trie of IPv6 or IPv4 route prefixes.
+ */
+struct net_route_lpm {
+	/** Root node of the trie. */
+	struct net_route_lpm_node *root;
+
+	/** Length of the addresses in bits, 128 for IPv6 and 32 for IPv4. */
+	uint8_t addr_len;
+};
+
+#define NET_ROUTE_LPM_INIT(_addr_len) { .root = NULL, .addr_len = (_addr_len) }
+
+/**
+ * @brief Trie membership of a route, embedded in the route entry.
+ */
+struct net_route_lpm_entry {
+	/** Node in the list of routes of a trie node. */
+	sys_snode_t node;
+
+	/** Trie node holding the routes with the same prefix as this one. */
+	struct net_route_lpm_node *lpm;
+};
+
+typedef void (*net_route_lpm_cb_t)(struct net_route_lpm_entry *entry,
+				   void *user_data);
+
+/**
+ * @brief Add a route to a trie.
+ *
+ * @param trie Trie to add the route to.
+ * @param entry Trie membership of the route.
+ * @param prefix Route prefix, in network byte order.
+ * @param prefix_len Length of the route prefix in bits.
+ *
+ * @return 0 if ok, -EINVAL if the prefix is too long, -ENOMEM if there
+ * are no free trie nodes.
+ */
+int net_route_lpm_add(struct net_route_lpm *trie,
+		      struct net_route_lpm_entry *entry,
+		      const uint8_t *prefix, uint8_t prefix_len);
+
+/**
+ * @brief Remove a route from a trie. Does nothing if the route is not in it.
+ *
+ * @param trie Trie the route was added to.
+ * @param entry Trie membership of the route.
+ */
+void net_route_lpm_del(struct net_route_lpm *trie,
+		       struct net_route_lpm_entry *entry);
+
+/**
+ * @brief Call a callback for every route whose prefix matches an address.
+ *
+ * The routes are passed from the shortest prefix to the longest one.
+ *
+ * @param trie Trie to search.
+ * @param addr Address to match, in network byte order.
+ * @param cb Callback to call for each matching route.
+ * @param user_data User specified data.
+ */
+void net_route_lpm_lookup(struct net_route_lpm *trie, const uint8_t *addr,
+			  net_route_lpm_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROUTE_LPM_H */
@@ -65,8 +65,7 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
+/* Define the number of MSS sections the slow start threshold is initialized at */
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
@@ -454,7 +453,7 @@ static void tcp_new_reno_log(struct tcp *conn, char *step)
 
 static void tcp_new_reno_init(struct tcp *conn)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.cwnd = tcp_ca_initial_window(conn);
 	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
 	conn->ca.pending_fast_retransmit_bytes = 0;
 	tcp_new_reno_log(conn, "init");
@@ -484,7 +483,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, TCP_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
@@ -500,7 +499,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, TCP_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -514,29 +513,162 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+TCP_CA_REGISTER(reno, tcp_new_reno_init, tcp_new_reno_fast_retransmit,
+		tcp_new_reno_timeout, tcp_new_reno_dup_ack,
+		tcp_new_reno_pkts_acked, NULL);
+
+static const struct tcp_ca_ops *tcp_ca_default;
+
+uint32_t tcp_ca_initial_window(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	return MIN(CONFIG_NET_TCP_CONGESTION_INITIAL_WINDOW * mss,
+		   MAX(2U * mss, 14600U));
+}
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strcmp(ops->name, name) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.delivered = 0U;
+	conn->ca.rtt_timing = false;
+	conn->ca.in_recovery = false;
+#ifdef TCP_CA_PRIV_SIZE
+	memset(conn->ca.priv, 0, sizeof(conn->ca.priv));
+#endif
+#ifdef CONFIG_NET_TCP_PACING
+	conn->pacing_rate = 0U;
+#endif
+
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	/* Retransmitted data gives no round trip time samples (Karn) */
+	conn->ca.rtt_timing = false;
+
+	if (!conn->ca.in_recovery) {
+		conn->ca.in_recovery = true;
+		conn->ca.recover = conn->seq + conn->unacked_len;
+	}
+
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	/* Everything is sent again, the data the peer queued is acknowledged
+	 * at once when the first hole is filled.
+	 */
+	conn->ca.rtt_timing = false;
+	conn->ca.in_recovery = true;
+	conn->ca.recover = conn->seq + conn->unacked_len;
+
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	uint32_t ack = conn->seq + acked_len;
+
+	conn->ca.delivered += acked_len;
+
+	if (conn->ca.in_recovery &&
+	    !net_tcp_seq_greater(conn->ca.recover, ack)) {
+		conn->ca.in_recovery = false;
+	}
+
+	if (conn->ca.rtt_timing && !net_tcp_seq_greater(conn->ca.rtt_seq, ack)) {
+		conn->ca.rtt_timing = false;
+
+		if (conn->ca.ops->rtt_sample != NULL) {
+			conn->ca.ops->rtt_sample(conn,
+						 tcp_now_us() - conn->ca.rtt_start,
+						 conn->ca.delivered -
+						 conn->ca.rtt_delivered);
+		}
+	}
+
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+/* Time a segment of new data, unless one is being timed already or
+ * the acknowledgment could be delayed by the recovery of lost data.
+ */
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq, int len)
+{
+	if (conn->ca.rtt_timing || conn->ca.in_recovery ||
+	    conn->data_mode != TCP_DATA_MODE_SEND) {
+		return;
+	}
+
+	conn->ca.rtt_timing = true;
+	conn->ca.rtt_seq = seq + len;
+	conn->ca.rtt_start = tcp_now_us();
+	conn->ca.rtt_delivered = conn->ca.delivered;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	char name[TCP_CA_NAME_MAX];
+	const struct tcp_ca_ops *ops;
+
+	if (conn == NULL || value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	len = MIN(len, sizeof(name) - 1);
+	memcpy(name, value, len);
+	name[len] = '\0';
+
+	ops = tcp_ca_find(name);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops == conn->ca.ops) {
+		return 0;
+	}
+
+	conn->ca.ops = ops;
+
+	/* An established connection continues from its current window */
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		uint32_t cwnd = conn->ca.cwnd;
+
+		tcp_ca_init(conn);
+		conn->ca.cwnd = cwnd;
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	if (conn == NULL || value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, strlen(conn->ca.ops->name) + 1);
+	memcpy(value, conn->ca.ops->name, *len);
+
+	return 0;
 }
 #else
 
@@ -550,6 +682,8 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_data_sent(struct tcp *conn, uint32_t seq, int len) { }
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -806,6 +940,9 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+#ifdef CONFIG_NET_TCP_PACING
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+#endif
 	keep_alive_timer_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
@@ -1088,7 +1225,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1098,8 +1235,18 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS, window scale and SACK permitted are only negotiated with
+	 * SYN segments, the options of later segments must not reset them.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
+
+#ifdef CONFIG_NET_TCP_SACK
+	recv_options->sack_count = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1134,6 +1281,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -1145,9 +1296,43 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+
+			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_SACK_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_count++];
+
+				block->left = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->right = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
 			break;
+#endif
 		default:
 			continue;
 		}
@@ -1227,55 +1412,52 @@ static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
 	    !net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
+		/* The queued data is sorted and may have gaps. The part of it
+		 * that continues the incoming data, up to the first gap, is
+		 * passed on with it, the rest stays queued.
 		 */
 		struct tcphdr *th = th_get(pkt);
 		uint32_t expected_seq = th_seq(th) + len;
+		struct net_buf *buf = conn->queue_recv_data->buffer;
+		struct net_buf *last;
 		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
+
+		/* Drop the queued data the incoming data already holds */
+		while (buf != NULL &&
+		       !net_tcp_seq_greater(tcp_get_seq(buf) + buf->len, expected_seq)) {
+			buf = net_buf_frag_del(NULL, buf);
+		}
+
+		conn->queue_recv_data->buffer = buf;
+
+		if (buf != NULL && !net_tcp_seq_greater(tcp_get_seq(buf), expected_seq)) {
+			pending_seq = tcp_get_seq(buf);
+			last = buf;
+			pending_len = buf->len;
+
+			while (last->frags != NULL &&
+			       tcp_get_seq(last->frags) == tcp_get_seq(last) + last->len) {
+				last = last->frags;
+				pending_len += last->len;
+			}
+
+			conn->queue_recv_data->buffer = last->frags;
+			last->frags = NULL;
+
+			/* The queued data may overlap the end of the incoming data */
+			if (expected_seq != pending_seq) {
+				net_pkt_remove_tail(pkt, expected_seq - pending_seq);
+				pending_len -= expected_seq - pending_seq;
 			}
 
 			NET_DBG("Found pending data seq %u len %zd",
 				expected_seq, pending_len);
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+			net_buf_frag_add(pkt->buffer, buf);
+		}
 
+		if (net_pkt_is_empty(conn->queue_recv_data)) {
 			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
-
-			pending_len = 0;
 		}
 	}
 
@@ -1338,8 +1520,22 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window to advertise, which is never scaled in SYN segments */
+static uint16_t tcp_recv_win_get(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if (!(flags & SYN)) {
+		win >>= conn->recv_win_shift;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1353,14 +1549,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_win_get(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1418,23 +1610,171 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+/* Smallest shift that fits a window of win bytes in the header */
+static uint8_t tcp_win_shift_get(uint32_t win)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	uint8_t shift = 0U;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	while ((win >> shift) > UINT16_MAX && shift < NET_TCP_WINDOW_SCALE_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* Get the run of contiguous queued data starting at buf, return the buffer
+ * following it.
+ */
+static struct net_buf *tcp_queue_run_get(struct net_buf *buf,
+					 struct tcp_sack_block *block)
+{
+	block->left = tcp_get_seq(buf);
+	block->right = block->left;
+
+	while (buf != NULL && tcp_get_seq(buf) == block->right) {
+		block->right += buf->len;
+		buf = buf->frags;
+	}
+
+	return buf;
+}
+
+/* Put the run of queued data holding seq first in the blocks reported to
+ * the peer, as the first block must report the most recently received
+ * segment (RFC 2018 ch 4). The blocks it joined with are dropped.
+ */
+static void tcp_sack_recv_update(struct tcp *conn, uint32_t seq)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_BLOCKS];
+	struct net_buf *buf = conn->queue_recv_data->buffer;
+	uint8_t count = 0;
+
+	while (buf != NULL) {
+		buf = tcp_queue_run_get(buf, &blocks[0]);
+
+		if (!net_tcp_seq_greater(blocks[0].left, seq) &&
+		    net_tcp_seq_greater(blocks[0].right, seq)) {
+			count = 1;
+			break;
+		}
+	}
+
+	for (int i = 0; i < conn->sack_recv_count && count < NET_TCP_SACK_BLOCKS; i++) {
+		struct tcp_sack_block *block = &conn->sack_recv[i];
+
+		if (count > 0 && !net_tcp_seq_greater(block->left, blocks[0].right) &&
+		    !net_tcp_seq_greater(blocks[0].left, block->right)) {
+			continue;
+		}
+
+		blocks[count++] = *block;
+	}
+
+	memcpy(conn->sack_recv, blocks, count * sizeof(blocks[0]));
+	conn->sack_recv_count = count;
+}
+
+/* Whether a block still matches a run of queued data past the acknowledged
+ * data. The runs only change when data is queued or passed on, so an old
+ * block that no longer matches has been joined with other data or received.
+ */
+static bool tcp_sack_recv_valid(struct tcp *conn, const struct tcp_sack_block *block)
+{
+	struct net_buf *buf = conn->queue_recv_data->buffer;
+	struct tcp_sack_block run;
+
+	if (!net_tcp_seq_greater(block->left, conn->ack)) {
+		return false;
+	}
+
+	while (buf != NULL) {
+		buf = tcp_queue_run_get(buf, &run);
+
+		if (run.left == block->left) {
+			return run.right == block->right;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* The runs of out-of-order data held in the receive queue, most recent
+ * first, if SACK is in use. Return the number of blocks.
+ */
+static int tcp_sack_blocks_get(struct tcp *conn, struct tcp_sack_block *blocks)
+{
+	int count = 0;
+
+#ifdef CONFIG_NET_TCP_SACK
+	if (!conn->sack_ok || conn->queue_recv_data == NULL ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	for (int i = 0; i < conn->sack_recv_count; i++) {
+		if (tcp_sack_recv_valid(conn, &conn->sack_recv[i])) {
+			blocks[count++] = conn->sack_recv[i];
+		}
+	}
+#endif
+
+	return count;
+}
+
+/* Fill in the options of a segment, return their length. The options
+ * in send_options are only set for SYN segments, the out-of-order data
+ * is reported in acknowledgments without data.
+ */
+static size_t tcp_options_fill(struct tcp *conn, uint8_t flags, bool data,
+			       uint8_t *opts)
+{
+	struct tcp_sack_block blocks[NET_TCP_SACK_BLOCKS];
+	size_t len = 0;
+	int count;
+
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)opts);
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	if (conn->send_options.wnd_found) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		opts[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		opts[len++] = conn->send_options.window;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (conn->send_options.sack_perm_found) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (!data && (flags & (SYN | RST | ACK)) == ACK) {
+		count = tcp_sack_blocks_get(conn, blocks);
+		if (count > 0) {
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_SACK_OPT;
+			opts[len++] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+		}
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+		for (int i = 0; i < count; i++) {
+			UNALIGNED_PUT(htonl(blocks[i].left), (uint32_t *)(opts + len));
+			UNALIGNED_PUT(htonl(blocks[i].right), (uint32_t *)(opts + len + 4));
+			len += NET_TCP_SACK_BLOCK_SIZE;
+		}
+	}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1541,14 +1881,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t opts_len = tcp_options_fill(conn, flags, data != NULL, opts);
+	size_t alloc_len = sizeof(struct tcphdr) + opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1567,14 +1905,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1736,42 +2074,84 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+#ifdef CONFIG_NET_TCP_PACING
+/* Segments sent at once after the pacing timer fired late */
+#define TCP_PACING_BURST 2
+
+/* Hold the next segment back until the pacing rate allows it */
+static bool tcp_pacing_wait(struct tcp *conn)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	int32_t wait;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
+	if (conn->pacing_rate == 0U) {
+		return false;
 	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+
+	wait = (int32_t)(conn->pacing_next - tcp_now_us());
+	if (wait <= 0) {
+		return false;
+	}
+
+	/* Keeps the timer if already scheduled, also when called from it */
+	(void)k_work_schedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+					K_USEC(wait));
+
+	return true;
+}
+
+static void tcp_pacing_sent(struct tcp *conn, int len)
+{
+	uint32_t now = tcp_now_us();
+	uint32_t interval;
+	uint32_t slack;
+
+	if (conn->pacing_rate == 0U) {
+		return;
 	}
 
+	interval = (uint64_t)len * USEC_PER_SEC / conn->pacing_rate;
+
+	/* The timer fires on a tick, which can be later than the time to
+	 * send. That time is made up for with a short burst, but not the
+	 * time the connection had nothing to send.
+	 */
+	slack = MAX(k_ticks_to_us_ceil32(1), TCP_PACING_BURST * interval);
+	if ((int32_t)(conn->pacing_next - now) < -(int32_t)slack) {
+		conn->pacing_next = now - slack;
+	}
+
+	conn->pacing_next += interval;
+}
+#else
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	return false;
+}
+
+static void tcp_pacing_sent(struct tcp *conn, int len) { }
+#endif
+
+/* Send len bytes of the send_data queue starting at the given offset */
+static int tcp_send_data_at(struct tcp *conn, int offset, int len, bool resend)
+{
+	struct net_pkt *pkt;
+	int ret;
+
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -1786,12 +2166,246 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_data_at(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		tcp_ca_data_sent(conn, conn->seq + conn->unacked_len, len);
+		tcp_pacing_sent(conn, len);
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+
+/* Drop the scoreboard blocks covered by the acknowledged data */
+static void tcp_sack_ack(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_sack_block *blocks = conn->sack_blocks;
+	int n = 0;
+
+	for (int i = 0; i < conn->sack_count; i++) {
+		if (!net_tcp_seq_greater(blocks[i].right, ack)) {
+			continue;
+		}
+
+		blocks[n] = blocks[i];
+
+		if (net_tcp_seq_greater(ack, blocks[n].left)) {
+			blocks[n].left = ack;
+		}
+
+		n++;
+	}
+
+	conn->sack_count = n;
+}
+
+/* Merge a block reported by the peer into the scoreboard. When the
+ * scoreboard is full, the highest block is forgotten, the retransmissions
+ * only look at the lower ones first anyway.
+ */
+static void tcp_sack_insert(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *blocks = conn->sack_blocks;
+	int n = 0;
+	int i;
+
+	for (i = 0; i < conn->sack_count; i++) {
+		if (net_tcp_seq_cmp(left, blocks[i].right) <= 0 &&
+		    net_tcp_seq_cmp(blocks[i].left, right) <= 0) {
+			if (net_tcp_seq_greater(left, blocks[i].left)) {
+				left = blocks[i].left;
+			}
+
+			if (net_tcp_seq_greater(blocks[i].right, right)) {
+				right = blocks[i].right;
+			}
+
+			continue;
+		}
+
+		blocks[n++] = blocks[i];
+	}
+
+	for (i = n; i > 0 && net_tcp_seq_greater(blocks[i - 1].left, left); i--) {
+		if (i < NET_TCP_SACK_BLOCKS) {
+			blocks[i] = blocks[i - 1];
+		}
+	}
+
+	if (i < NET_TCP_SACK_BLOCKS) {
+		blocks[i].left = left;
+		blocks[i].right = right;
+		n++;
+	}
+
+	conn->sack_count = MIN(n, NET_TCP_SACK_BLOCKS);
+}
+
+/* Update the scoreboard from the SACK option of an acknowledgment */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < opts->sack_count; i++) {
+		uint32_t left = opts->sack[i].left;
+		uint32_t right = opts->sack[i].right;
+
+		/* Ignore blocks of data that was not sent or acknowledged */
+		if (!net_tcp_seq_greater(right, left) ||
+		    !net_tcp_seq_greater(left, ack) ||
+		    right - conn->seq > conn->send_data_total) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, left, right);
+	}
+
+	opts->sack_count = 0;
+
+	tcp_sack_ack(conn, ack);
+}
+
+/* Retransmit the next segment of a hole below the data the peer holds,
+ * past what was retransmitted in this recovery already. When the peer
+ * does not report holding anything, the segment at the acknowledged
+ * data is retransmitted as after a partial acknowledgment in New Reno.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	struct tcp_sack_block *blocks = conn->sack_blocks;
+	uint32_t seq = conn->sack_rexmit_seq;
+	uint32_t offset;
+	uint32_t end;
+	uint32_t len;
+	int i;
+
+	if (net_tcp_seq_greater(conn->seq, seq)) {
+		seq = conn->seq;
+	}
+
+	for (i = 0; i < conn->sack_count; i++) {
+		if (net_tcp_seq_greater(blocks[i].left, seq)) {
+			break;
+		}
+
+		if (net_tcp_seq_greater(blocks[i].right, seq)) {
+			seq = blocks[i].right;
+		}
+	}
+
+	if (i < conn->sack_count) {
+		end = blocks[i].left;
+	} else if (seq == conn->seq) {
+		end = conn->seq + conn_mss(conn);
+	} else {
+		return false;
+	}
+
+	offset = seq - conn->seq;
+	len = MIN(end - conn->seq, (uint32_t)conn->unacked_len);
+	if (len <= offset) {
+		return false;
+	}
+
+	len = MIN(len - offset, conn_mss(conn));
+
+	NET_DBG("conn: %p retransmit hole at %u len %u", conn, seq, len);
+
+	if (tcp_send_data_at(conn, offset, len, true) < 0) {
+		return false;
+	}
+
+	conn->sack_rexmit_seq = seq + len;
+
+	return true;
+}
+
+/* Fill the holes while in recovery, one segment for each acknowledgment */
+static void tcp_sack_recovery(struct tcp *conn)
+{
+	if (!conn->sack_recovery) {
+		return;
+	}
+
+	if (!net_tcp_seq_greater(conn->sack_recovery_seq, conn->seq)) {
+		conn->sack_recovery = false;
+		return;
+	}
+
+	(void)tcp_sack_retransmit(conn);
+}
+
+/* Start a fast recovery, which lasts until all the data sent so far is
+ * acknowledged.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_ok) {
+		return false;
+	}
+
+	if (conn->sack_recovery) {
+		tcp_sack_recovery(conn);
+		return true;
+	}
+
+	conn->sack_recovery = true;
+	conn->sack_recovery_seq = conn->seq + conn->unacked_len;
+	conn->sack_rexmit_seq = conn->seq;
+
+	(void)tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+/* After a retransmission timeout, everything is sent again */
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack_count = 0;
+	conn->sack_recovery = false;
+}
+
+#else
+
+static void tcp_sack_update(struct tcp *conn, uint32_t ack) { }
+
+static bool tcp_sack_recovery_start(struct tcp *conn) { return false; }
+
+static void tcp_sack_recovery(struct tcp *conn) { }
+
+static void tcp_sack_reset(struct tcp *conn) { }
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1817,6 +2431,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_pacing_wait(conn)) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -1840,6 +2458,22 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_PACING
+static void tcp_pacing_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1853,6 +2487,9 @@ static void tcp_cleanup_recv_queue(struct k_work *work)
 
 	net_buf_unref(conn->queue_recv_data->buffer);
 	conn->queue_recv_data->buffer = NULL;
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_recv_count = 0;
+#endif
 
 	k_mutex_unlock(&conn->lock);
 }
@@ -1885,6 +2522,7 @@ static void tcp_resend_data(struct k_work *work)
 
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	tcp_sack_reset(conn);
 
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
@@ -2125,7 +2763,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
 	conn->recv_win_sent = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
@@ -2139,7 +2777,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_MAX_WIN;
+	conn->ca.ops = tcp_ca_default;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2156,6 +2795,9 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#ifdef CONFIG_NET_TCP_PACING
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_timeout);
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2561,8 +3203,9 @@ static bool check_seq_list(struct net_buf *buf)
 
 		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
 
+		/* Gaps are fine, overlaps and reordering are not */
 		if (last != NULL) {
-			if (next_seq != seq) {
+			if (net_tcp_seq_greater(next_seq, seq)) {
 				result = false;
 			}
 		}
@@ -2578,7 +3221,9 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
 	uint32_t seq_start = seq;
-	bool inserted = false;
+	uint32_t seq_end = seq + len;
+	struct net_buf *prev = NULL;
+	struct net_buf *next;
 	struct net_buf *tmp;
 
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
@@ -2599,114 +3244,78 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 		NET_DBG("Queuing data: conn %p", conn);
 	}
 
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
+	/* The queued data is sorted by sequence number, with gaps where
+	 * segments are still missing. Find the place of the new data, trim
+	 * what it overlaps and link it in between.
+	 *
+	 * Only work with subtractions between sequence numbers in uint32_t format
+	 * to proper handle cases that are around the wrapping point.
+	 */
+	next = conn->queue_recv_data->buffer;
 
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
+	while (next != NULL &&
+	       !net_tcp_seq_greater(tcp_get_seq(next) + next->len, seq_start)) {
+		prev = next;
+		next = next->frags;
+	}
 
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = seq - pending_seq;
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
+	if (next != NULL && !net_tcp_seq_greater(tcp_get_seq(next), seq_start) &&
+	    !net_tcp_seq_greater(seq_end, tcp_get_seq(next) + next->len)) {
+		NET_DBG("Data already queued");
+		return;
+	}
 
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data->buffer);
-				NET_DBG("Adding at before queue, end_offset %i, pending_len %zu",
-					end_offset, pending_len);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			}
-		} else {
-			struct net_buf *last;
+	if (next != NULL && net_tcp_seq_greater(seq_start, tcp_get_seq(next))) {
+		/* The new data starts inside a queued buffer */
+		next->len = seq_start - tcp_get_seq(next);
+		prev = next;
+		next = next->frags;
+	}
 
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
+	/* Drop the queued data the new data holds */
+	while (next != NULL &&
+	       !net_tcp_seq_greater(tcp_get_seq(next) + next->len, seq_end)) {
+		next = net_buf_frag_del(prev, next);
+		if (prev == NULL) {
+			conn->queue_recv_data->buffer = next;
+		}
+	}
 
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
+	if (next != NULL && net_tcp_seq_greater(seq_end, tcp_get_seq(next))) {
+		net_pkt_remove_tail(pkt, seq_end - tcp_get_seq(next));
+	}
 
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_pkt_remove_tail(conn->queue_recv_data,
-								    end_offset);
-					}
+	net_buf_frag_last(pkt->buffer)->frags = next;
+	if (prev != NULL) {
+		prev->frags = pkt->buffer;
+	} else {
+		conn->queue_recv_data->buffer = pkt->buffer;
+	}
 
-					/* Put new data after pending data */
-					NET_DBG("Adding at end of queue, start %i, end %i, len %zu",
-						start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data->buffer,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
-		}
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
 
-		if (inserted) {
-			NET_DBG("All pending data: conn %p", conn);
-			if (check_seq_list(conn->queue_recv_data->buffer) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-			}
-		} else {
-			NET_DBG("Cannot add new data to queue");
-		}
-	} else {
-		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
+	NET_DBG("All pending data: conn %p", conn);
+	if (check_seq_list(conn->queue_recv_data->buffer) == false) {
+		NET_ERR("Incorrect order in out of order sequence for conn %p",
+			conn);
+		/* error in sequence list, drop it */
+		net_buf_unref(conn->queue_recv_data->buffer);
+		conn->queue_recv_data->buffer = NULL;
+#ifdef CONFIG_NET_TCP_SACK
+		conn->sack_recv_count = 0;
+#endif
+		return;
 	}
 
-	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
+#ifdef CONFIG_NET_TCP_SACK
+	tcp_sack_recv_update(conn, seq_start);
+#endif
 
-		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
-			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
-				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
-		}
+	if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 	}
 }
 
@@ -2759,6 +3368,75 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
 }
 
+/* Largest receive window that can be advertised to the peer */
+static uint32_t tcp_recv_win_limit(struct tcp *conn)
+{
+	/* The window scale is not negotiated yet */
+	if (conn->state == TCP_LISTEN) {
+		return TCP_MAX_WIN;
+	}
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	return (uint32_t)UINT16_MAX << conn->recv_win_shift;
+#else
+	return UINT16_MAX;
+#endif
+}
+
+/* Options to send with a SYN segment. When answering a SYN, the window
+ * scale and SACK permitted options are only sent if the peer sent them.
+ */
+static void tcp_syn_options_set(struct tcp *conn, bool passive)
+{
+	conn->send_options.mss_found = true;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->send_options.wnd_found = !passive || conn->recv_options.wnd_found;
+	conn->send_options.window = tcp_win_shift_get(conn->recv_win_max);
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	conn->send_options.sack_perm_found = !passive ||
+					     conn->recv_options.sack_perm_found;
+#endif
+}
+
+static void tcp_syn_options_clear(struct tcp *conn)
+{
+	conn->send_options.mss_found = false;
+	conn->send_options.wnd_found = false;
+	conn->send_options.sack_perm_found = false;
+}
+
+/* Take the options of the SYN segment from the peer into use */
+static void tcp_syn_options_apply(struct tcp *conn)
+{
+	uint32_t limit = UINT16_MAX;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if (conn->recv_options.wnd_found) {
+		conn->send_win_shift = MIN(conn->recv_options.window,
+					   NET_TCP_WINDOW_SCALE_MAX);
+		conn->recv_win_shift = tcp_win_shift_get(conn->recv_win_max);
+	} else {
+		conn->send_win_shift = 0U;
+		conn->recv_win_shift = 0U;
+	}
+
+	limit <<= conn->recv_win_shift;
+
+	NET_DBG("conn: %p window shift send %u recv %u", conn,
+		conn->send_win_shift, conn->recv_win_shift);
+#endif
+
+	conn->recv_win_max = MIN(conn->recv_win_max, limit);
+	conn->recv_win = MIN(conn->recv_win, conn->recv_win_max);
+	conn->recv_win_sent = MIN(conn->recv_win_sent, conn->recv_win_max);
+
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+}
+
 static void tcp_check_sock_options(struct tcp *conn)
 {
 	int sndbuf_opt = 0;
@@ -2785,6 +3463,10 @@ static void tcp_check_sock_options(struct tcp *conn)
 		k_mutex_unlock(&conn->lock);
 	}
 
+	if (rcvbuf_opt > 0) {
+		rcvbuf_opt = MIN(rcvbuf_opt, tcp_recv_win_limit(conn));
+	}
+
 	if (rcvbuf_opt > 0 && rcvbuf_opt != conn->recv_win_max) {
 		int diff;
 
@@ -2871,7 +3553,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2896,6 +3579,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->send_win_shift;
+		}
+#endif
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2927,11 +3615,13 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			tcp_syn_options_apply(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
-			conn->send_options.mss_found = true;
+			tcp_syn_options_set(conn, true);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2942,13 +3632,13 @@ next_state:
 						    ACK_TIMEOUT);
 			verdict = NET_OK;
 		} else {
-			conn->send_options.mss_found = true;
+			tcp_syn_options_set(conn, false);
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
 				close_status = ret;
 			} else {
-				conn->send_options.mss_found = false;
+				tcp_syn_options_clear(conn);
 				conn_seq(conn, + 1);
 				next = TCP_SYN_SENT;
 				tcp_conn_ref(conn);
@@ -2965,6 +3655,9 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca.ops = conn->accepted_conn->ca.ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3054,6 +3747,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_apply(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3137,6 +3831,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th && (th_flags(th) & ACK)) {
+			tcp_sack_update(conn, th_ack(th));
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3158,19 +3856,22 @@ next_state:
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
-
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+				if (!tcp_sack_recovery_start(conn) && conn->unacked_len > 0) {
+					/* Resend the first segment, counted as a retransmission */
+					(void)tcp_send_data_at(conn, 0,
+							       MIN(conn->unacked_len,
+								   conn_mss(conn)),
+							       true);
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) && (len == 0) &&
+				   (conn->dup_ack_cnt > 0)) {
+				/* Fill the next hole reported by the peer */
+				tcp_sack_recovery(conn);
 			}
 		}
 #endif
@@ -3252,6 +3953,9 @@ next_state:
 				break;
 			}
 
+			/* Partial acknowledgment during a fast recovery */
+			tcp_sack_recovery(conn);
+
 			ret = tcp_send_queued_data(conn);
 			if (ret < 0 && ret != -ENOBUFS) {
 				tcp_out(conn, RST);
@@ -4563,6 +5267,13 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		ret = set_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOTSUP;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4600,6 +5311,13 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		ret = get_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOTSUP;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4667,6 +5385,12 @@ void net_tcp_init(void)
 		tcp_max_timeout_ms += tcp_max_timeout_ms >> 1;
 	}
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	tcp_ca_default = tcp_ca_find(CONFIG_NET_TCP_CONGESTION_DEFAULT_NAME);
+	NET_ASSERT(tcp_ca_default != NULL, "No congestion control algorithm %s",
+		   CONFIG_NET_TCP_CONGESTION_DEFAULT_NAME);
+#endif
+
 	k_thread_name_set(&tcp_work_q.thread, "tcp_work");
 	NET_DBG("Workq started. Thread ID: %p", &tcp_work_q.thread);
 }
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Model based congestion control after BBR (version 1). The bottleneck
+ * bandwidth is the largest delivery rate of the last ten round trips and the
+ * propagation delay the smallest round trip time of the last ten seconds.
+ * Data is paced at a multiple of the bandwidth and the data in flight is
+ * limited to twice the bandwidth delay product.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+/* Gains in 1/256 */
+#define BBR_UNIT 256
+/* 2 / ln(2), doubles the rate every round trip */
+#define BBR_HIGH_GAIN 739
+/* ln(2) / 2, drains the queue built in the startup */
+#define BBR_DRAIN_GAIN 89
+#define BBR_CWND_GAIN 512
+
+/* Bandwidth samples are kept for two periods of this many rounds */
+#define BBR_BW_ROUNDS 5
+/* Rounds without a 25 % bandwidth growth before the pipe is full */
+#define BBR_FULL_BW_ROUNDS 3
+
+#define BBR_MIN_RTT_WIN_MS 10000
+#define BBR_PROBE_RTT_MS 200
+#define BBR_MIN_SEGMENTS 4
+
+enum bbr_mode {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+/* Probe for more bandwidth, drain the queue it built, then cruise */
+static const uint16_t bbr_cycle_gain[] = {
+	BBR_UNIT * 5 / 4, BBR_UNIT * 3 / 4,
+	BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT,
+};
+
+struct tcp_bbr {
+	/* Largest delivery rates of the current and previous period */
+	uint32_t bw[2]; /* bytes per second */
+	uint32_t full_bw;
+	uint32_t min_rtt_us;
+	uint32_t min_rtt_stamp; /* ms */
+	uint32_t cycle_stamp; /* us */
+	uint32_t probe_rtt_done; /* ms */
+	uint32_t prior_cwnd;
+	uint16_t round;
+	uint8_t mode;
+	uint8_t cycle_idx;
+	uint8_t full_bw_cnt;
+	bool full_bw_reached : 1;
+};
+
+BUILD_ASSERT(sizeof(struct tcp_bbr) <= TCP_CA_PRIV_SIZE);
+
+static const char *const bbr_mode_str[] = {
+	[BBR_STARTUP] = "startup",
+	[BBR_DRAIN] = "drain",
+	[BBR_PROBE_BW] = "probe_bw",
+	[BBR_PROBE_RTT] = "probe_rtt",
+};
+
+static uint32_t bbr_max_bw(struct tcp_bbr *bbr)
+{
+	return MAX(bbr->bw[0], bbr->bw[1]);
+}
+
+/* Bandwidth delay product, scaled by the gain */
+static uint32_t bbr_bdp(struct tcp_bbr *bbr, uint32_t gain)
+{
+	uint64_t bdp = (uint64_t)bbr_max_bw(bbr) * bbr->min_rtt_us / USEC_PER_SEC;
+
+	return MIN(bdp * gain / BBR_UNIT, TCP_MAX_WIN);
+}
+
+static void bbr_set_mode(struct tcp *conn, enum bbr_mode mode)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	bbr->mode = mode;
+
+	NET_DBG("conn: %p, ca bbr %s, bw=%u, min_rtt=%u us, cwnd=%u", conn,
+		bbr_mode_str[mode], bbr_max_bw(bbr), bbr->min_rtt_us,
+		conn->ca.cwnd);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	conn->ca.cwnd = tcp_ca_initial_window(conn);
+	conn->ca.ssthresh = TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0U;
+
+	bbr_set_mode(conn, BBR_STARTUP);
+}
+
+/* Losses are not taken as a sign of congestion, the model sets the rate */
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	NET_DBG("conn: %p, ca bbr fast_retransmit, cwnd=%u", conn,
+		conn->ca.cwnd);
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	/* Restart from a small window, but keep the model */
+	bbr->prior_cwnd = MAX(bbr->prior_cwnd, conn->ca.cwnd);
+	conn->ca.cwnd = BBR_MIN_SEGMENTS * conn_mss(conn);
+
+	NET_DBG("conn: %p, ca bbr timeout, cwnd=%u", conn, conn->ca.cwnd);
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+}
+
+static void bbr_check_full_bw(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	uint32_t bw = bbr_max_bw(bbr);
+
+	if (bbr->full_bw_reached) {
+		return;
+	}
+
+	if ((uint64_t)bw * 4U >= (uint64_t)bbr->full_bw * 5U) {
+		bbr->full_bw = bw;
+		bbr->full_bw_cnt = 0U;
+		return;
+	}
+
+	if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+		bbr->full_bw_reached = true;
+	}
+}
+
+static void tcp_bbr_rtt_sample(struct tcp *conn, uint32_t rtt_us,
+			       uint32_t delivered)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	uint32_t now = k_uptime_get_32();
+	uint64_t rate;
+
+	rtt_us = MAX(rtt_us, 1U);
+
+	/* One timed segment per round trip, so every sample starts a round */
+	if (++bbr->round % BBR_BW_ROUNDS == 0U) {
+		bbr->bw[1] = bbr->bw[0];
+		bbr->bw[0] = 0U;
+	}
+
+	rate = (uint64_t)delivered * USEC_PER_SEC / rtt_us;
+	bbr->bw[0] = MAX(bbr->bw[0], MIN(rate, UINT32_MAX));
+
+	if (bbr->min_rtt_us == 0U || rtt_us <= bbr->min_rtt_us) {
+		bbr->min_rtt_us = rtt_us;
+		bbr->min_rtt_stamp = now;
+	} else if (now - bbr->min_rtt_stamp > BBR_MIN_RTT_WIN_MS &&
+		   bbr->mode != BBR_PROBE_RTT) {
+		/* Drain the pipe for a while to see the propagation delay */
+		bbr->min_rtt_us = rtt_us;
+		bbr->min_rtt_stamp = now;
+		bbr->prior_cwnd = conn->ca.cwnd;
+		bbr->probe_rtt_done = now + BBR_PROBE_RTT_MS;
+		bbr_set_mode(conn, BBR_PROBE_RTT);
+	}
+
+	if (bbr->mode == BBR_STARTUP) {
+		bbr_check_full_bw(conn);
+
+		if (bbr->full_bw_reached) {
+			bbr_set_mode(conn, BBR_DRAIN);
+		}
+	}
+}
+
+static void bbr_update_mode(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	uint32_t now_us = tcp_now_us();
+
+	switch (bbr->mode) {
+	case BBR_DRAIN:
+		if (conn->unacked_len <= bbr_bdp(bbr, BBR_UNIT)) {
+			bbr->cycle_idx = 0U;
+			bbr->cycle_stamp = now_us;
+			bbr_set_mode(conn, BBR_PROBE_BW);
+		}
+		break;
+	case BBR_PROBE_BW:
+		if (now_us - bbr->cycle_stamp > bbr->min_rtt_us) {
+			bbr->cycle_idx = (bbr->cycle_idx + 1U) %
+					 ARRAY_SIZE(bbr_cycle_gain);
+			bbr->cycle_stamp = now_us;
+		}
+		break;
+	case BBR_PROBE_RTT:
+		if ((int32_t)(k_uptime_get_32() - bbr->probe_rtt_done) >= 0) {
+			bbr->min_rtt_stamp = k_uptime_get_32();
+			conn->ca.cwnd = MAX(conn->ca.cwnd, bbr->prior_cwnd);
+			bbr->cycle_stamp = now_us;
+			bbr_set_mode(conn, bbr->full_bw_reached ? BBR_PROBE_BW :
+				     BBR_STARTUP);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	uint32_t min_cwnd = BBR_MIN_SEGMENTS * conn_mss(conn);
+	uint32_t pacing_gain = BBR_UNIT;
+	uint32_t cwnd_gain = BBR_CWND_GAIN;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+	uint64_t rate;
+
+	bbr_update_mode(conn);
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		pacing_gain = BBR_HIGH_GAIN;
+		cwnd_gain = BBR_HIGH_GAIN;
+		break;
+	case BBR_DRAIN:
+		pacing_gain = BBR_DRAIN_GAIN;
+		cwnd_gain = BBR_HIGH_GAIN;
+		break;
+	case BBR_PROBE_BW:
+		pacing_gain = bbr_cycle_gain[bbr->cycle_idx];
+		break;
+	default:
+		break;
+	}
+
+	/* Not paced until the first bandwidth sample */
+	if (bbr_max_bw(bbr) == 0U) {
+		conn->ca.cwnd = MIN(cwnd + acked_len, TCP_MAX_WIN);
+		return;
+	}
+
+	rate = (uint64_t)bbr_max_bw(bbr) * pacing_gain / BBR_UNIT;
+
+	/* The first samples are taken while little data is in flight, they
+	 * must not hold the startup back.
+	 */
+	if (!bbr->full_bw_reached) {
+		rate = MAX(rate, (uint64_t)cwnd * BBR_HIGH_GAIN / BBR_UNIT *
+				 USEC_PER_SEC / bbr->min_rtt_us);
+	}
+
+	conn->pacing_rate = MIN(rate, UINT32_MAX);
+
+	target = MAX(bbr_bdp(bbr, cwnd_gain), min_cwnd);
+
+	if (bbr->full_bw_reached) {
+		cwnd = MIN(cwnd + acked_len, target);
+	} else if (cwnd < target) {
+		cwnd += acked_len;
+	}
+
+	if (bbr->mode == BBR_PROBE_RTT) {
+		cwnd = MIN(cwnd, min_cwnd);
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, min_cwnd, TCP_MAX_WIN);
+}
+
+TCP_CA_REGISTER(bbr, tcp_bbr_init, tcp_bbr_fast_retransmit, tcp_bbr_timeout,
+		tcp_bbr_dup_ack, tcp_bbr_pkts_acked, tcp_bbr_rtt_sample);
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, RFC 9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor, 0.7 in 1/1024 */
+#define CUBIC_BETA 717
+
+/* Window increase of the Reno friendly region, 3 * (1 - beta) / (1 + beta)
+ * in 1/1024
+ */
+#define CUBIC_ALPHA 542
+
+/* The window grows by C * t^3 segments, with C = 0.4 and t in seconds, that
+ * is 4 * t^3 / 10^10 segments with t in milliseconds.
+ */
+#define CUBIC_C_NUM 4
+#define CUBIC_C_DEN 10000000000ULL
+
+/* Bound of the time in the cubic function, so that its cube fits */
+#define CUBIC_MAX_T_MS 100000
+
+struct tcp_cubic {
+	/* Window before the last reduction */
+	uint32_t w_max;
+	/* Window New Reno would have */
+	uint32_t w_est;
+	/* Time to grow back to w_max */
+	uint32_t k_ms;
+	/* Start of the congestion avoidance, 0 if not started */
+	uint32_t epoch_start;
+	uint32_t min_rtt_ms;
+};
+
+BUILD_ASSERT(sizeof(struct tcp_cubic) <= TCP_CA_PRIV_SIZE);
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, w_max=%u, k=%u ms",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh, cubic->w_max,
+		cubic->k_ms);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = tcp_ca_initial_window(conn);
+	conn->ca.ssthresh = TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0U;
+	tcp_cubic_log(conn, "init");
+}
+
+/* Reduce the slow start threshold after a loss */
+static void tcp_cubic_loss(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	uint32_t flight = MIN(conn->ca.cwnd, (uint32_t)conn->unacked_len);
+
+	/* Fast convergence, give up bandwidth when the window did not get
+	 * back to where it was at the previous loss.
+	 */
+	if (flight < cubic->w_max) {
+		cubic->w_max = (uint64_t)flight * (1024U + CUBIC_BETA) / 2048U;
+	} else {
+		cubic->w_max = flight;
+	}
+
+	conn->ca.ssthresh = MAX((uint64_t)flight * CUBIC_BETA / 1024U,
+				2U * conn_mss(conn));
+	cubic->epoch_start = 0U;
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0U) {
+		tcp_cubic_loss(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn->ca.ssthresh + 3U * conn_mss(conn);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_loss(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0U;
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), TCP_MAX_WIN);
+}
+
+/* Window growth in congestion avoidance */
+static void tcp_cubic_update(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t mss = conn_mss(conn);
+	int64_t target;
+	int64_t d;
+
+	if (cubic->epoch_start == 0U) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			cubic->k_ms = cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						 CUBIC_C_DEN / CUBIC_C_NUM / mss);
+		} else {
+			cubic->w_max = cwnd;
+			cubic->k_ms = 0U;
+		}
+
+		tcp_cubic_log(conn, "epoch");
+	}
+
+	/* Window one round trip time ahead */
+	d = MIN(now - cubic->epoch_start + cubic->min_rtt_ms, CUBIC_MAX_T_MS);
+	d -= cubic->k_ms;
+
+	target = cubic->w_max + d * d * d / 10000 * CUBIC_C_NUM * mss /
+			       (int64_t)(CUBIC_C_DEN / 10000);
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2U);
+
+	cwnd += (uint64_t)(target - cwnd) * acked_len / cwnd;
+
+	/* Never grow slower than New Reno would */
+	cubic->w_est += (uint64_t)CUBIC_ALPHA * acked_len * mss / 1024U /
+			conn->ca.cwnd;
+	cwnd = MAX(cwnd, cubic->w_est);
+
+	conn->ca.cwnd = MIN(cwnd, TCP_MAX_WIN);
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes != 0U) {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0U;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd - conn_mss(conn));
+		}
+	} else if (conn->ca.cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(conn->ca.cwnd + MIN(acked_len, conn_mss(conn)),
+				    TCP_MAX_WIN);
+	} else {
+		tcp_cubic_update(conn, acked_len);
+	}
+
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+static void tcp_cubic_rtt_sample(struct tcp *conn, uint32_t rtt_us,
+				 uint32_t delivered)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	uint32_t rtt_ms = rtt_us / USEC_PER_MSEC;
+
+	ARG_UNUSED(delivered);
+
+	if (cubic->min_rtt_ms == 0U || rtt_ms < cubic->min_rtt_ms) {
+		cubic->min_rtt_ms = MAX(rtt_ms, 1U);
+	}
+}
+
+TCP_CA_REGISTER(cubic, tcp_cubic_init, tcp_cubic_fast_retransmit,
+		tcp_cubic_timeout, tcp_cubic_dup_ack, tcp_cubic_pkts_acked,
+		tcp_cubic_rtt_sample);
@@ -146,7 +146,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -227,30 +227,114 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Largest window scale shift allowed by RFC 7323 */
+#define NET_TCP_WINDOW_SCALE_MAX 14
+
+/* Number of SACK blocks that fit in the option space */
+#define NET_TCP_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	uint8_t sack_count;
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+#endif
 };
 
+/* Largest window that can be advertised */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#define TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_WINDOW_SCALE_MAX)
+#else
+#define TCP_MAX_WIN UINT16_MAX
+#endif
+
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Longest congestion control algorithm name, with the terminating nul */
+#define TCP_CA_NAME_MAX 16
+
+/* Congestion control algorithm, called with the connection locked */
+struct tcp_ca_ops {
+	/* Name used with the TCP_CONGESTION socket option */
+	const char *name;
+	/* The connection is established, set the initial window */
+	void (*init)(struct tcp *conn);
+	/* Three duplicate acknowledgments triggered a fast retransmit */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* The retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/* A duplicate acknowledgment was received */
+	void (*dup_ack)(struct tcp *conn);
+	/* Data was acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+	/* Optional, a round trip time sample, with the amount of data
+	 * acknowledged during that round trip.
+	 */
+	void (*rtt_sample)(struct tcp *conn, uint32_t rtt_us,
+			   uint32_t delivered);
 };
+
+#define TCP_CA_REGISTER(_name, _init, _fast_retransmit, _timeout,	\
+			_dup_ack, _pkts_acked, _rtt_sample)		\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops,		\
+					     __tcp_ca_##_name) = {	\
+		.name = STRINGIFY(_name),				\
+		.init = _init,						\
+		.fast_retransmit = _fast_retransmit,			\
+		.timeout = _timeout,					\
+		.dup_ack = _dup_ack,					\
+		.pkts_acked = _pkts_acked,				\
+		.rtt_sample = _rtt_sample,				\
+	}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) || \
+	defined(CONFIG_NET_TCP_CONGESTION_BBR)
+/* Room for the state of the algorithms, see tcp_ca_priv() */
+#define TCP_CA_PRIV_SIZE 64
 #endif
 
-struct tcp;
+struct tcp_congestion_avoidance {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+	/* Data acknowledged since the connection was established */
+	uint32_t delivered;
+	/* Segment timed for a round trip time sample, see tcp_now_us() */
+	uint32_t rtt_seq;
+	uint32_t rtt_start;
+	uint32_t rtt_delivered;
+	/* Data sent when the last loss was detected */
+	uint32_t recover;
+	bool rtt_timing : 1;
+	bool in_recovery : 1;
+#ifdef TCP_CA_PRIV_SIZE
+	uint64_t priv[TCP_CA_PRIV_SIZE / sizeof(uint64_t)];
+#endif
+};
+#endif
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -314,16 +398,36 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#ifdef CONFIG_NET_TCP_SACK
+	/* Data the peer reported to hold past the acknowledged data, sorted */
+	struct tcp_sack_block sack_blocks[NET_TCP_SACK_BLOCKS];
+	uint32_t sack_recovery_seq;
+	uint32_t sack_rexmit_seq;
+	uint8_t sack_count;
+	/* Runs of out-of-order data to report to the peer, most recent first */
+	struct tcp_sack_block sack_recv[NET_TCP_SACK_BLOCKS];
+	uint8_t sack_recv_count;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	uint8_t send_win_shift;
+	uint8_t recv_win_shift;
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion_avoidance ca;
+#endif
+#ifdef CONFIG_NET_TCP_PACING
+	struct k_work_delayable pacing_timer;
+	/* Set by the congestion control algorithm, 0 if not paced */
+	uint32_t pacing_rate; /* bytes per second */
+	uint32_t pacing_next; /* time to send the next segment at */
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -339,6 +443,10 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_ok : 1;
+	bool sack_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -359,6 +467,19 @@ struct tcp { /* TCP connection */
 
 typedef void (*net_tcp_cb_t)(struct tcp *conn, void *user_data);
 
+/* Microsecond clock of the round trip time samples, wraps around */
+static inline uint32_t tcp_now_us(void)
+{
+	return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+/* State of the congestion control algorithm of the connection */
+#define tcp_ca_priv(_conn) ((void *)(_conn)->ca.priv)
+
+uint32_t tcp_ca_initial_window(struct tcp *conn);
+#endif
+
 #if defined(CONFIG_NET_TEST)
 void tcp_install_close_cb(struct net_context *ctx,
 			  net_tcp_closed_cb_t cb,
@@ -359,6 +359,7 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	bool is_ipv4_ll_used = false;
 	struct arp_entry *entry;
 	struct in_addr *addr;
+	struct net_ipv4_route_info route;
 
 	if (!pkt || !pkt->buffer) {
 		return NULL;
@@ -377,13 +378,16 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	}
 
 	/* Is the destination in the local network, if not route via
-	 * the gateway address.
+	 * the gateway of the longest matching route, or else via the
+	 * gateway address of the interface.
 	 */
 	if (!current_ip && !is_ipv4_ll_used &&
 	    !net_if_ipv4_addr_mask_cmp(net_pkt_iface(pkt), request_ip)) {
 		struct net_if_ipv4 *ipv4 = net_pkt_iface(pkt)->config.ip.ipv4;
 
-		if (ipv4) {
+		if (net_ipv4_route_lookup(net_pkt_iface(pkt), request_ip, &route)) {
+			addr = &route.gw;
+		} else if (ipv4) {
 			addr = &ipv4->gw;
 			if (net_ipv4_is_addr_unspecified(addr)) {
 				NET_ERR("Gateway not set for iface %d, could not "
@@ -10,14 +10,146 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static void dns_cache_clean(struct dns_cache *cache);
 
-int dns_cache_flush(struct dns_cache *cache)
+/* FNV-1a */
+static uint32_t dns_cache_hash(char const *query)
 {
-	k_mutex_lock(cache->lock, K_FOREVER);
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash = (hash ^ (uint8_t)*query++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static inline sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+static int dns_cache_family(enum dns_query_type type, sa_family_t *family)
+{
+	if (type == DNS_QUERY_TYPE_A) {
+		*family = AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		*family = AF_INET6;
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_reset(struct dns_cache *cache)
+{
+	sys_slist_init(&cache->free_list);
+	sys_dlist_init(&cache->expiry_list);
+
 	for (size_t i = 0; i < cache->size; i++) {
+		sys_slist_init(&cache->buckets[i]);
 		cache->entries[i].in_use = false;
+		sys_slist_append(&cache->free_list, &cache->entries[i].bucket_node);
+	}
+
+	cache->initialized = true;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_init_locked(struct dns_cache *cache)
+{
+	if (!cache->initialized) {
+		dns_cache_reset(cache);
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_entry_free(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	(void)sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->bucket_node);
+	sys_dlist_remove(&entry->expiry_node);
+	entry->in_use = false;
+	sys_slist_prepend(&cache->free_list, &entry->bucket_node);
+}
+
+/* Needs to be called when lock is already acquired. Takes a free entry, or
+ * the one closest to expiry if none is free.
+ */
+static struct dns_cache_entry *dns_cache_entry_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+	sys_snode_t *node;
+
+	node = sys_slist_get(&cache->free_list);
+	if (node == NULL) {
+		entry = SYS_DLIST_PEEK_HEAD_CONTAINER(&cache->expiry_list, entry, expiry_node);
+		NET_DBG("Overwrite \"%s\"", entry->query);
+		dns_cache_entry_free(cache, entry);
+		node = sys_slist_get(&cache->free_list);
 	}
+
+	return CONTAINER_OF(node, struct dns_cache_entry, bucket_node);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_entry_insert(struct dns_cache *cache, struct dns_cache_entry *entry,
+				   char const *query, uint32_t hash, uint32_t ttl)
+{
+	sys_dnode_t *node;
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->hash = hash;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->in_use = true;
+
+	sys_slist_append(dns_cache_bucket(cache, hash), &entry->bucket_node);
+
+	/* Most records have similar TTLs, so look for the place from the tail */
+	node = sys_dlist_peek_tail(&cache->expiry_list);
+	while (node != NULL &&
+	       sys_timepoint_cmp(CONTAINER_OF(node, struct dns_cache_entry, expiry_node)->expiry,
+				 entry->expiry) > 0) {
+		node = sys_dlist_peek_prev(&cache->expiry_list, node);
+	}
+
+	if (node == NULL) {
+		sys_dlist_prepend(&cache->expiry_list, &entry->expiry_node);
+	} else if (sys_dlist_is_tail(&cache->expiry_list, node)) {
+		sys_dlist_append(&cache->expiry_list, &entry->expiry_node);
+	} else {
+		sys_dlist_insert(node->next, &entry->expiry_node);
+	}
+}
+
+/* Needs to be called when lock is already acquired. Removes the entries of
+ * the query for the given family, or all of them if family is AF_UNSPEC.
+ */
+static void dns_cache_remove_family(struct dns_cache *cache, char const *query, uint32_t hash,
+				    sa_family_t family, bool negative)
+{
+	struct dns_cache_entry *entry, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, bucket_node) {
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		if (family != AF_UNSPEC &&
+		    (entry->data.ai_family != family || entry->negative != negative)) {
+			continue;
+		}
+
+		dns_cache_entry_free(cache, entry);
+	}
+}
+
+int dns_cache_flush(struct dns_cache *cache)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
+	dns_cache_reset(cache);
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,9 +158,8 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	struct dns_cache_entry *entry;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
@@ -41,32 +172,64 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
+	dns_cache_init_locked(cache);
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	/* The query has an address of this family after all */
+	dns_cache_remove_family(cache, query, hash, addrinfo->ai_family, true);
+
+	entry = dns_cache_entry_alloc(cache);
+	entry->data = *addrinfo;
+	entry->negative = false;
+	dns_cache_entry_insert(cache, entry, query, hash, ttl);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	sa_family_t family;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0 || dns_cache_family(type, &family) < 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_init_locked(cache);
+	dns_cache_clean(cache);
+
+	/* Replaces the addresses and the previous negative entry */
+	dns_cache_remove_family(cache, query, hash, family, false);
+	dns_cache_remove_family(cache, query, hash, family, true);
+
+	entry = dns_cache_entry_alloc(cache);
+	memset(&entry->data, 0, sizeof(entry->data));
+	entry->data.ai_family = family;
+	entry->negative = true;
+	dns_cache_entry_insert(cache, entry, query, hash, ttl);
 
 	k_mutex_unlock(cache->lock);
 
@@ -85,34 +248,29 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
+	dns_cache_init_locked(cache);
 	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
-	}
+	dns_cache_remove_family(cache, query, dns_cache_hash(query), AF_UNSPEC, false);
 
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry;
+	bool negative = false;
 	size_t found = 0;
 	sa_family_t family;
+	uint32_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (type == DNS_QUERY_TYPE_A) {
-		family = AF_INET;
-	} else if (type == DNS_QUERY_TYPE_AAAA) {
-		family = AF_INET6;
-	} else {
+	if (dns_cache_family(type, &family) < 0) {
 		return -EINVAL;
 	}
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
@@ -122,25 +280,29 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
+	dns_cache_init_locked(cache);
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, bucket_node) {
+		if (entry->hash != hash || entry->data.ai_family != family) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
+		if (entry->negative) {
+			negative = true;
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -153,22 +315,29 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	}
 
 	if (found == 0) {
+		if (negative) {
+			NET_DBG("\"%s\" has no address", query);
+			return -ENODATA;
+		}
+
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
 /* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+static void dns_cache_clean(struct dns_cache *cache)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	struct dns_cache_entry *entry;
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+	/* The entries are ordered by expiry, stop at the first one still valid */
+	while ((entry = SYS_DLIST_PEEK_HEAD_CONTAINER(&cache->expiry_list, entry,
+						      expiry_node)) != NULL) {
+		if (!sys_timepoint_expired(entry->expiry)) {
+			break;
 		}
+
+		NET_DBG("Remove \"%s\"", entry->query);
+		dns_cache_entry_free(cache, entry);
 	}
 }
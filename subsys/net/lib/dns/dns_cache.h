@@ -22,13 +22,24 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Hash bucket of the query, or free list when not in use */
+	sys_snode_t bucket_node;
+	/* Entries in use, ordered by expiry */
+	sys_dnode_t expiry_node;
+	uint32_t hash;
+	/* The query has no address of the data.ai_family type */
+	bool negative;
 	bool in_use;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	sys_slist_t *buckets;
+	sys_slist_t free_list;
+	sys_dlist_t expiry_list;
 	struct k_mutex *lock;
+	bool initialized;
 };
 
 /**
@@ -43,8 +54,10 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .buckets = name##_buckets, .size = cache_size,          \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -71,6 +84,20 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query has
+ * no address of the given type (RFC 2308).
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Query type which has no address.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -92,10 +119,11 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
  * A cache miss will therefore return a 0.
  * @retval On error a negative value is returned.
+ * -ENODATA means the query is cached as having no address of the given type.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
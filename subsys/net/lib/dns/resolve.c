@@ -779,6 +779,20 @@ static inline void invoke_query_callback(int status,
 	if (pending_query->query != NULL && pending_query->cb != NULL)  {
 		pending_query->cb(status, info, pending_query->user_data);
 	}
+
+	if (pending_query->ctx == NULL) {
+		return;
+	}
+
+	/* The queries waiting for the answer to this one get it too */
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *follower = &pending_query->ctx->queries[i];
+
+		if (follower->leader == pending_query && follower->query != NULL &&
+		    follower->cb != NULL) {
+			follower->cb(status, info, follower->user_data);
+		}
+	}
 }
 
 /* Release a query slot reserved by get_cb_slot().
@@ -791,6 +805,14 @@ static void release_query(struct dns_pending_query *pending_query)
 {
 	int busy = k_work_cancel_delayable(&pending_query->timer);
 
+	pending_query->leader = NULL;
+
+	for (int i = 0; pending_query->ctx != NULL && i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (pending_query->ctx->queries[i].leader == pending_query) {
+			release_query(&pending_query->ctx->queries[i]);
+		}
+	}
+
 	/* If the work item is no longer pending we're done. */
 	if (busy == 0) {
 		/* All done. */
@@ -1135,6 +1157,16 @@ rr_qtype_aaaa:
 	}
 
 	if (items == 0) {
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+		if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0 &&
+		    dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+			(void)dns_cache_add_negative(&dns_cache,
+						     ctx->queries[*query_idx].query,
+						     ctx->queries[*query_idx].query_type,
+						     CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+		}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1152,7 +1184,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 		    uint16_t *query_hash)
 {
 	/* Helper struct to track the dns msg received from the server */
-	struct dns_msg_t dns_msg;
+	struct dns_msg_t dns_msg = { 0 };
 	int data_len;
 	int ret;
 	int query_idx = -1;
@@ -1322,9 +1354,171 @@ static int dns_write(struct dns_resolve_context *ctx,
 	return 0;
 }
 
+/* If mDNS is enabled, then .local queries are sent only to the multicast
+ * address, with id 0, see RFC 6762 ch. 18.1 for details.
+ */
+static bool query_is_mdns(const char *query)
+{
+	const char *ptr;
+
+	if (!IS_ENABLED(CONFIG_MDNS_RESOLVER)) {
+		return false;
+	}
+
+	ptr = strrchr(query, '.');
+
+	/* Note that we memcmp() the \0 here too */
+	return ptr && !memcmp(ptr, (const void *){ ".local" }, 7);
+}
+
+/* Must be invoked with context lock held. Sends the query of a slot, with
+ * the id already set in the slot.
+ */
+static int send_query(struct dns_resolve_context *ctx, int slot, bool mdns_query)
+{
+	struct net_buf *dns_data;
+	struct net_buf *dns_qname = NULL;
+	int failure = 0;
+	uint8_t hop_limit;
+	int ret, j;
+
+	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
+	if (!dns_data) {
+		return -ENOMEM;
+	}
+
+	dns_qname = net_buf_alloc(&dns_qname_pool, ctx->buf_timeout);
+	if (!dns_qname) {
+		ret = -ENOMEM;
+		goto quit;
+	}
+
+	ret = dns_msg_pack_qname(&dns_qname->len, dns_qname->data,
+				CONFIG_DNS_RESOLVER_MAX_QUERY_LEN, ctx->queries[slot].query);
+	if (ret < 0) {
+		goto quit;
+	}
+
+	for (j = 0; j < SERVER_COUNT; j++) {
+		hop_limit = 0U;
+
+		if (ctx->servers[j].sock < 0) {
+			continue;
+		}
+
+		/* If mDNS is enabled, then send .local queries only to
+		 * a well known multicast mDNS server address.
+		 */
+		if (IS_ENABLED(CONFIG_MDNS_RESOLVER) && mdns_query &&
+		    !ctx->servers[j].is_mdns) {
+			continue;
+		}
+
+		/* If llmnr is enabled, then all the queries are sent to
+		 * LLMNR multicast address unless it is a mDNS query.
+		 */
+		if (!mdns_query && IS_ENABLED(CONFIG_LLMNR_RESOLVER)) {
+			if (!ctx->servers[j].is_llmnr) {
+				continue;
+			}
+
+			hop_limit = 1U;
+		}
+
+		ret = dns_write(ctx, j, slot, dns_data->data,
+				net_buf_max_len(dns_data),
+				net_buf_max_len(dns_data),
+				dns_qname, hop_limit);
+		if (ret < 0) {
+			failure++;
+			continue;
+		}
+
+		/* Do one concurrent query only for each name resolve.
+		 * TODO: Change the i (query index) to do multiple concurrent
+		 *       to each server.
+		 */
+		break;
+	}
+
+	if (failure) {
+		NET_DBG("DNS query failed %d times", failure);
+
+		if (failure == j) {
+			ret = -ENOENT;
+			goto quit;
+		}
+	}
+
+	ret = 0;
+
+quit:
+	net_buf_unref(dns_data);
+
+	if (dns_qname) {
+		net_buf_unref(dns_qname);
+	}
+
+	return ret;
+}
+
+/* Must be invoked with context lock held. The queries waiting for the answer
+ * of a query that is cancelled or timed out do not end with it. The first
+ * one is sent in its place, before its own timeout, and the others wait for
+ * its answer instead.
+ */
+static void promote_follower(struct dns_resolve_context *ctx,
+			     struct dns_pending_query *leader)
+{
+	struct dns_pending_query *new_leader = NULL;
+	k_ticks_t ticks_left;
+	int ret;
+
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *follower = &ctx->queries[i];
+
+		if (follower->leader != leader) {
+			continue;
+		}
+
+		if (new_leader == NULL && ctx->state == DNS_RESOLVE_CONTEXT_ACTIVE &&
+		    follower->query != NULL && follower->cb != NULL) {
+			new_leader = follower;
+			follower->leader = NULL;
+			continue;
+		}
+
+		follower->leader = new_leader;
+	}
+
+	if (new_leader == NULL) {
+		return;
+	}
+
+	NET_DBG("[%u] sends the query of DNS id %u", ARRAY_INDEX(ctx->queries, new_leader),
+		leader->id);
+
+	/* Sending the query starts its timer again, with what is left of
+	 * the original timeout.
+	 */
+	ticks_left = k_work_delayable_remaining_get(&new_leader->timer);
+	new_leader->timeout = K_TICKS(ticks_left);
+
+	ret = send_query(ctx, ARRAY_INDEX(ctx->queries, new_leader), false);
+	if (ret == 0) {
+		return;
+	}
+
+	invoke_query_callback(DNS_EAI_SYSTEM, NULL, new_leader);
+	release_query(new_leader);
+}
+
 /* Must be invoked with context lock held */
 static void dns_resolve_cancel_slot(struct dns_resolve_context *ctx, int slot)
 {
+	/* Only this query is cancelled, not the ones waiting for its answer */
+	promote_follower(ctx, &ctx->queries[slot]);
+
 	invoke_query_callback(DNS_EAI_CANCELED, NULL, &ctx->queries[slot]);
 
 	release_query(&ctx->queries[slot]);
@@ -1480,6 +1674,65 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+/* Must be invoked with context lock held. Finds a query for the same name
+ * and type which was sent and is waiting for its answer.
+ */
+static struct dns_pending_query *find_pending_query(struct dns_resolve_context *ctx,
+						    const char *query,
+						    enum dns_query_type type)
+{
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *pending_query = &ctx->queries[i];
+
+		if (check_query_active(pending_query, false) &&
+		    pending_query->query != NULL &&
+		    pending_query->leader == NULL &&
+		    pending_query->query_hash != 0 &&
+		    pending_query->query_type == type &&
+		    strcmp(pending_query->query, query) == 0) {
+			return pending_query;
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be invoked with context lock held. The query in slot gets the
+ * answer of its leader instead of being sent. It keeps its own timeout,
+ * and an id which lets the caller cancel it alone. The id only goes on the
+ * wire if the query is sent after all, in place of its leader.
+ */
+static int follow_pending_query(struct dns_resolve_context *ctx, int slot,
+				uint16_t *dns_id)
+{
+	struct dns_pending_query *pending_query = &ctx->queries[slot];
+	uint16_t id;
+	int ret;
+
+	pending_query->id = 0U;
+
+	do {
+		id = sys_rand16_get();
+	} while (id == 0U || get_slot_by_id(ctx, id, 0) >= 0);
+
+	pending_query->id = id;
+	pending_query->query_hash = pending_query->leader->query_hash;
+
+	ret = k_work_reschedule(&pending_query->timer, pending_query->timeout);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (dns_id) {
+		*dns_id = id;
+	}
+
+	NET_DBG("[%u] waits for the answer of DNS id %u", slot,
+		pending_query->leader->id);
+
+	return 0;
+}
+
 int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 			      const char *query,
 			      enum dns_query_type type,
@@ -1490,13 +1743,9 @@ int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 			      bool use_cache)
 {
 	k_timeout_t tout;
-	struct net_buf *dns_data = NULL;
-	struct net_buf *dns_qname = NULL;
 	struct sockaddr addr;
-	int ret, i = -1, j = 0;
-	int failure = 0;
-	bool mdns_query = false;
-	uint8_t hop_limit;
+	int ret, i = -1;
+	bool mdns_query;
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
@@ -1577,9 +1826,14 @@ try_resolve:
 
 			return 0;
 		}
+
+		if (ret == -ENODATA) {
+			/* The name is known not to exist */
+			cb(DNS_EAI_NODATA, NULL, user_data);
+
+			return 0;
+		}
 	}
-#else
-	ARG_UNUSED(use_cache);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	k_mutex_lock(&ctx->lock, K_FOREVER);
@@ -1602,42 +1856,27 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].leader = NULL;
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
-	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
-	if (!dns_data) {
-		ret = -ENOMEM;
-		goto quit;
-	}
-
-	dns_qname = net_buf_alloc(&dns_qname_pool, ctx->buf_timeout);
-	if (!dns_qname) {
-		ret = -ENOMEM;
-		goto quit;
-	}
-
-	ret = dns_msg_pack_qname(&dns_qname->len, dns_qname->data,
-				CONFIG_DNS_RESOLVER_MAX_QUERY_LEN, ctx->queries[i].query);
-	if (ret < 0) {
-		goto quit;
+	/* An mDNS query is sent with id 0, so it could not be sent in place
+	 * of another one and keep the id given to the caller.
+	 */
+	if (use_cache && !query_is_mdns(query)) {
+		ctx->queries[i].leader = find_pending_query(ctx, query, type);
+		if (ctx->queries[i].leader != NULL) {
+			ret = follow_pending_query(ctx, i, dns_id);
+			goto quit;
+		}
 	}
 
 	ctx->queries[i].id = sys_rand16_get();
 
-	/* If mDNS is enabled, then send .local queries only to multicast
-	 * address. For mDNS the id should be set to 0, see RFC 6762 ch. 18.1
-	 * for details.
-	 */
-	if (IS_ENABLED(CONFIG_MDNS_RESOLVER)) {
-		const char *ptr = strrchr(query, '.');
-
-		/* Note that we memcmp() the \0 here too */
-		if (ptr && !memcmp(ptr, (const void *){ ".local" }, 7)) {
-			mdns_query = true;
-
-			ctx->queries[i].id = 0;
-		}
+	/* For mDNS the id should be set to 0 */
+	mdns_query = query_is_mdns(query);
+	if (mdns_query) {
+		ctx->queries[i].id = 0;
 	}
 
 	/* Do this immediately after calculating the Id so that the unit
@@ -1649,58 +1888,7 @@ try_resolve:
 		NET_DBG("DNS id will be %u", *dns_id);
 	}
 
-	for (j = 0; j < SERVER_COUNT; j++) {
-		hop_limit = 0U;
-
-		if (ctx->servers[j].sock < 0) {
-			continue;
-		}
-
-		/* If mDNS is enabled, then send .local queries only to
-		 * a well known multicast mDNS server address.
-		 */
-		if (IS_ENABLED(CONFIG_MDNS_RESOLVER) && mdns_query &&
-		    !ctx->servers[j].is_mdns) {
-			continue;
-		}
-
-		/* If llmnr is enabled, then all the queries are sent to
-		 * LLMNR multicast address unless it is a mDNS query.
-		 */
-		if (!mdns_query && IS_ENABLED(CONFIG_LLMNR_RESOLVER)) {
-			if (!ctx->servers[j].is_llmnr) {
-				continue;
-			}
-
-			hop_limit = 1U;
-		}
-
-		ret = dns_write(ctx, j, i, dns_data->data,
-				net_buf_max_len(dns_data),
-				net_buf_max_len(dns_data),
-				dns_qname, hop_limit);
-		if (ret < 0) {
-			failure++;
-			continue;
-		}
-
-		/* Do one concurrent query only for each name resolve.
-		 * TODO: Change the i (query index) to do multiple concurrent
-		 *       to each server.
-		 */
-		break;
-	}
-
-	if (failure) {
-		NET_DBG("DNS query failed %d times", failure);
-
-		if (failure == j) {
-			ret = -ENOENT;
-			goto quit;
-		}
-	}
-
-	ret = 0;
+	ret = send_query(ctx, i, mdns_query);
 
 quit:
 	if (ret < 0) {
@@ -1713,14 +1901,6 @@ quit:
 		}
 	}
 
-	if (dns_data) {
-		net_buf_unref(dns_data);
-	}
-
-	if (dns_qname) {
-		net_buf_unref(dns_qname);
-	}
-
 fail:
 	k_mutex_unlock(&ctx->lock);
 
@@ -44,6 +44,29 @@ const char *http_compression_text(enum http_compression compression);
 int http_compression_from_text(enum http_compression *compression, const char *text);
 bool compression_value_is_valid(enum http_compression compression);
 
+/* Static file cache */
+#define HTTP_FS_CACHE_ETAG_LEN sizeof("\"01234567-0123456789abcdef-0\"")
+
+struct http_fs_cache_entry;
+
+struct http_fs_cache_file {
+	struct http_fs_cache_entry *entry;
+	/* HTTP/1 response header, directly followed by the data */
+	const char *header;
+	size_t header_len;
+	const uint8_t *data;
+	size_t data_len;
+	const char *etag;
+	enum http_compression compression;
+};
+
+int http_fs_cache_get(const char *fname, const char *content_type,
+		      uint8_t supported_compression, struct http_fs_cache_file *file);
+void http_fs_cache_release(struct http_fs_cache_file *file);
+int http_fs_cache_etag(const char *fname, size_t size, enum http_compression compression,
+		       char *etag);
+bool http_fs_cache_etag_match(const char *if_none_match, const char *etag);
+
 /* Others */
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
@@ -14,6 +14,7 @@
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_interface.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
@@ -750,32 +751,286 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+static bool resource_matches(struct http_resource_desc *resource, const char *path,
+			     int *path_len)
 {
-	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
-		if (skip_this(resource, is_websocket)) {
-			continue;
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		int ret;
+
+		ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
+		if (ret == 0) {
+			*path_len = path_len_without_query(path);
+			return true;
 		}
+	}
 
-		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
-			int ret;
+	if (compare_strings(path, resource->resource) == 0) {
+		NET_DBG("Got match for %s", resource->resource);
 
-			ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
-			if (ret == 0) {
-				*path_len = path_len_without_query(path);
-				return resource->detail;
+		*path_len = strlen(resource->resource);
+		return true;
+	}
+
+	return false;
+}
+
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TREE)
+
+/* Each resource is stored in the node of its literal prefix, the part of the
+ * resource string before the first wildcard character, or the whole string if
+ * there is none. Every resource matching a path has its literal prefix at the
+ * start of the path, so only the nodes found while walking down the path have
+ * to be looked at. The resources they hold are then checked one by one as
+ * without the tree, and the one coming first in the resources of the service
+ * still wins.
+ *
+ * Services and their resources are all defined at build time, so the trees
+ * are built once at boot and only read afterwards, without any lock.
+ */
+
+#define RESOURCE_TREE_MAX_ENTRIES CONFIG_HTTP_SERVER_RESOURCE_TREE_SIZE
+/* A resource adds at most a leaf and a node splitting an edge */
+#define RESOURCE_TREE_MAX_NODES   (2 * CONFIG_HTTP_SERVER_RESOURCE_TREE_SIZE + \
+				   CONFIG_HTTP_SERVER_NUM_SERVICES)
+
+#define RESOURCE_TREE_NONE      UINT16_MAX
+#define RESOURCE_TREE_UNINDEXED (UINT16_MAX - 1)
+
+struct resource_tree_node {
+	/* Edge from the parent, pointing into a resource string */
+	const char *label;
+	uint16_t label_len;
+	uint16_t child;
+	uint16_t sibling;
+	uint16_t entry;
+};
+
+struct resource_tree_entry {
+	struct http_resource_desc *resource;
+	uint16_t next;
+};
+
+static struct resource_tree_node resource_tree_nodes[RESOURCE_TREE_MAX_NODES];
+static struct resource_tree_entry resource_tree_entries[RESOURCE_TREE_MAX_ENTRIES];
+static uint16_t resource_tree_node_count;
+static uint16_t resource_tree_entry_count;
+
+static size_t resource_key_len(const char *resource)
+{
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		return strcspn(resource, "*?[\\");
+	}
+
+	return strlen(resource);
+}
+
+static uint16_t resource_tree_new_node(const char *label, size_t label_len)
+{
+	struct resource_tree_node *node = &resource_tree_nodes[resource_tree_node_count];
+
+	node->label = label;
+	node->label_len = label_len;
+	node->child = RESOURCE_TREE_NONE;
+	node->sibling = RESOURCE_TREE_NONE;
+	node->entry = RESOURCE_TREE_NONE;
+
+	return resource_tree_node_count++;
+}
+
+static uint16_t resource_tree_find_child(uint16_t parent, char c)
+{
+	uint16_t child = resource_tree_nodes[parent].child;
+
+	while (child != RESOURCE_TREE_NONE && resource_tree_nodes[child].label[0] != c) {
+		child = resource_tree_nodes[child].sibling;
+	}
+
+	return child;
+}
+
+static void resource_tree_insert(uint16_t root, struct http_resource_desc *resource)
+{
+	const char *key = resource->resource;
+	size_t key_len = resource_key_len(key);
+	struct resource_tree_entry *entry;
+	struct resource_tree_node *child;
+	uint16_t node = root;
+	uint16_t *link;
+	uint16_t split;
+	size_t pos = 0;
+	size_t common;
+
+	while (pos < key_len) {
+		link = &resource_tree_nodes[node].child;
+		while (*link != RESOURCE_TREE_NONE &&
+		       resource_tree_nodes[*link].label[0] != key[pos]) {
+			link = &resource_tree_nodes[*link].sibling;
+		}
+
+		if (*link == RESOURCE_TREE_NONE) {
+			*link = resource_tree_new_node(&key[pos], key_len - pos);
+			node = *link;
+			break;
+		}
+
+		child = &resource_tree_nodes[*link];
+
+		common = 1;
+		while (common < child->label_len && pos + common < key_len &&
+		       child->label[common] == key[pos + common]) {
+			common++;
+		}
+
+		if (common < child->label_len) {
+			/* Split the edge where the key leaves it */
+			split = resource_tree_new_node(child->label, common);
+			resource_tree_nodes[split].child = *link;
+			resource_tree_nodes[split].sibling = child->sibling;
+			child->label += common;
+			child->label_len -= common;
+			child->sibling = RESOURCE_TREE_NONE;
+			*link = split;
+		}
+
+		node = *link;
+		pos += common;
+	}
+
+	/* Keep the resources of a node in the order of the service */
+	link = &resource_tree_nodes[node].entry;
+	while (*link != RESOURCE_TREE_NONE) {
+		link = &resource_tree_entries[*link].next;
+	}
+
+	entry = &resource_tree_entries[resource_tree_entry_count];
+	entry->resource = resource;
+	entry->next = RESOURCE_TREE_NONE;
+	*link = resource_tree_entry_count++;
+}
+
+static uint16_t resource_tree_build(const struct http_service_desc *service)
+{
+	size_t count = HTTP_SERVICE_RESOURCE_COUNT(service);
+	uint16_t root;
+
+	if (resource_tree_node_count + 2 * count + 1 > RESOURCE_TREE_MAX_NODES ||
+	    resource_tree_entry_count + count > RESOURCE_TREE_MAX_ENTRIES) {
+		LOG_WRN("No room to index %zu resources, see %s", count,
+			"CONFIG_HTTP_SERVER_RESOURCE_TREE_SIZE");
+		return RESOURCE_TREE_UNINDEXED;
+	}
+
+	root = resource_tree_new_node("", 0);
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		resource_tree_insert(root, resource);
+	}
+
+	return root;
+}
+
+static int resource_tree_init(void)
+{
+	HTTP_SERVICE_FOREACH(service) {
+		*service->res_tree = resource_tree_build(service);
+	}
+
+	return 0;
+}
+
+SYS_INIT(resource_tree_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static struct http_resource_desc *resource_tree_lookup(uint16_t root, const char *path,
+						       int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *found = NULL;
+	const struct resource_tree_node *node;
+	struct resource_tree_entry *entry;
+	uint16_t index = root;
+	size_t pos = 0;
+	int len;
+
+	while (true) {
+		node = &resource_tree_nodes[index];
+
+		/* Literal resources only match where the path ends */
+		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) || path[pos] == '\0' ||
+		    path[pos] == '?') {
+			for (uint16_t i = node->entry; i != RESOURCE_TREE_NONE; i = entry->next) {
+				entry = &resource_tree_entries[i];
+
+				if (found != NULL && entry->resource > found) {
+					break;
+				}
+
+				if (skip_this(entry->resource, is_websocket)) {
+					continue;
+				}
+
+				if (resource_matches(entry->resource, path, &len)) {
+					found = entry->resource;
+					*path_len = len;
+					break;
+				}
 			}
 		}
 
-		if (compare_strings(path, resource->resource) == 0) {
-			NET_DBG("Got match for %s", resource->resource);
+		if (path[pos] == '\0') {
+			break;
+		}
+
+		index = resource_tree_find_child(index, path[pos]);
+		if (index == RESOURCE_TREE_NONE) {
+			break;
+		}
+
+		node = &resource_tree_nodes[index];
+		if (strncmp(node->label, &path[pos], node->label_len) != 0) {
+			break;
+		}
+
+		pos += node->label_len;
+	}
+
+	return found;
+}
+
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_TREE */
+
+static struct http_resource_desc *find_resource(const struct http_service_desc *service,
+						const char *path, int *path_len, bool is_websocket)
+{
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TREE)
+	uint16_t root = *service->res_tree;
+
+	if (root != RESOURCE_TREE_UNINDEXED) {
+		return resource_tree_lookup(root, path, path_len, is_websocket);
+	}
+#endif
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		if (skip_this(resource, is_websocket)) {
+			continue;
+		}
 
-			*path_len = strlen(resource->resource);
-			return resource->detail;
+		if (resource_matches(resource, path, path_len)) {
+			return resource;
 		}
 	}
 
+	return NULL;
+}
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *resource;
+
+	resource = find_resource(service, path, path_len, is_websocket);
+	if (resource != NULL) {
+		return resource->detail;
+	}
+
 	if (service->res_fallback != NULL) {
 		*path_len = path_len_without_query(path);
 		return service->res_fallback;
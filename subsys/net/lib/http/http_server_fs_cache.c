@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cache of the files of static file system resources. Each cached file lives
+ * in a single heap block holding its HTTP/1 response header followed by its
+ * content, so that it can be sent in one go, and then its name and content
+ * type. The compressed variants of a file are cached as separate files, and
+ * all of them remember which variants exist on the file system, so that a hit
+ * needs no file system access at all.
+ */
+
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/dlist.h>
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+#define FS_CACHE_HEADER_TEMPLATE                                                                   \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Length: %zu\r\n"                                                                  \
+	"Content-Type: %s%s%s\r\n"                                                                 \
+	"ETag: %s\r\n\r\n"
+#define FS_CACHE_CONTENT_ENCODING_HEADER "\r\nContent-Encoding: "
+#define FS_CACHE_ETAG_TEMPLATE "\"%08x-%zx-%x\""
+
+struct http_fs_cache_entry {
+	/* Recently used list, or free list */
+	sys_dnode_t node;
+	/* Header, data, name and content type */
+	uint8_t *block;
+	const char *name;
+	const char *content_type;
+	size_t header_len;
+	size_t data_len;
+	char etag[HTTP_FS_CACHE_ETAG_LEN];
+	uint8_t refs;
+	uint8_t compression;
+	/* Variants of the file on the file system, BIT(HTTP_NONE) for the file itself */
+	uint8_t variants;
+	/* Flushed while in use */
+	bool stale;
+};
+
+/* Suffixes of the compressed variants, in order of preference */
+static const struct {
+	enum http_compression compression;
+	const char *suffix;
+} fs_cache_suffixes[] = {
+	{ HTTP_BR, ".br" },
+	{ HTTP_GZIP, ".gz" },
+	{ HTTP_ZSTD, ".zst" },
+	{ HTTP_COMPRESS, ".lzw" },
+	{ HTTP_DEFLATE, ".zz" },
+};
+
+K_HEAP_DEFINE(fs_cache_heap, CONFIG_HTTP_SERVER_STATIC_FS_CACHE_SIZE);
+static struct http_fs_cache_entry fs_cache_entries[CONFIG_HTTP_SERVER_STATIC_FS_CACHE_ENTRIES];
+static sys_dlist_t fs_cache_lru = SYS_DLIST_STATIC_INIT(&fs_cache_lru);
+static sys_dlist_t fs_cache_free = SYS_DLIST_STATIC_INIT(&fs_cache_free);
+static K_MUTEX_DEFINE(fs_cache_lock);
+static bool fs_cache_initialized;
+
+static void fs_cache_init(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(fs_cache_entries); i++) {
+		sys_dlist_append(&fs_cache_free, &fs_cache_entries[i].node);
+	}
+
+	fs_cache_initialized = true;
+}
+
+static void fs_cache_free_entry(struct http_fs_cache_entry *entry)
+{
+	k_heap_free(&fs_cache_heap, entry->block);
+	entry->block = NULL;
+	entry->stale = false;
+	sys_dlist_append(&fs_cache_free, &entry->node);
+}
+
+/* Drop the least recently used file which is not being sent */
+static bool fs_cache_evict(void)
+{
+	struct http_fs_cache_entry *entry;
+	sys_dnode_t *node;
+
+	for (node = sys_dlist_peek_tail(&fs_cache_lru); node != NULL;
+	     node = sys_dlist_peek_prev(&fs_cache_lru, node)) {
+		entry = CONTAINER_OF(node, struct http_fs_cache_entry, node);
+		if (entry->refs > 0) {
+			continue;
+		}
+
+		LOG_DBG("Dropping %s from the cache", entry->name);
+
+		sys_dlist_remove(&entry->node);
+		fs_cache_free_entry(entry);
+		return true;
+	}
+
+	return false;
+}
+
+static struct http_fs_cache_entry *fs_cache_find(const char *fname, const char *content_type,
+						  int compression)
+{
+	struct http_fs_cache_entry *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&fs_cache_lru, entry, node) {
+		if ((compression < 0 || entry->compression == compression) &&
+		    strcmp(entry->name, fname) == 0 &&
+		    strcmp(entry->content_type, content_type) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static uint8_t fs_cache_probe_variants(const char *fname)
+{
+	char variant[HTTP_SERVER_MAX_URL_LENGTH + sizeof(".zst")];
+	struct fs_dirent dirent;
+	uint8_t variants = 0;
+
+	if (fs_stat(fname, &dirent) == 0 && dirent.type == FS_DIR_ENTRY_FILE) {
+		WRITE_BIT(variants, HTTP_NONE, true);
+	}
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION)) {
+		return variants;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(fs_cache_suffixes); i++) {
+		snprintk(variant, sizeof(variant), "%s%s", fname, fs_cache_suffixes[i].suffix);
+
+		if (fs_stat(variant, &dirent) == 0 && dirent.type == FS_DIR_ENTRY_FILE) {
+			WRITE_BIT(variants, fs_cache_suffixes[i].compression, true);
+		}
+	}
+
+	return variants;
+}
+
+/* Same choice as http_server_find_file() */
+static int fs_cache_choose(uint8_t variants, uint8_t supported_compression)
+{
+	uint8_t available = variants & supported_compression;
+
+	for (int i = 0; i < ARRAY_SIZE(fs_cache_suffixes); i++) {
+		if (IS_BIT_SET(available, fs_cache_suffixes[i].compression)) {
+			return fs_cache_suffixes[i].compression;
+		}
+	}
+
+	if (IS_BIT_SET(variants, HTTP_NONE)) {
+		return HTTP_NONE;
+	}
+
+	return -ENOENT;
+}
+
+static const char *fs_cache_suffix(enum http_compression compression)
+{
+	for (int i = 0; i < ARRAY_SIZE(fs_cache_suffixes); i++) {
+		if (fs_cache_suffixes[i].compression == compression) {
+			return fs_cache_suffixes[i].suffix;
+		}
+	}
+
+	return "";
+}
+
+static int fs_cache_read(const char *fname, uint8_t *buf, size_t size)
+{
+	struct fs_file_t file;
+	ssize_t len;
+	int ret;
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, fname, FS_O_READ);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (size > 0) {
+		len = fs_read(&file, buf, size);
+		if (len <= 0) {
+			ret = (len < 0) ? len : -EIO;
+			break;
+		}
+
+		buf += len;
+		size -= len;
+	}
+
+	fs_close(&file);
+
+	return ret;
+}
+
+static int fs_cache_header(char *buf, size_t size, size_t data_len, const char *content_type,
+			   enum http_compression compression, const char *etag)
+{
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION) && compression != HTTP_NONE) {
+		return snprintk(buf, size, FS_CACHE_HEADER_TEMPLATE, data_len, content_type,
+				FS_CACHE_CONTENT_ENCODING_HEADER,
+				http_compression_text(compression), etag);
+	}
+
+	return snprintk(buf, size, FS_CACHE_HEADER_TEMPLATE, data_len, content_type, "", "",
+			etag);
+}
+
+static struct http_fs_cache_entry *fs_cache_load(const char *fname, const char *content_type,
+						  enum http_compression compression,
+						  uint8_t variants)
+{
+	char variant[HTTP_SERVER_MAX_URL_LENGTH + sizeof(".zst")];
+	char etag[HTTP_FS_CACHE_ETAG_LEN];
+	struct http_fs_cache_entry *entry;
+	struct fs_dirent dirent;
+	size_t header_len;
+	size_t block_len;
+	uint8_t *block;
+	uint8_t *data;
+	uint8_t first;
+	int ret;
+
+	snprintk(variant, sizeof(variant), "%s%s", fname, fs_cache_suffix(compression));
+
+	ret = fs_stat(variant, &dirent);
+	if (ret < 0 || dirent.size > CONFIG_HTTP_SERVER_STATIC_FS_CACHE_MAX_FILE_SIZE) {
+		return NULL;
+	}
+
+	/* The CRC has a fixed width, so the size of the header does not depend on it */
+	snprintk(etag, sizeof(etag), FS_CACHE_ETAG_TEMPLATE, 0U, dirent.size, compression);
+	header_len = fs_cache_header(NULL, 0, dirent.size, content_type, compression, etag);
+	block_len = header_len + dirent.size + strlen(fname) + 1 + strlen(content_type) + 1;
+	if (block_len > CONFIG_HTTP_SERVER_STATIC_FS_CACHE_SIZE) {
+		return NULL;
+	}
+
+	while (sys_dlist_is_empty(&fs_cache_free) ||
+	       (block = k_heap_alloc(&fs_cache_heap, block_len, K_NO_WAIT)) == NULL) {
+		if (!fs_cache_evict()) {
+			LOG_DBG("No room to cache %s (%zu bytes)", variant, dirent.size);
+			return NULL;
+		}
+	}
+
+	data = block + header_len;
+
+	ret = fs_cache_read(variant, data, dirent.size);
+	if (ret < 0) {
+		LOG_ERR("Cannot read %s (%d)", variant, ret);
+		k_heap_free(&fs_cache_heap, block);
+		return NULL;
+	}
+
+	entry = CONTAINER_OF(sys_dlist_get(&fs_cache_free), struct http_fs_cache_entry, node);
+
+	snprintk(entry->etag, sizeof(entry->etag), FS_CACHE_ETAG_TEMPLATE,
+		 crc32_ieee(data, dirent.size), dirent.size, compression);
+
+	/* The terminating NUL of the header lands on the first byte of the data */
+	first = data[0];
+	(void)fs_cache_header(block, header_len + 1, dirent.size, content_type, compression,
+			      entry->etag);
+	data[0] = first;
+
+	entry->name = (char *)data + dirent.size;
+	strcpy((char *)entry->name, fname);
+	entry->content_type = entry->name + strlen(fname) + 1;
+	strcpy((char *)entry->content_type, content_type);
+
+	entry->block = block;
+	entry->header_len = header_len;
+	entry->data_len = dirent.size;
+	entry->compression = compression;
+	entry->variants = variants;
+	entry->refs = 0;
+
+	sys_dlist_prepend(&fs_cache_lru, &entry->node);
+
+	LOG_DBG("Cached %s (%zu bytes)", variant, dirent.size);
+
+	return entry;
+}
+
+int http_fs_cache_get(const char *fname, const char *content_type,
+		      uint8_t supported_compression, struct http_fs_cache_file *file)
+{
+	struct http_fs_cache_entry *entry;
+	uint8_t variants;
+	int compression;
+	int ret = 0;
+
+	(void)k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	if (!fs_cache_initialized) {
+		fs_cache_init();
+	}
+
+	/* Any cached variant knows the others */
+	entry = fs_cache_find(fname, content_type, -1);
+	if (entry != NULL) {
+		variants = entry->variants;
+	} else {
+		variants = fs_cache_probe_variants(fname);
+	}
+
+	compression = fs_cache_choose(variants, supported_compression);
+	if (compression < 0) {
+		ret = compression;
+		goto unlock;
+	}
+
+	entry = fs_cache_find(fname, content_type, compression);
+	if (entry == NULL) {
+		entry = fs_cache_load(fname, content_type, compression, variants);
+		if (entry == NULL) {
+			ret = -ENOMEM;
+			goto unlock;
+		}
+	} else {
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&fs_cache_lru, &entry->node);
+	}
+
+	entry->refs++;
+
+	file->entry = entry;
+	file->header = (const char *)entry->block;
+	file->header_len = entry->header_len;
+	file->data = entry->block + entry->header_len;
+	file->data_len = entry->data_len;
+	file->etag = entry->etag;
+	file->compression = entry->compression;
+
+unlock:
+	k_mutex_unlock(&fs_cache_lock);
+
+	return ret;
+}
+
+void http_fs_cache_release(struct http_fs_cache_file *file)
+{
+	struct http_fs_cache_entry *entry = file->entry;
+
+	(void)k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	entry->refs--;
+	if (entry->stale && entry->refs == 0) {
+		fs_cache_free_entry(entry);
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+}
+
+/* The tag of a file which is not cached, as if it were */
+int http_fs_cache_etag(const char *fname, size_t size, enum http_compression compression,
+		       char *etag)
+{
+	struct fs_file_t file;
+	uint8_t buf[64];
+	uint32_t crc = 0;
+	size_t remaining = size;
+	ssize_t len;
+	int ret;
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, fname, FS_O_READ);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (remaining > 0) {
+		len = fs_read(&file, buf, MIN(remaining, sizeof(buf)));
+		if (len <= 0) {
+			ret = (len < 0) ? len : -EIO;
+			break;
+		}
+
+		crc = crc32_ieee_update(crc, buf, len);
+		remaining -= len;
+	}
+
+	fs_close(&file);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	snprintk(etag, HTTP_FS_CACHE_ETAG_LEN, FS_CACHE_ETAG_TEMPLATE, crc, size, compression);
+
+	return 0;
+}
+
+bool http_fs_cache_etag_match(const char *if_none_match, const char *etag)
+{
+	const char *found;
+	size_t len;
+
+	if (if_none_match[0] == '\0') {
+		return false;
+	}
+
+	if (strcmp(if_none_match, "*") == 0) {
+		return true;
+	}
+
+	/* A list of tags, possibly weak ones */
+	len = strlen(etag);
+	found = strstr(if_none_match, etag);
+
+	return found != NULL && (found[len] == '\0' || found[len] == ',' || found[len] == ' ');
+}
+
+void http_server_static_fs_cache_flush(void)
+{
+	struct http_fs_cache_entry *entry, *next;
+
+	(void)k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&fs_cache_lru, entry, next, node) {
+		sys_dlist_remove(&entry->node);
+
+		if (entry->refs > 0) {
+			/* Freed once sent */
+			entry->stale = true;
+		} else {
+			fs_cache_free_entry(entry);
+		}
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+}
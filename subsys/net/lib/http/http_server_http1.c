@@ -466,13 +466,60 @@ static int dynamic_post_put_req(struct http_resource_detail_dynamic *dynamic_det
 
 #if defined(CONFIG_FILE_SYSTEM)
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+static int send_http1_304(struct http_client_ctx *client, const char *etag)
+{
+	char not_modified[sizeof("HTTP/1.1 304 Not Modified\r\nETag: \r\n\r\n") +
+			  HTTP_FS_CACHE_ETAG_LEN];
+	int len;
+
+	len = snprintk(not_modified, sizeof(not_modified),
+		       "HTTP/1.1 304 Not Modified\r\nETag: %s\r\n\r\n", etag);
+
+	return http_server_sendall(client, not_modified, len);
+}
+
+/* Returns -ENOENT if the file is to be read from the file system */
+static int send_http1_cached_file(struct http_client_ctx *client, const char *fname,
+				  const char *content_type)
+{
+	struct http_fs_cache_file file;
+	uint8_t supported_compression = 0;
+	int ret;
+
+#ifdef CONFIG_HTTP_SERVER_COMPRESSION
+	supported_compression = client->supported_compression;
+#endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+
+	ret = http_fs_cache_get(fname, content_type, supported_compression, &file);
+	if (ret < 0) {
+		return -ENOENT;
+	}
+
+	if (http_fs_cache_etag_match(client->if_none_match, file.etag)) {
+		ret = send_http1_304(client, file.etag);
+	} else {
+		/* The header and the data are contiguous */
+		ret = http_server_sendall(client, file.header, file.header_len + file.data_len);
+	}
+
+	if (ret == 0) {
+		client->http1_headers_sent = true;
+	}
+
+	http_fs_cache_release(&file);
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 				    struct http_client_ctx *client)
 {
 #define RESPONSE_TEMPLATE_STATIC_FS                                                                \
 	"HTTP/1.1 200 OK\r\n"                                                                      \
 	"Content-Length: %zd\r\n"                                                                  \
-	"Content-Type: %s%s%s\r\n\r\n"
+	"Content-Type: %s%s%s\r\n%s\r\n"
 #define CONTENT_ENCODING_HEADER "\r\nContent-Encoding: "
 /* Add couple of bytes to response template size to have space
  * for the content type and encoding
@@ -482,11 +529,14 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		sizeof("Content-Length: 01234567890123456789\r\n")
 #define CONTENT_ENCODING_HEADER_SIZE                                                               \
 	sizeof(CONTENT_ENCODING_HEADER) + HTTP_COMPRESSION_MAX_STRING_LEN + sizeof("\r\n")
+#define ETAG_HEADER_SIZE                                                                           \
+	COND_CODE_1(IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE),                                \
+		    (sizeof("ETag: \r\n") + HTTP_FS_CACHE_ETAG_LEN), (0))
 #define STATIC_FS_RESPONSE_SIZE                                                                    \
 	COND_CODE_1(                                                                               \
 		IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION),                                        \
-		(STATIC_FS_RESPONSE_BASE_SIZE + CONTENT_ENCODING_HEADER_SIZE),                     \
-		(STATIC_FS_RESPONSE_BASE_SIZE))
+		(STATIC_FS_RESPONSE_BASE_SIZE + CONTENT_ENCODING_HEADER_SIZE + ETAG_HEADER_SIZE),  \
+		(STATIC_FS_RESPONSE_BASE_SIZE + ETAG_HEADER_SIZE))
 
 	enum http_compression chosen_compression = 0;
 	int len;
@@ -497,6 +547,7 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
 	char http_response[STATIC_FS_RESPONSE_SIZE];
+	char etag_header[ETAG_HEADER_SIZE + 1] = "";
 
 	if (client->method != HTTP_GET) {
 		return send_http1_405(client);
@@ -514,6 +565,13 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 			 client->url_buffer);
 	}
 
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	ret = send_http1_cached_file(client, fname, content_type);
+	if (ret != -ENOENT) {
+		return ret;
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 	/* open file, if it exists */
 #ifdef CONFIG_HTTP_SERVER_COMPRESSION
 	ret = http_server_find_file(fname, sizeof(fname), &file_size, client->supported_compression,
@@ -525,6 +583,31 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		LOG_ERR("fs_stat %s: %d", fname, ret);
 		return send_http1_404(client);
 	}
+
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	/* Not cached, so only compute the tag for conditional requests */
+	if (client->if_none_match[0] != '\0') {
+		char etag[HTTP_FS_CACHE_ETAG_LEN];
+
+		ret = http_fs_cache_etag(fname, file_size, chosen_compression, etag);
+		if (ret < 0) {
+			LOG_ERR("Cannot read %s (%d)", fname, ret);
+			return ret;
+		}
+
+		if (http_fs_cache_etag_match(client->if_none_match, etag)) {
+			ret = send_http1_304(client, etag);
+			if (ret == 0) {
+				client->http1_headers_sent = true;
+			}
+
+			return ret;
+		}
+
+		snprintk(etag_header, sizeof(etag_header), "ETag: %s\r\n", etag);
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 	fs_file_t_init(&file);
 	ret = fs_open(&file, fname, FS_O_READ);
 	if (ret < 0) {
@@ -541,10 +624,10 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	    http_compression_text(chosen_compression)[0] != 0) {
 		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
 			       file_size, content_type, CONTENT_ENCODING_HEADER,
-			       http_compression_text(chosen_compression));
+			       http_compression_text(chosen_compression), etag_header);
 	} else {
 		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
-			       file_size, content_type, "", "");
+			       file_size, content_type, "", "", etag_header);
 	}
 	ret = http_server_sendall(client, http_response, len);
 	if (ret < 0) {
@@ -568,7 +651,6 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		}
 		remaining -= len;
 	}
-	ret = http_server_sendall(client, "\r\n\r\n", 4);
 
 close:
 	/* close file */
@@ -724,6 +806,11 @@ static int on_header_field(struct http_parser *parser, const char *at,
 				ctx->accept_encoding_next = true;
 			}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+			else if (strcasecmp(ctx->header_buffer, "If-None-Match") == 0) {
+				ctx->if_none_match_next = true;
+			}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 			ctx->header_buffer[0] = '\0';
 		}
@@ -781,6 +868,11 @@ static int on_header_value(struct http_parser *parser,
 			ctx->header_capture_ctx.store_next_value = false;
 			ctx->header_capture_ctx.status = HTTP_HEADER_STATUS_DROPPED;
 		}
+
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+		/* A truncated If-None-Match value is ignored */
+		ctx->if_none_match_next = false;
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 	} else {
 		memcpy(ctx->header_buffer + offset, at, length);
 		offset += length;
@@ -816,6 +908,12 @@ static int on_header_value(struct http_parser *parser,
 				ctx->accept_encoding_next = false;
 			}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+			if (ctx->if_none_match_next) {
+				memcpy(ctx->if_none_match, ctx->header_buffer, offset + 1);
+				ctx->if_none_match_next = false;
+			}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 			ctx->header_buffer[0] = '\0';
 		}
@@ -903,6 +1001,10 @@ int enter_http1_request(struct http_client_ctx *client)
 	memset(client->header_buffer, 0, sizeof(client->header_buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	client->if_none_match[0] = '\0';
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 	return 0;
 }
 
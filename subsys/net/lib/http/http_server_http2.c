@@ -451,6 +451,79 @@ out:
 }
 
 #if defined(CONFIG_FILE_SYSTEM)
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+/* Returns -ENOENT if the file is to be read from the file system */
+static int send_http2_cached_file(struct http_client_ctx *client, struct http2_frame *frame,
+				  struct http_resource_detail *res_detail, const char *fname)
+{
+	struct http_fs_cache_file file;
+	struct http_header etag_header = {
+		.name = "etag",
+	};
+	uint8_t supported_compression = 0;
+	size_t remaining;
+	size_t len;
+	int ret;
+
+#ifdef CONFIG_HTTP_SERVER_COMPRESSION
+	supported_compression = client->supported_compression;
+#endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+
+	ret = http_fs_cache_get(fname, res_detail->content_type, supported_compression, &file);
+	if (ret < 0) {
+		return -ENOENT;
+	}
+
+	etag_header.value = file.etag;
+
+	if (http_fs_cache_etag_match(client->if_none_match, file.etag)) {
+		ret = send_headers_frame(client, HTTP_304_NOT_MODIFIED, frame->stream_identifier,
+					 NULL, HTTP2_FLAG_END_STREAM, &etag_header, 1);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			goto out;
+		}
+
+		client->current_stream->end_stream_sent = true;
+		goto out;
+	}
+
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION)) {
+		res_detail->content_encoding = http_compression_text(file.compression);
+	}
+
+	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, res_detail,
+				 file.data_len == 0 ? HTTP2_FLAG_END_STREAM : 0, &etag_header, 1);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+		goto out;
+	}
+
+	remaining = file.data_len;
+	while (remaining > 0) {
+		len = MIN(remaining, HTTP2_DEFAULT_MAX_FRAME_SIZE);
+		remaining -= len;
+
+		ret = send_data_frame(client, (const char *)file.data + file.data_len -
+					      remaining - len,
+				      len, frame->stream_identifier,
+				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			goto out;
+		}
+	}
+
+	client->current_stream->end_stream_sent = true;
+
+out:
+	http_fs_cache_release(&file);
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 					   struct http2_frame *frame,
 					   struct http_client_ctx *client)
@@ -470,6 +543,14 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	int len;
 	int remaining;
 	char tmp[64];
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	char etag[HTTP_FS_CACHE_ETAG_LEN];
+	struct http_header etag_header = {
+		.name = "etag",
+		.value = etag,
+	};
+	size_t header_count = 0;
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
@@ -491,6 +572,13 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 			 client->url_buffer);
 	}
 
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	ret = send_http2_cached_file(client, frame, &res_detail, fname);
+	if (ret != -ENOENT) {
+		return ret;
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 	/* open file, if it exists */
 #ifdef CONFIG_HTTP_SERVER_COMPRESSION
 	ret = http_server_find_file(fname, sizeof(fname), &client->data_len,
@@ -508,6 +596,33 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		}
 		return ret;
 	}
+
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	/* Not cached, so only compute the tag for conditional requests */
+	if (client->if_none_match[0] != '\0') {
+		ret = http_fs_cache_etag(fname, client->data_len, chosen_compression, etag);
+		if (ret < 0) {
+			LOG_ERR("Cannot read %s (%d)", fname, ret);
+			return ret;
+		}
+
+		if (http_fs_cache_etag_match(client->if_none_match, etag)) {
+			ret = send_headers_frame(client, HTTP_304_NOT_MODIFIED,
+						 frame->stream_identifier, NULL,
+						 HTTP2_FLAG_END_STREAM, &etag_header, 1);
+			if (ret < 0) {
+				LOG_DBG("Cannot write to socket (%d)", ret);
+				return ret;
+			}
+
+			client->current_stream->end_stream_sent = true;
+			return 0;
+		}
+
+		header_count = 1;
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 	fs_file_t_init(&file);
 	ret = fs_open(&file, fname, FS_O_READ);
 	if (ret < 0) {
@@ -521,8 +636,13 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION)) {
 		res_detail.content_encoding = http_compression_text(chosen_compression);
 	}
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, &res_detail, 0,
+				 &etag_header, header_count);
+#else
 	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, &res_detail, 0,
 				 NULL, 0);
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 		goto out;
@@ -926,6 +1046,10 @@ static int enter_http_frame_headers_state(struct http_client_ctx *client)
 		client->expect_continuation = false;
 	}
 
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	client->if_none_match[0] = '\0';
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)) {
 		/* Reset header capture state for new headers frame */
 		client->header_capture_ctx.count = 0;
@@ -1405,6 +1529,16 @@ static int process_header(struct http_client_ctx *client,
 						       &client->supported_compression);
 	}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	else if (header->name_len == (sizeof("if-none-match") - 1) &&
+		 memcmp(header->name, "if-none-match", header->name_len) == 0) {
+		/* A value too long to be stored is ignored */
+		if (header->value_len < sizeof(client->if_none_match)) {
+			memcpy(client->if_none_match, header->value, header->value_len);
+			client->if_none_match[header->value_len] = '\0';
+		}
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 	else {
 		/* Just ignore for now. */
 		LOG_DBG("Ignoring field %.*s", (int)header->name_len, header->name);
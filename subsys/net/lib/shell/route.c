@@ -10,6 +10,8 @@ LOG_MODULE_DECLARE(net_shell);
 
 #include "net_shell_private.h"
 
+#include <zephyr/net/ipv4_route.h>
+
 #include "../ip/route.h"
 
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
@@ -87,6 +89,82 @@ static void iface_per_route_cb(struct net_if *iface, void *user_data)
 }
 #endif /* CONFIG_NET_ROUTE */
 
+#if defined(CONFIG_NET_IPV4_ROUTE) && defined(CONFIG_NET_NATIVE)
+static void ipv4_route_cb(const struct net_ipv4_route_info *route, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	struct net_if *iface = data->user_data;
+	char remaining_str[sizeof("01234567890 sec")];
+
+	if (route->iface != iface) {
+		return;
+	}
+
+	if (route->lifetime == NET_IPV4_ROUTE_INFINITE_LIFETIME) {
+		snprintk(remaining_str, sizeof(remaining_str) - 1, "infinite");
+	} else {
+		snprintk(remaining_str, sizeof(remaining_str) - 1, "%u sec",
+			 route->lifetime);
+	}
+
+	PR("IPv4 prefix : %s/%d\tgateway : %s\tlifetime : %s\n",
+	   net_sprint_ipv4_addr(&route->addr), route->prefix_len,
+	   net_sprint_ipv4_addr(&route->gw), remaining_str);
+}
+
+static void iface_per_ipv4_route_cb(struct net_if *iface, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	const char *extra;
+
+	PR("\nIPv4 routes for interface %d (%p) (%s)\n",
+	   net_if_get_by_iface(iface), iface,
+	   iface2str(iface, &extra));
+	PR("=========================================%s\n", extra);
+
+	data->user_data = iface;
+
+	net_ipv4_route_foreach(ipv4_route_cb, data);
+}
+
+/* Parse "<address>[/<prefix len>]", without a prefix length it is a host route */
+static int parse_ipv4_prefix(const char *str, struct in_addr *addr, uint8_t *prefix_len)
+{
+	const char *slash = strchr(str, '/');
+	size_t len = slash != NULL ? slash - str : strlen(str);
+	char buf[NET_IPV4_ADDR_LEN];
+	unsigned long value;
+	int err = 0;
+
+	if (len >= sizeof(buf)) {
+		return -EINVAL;
+	}
+
+	memcpy(buf, str, len);
+	buf[len] = '\0';
+
+	if (net_addr_pton(AF_INET, buf, addr) < 0) {
+		return -EINVAL;
+	}
+
+	if (slash == NULL) {
+		*prefix_len = 32U;
+		return 0;
+	}
+
+	value = shell_strtoul(slash + 1, 10, &err);
+	if (err != 0 || value > 32U) {
+		return -EINVAL;
+	}
+
+	*prefix_len = value;
+
+	return 0;
+}
+#endif /* CONFIG_NET_IPV4_ROUTE */
+
 #if defined(CONFIG_NET_ROUTE_MCAST) && defined(CONFIG_NET_NATIVE)
 static void route_mcast_cb(struct net_route_entry_mcast *entry,
 			   void *user_data)
@@ -202,25 +280,143 @@ static int cmd_net_ip6_route_del(const struct shell *sh, size_t argc, char *argv
 	return 0;
 }
 
+static int cmd_net_ip4_route_add(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_IPV4_ROUTE) && defined(CONFIG_NET_NATIVE)
+	struct net_if *iface = NULL;
+	int idx;
+	struct in_addr gw = { 0 };
+	struct in_addr prefix = { 0 };
+	uint8_t prefix_len;
+
+	if (argc != 4) {
+		PR_ERROR("Correct usage: net route add <index> "
+			 "<destination>[/<prefix len>] <gateway>\n");
+		return -EINVAL;
+	}
+
+	idx = get_iface_idx(sh, argv[1]);
+	if (idx < 0) {
+		return -ENOEXEC;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (!iface) {
+		PR_WARNING("No such interface in index %d\n", idx);
+		return -ENOEXEC;
+	}
+
+	if (parse_ipv4_prefix(argv[2], &prefix, &prefix_len) < 0) {
+		PR_ERROR("Invalid address: %s\n", argv[2]);
+		return -EINVAL;
+	}
+
+	if (net_addr_pton(AF_INET, argv[3], &gw)) {
+		PR_ERROR("Invalid gateway: %s\n", argv[3]);
+		return -EINVAL;
+	}
+
+	if (net_ipv4_route_add(iface, &prefix, prefix_len, &gw,
+			       NET_IPV4_ROUTE_INFINITE_LIFETIME) < 0) {
+		PR_ERROR("Failed to add route\n");
+		return -ENOEXEC;
+	}
+#else /* CONFIG_NET_IPV4_ROUTE && CONFIG_NET_NATIVE */
+	PR_INFO("Set %s and %s to enable native %s support.\n",
+		"CONFIG_NET_NATIVE", "CONFIG_NET_IPV4_ROUTE", "IPv4 route");
+#endif /* CONFIG_NET_IPV4_ROUTE && CONFIG_NET_NATIVE */
+	return 0;
+}
+
+static int cmd_net_ip4_route_del(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_IPV4_ROUTE) && defined(CONFIG_NET_NATIVE)
+	struct net_if *iface = NULL;
+	int idx;
+	struct in_addr prefix = { 0 };
+	uint8_t prefix_len;
+
+	if (argc != 3) {
+		PR_ERROR("Correct usage: net route del <index> "
+			 "<destination>[/<prefix len>]\n");
+		return -EINVAL;
+	}
+
+	idx = get_iface_idx(sh, argv[1]);
+	if (idx < 0) {
+		return -ENOEXEC;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (!iface) {
+		PR_WARNING("No such interface in index %d\n", idx);
+		return -ENOEXEC;
+	}
+
+	if (parse_ipv4_prefix(argv[2], &prefix, &prefix_len) < 0) {
+		PR_ERROR("Invalid address: %s\n", argv[2]);
+		return -EINVAL;
+	}
+
+	if (net_ipv4_route_del(iface, &prefix, prefix_len) < 0) {
+		PR_WARNING("No route to %s\n", argv[2]);
+	}
+#else /* CONFIG_NET_IPV4_ROUTE && CONFIG_NET_NATIVE */
+	PR_INFO("Set %s and %s to enable native %s support.\n",
+		"CONFIG_NET_NATIVE", "CONFIG_NET_IPV4_ROUTE", "IPv4 route");
+#endif /* CONFIG_NET_IPV4_ROUTE && CONFIG_NET_NATIVE */
+	return 0;
+}
+
+/* IPv6 addresses have colons, IPv4 ones do not */
+static bool is_ipv4_route(size_t argc, char *argv[])
+{
+	return argc > 2 && strchr(argv[2], ':') == NULL;
+}
+
+static int cmd_net_route_add(const struct shell *sh, size_t argc, char *argv[])
+{
+	if (is_ipv4_route(argc, argv)) {
+		return cmd_net_ip4_route_add(sh, argc, argv);
+	}
+
+	return cmd_net_ip6_route_add(sh, argc, argv);
+}
+
+static int cmd_net_route_del(const struct shell *sh, size_t argc, char *argv[])
+{
+	if (is_ipv4_route(argc, argv)) {
+		return cmd_net_ip4_route_del(sh, argc, argv);
+	}
+
+	return cmd_net_ip6_route_del(sh, argc, argv);
+}
+
 static int cmd_net_route(const struct shell *sh, size_t argc, char *argv[])
 {
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
 #if defined(CONFIG_NET_NATIVE)
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_IPV4_ROUTE)
 	struct net_shell_user_data user_data;
 #endif
 
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_IPV4_ROUTE)
 	user_data.sh = sh;
 #endif
 
 #if defined(CONFIG_NET_ROUTE)
 	net_if_foreach(iface_per_route_cb, &user_data);
-#else
-	PR_INFO("Set %s to enable %s support.\n", "CONFIG_NET_ROUTE",
-		"network route");
+#elif !defined(CONFIG_NET_IPV4_ROUTE)
+	PR_INFO("Set %s or %s to enable %s support.\n", "CONFIG_NET_ROUTE",
+		"CONFIG_NET_IPV4_ROUTE", "network route");
+#endif
+
+#if defined(CONFIG_NET_IPV4_ROUTE)
+	net_if_foreach(iface_per_ipv4_route_cb, &user_data);
 #endif
 
 #if defined(CONFIG_NET_ROUTE_MCAST)
@@ -232,13 +428,14 @@ static int cmd_net_route(const struct shell *sh, size_t argc, char *argv[])
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_route,
 	SHELL_CMD(add, NULL,
-		  "'net route add <index> <destination> <gateway>'"
-		  " adds the route to the destination.",
-		  cmd_net_ip6_route_add),
+		  "'net route add <index> <destination>[/<prefix len>] <gateway>'"
+		  " adds the route to the destination. The prefix length is only"
+		  " taken for IPv4, where it defaults to a host route.",
+		  cmd_net_route_add),
 	SHELL_CMD(del, NULL,
-		  "'net route del <index> <destination>'"
+		  "'net route del <index> <destination>[/<prefix len>]'"
 		  " deletes the route to the destination.",
-		  cmd_net_ip6_route_del),
+		  cmd_net_route_del),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/math_extras.h>
 
 #include "sockets_internal.h"
 
@@ -41,6 +42,11 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 							     \
 		k_mutex_unlock(lock);                        \
 							     \
+		if (IS_ENABLED(CONFIG_ZVFS_EPOLL) &&	     \
+		    retval < 0 && errno == EAGAIN) {	     \
+			zvfs_epoll_rearm_fd(sock);	     \
+		}					     \
+							     \
 		retval;					     \
 	})
 
@@ -369,107 +375,199 @@ ssize_t z_vrfy_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 #include <zephyr/syscalls/zsock_sendto_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
+#ifdef CONFIG_USERSPACE
+static void msghdr_free_copy(struct msghdr *copy, size_t iovlen)
 {
-	int bytes_sent;
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock, msg, flags);
+	k_free(copy->msg_name);
+	k_free(copy->msg_control);
 
-	bytes_sent = VTABLE_CALL(sendmsg, sock, msg, flags);
-
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
-				       bytes_sent < 0 ? -errno : bytes_sent);
-
-	sock_obj_core_update_send_stats(sock, bytes_sent);
+	if (copy->msg_iov != NULL) {
+		for (size_t i = 0; i < iovlen; i++) {
+			k_free(copy->msg_iov[i].iov_base);
+		}
 
-	return bytes_sent;
+		k_free(copy->msg_iov);
+	}
 }
 
-#ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+/* Copies a message and the buffers it points to from user mode, given a
+ * copy @p hdr of its header. On success, the copy is freed with
+ * msghdr_free_copy() and the original number of buffers.
+ */
+static int msghdr_copy_from_user(struct msghdr *copy, const struct msghdr *hdr, bool recv)
 {
-	struct msghdr msg_copy;
-	size_t i;
-	int ret;
+	size_t size;
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	*copy = *hdr;
+	copy->msg_name = NULL;
+	copy->msg_control = NULL;
+	copy->msg_iov = NULL;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	if (hdr->msg_iov == NULL && (recv || hdr->msg_iovlen > 0)) {
+		errno = recv ? ENOMEM : EINVAL;
+		return -1;
+	}
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
-		goto fail;
+	if (size_mul_overflow(hdr->msg_iovlen, sizeof(struct iovec), &size)) {
+		errno = EINVAL;
+		return -1;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
-			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
-					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+	if (size > 0) {
+		copy->msg_iov = k_usermode_alloc_from_copy(hdr->msg_iov, size);
+		if (copy->msg_iov == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		/* Clear the pointers in the copy so that if the allocation in the
+		 * next loop fails, we do not try to free non allocated memory.
+		 */
+		memset(copy->msg_iov, 0, size);
 	}
 
-	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+	for (size_t i = 0; i < hdr->msg_iovlen; i++) {
+		struct iovec iov;
+
+		if (k_usermode_from_copy(&iov, &hdr->msg_iov[i], sizeof(iov)) != 0) {
+			errno = EFAULT;
+			goto fail;
+		}
+
+		/* TODO: In practice we do not need to copy the actual data
+		 * in msghdr when receiving data but currently there is no
+		 * ready made function to do just that (unless we want to call
+		 * relevant malloc function here ourselves). So just use
+		 * the copying variant for now.
+		 */
+		copy->msg_iov[i].iov_base = k_usermode_alloc_from_copy(iov.iov_base, iov.iov_len);
+		if (copy->msg_iov[i].iov_base == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
+
+		copy->msg_iov[i].iov_len = iov.iov_len;
 	}
 
-	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+	if (hdr->msg_namelen > 0) {
+		if (hdr->msg_name == NULL) {
+			errno = EINVAL;
+			goto fail;
+		}
+
+		copy->msg_name = k_usermode_alloc_from_copy(hdr->msg_name, hdr->msg_namelen);
+		if (copy->msg_name == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
-
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	if (hdr->msg_controllen > 0) {
+		if (hdr->msg_control == NULL) {
+			errno = EINVAL;
+			goto fail;
+		}
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+		copy->msg_control = k_usermode_alloc_from_copy(hdr->msg_control,
+							       hdr->msg_controllen);
+		if (copy->msg_control == NULL) {
+			errno = ENOMEM;
+			goto fail;
+		}
 	}
 
-	k_free(msg_copy.msg_iov);
-
-	return ret;
+	return 0;
 
 fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+	msghdr_free_copy(copy, hdr->msg_iovlen);
+
+	return -1;
+}
+
+/* Copies a received message back to user mode, returns non-zero on a fault */
+static int msghdr_copy_to_user(struct msghdr *msg, const struct msghdr *hdr,
+			       const struct msghdr *copy)
+{
+	size_t controllen = 0U;
+	int ret = 0;
+
+	if (hdr->msg_namelen > 0 && hdr->msg_name != NULL) {
+		ret |= k_usermode_to_copy(hdr->msg_name, copy->msg_name, copy->msg_namelen);
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (hdr->msg_controllen > 0 && hdr->msg_control != NULL) {
+		ret |= k_usermode_to_copy(hdr->msg_control, copy->msg_control,
+					  copy->msg_controllen);
+		controllen = copy->msg_controllen;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	ret |= k_usermode_to_copy(&msg->msg_controllen, &controllen, sizeof(controllen));
+	ret |= k_usermode_to_copy(&msg->msg_iovlen, &copy->msg_iovlen, sizeof(copy->msg_iovlen));
+
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(copy->msg_iovlen <= hdr->msg_iovlen);
+
+	for (size_t i = 0; i < hdr->msg_iovlen; i++) {
+		struct iovec iov;
+
+		ret |= k_usermode_from_copy(&iov, &hdr->msg_iov[i], sizeof(iov));
+
+		if (i < copy->msg_iovlen) {
+			ret |= k_usermode_to_copy(iov.iov_base, copy->msg_iov[i].iov_base,
+						  copy->msg_iov[i].iov_len);
+			iov.iov_len = copy->msg_iov[i].iov_len;
+		} else {
+			/* Clear out those vectors that we could not populate */
+			iov.iov_len = 0;
 		}
 
-		k_free(msg_copy.msg_iov);
+		ret |= k_usermode_to_copy(&hdr->msg_iov[i].iov_len, &iov.iov_len,
+					  sizeof(iov.iov_len));
 	}
 
-	return -1;
+	ret |= k_usermode_to_copy(&msg->msg_flags, &copy->msg_flags, sizeof(copy->msg_flags));
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
+ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
+{
+	int bytes_sent;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock, msg, flags);
+
+	bytes_sent = VTABLE_CALL(sendmsg, sock, msg, flags);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+				       bytes_sent < 0 ? -errno : bytes_sent);
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	return bytes_sent;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	struct msghdr hdr;
+	ssize_t ret;
+
+	K_OOPS(k_usermode_from_copy(&hdr, (void *)msg, sizeof(hdr)));
+
+	if (msghdr_copy_from_user(&msg_copy, &hdr, false) < 0) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+				   flags);
+
+	msghdr_free_copy(&msg_copy, hdr.msg_iovlen);
+
+	return ret;
 }
 #include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
@@ -544,8 +642,7 @@ ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 {
 	struct msghdr msg_copy;
-	size_t iovlen;
-	size_t i;
+	struct msghdr hdr;
 	int ret;
 
 	if (msg == NULL) {
@@ -553,161 +650,231 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 		return -1;
 	}
 
-	if (msg->msg_iov == NULL) {
-		errno = ENOMEM;
+	K_OOPS(k_usermode_from_copy(&hdr, (void *)msg, sizeof(hdr)));
+
+	if (msghdr_copy_from_user(&msg_copy, &hdr, true) < 0) {
 		return -1;
 	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	/* Do not copy anything back if there was an error or nothing was
+	 * received.
+	 */
+	if (ret > 0) {
+		K_OOPS(msghdr_copy_to_user(msg, &hdr, &msg_copy));
+	}
+
+	msghdr_free_copy(&msg_copy, hdr.msg_iovlen);
+
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
 
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+/* Sends or receives one message of a batch, the lock of the socket is held */
+typedef ssize_t (*mmsg_transfer_t)(void *obj, const struct socket_op_vtable *vtable,
+				   struct mmsghdr *mmsg, int flags);
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+static ssize_t mmsg_send(void *obj, const struct socket_op_vtable *vtable,
+			 struct mmsghdr *mmsg, int flags)
+{
+	ssize_t ret = vtable->sendmsg(obj, &mmsg->msg_hdr, flags);
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
-		goto fail;
+	if (ret >= 0) {
+		mmsg->msg_len = ret;
 	}
 
-	/* Clear the pointers in the copy so that if the allocation in the
-	 * next loop fails, we do not try to free non allocated memory
-	 * in fail branch.
-	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	return ret;
+}
 
-	for (i = 0; i < iovlen; i++) {
-		/* TODO: In practice we do not need to copy the actual data
-		 * in msghdr when receiving data but currently there is no
-		 * ready made function to do just that (unless we want to call
-		 * relevant malloc function here ourselves). So just use
-		 * the copying variant for now.
-		 */
-		msg_copy.msg_iov[i].iov_base =
-			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
-						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
-			errno = ENOMEM;
-			goto fail;
-		}
+static ssize_t mmsg_recv(void *obj, const struct socket_op_vtable *vtable,
+			 struct mmsghdr *mmsg, int flags)
+{
+	ssize_t ret = vtable->recvmsg(obj, &mmsg->msg_hdr, flags);
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+	if (ret >= 0) {
+		mmsg->msg_len = ret;
 	}
 
-	if (msg->msg_namelen > 0) {
-		if (msg->msg_name == NULL) {
-			errno = EINVAL;
-			goto fail;
-		}
+	return ret;
+}
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
-			errno = ENOMEM;
-			goto fail;
-		}
+static int mmsg_batch(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+		      const struct timespec *timeout, bool is_send, mmsg_transfer_t transfer)
+{
+	const struct socket_op_vtable *vtable;
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	int bytes = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
-	if (msg->msg_controllen > 0) {
-		if (msg->msg_control == NULL) {
+	if ((is_send && vtable->sendmsg == NULL) || (!is_send && vtable->recvmsg == NULL)) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= NSEC_PER_SEC) {
 			errno = EINVAL;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_control =
-			k_usermode_alloc_from_copy(msg->msg_control,
-						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
-			errno = ENOMEM;
-			goto fail;
-		}
+		end = sys_timepoint_calc(K_USEC((int64_t)timeout->tv_sec * USEC_PER_SEC +
+						timeout->tv_nsec / NSEC_PER_USEC));
 	}
 
-	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+	vlen = MIN(vlen, INT_MAX);
 
-	/* Do not copy anything back if there was an error or nothing was
-	 * received.
-	 */
-	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		ret = transfer(obj, vtable, &msgvec[count], flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
 		}
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+		bytes = (ret > INT_MAX - bytes) ? INT_MAX : bytes + ret;
 
-			msg->msg_controllen = msg_copy.msg_controllen;
-		} else {
-			msg->msg_controllen = 0U;
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
 		}
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
-
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
-
-		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
-			}
+		/* Like on Linux, the timeout is only checked between messages */
+		if (sys_timepoint_expired(end)) {
+			count++;
+			break;
 		}
+	}
+
+	k_mutex_unlock(lock);
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+	/* A batch ending with EAGAIN drained the socket, like a single call */
+	if (IS_ENABLED(CONFIG_ZVFS_EPOLL) && ret < 0 && errno == EAGAIN) {
+		zvfs_epoll_rearm_fd(sock);
 	}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	if (is_send) {
+		sock_obj_core_update_send_stats(sock, bytes);
+	} else {
+		sock_obj_core_update_recv_stats(sock, bytes);
+	}
+
+	/* Errors after the first message are left for the next call */
+	return (count == 0 && ret < 0) ? -1 : count;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	return mmsg_batch(sock, msgvec, vlen, flags, NULL, true, mmsg_send);
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+			  struct timespec *timeout)
+{
+	return mmsg_batch(sock, msgvec, vlen, flags, timeout, false, mmsg_recv);
+}
+
+#ifdef CONFIG_USERSPACE
+/* The message and its buffers are copied in and out of user mode one at a
+ * time, with the lock of the socket held, so a fault must not oops.
+ */
+static ssize_t mmsg_send_user(void *obj, const struct socket_op_vtable *vtable,
+			      struct mmsghdr *mmsg, int flags)
+{
+	struct msghdr msg_copy;
+	struct msghdr hdr;
+	unsigned int len;
+	ssize_t ret;
+
+	if (k_usermode_from_copy(&hdr, &mmsg->msg_hdr, sizeof(hdr)) != 0) {
+		errno = EFAULT;
+		return -1;
+	}
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	if (msghdr_copy_from_user(&msg_copy, &hdr, false) < 0) {
+		return -1;
 	}
 
-	k_free(msg_copy.msg_iov);
+	ret = vtable->sendmsg(obj, &msg_copy, flags);
+
+	msghdr_free_copy(&msg_copy, hdr.msg_iovlen);
+
+	if (ret >= 0) {
+		len = ret;
+		(void)k_usermode_to_copy(&mmsg->msg_len, &len, sizeof(len));
+	}
 
 	return ret;
+}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+static ssize_t mmsg_recv_user(void *obj, const struct socket_op_vtable *vtable,
+			      struct mmsghdr *mmsg, int flags)
+{
+	struct msghdr msg_copy;
+	struct msghdr hdr;
+	unsigned int len;
+	ssize_t ret;
+
+	if (k_usermode_from_copy(&hdr, &mmsg->msg_hdr, sizeof(hdr)) != 0) {
+		errno = EFAULT;
+		return -1;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (msghdr_copy_from_user(&msg_copy, &hdr, true) < 0) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
-		}
+	ret = vtable->recvmsg(obj, &msg_copy, flags);
 
-		k_free(msg_copy.msg_iov);
+	if (ret > 0 && msghdr_copy_to_user(&mmsg->msg_hdr, &hdr, &msg_copy) != 0) {
+		errno = EFAULT;
+		ret = -1;
 	}
 
-	return -1;
+	msghdr_free_copy(&msg_copy, hdr.msg_iovlen);
+
+	if (ret >= 0) {
+		len = ret;
+		(void)k_usermode_to_copy(&mmsg->msg_len, &len, sizeof(len));
+	}
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+					int flags)
+{
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	return mmsg_batch(sock, msgvec, vlen, flags, NULL, true, mmsg_send_user);
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+					int flags, struct timespec *timeout)
+{
+	struct timespec timeout_copy;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, timeout, sizeof(timeout_copy)));
+	}
+
+	return mmsg_batch(sock, msgvec, vlen, flags, timeout != NULL ? &timeout_copy : NULL,
+			  false, mmsg_recv_user);
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 /* As this is limited function, we don't follow POSIX signature, with
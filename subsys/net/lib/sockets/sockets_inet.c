@@ -1874,6 +1874,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -2503,6 +2517,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
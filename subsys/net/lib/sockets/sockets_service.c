@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
 #include <zephyr/zvfs/eventfd.h>
+#include <zephyr/zvfs/epoll.h>
 
 static int init_socket_service(void);
 
@@ -165,6 +166,119 @@ static int trigger_work(struct zsock_pollfd *pev)
 	return call_work(pev, event);
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+/* Ready sockets handled per wakeup */
+#define SOCKET_SERVICE_EPOLL_EVENTS 8
+
+extern int zvfs_close(int fd);
+
+/* Register the restart eventfd and the sockets of all services with a new
+ * epoll instance. The registrations point to the service events, so a ready
+ * socket is dispatched without looking for its service. Fails if a socket
+ * cannot be registered, for example an offloaded one.
+ */
+static int epoll_setup(int efd)
+{
+	struct zvfs_epoll_event ev;
+	int epfd;
+
+	epfd = zvfs_epoll_create(0);
+	if (epfd < 0) {
+		return -errno;
+	}
+
+	ev.events = ZVFS_EPOLLIN;
+	ev.data.ptr = NULL;
+
+	if (zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd, &ev) < 0) {
+		int ret = -errno;
+
+		(void)zvfs_close(epfd);
+		return ret;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		for (int j = 0; j < svc->pev_len; j++) {
+			if (svc->pev[j].event.fd < 0) {
+				continue;
+			}
+
+			svc->pev[j].svc = svc;
+
+			ev.events = svc->pev[j].event.events;
+			ev.data.ptr = &svc->pev[j];
+
+			if (zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, svc->pev[j].event.fd,
+					   &ev) < 0) {
+				int ret = -errno;
+
+				NET_DBG("Cannot monitor socket %d with epoll (%d)",
+					svc->pev[j].event.fd, ret);
+				k_mutex_unlock(&lock);
+				(void)zvfs_close(epfd);
+				return ret;
+			}
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return epfd;
+}
+
+static int socket_service_epoll(int efd)
+{
+	struct zvfs_epoll_event events[SOCKET_SERVICE_EPOLL_EVENTS];
+	struct net_socket_service_event *event;
+	zvfs_eventfd_t value;
+	bool restart;
+	int epfd;
+	int ret;
+
+	while (true) {
+		epfd = epoll_setup(efd);
+		if (epfd < 0) {
+			return epfd;
+		}
+
+		do {
+			ret = zvfs_epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+			if (ret < 0) {
+				ret = -errno;
+				NET_ERR("epoll wait failed (%d)", ret);
+				(void)zvfs_close(epfd);
+				return ret;
+			}
+
+			restart = false;
+
+			for (int i = 0; i < ret; i++) {
+				event = events[i].data.ptr;
+				if (event == NULL) {
+					restart = true;
+					continue;
+				}
+
+				event->event.revents = events[i].events;
+
+				/* Synchronous call */
+				net_socket_service_callback(event);
+			}
+		} while (!restart);
+
+		/* Restart after the work is done, the callbacks may have
+		 * registered new sockets.
+		 */
+		zvfs_eventfd_read(efd, &value);
+		NET_DBG("Received restart event.");
+
+		(void)zvfs_close(epfd);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 static void socket_service_thread(void)
 {
 	int ret, i, fd, count = 0;
@@ -186,13 +300,9 @@ static void socket_service_thread(void)
 		count += svc->pev_len;
 	}
 
-	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
-		NET_ERR("You have %d services to monitor but "
-			"%zd poll entries configured.",
-			count + 1, ARRAY_SIZE(ctx.events));
-		NET_ERR("Please increase value of %s to at least %d",
-			"CONFIG_ZVFS_POLL_MAX", count + 1);
-		goto fail;
+	if (!IS_ENABLED(CONFIG_NET_SOCKETS_SERVICE_EPOLL) &&
+	    (count + 1) > ARRAY_SIZE(ctx.events)) {
+		goto too_many;
 	}
 
 	NET_DBG("Monitoring %d socket entries", count);
@@ -213,6 +323,17 @@ static void socket_service_thread(void)
 	ctx.events[0].fd = fd;
 	ctx.events[0].events = ZSOCK_POLLIN;
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	ret = socket_service_epoll(fd);
+
+	/* Some sockets cannot be waited for with epoll, use poll() instead */
+	NET_WARN("Cannot use epoll (%d), falling back to poll", ret);
+
+	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
+		goto too_many;
+	}
+#endif
+
 restart:
 	i = 1;
 
@@ -270,6 +391,13 @@ out:
 
 	return;
 
+too_many:
+	NET_ERR("You have %d services to monitor but "
+		"%zd poll entries configured.",
+		count + 1, ARRAY_SIZE(ctx.events));
+	NET_ERR("Please increase value of %s to at least %d",
+		"CONFIG_ZVFS_POLL_MAX", count + 1);
+
 fail:
 	thread_status = SOCKET_SERVICE_THREAD_FAILED;
 	k_condvar_broadcast(&wait_start);
@@ -47,6 +47,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -99,14 +100,25 @@ struct dtls_timing_context {
 	uint32_t fin_ms;
 };
 
-/** TLS peer address/session ID mapping. */
+/** Stored TLS session, found by peer address on the client side and by
+ *  session ID on the server side.
+ */
 struct tls_session_cache {
 	/** Creation time. */
 	int64_t timestamp;
 
+	/** Last use time, the least recently used session is replaced first. */
+	int64_t last_used;
+
 	/** Peer address. */
 	struct sockaddr peer_addr;
 
+	/** Session ID, up to 32 bytes (RFC 5246). */
+	uint8_t id[32];
+
+	/** Session ID length. */
+	size_t id_len;
+
 	/** Session buffer. */
 	uint8_t *session;
 
@@ -250,10 +262,27 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 
 static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT];
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-static mbedtls_ssl_cache_context server_cache;
+#if CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT > 0
+static struct tls_session_cache server_cache[CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT];
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+#if defined(MBEDTLS_GCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_GCM
+#elif defined(MBEDTLS_CCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_CCM
+#else
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_CHACHA20_POLY1305
 #endif
 
+static mbedtls_ssl_ticket_context ticket_ctx;
+static bool ticket_ctx_ready;
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS */
+
+/* Shared by the client and server session caches and the session tickets */
+static struct tls_session_cache_stats session_stats;
+static struct k_mutex session_lock;
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -271,6 +300,16 @@ static void tls_session_cache_reset(void)
 	}
 
 	(void)memset(client_cache, 0, sizeof(client_cache));
+
+#if CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT > 0
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session != NULL) {
+			mbedtls_free(server_cache[i].session);
+		}
+	}
+
+	(void)memset(server_cache, 0, sizeof(server_cache));
+#endif
 }
 
 bool net_socket_is_tls(void *obj)
@@ -368,9 +407,10 @@ static int tls_init(void)
 	(void)memset(client_cache, 0, sizeof(client_cache));
 
 	k_mutex_init(&context_lock);
+	k_mutex_init(&session_lock);
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-	mbedtls_ssl_cache_init(&server_cache);
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+	mbedtls_ssl_ticket_init(&ticket_ctx);
 #endif
 
 	return 0;
@@ -571,42 +611,56 @@ static bool peer_addr_cmp(const struct sockaddr *addr,
 	return false;
 }
 
-static int tls_session_save(const struct sockaddr *peer_addr,
-			    mbedtls_ssl_session *session)
+static bool tls_session_expired(const struct tls_session_cache *entry, int64_t now)
 {
-	struct tls_session_cache *entry = NULL;
-	size_t session_len;
-	int ret;
+	return now - entry->timestamp >
+	       (int64_t)CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME * MSEC_PER_SEC;
+}
 
-	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
-		if (client_cache[i].session == NULL) {
-			/* New entry. */
-			if (entry == NULL || entry->session != NULL) {
-				entry = &client_cache[i];
-			}
-		} else {
-			if (peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
-				/* Reuse old entry for given address. */
-				entry = &client_cache[i];
-				break;
-			}
+static void tls_session_entry_free(struct tls_session_cache *entry)
+{
+	mbedtls_free(entry->session);
+	entry->session = NULL;
+}
 
-			/* Remember the oldest entry and reuse if needed. */
-			if (entry == NULL ||
-			    (entry->session != NULL &&
-			     entry->timestamp < client_cache[i].timestamp)) {
-				entry = &client_cache[i];
-			}
+/* Pick an empty entry, else an expired one, else the least recently used.
+ * Returns NULL if the cache has no entries.
+ */
+static struct tls_session_cache *tls_session_entry_alloc(struct tls_session_cache *cache,
+							  size_t count, int64_t now)
+{
+	struct tls_session_cache *lru = NULL;
+
+	for (int i = 0; i < count; i++) {
+		if (cache[i].session == NULL) {
+			return &cache[i];
 		}
-	}
 
-	/* Allocate session and save */
+		if (tls_session_expired(&cache[i], now)) {
+			session_stats.expired++;
+			tls_session_entry_free(&cache[i]);
+			return &cache[i];
+		}
 
-	if (entry->session != NULL) {
-		mbedtls_free(entry->session);
-		entry->session = NULL;
+		if (lru == NULL || cache[i].last_used < lru->last_used) {
+			lru = &cache[i];
+		}
+	}
+
+	if (lru != NULL) {
+		session_stats.evicted++;
+		tls_session_entry_free(lru);
 	}
 
+	return lru;
+}
+
+static int tls_session_entry_save(struct tls_session_cache *entry,
+				  const mbedtls_ssl_session *session, int64_t now)
+{
+	size_t session_len;
+	int ret;
+
 	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
 
 	entry->session = mbedtls_calloc(1, session_len);
@@ -619,24 +673,82 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 				       &session_len);
 	if (ret < 0) {
 		NET_ERR("Failed to serialize session, err: -0x%x.", -ret);
-		mbedtls_free(entry->session);
-		entry->session = NULL;
+		tls_session_entry_free(entry);
 		return -ENOMEM;
 	}
 
 	entry->session_len = session_len;
-	entry->timestamp = k_uptime_get();
-	memcpy(&entry->peer_addr, peer_addr, sizeof(*peer_addr));
+	entry->timestamp = now;
+	entry->last_used = now;
 
 	return 0;
 }
 
+static int tls_session_entry_load(struct tls_session_cache *entry,
+				  mbedtls_ssl_session *session, int64_t now)
+{
+	int ret;
+
+	ret = mbedtls_ssl_session_load(session, entry->session,
+				       entry->session_len);
+	if (ret < 0) {
+		/* Discard corrupted session data. */
+		tls_session_entry_free(entry);
+		NET_ERR("Failed to load TLS session %d", ret);
+		return -EIO;
+	}
+
+	entry->last_used = now;
+
+	return 0;
+}
+
+static int tls_session_save(const struct sockaddr *peer_addr,
+			    mbedtls_ssl_session *session)
+{
+	struct tls_session_cache *entry = NULL;
+	int64_t now = k_uptime_get();
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		if (client_cache[i].session != NULL &&
+		    peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
+			/* Reuse old entry for given address. */
+			entry = &client_cache[i];
+			tls_session_entry_free(entry);
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		entry = tls_session_entry_alloc(client_cache, ARRAY_SIZE(client_cache), now);
+	}
+
+	if (entry == NULL) {
+		ret = -ENOMEM;
+	} else {
+		ret = tls_session_entry_save(entry, session, now);
+		if (ret == 0) {
+			memcpy(&entry->peer_addr, peer_addr, sizeof(*peer_addr));
+		}
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
 static int tls_session_get(const struct sockaddr *peer_addr,
 			   mbedtls_ssl_session *session)
 {
 	struct tls_session_cache *entry = NULL;
+	int64_t now = k_uptime_get();
 	int ret;
 
+	k_mutex_lock(&session_lock, K_FOREVER);
+
 	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
 		if (client_cache[i].session != NULL &&
 		    peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
@@ -645,23 +757,185 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 		}
 	}
 
+	if (entry != NULL && tls_session_expired(entry, now)) {
+		session_stats.expired++;
+		tls_session_entry_free(entry);
+		entry = NULL;
+	}
+
 	if (entry == NULL) {
-		return -ENOENT;
+		session_stats.client_misses++;
+		ret = -ENOENT;
+		goto out;
 	}
 
-	ret = mbedtls_ssl_session_load(session, entry->session,
-				       entry->session_len);
-	if (ret < 0) {
-		/* Discard corrupted session data. */
-		mbedtls_free(entry->session);
-		entry->session = NULL;
-		NET_ERR("Failed to load TLS session %d", ret);
-		return -EIO;
+	ret = tls_session_entry_load(entry, session, now);
+	if (ret == 0) {
+		session_stats.client_hits++;
+	} else {
+		session_stats.client_misses++;
 	}
 
-	return 0;
+out:
+	k_mutex_unlock(&session_lock);
+
+	return ret;
 }
 
+#if CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT > 0
+/* mbedTLS session cache callbacks of the servers, sessions are found by ID */
+static struct tls_session_cache *tls_server_session_find(unsigned char const *session_id,
+							  size_t session_id_len)
+{
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session != NULL &&
+		    server_cache[i].id_len == session_id_len &&
+		    memcmp(server_cache[i].id, session_id, session_id_len) == 0) {
+			return &server_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int tls_server_session_get(void *data, unsigned char const *session_id,
+				  size_t session_id_len, mbedtls_ssl_session *session)
+{
+	struct tls_session_cache *entry;
+	int64_t now = k_uptime_get();
+	int ret;
+
+	ARG_UNUSED(data);
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_server_session_find(session_id, session_id_len);
+	if (entry != NULL && tls_session_expired(entry, now)) {
+		session_stats.expired++;
+		tls_session_entry_free(entry);
+		entry = NULL;
+	}
+
+	if (entry == NULL) {
+		session_stats.server_misses++;
+		ret = -ENOENT;
+		goto out;
+	}
+
+	ret = tls_session_entry_load(entry, session, now);
+	if (ret == 0) {
+		session_stats.server_hits++;
+	} else {
+		session_stats.server_misses++;
+	}
+
+out:
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_server_session_set(void *data, unsigned char const *session_id,
+				  size_t session_id_len, const mbedtls_ssl_session *session)
+{
+	struct tls_session_cache *entry;
+	int64_t now = k_uptime_get();
+	int ret;
+
+	ARG_UNUSED(data);
+
+	if (session_id_len > sizeof(entry->id)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_server_session_find(session_id, session_id_len);
+	if (entry != NULL) {
+		tls_session_entry_free(entry);
+	} else {
+		entry = tls_session_entry_alloc(server_cache, ARRAY_SIZE(server_cache), now);
+	}
+
+	if (entry == NULL) {
+		ret = -ENOMEM;
+	} else {
+		ret = tls_session_entry_save(entry, session, now);
+		if (ret == 0) {
+			memcpy(entry->id, session_id, session_id_len);
+			entry->id_len = session_id_len;
+		}
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT > 0 */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+/* The ticket keys are generated on the first use, when entropy is available */
+static int tls_session_tickets_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	if (!ticket_ctx_ready) {
+		ret = mbedtls_ssl_ticket_setup(&ticket_ctx, tls_ctr_drbg_random, NULL,
+					       TLS_TICKET_CIPHER,
+					       CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to set up session tickets, err: -0x%x.", -ret);
+		} else {
+			ticket_ctx_ready = true;
+		}
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+			    unsigned char *start, const unsigned char *end,
+			    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	/* The ticket keys are shared by all the server contexts */
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen, lifetime);
+	if (ret == 0) {
+		session_stats.tickets_issued++;
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+			    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	if (ret == 0) {
+		session_stats.tickets_accepted++;
+	} else {
+		session_stats.tickets_rejected++;
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS */
+
 static void tls_session_store(struct tls_context *context,
 			      const struct sockaddr *addr,
 			      socklen_t addrlen)
@@ -724,12 +998,9 @@ exit:
 
 static void tls_session_purge(void)
 {
+	k_mutex_lock(&session_lock, K_FOREVER);
 	tls_session_cache_reset();
-
-#if defined(MBEDTLS_SSL_CACHE_C)
-	mbedtls_ssl_cache_free(&server_cache);
-	mbedtls_ssl_cache_init(&server_cache);
-#endif
+	k_mutex_unlock(&session_lock);
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -1413,13 +1684,22 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif /* CONFIG_MBEDTLS_SSL_ALPN */
 
-#if defined(MBEDTLS_SSL_CACHE_C)
 	if (is_server && context->options.cache_enabled) {
-		mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
-					       mbedtls_ssl_cache_get,
-					       mbedtls_ssl_cache_set);
-	}
+#if CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT > 0
+		mbedtls_ssl_conf_session_cache(&context->config, NULL,
+					       tls_server_session_get,
+					       tls_server_session_set);
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+		if (tls_session_tickets_setup() == 0) {
+			mbedtls_ssl_conf_session_tickets_cb(&context->config,
+							    tls_ticket_write,
+							    tls_ticket_parse,
+							    &ticket_ctx);
+		}
 #endif
+	}
 
 #if defined(MBEDTLS_SSL_EARLY_DATA)
 	mbedtls_ssl_conf_early_data(&context->config, MBEDTLS_SSL_EARLY_DATA_ENABLED);
@@ -1945,6 +2225,22 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_stats_get(struct tls_context *context,
+					   void *optval, socklen_t *optlen)
+{
+	ARG_UNUSED(context);
+
+	if (*optlen != sizeof(struct tls_session_cache_stats)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	memcpy(optval, &session_stats, sizeof(session_stats));
+	k_mutex_unlock(&session_lock);
+
+	return 0;
+}
+
 static int tls_opt_session_cache_purge_set(struct tls_context *context,
 					   const void *optval, socklen_t optlen)
 {
@@ -3493,6 +3789,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE_STATS:
+		err = tls_opt_session_cache_stats_get(ctx, optval, optlen);
+		break;
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_get(ctx, optval,
@@ -36,6 +36,7 @@ static struct sockaddr_in *in4_addr_my;
 #define SOCK_ID_MAX 2
 
 #define UDP_RECEIVER_BUF_SIZE 1500
+#define UDP_RECEIVER_BATCH CONFIG_NET_ZPERF_UDP_BATCH
 #define POLL_TIMEOUT_MS 100
 
 static zperf_callback udp_session_cb;
@@ -312,14 +313,48 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
+/* Returns the number of datagrams received, or -1 with errno set */
+static int udp_recv_batch(int sock, uint8_t bufs[][UDP_RECEIVER_BUF_SIZE],
+			  struct sockaddr *addrs, struct mmsghdr *msgs)
+{
+	static struct iovec iov[UDP_RECEIVER_BATCH];
+	socklen_t addrlen = sizeof(addrs[0]);
+	ssize_t ret;
+
+	if (UDP_RECEIVER_BATCH == 1) {
+		ret = zsock_recvfrom(sock, bufs[0], UDP_RECEIVER_BUF_SIZE, ZSOCK_MSG_DONTWAIT,
+				     &addrs[0], &addrlen);
+		if (ret < 0) {
+			return -1;
+		}
+
+		msgs[0].msg_len = ret;
+
+		return 1;
+	}
+
+	for (int i = 0; i < UDP_RECEIVER_BATCH; i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = UDP_RECEIVER_BUF_SIZE;
+
+		memset(&msgs[i], 0, sizeof(msgs[i]));
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = addrlen;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	return zsock_recvmmsg(sock, msgs, UDP_RECEIVER_BATCH, ZSOCK_MSG_DONTWAIT, NULL);
+}
+
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
-	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	static uint8_t bufs[UDP_RECEIVER_BATCH][UDP_RECEIVER_BUF_SIZE];
+	static struct sockaddr addrs[UDP_RECEIVER_BATCH];
+	static struct mmsghdr msgs[UDP_RECEIVER_BATCH];
 	int ret = 1;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -342,8 +377,7 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 	}
 
 	while (ret > 0) {
-		ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
-				     &addr, &addrlen);
+		ret = udp_recv_batch(pev->event.fd, bufs, addrs, msgs);
 		if ((ret < 0) && (errno == EAGAIN)) {
 			ret = 0;
 			break;
@@ -358,7 +392,9 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 			goto error;
 		}
 
-		udp_received(pev->event.fd, &addr, buf, ret);
+		for (int i = 0; i < ret; i++) {
+			udp_received(pev->event.fd, &addrs[i], bufs[i], msgs[i].msg_len);
+		}
 	}
 	return ret;
 
@@ -18,6 +18,17 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 			     sizeof(struct zperf_client_hdr_v1) +
 			     PACKET_SIZE_MAX];
 
+#define UDP_UPLOAD_BATCH CONFIG_NET_ZPERF_UDP_BATCH
+#define UDP_UPLOAD_HDR_LEN (sizeof(struct zperf_udp_datagram) + \
+			    sizeof(struct zperf_client_hdr_v1))
+
+/* With batching, each datagram gets its own header, followed by the payload
+ * shared by all of them.
+ */
+static uint8_t batch_hdrs[UDP_UPLOAD_BATCH][UDP_UPLOAD_HDR_LEN];
+static struct iovec batch_iov[UDP_UPLOAD_BATCH][2];
+static struct mmsghdr batch_msgs[UDP_UPLOAD_BATCH];
+
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
 static inline void zperf_upload_decode_stat(const uint8_t *data,
@@ -138,6 +149,67 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
+static void udp_fill_header(uint8_t *buf, uint32_t id, int64_t loop_time, int port,
+			    uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+	uint64_t usecs64;
+	uint32_t secs, usecs;
+
+	usecs64 = k_ticks_to_us_floor64(loop_time);
+	secs = usecs64 / USEC_PER_SEC;
+	usecs = usecs64 - (uint64_t)secs * USEC_PER_SEC;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+/* Returns the number of datagrams sent, or -1 with errno set */
+static int udp_send_batch(int sock, uint32_t first_id, int64_t loop_time, int port,
+			  uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	size_t hdr_len = MIN(packet_size, UDP_UPLOAD_HDR_LEN);
+	int ret;
+
+	if (UDP_UPLOAD_BATCH == 1) {
+		udp_fill_header(sample_packet, first_id, loop_time, port,
+				rate_in_kbps, packet_size);
+
+		ret = zsock_send(sock, sample_packet, packet_size, 0);
+
+		return ret < 0 ? ret : 1;
+	}
+
+	for (int i = 0; i < UDP_UPLOAD_BATCH; i++) {
+		udp_fill_header(batch_hdrs[i], first_id + i, loop_time, port,
+				rate_in_kbps, packet_size);
+
+		batch_iov[i][0].iov_base = batch_hdrs[i];
+		batch_iov[i][0].iov_len = hdr_len;
+		batch_iov[i][1].iov_base = sample_packet + hdr_len;
+		batch_iov[i][1].iov_len = packet_size - hdr_len;
+
+		memset(&batch_msgs[i], 0, sizeof(batch_msgs[i]));
+		batch_msgs[i].msg_hdr.msg_iov = batch_iov[i];
+		batch_msgs[i].msg_hdr.msg_iovlen = ARRAY_SIZE(batch_iov[i]);
+	}
+
+	return zsock_sendmmsg(sock, batch_msgs, UDP_UPLOAD_BATCH, 0);
+}
+
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
@@ -146,7 +218,7 @@ static int udp_upload(int sock, int port,
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
+	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us * UDP_UPLOAD_BATCH);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
 	int64_t start_time, end_time;
@@ -177,10 +249,6 @@ static int udp_upload(int sock, int port,
 	(void)memset(sample_packet, 'z', sizeof(sample_packet));
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
-		uint64_t usecs64;
-		uint32_t secs, usecs;
 		int64_t loop_time;
 		int32_t adjust;
 
@@ -205,34 +273,14 @@ static int udp_upload(int sock, int port,
 
 		last_loop_time = loop_time;
 
-		usecs64 = k_ticks_to_us_floor64(loop_time);
-		secs = usecs64 / USEC_PER_SEC;
-		usecs = usecs64 - (uint64_t)secs * USEC_PER_SEC;
-
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
-
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		/* Send the packets */
+		ret = udp_send_batch(sock, nb_packets, loop_time, port, rate_in_kbps,
+				     packet_size);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
 		} else {
-			nb_packets++;
+			nb_packets += ret;
 		}
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
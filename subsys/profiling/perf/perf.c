@@ -10,9 +10,12 @@
 #include <zephyr/arch/cpu.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/shell/shell_uart.h>
+#include <zephyr/fs/fs.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "perf_stacks.h"
+
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
 struct perf_data_t {
@@ -22,8 +25,10 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
+#ifndef CONFIG_PROFILING_PERF_AGGREGATE
 	size_t idx;
 	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+#endif
 	bool buf_full;
 };
 
@@ -34,6 +39,17 @@ static struct perf_data_t perf_data = {
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
 };
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static void perf_tracer(struct k_timer *timer)
+{
+	uintptr_t frames[CONFIG_PROFILING_PERF_STACK_DEPTH];
+
+	ARG_UNUSED(timer);
+
+	/* The unwinders return 0 for a stack deeper than the buffer */
+	perf_stacks_add(frames, arch_perf_current_stack_trace(frames, ARRAY_SIZE(frames)));
+}
+#else
 static void perf_tracer(struct k_timer *timer)
 {
 	struct perf_data_t *perf_data_ptr =
@@ -56,6 +72,7 @@ static void perf_tracer(struct k_timer *timer)
 		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
 	}
 }
+#endif
 
 static void perf_dwork_handler(struct k_work *work)
 {
@@ -97,6 +114,128 @@ static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+#define PERF_LINE_SIZE 512
+
+static char perf_line[PERF_LINE_SIZE];
+
+static int cmd_perf_start(const struct shell *sh, size_t argc, char **argv)
+{
+	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	k_timeout_t period = K_NSEC(1000000000 / strtoll(argv[1], NULL, 10));
+
+	perf_data.sh = sh;
+
+	k_timer_user_data_set(&perf_data.timer, &perf_data);
+	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
+
+	/* Never expires, perf runs until perf stop */
+	k_work_schedule(&perf_data.dwork, K_FOREVER);
+
+	shell_print(sh, "Enabled perf");
+
+	return 0;
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	if (!k_work_delayable_is_pending(&perf_data.dwork)) {
+		shell_warn(sh, "Perf is not running");
+		return -EALREADY;
+	}
+
+	k_work_reschedule(&perf_data.dwork, K_NO_WAIT);
+
+	return 0;
+}
+
+#ifdef CONFIG_FILE_SYSTEM
+static int perf_folded_save(const struct shell *sh, const char *path)
+{
+	struct fs_file_t file;
+	size_t idx, len;
+	ssize_t ret;
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+	if (ret < 0) {
+		shell_error(sh, "Failed to open %s (%d)", path, (int)ret);
+		return ret;
+	}
+
+	/* One byte is kept for the line feed */
+	for (idx = 0; (len = perf_stacks_folded(idx, perf_line, sizeof(perf_line) - 1)) != 0;
+	     idx++) {
+		perf_line[len++] = '\n';
+		ret = fs_write(&file, perf_line, len);
+		if (ret < 0) {
+			shell_error(sh, "Failed to write %s (%d)", path, (int)ret);
+			break;
+		}
+	}
+
+	(void)fs_close(&file);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	shell_print(sh, "Perf stacks saved to %s", path);
+
+	return 0;
+}
+#endif
+
+static int cmd_perf_folded(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc > 1) {
+#ifdef CONFIG_FILE_SYSTEM
+		return perf_folded_save(sh, argv[1]);
+#else
+		shell_error(sh, "File system is not enabled");
+		return -ENOTSUP;
+#endif
+	}
+
+	for (size_t idx = 0; perf_stacks_folded(idx, perf_line, sizeof(perf_line)) != 0; idx++) {
+		shell_print(sh, "%s", perf_line);
+	}
+
+	return 0;
+}
+
+static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	/* Perf may keep running, the counts restart from zero */
+	perf_stacks_clear();
+
+	shell_print(sh, "Perf stacks cleared");
+
+	return 0;
+}
+
+static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
+{
+	struct perf_stacks_info info;
+
+	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		shell_print(sh, "Perf is running");
+	}
+
+	perf_stacks_info_get(&info);
+
+	shell_print(sh, "Perf stacks: %zu/%d, frames: %zu/%d", info.stacks,
+		    CONFIG_PROFILING_PERF_STACKS, info.frames, CONFIG_PROFILING_PERF_BUFFER_SIZE);
+	shell_print(sh, "Perf samples: %u, lost: %u", info.samples, info.lost);
+
+	return 0;
+}
+#else
 static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 {
 	if (sh != NULL) {
@@ -141,11 +280,31 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 
 	return 0;
 }
+#endif
 
 #define CMD_HELP_RECORD                                                                            \
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
 	"Usage: record <duration> <frequency>"
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+#define CMD_HELP_START                                                                             \
+	"Start recording on <frequency> Hz until perf stop\n"                                      \
+	"Usage: start <frequency>"
+
+#define CMD_HELP_FOLDED                                                                            \
+	"Print the stacks in the folded format, or write them to <file>\n"                         \
+	"Usage: folded [<file>]"
+
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
+	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
+	SHELL_CMD_ARG(start, NULL, CMD_HELP_START, cmd_perf_start, 2, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording", cmd_perf_stop, 0, 0),
+	SHELL_CMD_ARG(folded, NULL, CMD_HELP_FOLDED, cmd_perf_folded, 0, 1),
+	SHELL_CMD_ARG(clear, NULL, "Clear the perf stacks", cmd_perf_clear, 0, 0),
+	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
+	SHELL_SUBCMD_SET_END
+);
+#else
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
@@ -153,4 +312,5 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
 );
+#endif
 SHELL_CMD_ARG_REGISTER(perf, &m_sub_perf, "Lightweight profiler", NULL, 0, 0);
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Aggregation of the perf samples. Each distinct stack, identified by its
+ * return addresses, its thread and its CPU, is kept once in a hash table with
+ * the number of samples in which it was seen. The return addresses of all the
+ * stacks are stored one after the other in a shared pool.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/debug/symtab.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "perf_stacks.h"
+
+#define NUM_STACKS CONFIG_PROFILING_PERF_STACKS
+#define NUM_FRAMES CONFIG_PROFILING_PERF_BUFFER_SIZE
+
+/* Stack indexes are stored plus one, 0 ends a bucket */
+#define STACK_NONE 0U
+
+struct perf_stack {
+	uint32_t hash;
+	uint32_t count;
+	k_tid_t thread;
+	uint32_t first_frame;
+	uint16_t next;
+	uint8_t depth;
+	uint8_t cpu;
+#ifdef CONFIG_THREAD_NAME
+	char name[CONFIG_THREAD_MAX_NAME_LEN];
+#endif
+};
+
+static struct {
+	struct k_spinlock lock;
+	uint16_t buckets[NUM_STACKS];
+	struct perf_stack stacks[NUM_STACKS];
+	uintptr_t frames[NUM_FRAMES];
+	size_t num_stacks;
+	size_t num_frames;
+	uint32_t samples;
+	uint32_t lost;
+} perf_stacks;
+
+/* FNV-1a over the words identifying the stack */
+static uint32_t perf_stack_hash(const uintptr_t *frames, size_t depth, k_tid_t thread,
+				uint8_t cpu)
+{
+	uint32_t hash = 2166136261U;
+
+	hash = (hash ^ (uint32_t)(uintptr_t)thread) * 16777619U;
+	hash = (hash ^ cpu) * 16777619U;
+
+	for (size_t i = 0; i < depth; i++) {
+		hash = (hash ^ (uint32_t)frames[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+static bool perf_stack_equal(const struct perf_stack *stack, uint32_t hash,
+			     const uintptr_t *frames, size_t depth, k_tid_t thread, uint8_t cpu)
+{
+	return stack->hash == hash && stack->depth == depth && stack->thread == thread &&
+	       stack->cpu == cpu &&
+	       memcmp(&perf_stacks.frames[stack->first_frame], frames,
+		      depth * sizeof(frames[0])) == 0;
+}
+
+void perf_stacks_add(const uintptr_t *frames, size_t depth)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_stacks.lock);
+	k_tid_t thread = k_current_get();
+	uint8_t cpu = _current_cpu->id;
+	struct perf_stack *stack;
+	uint16_t *bucket;
+	uint32_t hash;
+
+	if (depth == 0U || depth > CONFIG_PROFILING_PERF_STACK_DEPTH) {
+		perf_stacks.lost++;
+		goto out;
+	}
+
+	hash = perf_stack_hash(frames, depth, thread, cpu);
+	bucket = &perf_stacks.buckets[hash % NUM_STACKS];
+
+	for (uint16_t idx = *bucket; idx != STACK_NONE; idx = stack->next) {
+		stack = &perf_stacks.stacks[idx - 1];
+		if (perf_stack_equal(stack, hash, frames, depth, thread, cpu)) {
+			stack->count++;
+			perf_stacks.samples++;
+			goto out;
+		}
+	}
+
+	if (perf_stacks.num_stacks == NUM_STACKS ||
+	    perf_stacks.num_frames + depth > NUM_FRAMES) {
+		perf_stacks.lost++;
+		goto out;
+	}
+
+	stack = &perf_stacks.stacks[perf_stacks.num_stacks];
+	stack->hash = hash;
+	stack->count = 1U;
+	stack->thread = thread;
+	stack->first_frame = perf_stacks.num_frames;
+	stack->depth = depth;
+	stack->cpu = cpu;
+#ifdef CONFIG_THREAD_NAME
+	strncpy(stack->name, k_thread_name_get(thread), sizeof(stack->name) - 1);
+	stack->name[sizeof(stack->name) - 1] = '\0';
+#endif
+	memcpy(&perf_stacks.frames[perf_stacks.num_frames], frames, depth * sizeof(frames[0]));
+
+	stack->next = *bucket;
+	*bucket = ++perf_stacks.num_stacks;
+	perf_stacks.num_frames += depth;
+	perf_stacks.samples++;
+
+out:
+	k_spin_unlock(&perf_stacks.lock, key);
+}
+
+void perf_stacks_clear(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_stacks.lock);
+
+	memset(perf_stacks.buckets, 0, sizeof(perf_stacks.buckets));
+	perf_stacks.num_stacks = 0;
+	perf_stacks.num_frames = 0;
+	perf_stacks.samples = 0U;
+	perf_stacks.lost = 0U;
+
+	k_spin_unlock(&perf_stacks.lock, key);
+}
+
+void perf_stacks_info_get(struct perf_stacks_info *info)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_stacks.lock);
+
+	info->samples = perf_stacks.samples;
+	info->lost = perf_stacks.lost;
+	info->stacks = perf_stacks.num_stacks;
+	info->frames = perf_stacks.num_frames;
+
+	k_spin_unlock(&perf_stacks.lock, key);
+}
+
+static const char *perf_frame_name(uintptr_t addr, char *buf, size_t size)
+{
+#ifdef CONFIG_SYMTAB
+	uint32_t offset;
+	const char *name = symtab_find_symbol_name(addr, &offset);
+
+	if (strcmp(name, "?") != 0) {
+		return name;
+	}
+#endif
+
+	/* Left for scripts/profiling/stackcollapse.py to resolve */
+	snprintf(buf, size, "0x%lx", (unsigned long)addr);
+
+	return buf;
+}
+
+static void perf_append(char *buf, size_t size, size_t *len, const char *fmt, ...)
+{
+	va_list args;
+
+	if (*len >= size) {
+		return;
+	}
+
+	va_start(args, fmt);
+	*len += vsnprintf(buf + *len, size - *len, fmt, args);
+	va_end(args);
+}
+
+size_t perf_stacks_folded(size_t idx, char *buf, size_t size)
+{
+	uintptr_t frames[CONFIG_PROFILING_PERF_STACK_DEPTH];
+	char addr[2 + 2 * sizeof(uintptr_t) + 1];
+	const char *prev_name = NULL;
+	struct perf_stack stack;
+	k_spinlock_key_t key;
+	size_t len = 0;
+
+	/* Stacks are only appended, a copy is consistent until the table is cleared */
+	key = k_spin_lock(&perf_stacks.lock);
+	if (idx >= perf_stacks.num_stacks) {
+		k_spin_unlock(&perf_stacks.lock, key);
+		return 0;
+	}
+
+	stack = perf_stacks.stacks[idx];
+	memcpy(frames, &perf_stacks.frames[stack.first_frame], stack.depth * sizeof(frames[0]));
+	k_spin_unlock(&perf_stacks.lock, key);
+
+#if CONFIG_MP_MAX_NUM_CPUS > 1
+	perf_append(buf, size, &len, "cpu%u;", stack.cpu);
+#endif
+
+#ifdef CONFIG_THREAD_NAME
+	if (stack.name[0] != '\0') {
+		perf_append(buf, size, &len, "%s", stack.name);
+	} else
+#endif
+	{
+		perf_append(buf, size, &len, "thread_%p", stack.thread);
+	}
+
+	/* Outermost first, a function shows once when it is sampled before a call */
+	for (size_t i = stack.depth; i > 0; i--) {
+		const char *name = perf_frame_name(frames[i - 1], addr, sizeof(addr));
+
+		if (prev_name != NULL && strcmp(prev_name, name) == 0) {
+			continue;
+		}
+
+		prev_name = (name != addr) ? name : NULL;
+		perf_append(buf, size, &len, ";%s", name);
+	}
+
+	perf_append(buf, size, &len, " %u", stack.count);
+
+	return MIN(len, size - 1);
+}
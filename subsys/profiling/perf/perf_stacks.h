@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_PROFILING_PERF_STACKS_H_
+#define ZEPHYR_SUBSYS_PROFILING_PERF_STACKS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct perf_stacks_info {
+	/* Samples counted in the table */
+	uint32_t samples;
+	/* Samples which could not be counted */
+	uint32_t lost;
+	/* Distinct stacks in the table */
+	size_t stacks;
+	/* Return addresses of all the distinct stacks */
+	size_t frames;
+};
+
+/**
+ * @brief Count a sample of the current thread.
+ *
+ * Called from the sampling timer, in interrupt context.
+ *
+ * @param frames Return addresses, the innermost first.
+ * @param depth Number of return addresses, 0 if the stack could not be traced.
+ */
+void perf_stacks_add(const uintptr_t *frames, size_t depth);
+
+/**
+ * @brief Remove all the stacks and reset the counters.
+ */
+void perf_stacks_clear(void);
+
+/**
+ * @brief Get the usage of the stack table.
+ *
+ * @param info Filled with the usage of the table.
+ */
+void perf_stacks_info_get(struct perf_stacks_info *info);
+
+/**
+ * @brief Format a stack in the folded format.
+ *
+ * The line starts with the thread and ends with the number of samples, the
+ * functions are separated with semicolons, the outermost first.
+ *
+ * @param idx Index of the stack, from 0 to the number of stacks.
+ * @param buf Buffer for the line, truncated if too small.
+ * @param size Size of the buffer.
+ *
+ * @retval Length of the line.
+ * @retval 0 if there is no stack with this index.
+ */
+size_t perf_stacks_folded(size_t idx, char *buf, size_t size);
+
+#endif /* ZEPHYR_SUBSYS_PROFILING_PERF_STACKS_H_ */
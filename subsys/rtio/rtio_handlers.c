@@ -27,6 +27,7 @@ static inline bool rtio_vrfy_sqe(struct rtio_sqe *sqe)
 
 	switch (sqe->op) {
 	case RTIO_OP_NOP:
+	case RTIO_OP_FSYNC:
 		break;
 	case RTIO_OP_TX:
 		valid_sqe &= K_SYSCALL_MEMORY(sqe->tx.buf, sqe->tx.buf_len, false);
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Packets go to the buffer of the current CPU, only its interrupts are masked */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -38,6 +45,15 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Get the number of dropped tracing packets.
+ *
+ * @param cpu CPU on which the packets were dropped, or -1 for all CPUs.
+ *
+ * @return Number of tracing packets dropped since tracing was initialized.
+ */
+uint32_t tracing_packet_drop_num_get(int cpu);
+
 /**
  * @brief Handle tracing command.
  *
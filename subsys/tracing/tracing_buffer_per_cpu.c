@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Tracing buffer split per CPU. Packets are written by the CPU owning the
+ * buffer with its interrupts masked, so each buffer has a single producer,
+ * and read by the tracing thread, the single consumer. Head and tail are
+ * published with atomic operations, no lock is shared between CPUs.
+ *
+ * Each packet is stored as a record prefixed with a header holding its
+ * length and the cycle count at which it was written. The tracing thread
+ * always outputs the oldest record of all the buffers, without its header,
+ * so the backend gets the same stream as with a single buffer.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <tracing_buffer.h>
+
+#define BUFFER_SIZE (CONFIG_TRACING_BUFFER_SIZE + 1)
+
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+typedef uint64_t tracing_timestamp_t;
+#define TIMESTAMP_GET()		k_cycle_get_64()
+#define TIMESTAMP_BEFORE(a, b)	((int64_t)((a) - (b)) < 0)
+#else
+typedef uint32_t tracing_timestamp_t;
+#define TIMESTAMP_GET()		k_cycle_get_32()
+#define TIMESTAMP_BEFORE(a, b)	((int32_t)((a) - (b)) < 0)
+#endif
+
+/* Packed to keep the overhead low, it is only accessed through memcpy() */
+struct tracing_record_hdr {
+	tracing_timestamp_t timestamp;
+	uint16_t length;
+} __packed;
+
+#define HDR_SIZE sizeof(struct tracing_record_hdr)
+
+struct tracing_cpu_buffer {
+	/* Start of the oldest record, written by the consumer only */
+	atomic_t head;
+	/* End of the newest record, written by the owning CPU only */
+	atomic_t tail;
+	/* Bytes claimed for the record being written, producer side */
+	uint32_t claimed;
+	/* Payload bytes left in the record being output, consumer side */
+	uint32_t remaining;
+	uint8_t data[BUFFER_SIZE];
+};
+
+static struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_MAX_NUM_CPUS];
+static struct tracing_cpu_buffer *output_buffer;
+static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
+
+/* Callers have the local interrupts masked, the thread cannot migrate */
+static inline struct tracing_cpu_buffer *local_buffer(void)
+{
+	return &tracing_cpu_buffers[_current_cpu->id];
+}
+
+static inline uint32_t buffer_used(uint32_t head, uint32_t tail)
+{
+	return (tail >= head) ? (tail - head) : (BUFFER_SIZE - head + tail);
+}
+
+static inline uint32_t buffer_pos(uint32_t pos, uint32_t offset)
+{
+	pos += offset;
+
+	return (pos >= BUFFER_SIZE) ? (pos - BUFFER_SIZE) : pos;
+}
+
+static void buffer_write(struct tracing_cpu_buffer *buf, uint32_t pos,
+			 const void *data, uint32_t size)
+{
+	uint32_t first = MIN(size, BUFFER_SIZE - pos);
+
+	memcpy(&buf->data[pos], data, first);
+	memcpy(&buf->data[0], (const uint8_t *)data + first, size - first);
+}
+
+static void buffer_read(struct tracing_cpu_buffer *buf, uint32_t pos,
+			void *data, uint32_t size)
+{
+	uint32_t first = MIN(size, BUFFER_SIZE - pos);
+
+	memcpy(data, &buf->data[pos], first);
+	memcpy((uint8_t *)data + first, &buf->data[0], size - first);
+}
+
+/* Free space for the payload of the record being written */
+static uint32_t buffer_space(struct tracing_cpu_buffer *buf)
+{
+	uint32_t head = (uint32_t)atomic_get(&buf->head);
+	uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+	uint32_t free = BUFFER_SIZE - 1 - buffer_used(head, tail);
+
+	return (free > HDR_SIZE + buf->claimed) ? (free - HDR_SIZE - buf->claimed) : 0;
+}
+
+/* Find the buffer holding the oldest record and start outputting it */
+static struct tracing_cpu_buffer *oldest_buffer(void)
+{
+	struct tracing_cpu_buffer *oldest = NULL;
+	tracing_timestamp_t oldest_timestamp = 0;
+	struct tracing_record_hdr hdr;
+	uint32_t head;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(tracing_cpu_buffers); i++) {
+		struct tracing_cpu_buffer *buf = &tracing_cpu_buffers[i];
+
+		head = (uint32_t)atomic_get(&buf->head);
+		if (head == (uint32_t)atomic_get(&buf->tail)) {
+			continue;
+		}
+
+		buffer_read(buf, head, &hdr.timestamp, sizeof(hdr.timestamp));
+		if (oldest == NULL || TIMESTAMP_BEFORE(hdr.timestamp, oldest_timestamp)) {
+			oldest = buf;
+			oldest_timestamp = hdr.timestamp;
+		}
+	}
+
+	if (oldest != NULL) {
+		head = (uint32_t)atomic_get(&oldest->head);
+		buffer_read(oldest, head, &hdr, HDR_SIZE);
+		oldest->remaining = hdr.length;
+		atomic_set(&oldest->head, buffer_pos(head, HDR_SIZE));
+	}
+
+	return oldest;
+}
+
+uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+{
+	*data = &tracing_cmd_buffer[0];
+
+	return sizeof(tracing_cmd_buffer);
+}
+
+uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
+{
+	struct tracing_cpu_buffer *buf = local_buffer();
+	uint32_t pos;
+
+	pos = buffer_pos((uint32_t)atomic_get(&buf->tail), HDR_SIZE + buf->claimed);
+	size = MIN(size, MIN(buffer_space(buf), BUFFER_SIZE - pos));
+
+	*data = &buf->data[pos];
+	buf->claimed += size;
+
+	return size;
+}
+
+int tracing_buffer_put_finish(uint32_t size)
+{
+	struct tracing_cpu_buffer *buf = local_buffer();
+	struct tracing_record_hdr hdr;
+	uint32_t tail;
+
+	if (size > buf->claimed) {
+		return -EINVAL;
+	}
+
+	buf->claimed = 0U;
+	if (size == 0U) {
+		return 0;
+	}
+
+	tail = (uint32_t)atomic_get(&buf->tail);
+	hdr.timestamp = TIMESTAMP_GET();
+	hdr.length = size;
+	buffer_write(buf, tail, &hdr, HDR_SIZE);
+
+	/* Publishes the record to the tracing thread */
+	atomic_set(&buf->tail, buffer_pos(tail, HDR_SIZE + size));
+
+	return 0;
+}
+
+uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
+{
+	uint32_t claimed_size, total_size = 0U;
+	uint8_t *dst;
+
+	do {
+		claimed_size = tracing_buffer_put_claim(&dst, size - total_size);
+		memcpy(dst, data + total_size, claimed_size);
+		total_size += claimed_size;
+	} while (total_size < size && claimed_size != 0U);
+
+	(void)tracing_buffer_put_finish(total_size);
+
+	return total_size;
+}
+
+uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
+{
+	uint32_t head;
+
+	if (output_buffer == NULL || output_buffer->remaining == 0U) {
+		output_buffer = oldest_buffer();
+		if (output_buffer == NULL) {
+			return 0;
+		}
+	}
+
+	head = (uint32_t)atomic_get(&output_buffer->head);
+	*data = &output_buffer->data[head];
+
+	return MIN(size, MIN(output_buffer->remaining, BUFFER_SIZE - head));
+}
+
+int tracing_buffer_get_finish(uint32_t size)
+{
+	if (output_buffer == NULL || size > output_buffer->remaining) {
+		return -EINVAL;
+	}
+
+	output_buffer->remaining -= size;
+	atomic_set(&output_buffer->head,
+		   buffer_pos((uint32_t)atomic_get(&output_buffer->head), size));
+
+	return 0;
+}
+
+uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
+{
+	uint32_t claimed_size, total_size = 0U;
+	uint8_t *src;
+
+	do {
+		claimed_size = tracing_buffer_get_claim(&src, size - total_size);
+		memcpy(data + total_size, src, claimed_size);
+		(void)tracing_buffer_get_finish(claimed_size);
+		total_size += claimed_size;
+	} while (total_size < size && claimed_size != 0U);
+
+	return total_size;
+}
+
+void tracing_buffer_init(void)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(tracing_cpu_buffers); i++) {
+		atomic_set(&tracing_cpu_buffers[i].head, 0);
+		atomic_set(&tracing_cpu_buffers[i].tail, 0);
+		tracing_cpu_buffers[i].claimed = 0U;
+		tracing_cpu_buffers[i].remaining = 0U;
+	}
+
+	output_buffer = NULL;
+}
+
+bool tracing_buffer_is_empty(void)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(tracing_cpu_buffers); i++) {
+		if (atomic_get(&tracing_cpu_buffers[i].head) !=
+		    atomic_get(&tracing_cpu_buffers[i].tail)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t tracing_buffer_capacity_get(void)
+{
+	return CONFIG_TRACING_BUFFER_SIZE - HDR_SIZE;
+}
+
+uint32_t tracing_buffer_space_get(void)
+{
+	return buffer_space(local_buffer());
+}
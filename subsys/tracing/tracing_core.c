@@ -41,7 +41,7 @@ enum tracing_state {
 };
 
 static atomic_t tracing_state;
-static atomic_t tracing_packet_drop_num;
+static atomic_t tracing_packet_drop_num[CONFIG_MP_MAX_NUM_CPUS];
 static struct tracing_backend *working_backend;
 
 #ifdef CONFIG_TRACING_ASYNC
@@ -97,7 +97,9 @@ static int tracing_init(void)
 	working_backend = tracing_backend_get(TRACING_BACKEND_NAME);
 	tracing_backend_init(working_backend);
 
-	atomic_set(&tracing_packet_drop_num, 0);
+	for (unsigned int i = 0; i < ARRAY_SIZE(tracing_packet_drop_num); i++) {
+		atomic_set(&tracing_packet_drop_num[i], 0);
+	}
 
 	if (IS_ENABLED(CONFIG_TRACING_HANDLE_HOST_CMD)) {
 		tracing_set_state(TRACING_DISABLE);
@@ -158,5 +160,24 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length)
 
 void tracing_packet_drop_handle(void)
 {
-	atomic_inc(&tracing_packet_drop_num);
+	unsigned int key = arch_irq_lock();
+
+	atomic_inc(&tracing_packet_drop_num[_current_cpu->id]);
+	arch_irq_unlock(key);
+}
+
+uint32_t tracing_packet_drop_num_get(int cpu)
+{
+	uint32_t num = 0U;
+
+	if (cpu >= 0) {
+		return (cpu < ARRAY_SIZE(tracing_packet_drop_num)) ?
+			(uint32_t)atomic_get(&tracing_packet_drop_num[cpu]) : 0U;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(tracing_packet_drop_num); i++) {
+		num += (uint32_t)atomic_get(&tracing_packet_drop_num[i]);
+	}
+
+	return num;
 }
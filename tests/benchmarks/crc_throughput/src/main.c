@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the throughput of the CRC functions
+ * backed by the lookup tables and CPU instructions selected in lib/crc,
+ * as used to verify firmware images, storage sectors and network frames.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+
+#define BUFFER_SIZE    CONFIG_BENCHMARK_BUFFER_SIZE
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+static uint8_t buffer[BUFFER_SIZE];
+
+static uint32_t bench_crc32_ieee(void)
+{
+	return crc32_ieee(buffer, sizeof(buffer));
+}
+
+static uint32_t bench_crc32_c(void)
+{
+	return crc32_c(0, buffer, sizeof(buffer), true, true);
+}
+
+static uint32_t bench_crc16_ccitt(void)
+{
+	return crc16_ccitt(0xffff, buffer, sizeof(buffer));
+}
+
+static int run_crc(const char *tag, const char *description, uint32_t (*crc)(void))
+{
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	uint32_t expected;
+	uint32_t value;
+
+	/* Also fills the tables, if they are filled on first use */
+	expected = crc();
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		value = crc();
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+
+		if (value != expected) {
+			printk("%s not stable: 0x%08x != 0x%08x\n", tag, value, expected);
+			return -EINVAL;
+		}
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / NUM_ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_ITERATIONS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, NUM_ITERATIONS);
+#endif
+
+	printk("    %llu bytes per 1000 cycles\n",
+	       (cycles != 0ULL) ? (1000ULL * BUFFER_SIZE * NUM_ITERATIONS) / cycles : 0ULL);
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+
+	for (int i = 0; i < sizeof(buffer); i++) {
+		buffer[i] = (uint8_t)(i * 131 + 7);
+	}
+
+	printk("CRC of a %d byte buffer, %s\n", BUFFER_SIZE,
+	       IS_ENABLED(CONFIG_CRC_TABLES_SLICE_BY_8) ? "slice-by-8 tables" :
+	       IS_ENABLED(CONFIG_CRC_TABLES_SLICE_BY_4) ? "slice-by-4 tables" :
+	       "4-bit tables");
+	printk("CPU CRC instructions: %s\n",
+	       IS_ENABLED(CONFIG_CRC_HW_INSTRUCTIONS) ? "enabled" : "disabled");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = run_crc("crc.crc32_ieee", "crc32_ieee() of the buffer", bench_crc32_ieee);
+
+	if (ret == 0) {
+		ret = run_crc("crc.crc32_c", "crc32_c() of the buffer", bench_crc32_c);
+	}
+
+	if (ret == 0) {
+		ret = run_crc("crc.crc16_ccitt", "crc16_ccitt() of the buffer",
+			      bench_crc16_ccitt);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the DNS resolver cache and of name
+ * resolution with getaddrinfo() against a DNS server answering on the
+ * loopback interface. The server counts the queries it receives, showing
+ * the queries saved by the cache, by the caching of names which do not
+ * exist and by the sharing of one query between concurrent resolutions of
+ * the same name.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include "dns_cache.h"
+#include "benchmark_utils.h"
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+#define SERVER_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT      53
+#define NUM_NAMES        CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES
+#define NUM_NET_NAMES    16
+#define NUM_MISSING      8
+#define NUM_RESOLVERS    4
+#define NUM_ROUNDS       8
+#define STACK_SIZE       2048
+
+/* Delay of the answers to the shared names, for the resolutions to overlap */
+#define SHARED_DELAY K_MSEC(20)
+
+DNS_CACHE_DEFINE(bench_cache, NUM_NAMES);
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_THREAD_STACK_ARRAY_DEFINE(resolver_stacks, NUM_RESOLVERS, STACK_SIZE);
+static struct k_thread resolver_threads[NUM_RESOLVERS];
+static K_SEM_DEFINE(round_start, 0, NUM_RESOLVERS);
+static K_SEM_DEFINE(round_done, 0, NUM_RESOLVERS);
+
+static atomic_t server_queries;
+static atomic_t resolver_failures;
+static int server_fd = -1;
+
+static bool label_is(const uint8_t *qname, const char *prefix)
+{
+	size_t len = strlen(prefix);
+
+	return qname[0] >= len && memcmp(&qname[1], prefix, len) == 0;
+}
+
+/* Answers A queries with 127.0.0.2, and names starting with "missing" with
+ * NXDOMAIN and the SOA record of the zone.
+ */
+static void server_entry(void *p1, void *p2, void *p3)
+{
+	static const uint8_t answer[] = {
+		0xc0, 0x0c,             /* Name pointer to the question */
+		0x00, 0x01, 0x00, 0x01, /* Type A, class IN */
+		0x00, 0x00, 0x0e, 0x10, /* TTL 3600 */
+		0x00, 0x04, 127, 0, 0, 2,
+	};
+	static const uint8_t authority[] = {
+		0xc0, 0x0c,             /* Name pointer to the question */
+		0x00, 0x06, 0x00, 0x01, /* Type SOA, class IN */
+		0x00, 0x00, 0x00, 0x3c, /* TTL 60 */
+		0x00, 0x16, 0x00, 0x00, /* Root primary server and mailbox */
+		0x00, 0x00, 0x00, 0x01, /* Serial */
+		0x00, 0x00, 0x0e, 0x10, /* Refresh */
+		0x00, 0x00, 0x02, 0x58, /* Retry */
+		0x00, 0x09, 0x3a, 0x80, /* Expire */
+		0x00, 0x00, 0x00, 0x3c, /* Minimum TTL */
+	};
+	struct sockaddr_in peer;
+	socklen_t peer_len;
+	uint8_t buf[512];
+	bool missing;
+	ssize_t len;
+	size_t pos;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		peer_len = sizeof(peer);
+		len = zsock_recvfrom(server_fd, buf, sizeof(buf) - sizeof(authority), 0,
+				     (struct sockaddr *)&peer, &peer_len);
+		if (len < 0) {
+			break;
+		}
+
+		/* Skip the question name, type and class */
+		for (pos = 12; pos < len && buf[pos] != 0; pos += buf[pos] + 1) {
+		}
+
+		pos += 5;
+		if (pos > len) {
+			continue;
+		}
+
+		atomic_inc(&server_queries);
+
+		if (label_is(&buf[12], "shared")) {
+			k_sleep(SHARED_DELAY);
+		}
+
+		missing = label_is(&buf[12], "missing");
+
+		buf[2] = 0x81; /* Response, recursion desired */
+		buf[3] = missing ? 0x83 : 0x80; /* Recursion available, rcode */
+		sys_put_be16(1, &buf[4]);
+		sys_put_be16(missing ? 0 : 1, &buf[6]);
+		sys_put_be16(missing ? 1 : 0, &buf[8]);
+		sys_put_be16(0, &buf[10]);
+
+		if (missing) {
+			memcpy(&buf[pos], authority, sizeof(authority));
+			pos += sizeof(authority);
+		} else {
+			memcpy(&buf[pos], answer, sizeof(answer));
+			pos += sizeof(answer);
+		}
+
+		(void)zsock_sendto(server_fd, buf, pos, 0, (struct sockaddr *)&peer, peer_len);
+	}
+}
+
+static int resolve(const char *name)
+{
+	static const struct zsock_addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_DGRAM,
+	};
+	struct zsock_addrinfo *res;
+	int ret;
+
+	ret = zsock_getaddrinfo(name, NULL, &hints, &res);
+	if (ret == 0) {
+		zsock_freeaddrinfo(res);
+	}
+
+	return ret;
+}
+
+static void resolver_entry(void *p1, void *p2, void *p3)
+{
+	char name[32];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_ROUNDS; i++) {
+		k_sem_take(&round_start, K_FOREVER);
+
+		snprintk(name, sizeof(name), "shared%d.example.com", i);
+		if (resolve(name) != 0) {
+			atomic_inc(&resolver_failures);
+		}
+
+		k_sem_give(&round_done);
+	}
+}
+
+static void print_result(const char *tag, const char *description, uint64_t cycles,
+			 uint32_t count)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / count), (uint32_t)timing_cycles_to_ns_avg(cycles, count));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, count);
+#endif
+}
+
+static int bench_cache_find(void)
+{
+	struct dns_addrinfo info = { .ai_family = AF_INET };
+	uint64_t hit_cycles = 0ULL, miss_cycles = 0ULL;
+	timing_t start, end;
+	char name[32];
+	int ret;
+
+	for (int i = 0; i < NUM_NAMES; i++) {
+		snprintk(name, sizeof(name), "host%d.example.com", i);
+		(void)dns_cache_add(&bench_cache, name, &info, 3600);
+	}
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		snprintk(name, sizeof(name), "host%d.example.com", i % NUM_NAMES);
+
+		start = timing_counter_get();
+		ret = dns_cache_find(&bench_cache, name, DNS_QUERY_TYPE_A, &info, 1);
+		end = timing_counter_get();
+
+		if (ret != 1) {
+			printk("Cache lookup of %s failed (%d)\n", name, ret);
+			return -EIO;
+		}
+
+		hit_cycles += timing_cycles_get(&start, &end);
+
+		snprintk(name, sizeof(name), "other%d.example.com", i % NUM_NAMES);
+
+		start = timing_counter_get();
+		ret = dns_cache_find(&bench_cache, name, DNS_QUERY_TYPE_A, &info, 1);
+		end = timing_counter_get();
+
+		if (ret != 0) {
+			printk("Cache lookup of %s found (%d)\n", name, ret);
+			return -EIO;
+		}
+
+		miss_cycles += timing_cycles_get(&start, &end);
+	}
+
+	print_result("dns_resolve.cache_hit", "Cache lookup (hit, " STRINGIFY(NUM_NAMES)
+		     " names)", hit_cycles, NUM_ITERATIONS);
+	print_result("dns_resolve.cache_miss", "Cache lookup (miss, " STRINGIFY(NUM_NAMES)
+		     " names)", miss_cycles, NUM_ITERATIONS);
+
+	return 0;
+}
+
+static int bench_getaddrinfo(void)
+{
+	atomic_val_t queries = atomic_get(&server_queries);
+	uint64_t net_cycles = 0ULL, cached_cycles = 0ULL;
+	timing_t start, end;
+	char name[32];
+
+	for (int i = 0; i < NUM_NET_NAMES; i++) {
+		snprintk(name, sizeof(name), "net%d.example.com", i);
+
+		start = timing_counter_get();
+		if (resolve(name) != 0) {
+			printk("Cannot resolve %s\n", name);
+			return -EIO;
+		}
+		end = timing_counter_get();
+
+		net_cycles += timing_cycles_get(&start, &end);
+	}
+
+	print_result("dns_resolve.getaddrinfo_query", "getaddrinfo (server query)", net_cycles,
+		     NUM_NET_NAMES);
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		snprintk(name, sizeof(name), "net%d.example.com", i % NUM_NET_NAMES);
+
+		start = timing_counter_get();
+		if (resolve(name) != 0) {
+			printk("Cannot resolve %s\n", name);
+			return -EIO;
+		}
+		end = timing_counter_get();
+
+		cached_cycles += timing_cycles_get(&start, &end);
+	}
+
+	print_result("dns_resolve.getaddrinfo_cached", "getaddrinfo (cached)", cached_cycles,
+		     NUM_ITERATIONS);
+
+	queries = atomic_get(&server_queries) - queries;
+
+	printk("%-74s: %u server queries for %u lookups\n", "getaddrinfo of existing names",
+	       (uint32_t)queries, NUM_NET_NAMES + NUM_ITERATIONS);
+
+	return queries == NUM_NET_NAMES ? 0 : -EIO;
+}
+
+static int bench_missing_names(void)
+{
+	atomic_val_t queries = atomic_get(&server_queries);
+	char name[32];
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		snprintk(name, sizeof(name), "missing%d.example.com", i % NUM_MISSING);
+
+		if (resolve(name) == 0) {
+			printk("Resolved %s\n", name);
+			return -EIO;
+		}
+	}
+
+	queries = atomic_get(&server_queries) - queries;
+
+	printk("%-74s: %u server queries for %u lookups\n", "getaddrinfo of missing names",
+	       (uint32_t)queries, NUM_ITERATIONS);
+
+	return queries == NUM_MISSING ? 0 : -EIO;
+}
+
+static int bench_concurrent(void)
+{
+	atomic_val_t queries = atomic_get(&server_queries);
+
+	for (int i = 0; i < NUM_RESOLVERS; i++) {
+		k_thread_create(&resolver_threads[i], resolver_stacks[i],
+				K_THREAD_STACK_SIZEOF(resolver_stacks[i]), resolver_entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(2), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_ROUNDS; i++) {
+		for (int j = 0; j < NUM_RESOLVERS; j++) {
+			k_sem_give(&round_start);
+		}
+
+		for (int j = 0; j < NUM_RESOLVERS; j++) {
+			k_sem_take(&round_done, K_FOREVER);
+		}
+	}
+
+	queries = atomic_get(&server_queries) - queries;
+
+	printk("%-74s: %u server queries for %u lookups\n", "Concurrent getaddrinfo of a name",
+	       (uint32_t)queries, NUM_ROUNDS * NUM_RESOLVERS);
+
+	if (atomic_get(&resolver_failures) > 0) {
+		printk("%u concurrent lookups failed\n", (uint32_t)atomic_get(&resolver_failures));
+		return -EIO;
+	}
+
+	return queries == NUM_ROUNDS ? 0 : -EIO;
+}
+
+static int setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	(void)zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &addr.sin_addr);
+
+	server_fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (server_fd < 0) {
+		printk("socket failed (%d)\n", errno);
+		return -errno;
+	}
+
+	if (zsock_bind(server_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("bind failed (%d)\n", errno);
+		return -errno;
+	}
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+
+	ret = setup();
+
+	printk("DNS resolver cache of %u entries\n", NUM_NAMES);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	if (ret == 0) {
+		ret = bench_cache_find();
+	}
+
+	if (ret == 0) {
+		ret = bench_getaddrinfo();
+	}
+
+	if (ret == 0) {
+		ret = bench_missing_names();
+	}
+
+	if (ret == 0) {
+		ret = bench_concurrent();
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
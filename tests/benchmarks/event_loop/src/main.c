@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the latency of an event loop waiting
+ * for one active descriptor among many idle ones, like a server with many
+ * idle connections. The loop waits either with zvfs_poll() or with
+ * zvfs_epoll_wait(). The descriptors are eventfds, so that the benchmark
+ * does not depend on the network stack.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+#include <zephyr/zvfs/eventfd.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+
+#define IDLE_FDS       CONFIG_BENCHMARK_IDLE_FDS
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+/* The k_poll_events of zvfs_poll() are on the stack */
+#define LOOP_STACK_SIZE (4096 + CONFIG_ZVFS_POLL_MAX * sizeof(struct k_poll_event))
+
+BUILD_ASSERT(CONFIG_ZVFS_POLL_MAX > IDLE_FDS);
+BUILD_ASSERT(CONFIG_ZVFS_EPOLL_ITEM_MAX > IDLE_FDS);
+
+enum loop_mode {
+	LOOP_POLL,
+	LOOP_EPOLL,
+};
+
+static K_THREAD_STACK_DEFINE(loop_stack, LOOP_STACK_SIZE);
+static struct k_thread loop_thread;
+
+/* The active descriptor comes last, as the worst case of a scan */
+static struct zvfs_pollfd fds[IDLE_FDS + 1];
+static int ping_fd;
+static int pong_fd;
+static int epfd;
+
+static void poll_loop(void)
+{
+	zvfs_eventfd_t value;
+
+	for (int i = 0; i < NUM_ITERATIONS + 1; i++) {
+		if (zvfs_poll(fds, ARRAY_SIZE(fds), -1) <= 0) {
+			break;
+		}
+
+		for (int j = 0; j < ARRAY_SIZE(fds); j++) {
+			if (fds[j].revents == 0) {
+				continue;
+			}
+
+			(void)zvfs_eventfd_read(fds[j].fd, &value);
+			(void)zvfs_eventfd_write(pong_fd, 1);
+		}
+	}
+}
+
+static void epoll_loop(void)
+{
+	struct zvfs_epoll_event events[4];
+	zvfs_eventfd_t value;
+	int ret;
+
+	for (int i = 0; i < NUM_ITERATIONS + 1; i++) {
+		ret = zvfs_epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+		if (ret <= 0) {
+			break;
+		}
+
+		for (int j = 0; j < ret; j++) {
+			(void)zvfs_eventfd_read(events[j].data.fd, &value);
+			(void)zvfs_eventfd_write(pong_fd, 1);
+		}
+	}
+}
+
+static void loop_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if ((enum loop_mode)(uintptr_t)p1 == LOOP_POLL) {
+		poll_loop();
+	} else {
+		epoll_loop();
+	}
+}
+
+static int run_loop(const char *tag, const char *description, enum loop_mode mode)
+{
+	uint64_t cycles = 0ULL;
+	zvfs_eventfd_t value;
+	timing_t start, end;
+	k_tid_t tid;
+
+	tid = k_thread_create(&loop_thread, loop_stack, K_THREAD_STACK_SIZEOF(loop_stack),
+			      loop_entry, (void *)(uintptr_t)mode, NULL, NULL,
+			      K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	/* The first round trip is not measured */
+	for (int i = 0; i < NUM_ITERATIONS + 1; i++) {
+		start = timing_counter_get();
+		(void)zvfs_eventfd_write(ping_fd, 1);
+		if (zvfs_eventfd_read(pong_fd, &value) < 0) {
+			printk("%s: no reply (%d)\n", tag, errno);
+			k_thread_abort(tid);
+			return -EIO;
+		}
+		end = timing_counter_get();
+
+		if (i > 0) {
+			cycles += timing_cycles_get(&start, &end);
+		}
+	}
+
+	k_thread_join(tid, K_FOREVER);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / NUM_ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_ITERATIONS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, NUM_ITERATIONS);
+#endif
+
+	return 0;
+}
+
+static int setup(void)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+	};
+
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		fds[i].fd = zvfs_eventfd(0, 0);
+		fds[i].events = ZVFS_POLLIN;
+		if (fds[i].fd < 0) {
+			printk("eventfd failed (%d)\n", errno);
+			return -ENOMEM;
+		}
+	}
+
+	ping_fd = fds[IDLE_FDS].fd;
+
+	pong_fd = zvfs_eventfd(0, 0);
+	if (pong_fd < 0) {
+		printk("eventfd failed (%d)\n", errno);
+		return -ENOMEM;
+	}
+
+	epfd = zvfs_epoll_create(0);
+	if (epfd < 0) {
+		printk("epoll_create failed (%d)\n", errno);
+		return -ENOMEM;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		ev.data.fd = fds[i].fd;
+		if (zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, fds[i].fd, &ev) < 0) {
+			printk("epoll_ctl failed (%d)\n", errno);
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+
+	ret = setup();
+
+	printk("Event loop with %d idle eventfds and one active\n", IDLE_FDS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	if (ret == 0) {
+		ret = run_loop("event_loop.poll", "zvfs_poll() round trip", LOOP_POLL);
+	}
+
+	if (ret == 0) {
+		ret = run_loop("event_loop.epoll", "zvfs_epoll_wait() round trip", LOOP_EPOLL);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring the throughput of a k_heap while
+ * a growing number of threads stress it at the same time. Each thread runs
+ * the sys_heap_stress() rig, allocating and freeing blocks of pseudo-random,
+ * mostly small, sizes. On SMP systems the threads are spread over the CPUs
+ * so that they contend on the heap lock, which CONFIG_SYS_HEAP_CACHE avoids
+ * for the small blocks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+#include <stdio.h>
+
+#define HEAP_SIZE    CONFIG_BENCHMARK_HEAP_SIZE
+#define MAX_THREADS  CONFIG_BENCHMARK_NUM_THREADS
+#define NUM_OPS      CONFIG_BENCHMARK_NUM_OPS
+#define SCRATCH_SIZE (HEAP_SIZE / 4)
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_HEAP_DEFINE(stress_heap, HEAP_SIZE);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stress_stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread stress_threads[MAX_THREADS];
+
+static uint8_t __aligned(sizeof(void *)) scratch[MAX_THREADS][SCRATCH_SIZE];
+static struct z_heap_stress_result results[MAX_THREADS];
+static timing_t finish_times[MAX_THREADS];
+static timing_t run_start;
+
+static atomic_t ready;
+
+static void *stress_alloc(void *arg, size_t bytes)
+{
+	return k_heap_alloc(arg, bytes, K_NO_WAIT);
+}
+
+static void stress_free(void *arg, void *p)
+{
+	k_heap_free(arg, p);
+}
+
+static void stress_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int num_threads = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	/* Wait for every thread so they all hit the heap at once */
+	if (atomic_inc(&ready) == (num_threads - 1)) {
+		run_start = timing_counter_get();
+	}
+	while (atomic_get(&ready) < num_threads) {
+		k_yield();
+	}
+
+	/* Each thread gets its share of the heap to fill */
+	sys_heap_stress(stress_alloc, stress_free, &stress_heap,
+			HEAP_SIZE / num_threads, NUM_OPS,
+			scratch[id], SCRATCH_SIZE,
+			CONFIG_BENCHMARK_TARGET_PERCENT, &results[id]);
+
+	finish_times[id] = timing_counter_get();
+}
+
+static void run_stress(unsigned int num_threads)
+{
+	unsigned int i;
+
+	/* Start from an empty heap, blocks left by a previous run included */
+	k_heap_init(&stress_heap, stress_heap.heap.init_mem, stress_heap.heap.init_bytes);
+
+	atomic_set(&ready, 0);
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&stress_threads[i], stress_stacks[i],
+				STACK_SIZE, stress_thread,
+				UINT_TO_POINTER(i), UINT_TO_POINTER(num_threads), NULL,
+				K_PRIO_COOP(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_pin(&stress_threads[i], i % arch_num_cpus());
+#endif
+		k_thread_start(&stress_threads[i]);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&stress_threads[i], K_FOREVER);
+	}
+}
+
+static void report_stress(unsigned int num_threads)
+{
+	char tag[50];
+	char description[120];
+	uint64_t cycles = 0ULL;
+	uint32_t total_ops = num_threads * NUM_OPS;
+	uint32_t successful_allocs = 0U;
+	uint32_t total_allocs = 0U;
+	uint64_t ns;
+	unsigned int i;
+
+	/* Wall clock time from the start of the first thread to the end of the last */
+	for (i = 0; i < num_threads; i++) {
+		cycles = MAX(cycles, timing_cycles_get(&run_start, &finish_times[i]));
+		successful_allocs += results[i].successful_allocs;
+		total_allocs += results[i].total_allocs;
+	}
+
+	snprintf(tag, sizeof(tag), "heap.stress.%uthread", num_threads);
+	snprintf(description, sizeof(description),
+		 "Heap operation, %u thread(s) stressing the heap", num_threads);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / total_ops),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, total_ops));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, total_ops);
+#endif
+
+	ns = timing_cycles_to_ns(cycles);
+	printk("    %u thread(s): %llu operations/s, %u of %u allocations succeeded\n",
+	       num_threads, (ns != 0ULL) ? (total_ops * 1000000000ULL) / ns : 0ULL,
+	       successful_allocs, total_allocs);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	struct sys_memory_stats stats;
+
+	sys_heap_runtime_stats_get(&stress_heap.heap, &stats);
+	printk("    max allocated: %zu bytes\n", stats.max_allocated_bytes);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	printk("    cache: %u hits, %u misses, %zu bytes cached\n",
+	       stats.cache_hits, stats.cache_misses, stats.cached_bytes);
+#endif
+#endif
+}
+
+int main(void)
+{
+	unsigned int num_threads;
+
+	timing_init();
+
+	printk("Heap stress with %s\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_CACHE) ? "per-CPU block caches" : "no block cache");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	/* Don't let the first stress thread run before all are started */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	timing_start();
+
+	for (num_threads = 1; num_threads <= MAX_THREADS; num_threads++) {
+		run_stress(num_threads);
+		report_stress(num_threads);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
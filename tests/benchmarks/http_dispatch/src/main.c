@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the time taken by the HTTP server to find
+ * the resource of a request, for services with a growing number of resources.
+ */
+
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+extern struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+							const char *path, int *path_len,
+							bool is_websocket);
+
+static struct http_resource_detail detail = {
+	.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail files_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static uint16_t service_port = 80;
+
+/* REST endpoints sharing a common prefix, like those of a device */
+#define RESOURCE(n, _service)                                                                      \
+	HTTP_RESOURCE_DEFINE(_service##_res_##n, _service,                                         \
+			     "/api/v1/sensors/" STRINGIFY(n) "/value", &detail)
+
+#define SERVICE(_count)                                                                            \
+	HTTP_SERVICE_DEFINE(service_##_count, NULL, &service_port, 1, 1, NULL, NULL);              \
+	LISTIFY(_count, RESOURCE, (;), service_##_count);                                          \
+	HTTP_RESOURCE_DEFINE(service_##_count##_files, service_##_count, "/files/*",              \
+			     &files_detail)
+
+SERVICE(16);
+SERVICE(64);
+SERVICE(256);
+
+static int run_lookup(const char *tag, const char *description,
+		      const struct http_service_desc *service, const char *path,
+		      struct http_resource_detail *expected)
+{
+	struct http_resource_detail *res = NULL;
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	int path_len;
+
+	/* The first lookup is not measured, it may index the resources */
+	for (int i = 0; i < NUM_ITERATIONS + 1; i++) {
+		start = timing_counter_get();
+		res = get_resource_detail(service, path, &path_len, false);
+		end = timing_counter_get();
+
+		if (i > 0) {
+			cycles += timing_cycles_get(&start, &end);
+		}
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / NUM_ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_ITERATIONS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, NUM_ITERATIONS);
+#endif
+
+	return (res == expected) ? 0 : -ENOENT;
+}
+
+static int run_service(const struct http_service_desc *service, int count)
+{
+	char description[64];
+	char tag[40];
+	int ret;
+
+	/* The last resource of the service is the worst case of a scan */
+	snprintf(tag, sizeof(tag), "http_dispatch.%d.last", count);
+	snprintf(description, sizeof(description), "%d resources, last resource", count);
+
+	ret = run_lookup(tag, description, service, (service->res_end - 1)->resource, &detail);
+	if (ret < 0) {
+		return ret;
+	}
+
+	snprintf(tag, sizeof(tag), "http_dispatch.%d.unknown", count);
+	snprintf(description, sizeof(description), "%d resources, unknown resource", count);
+
+	return run_lookup(tag, description, service, "/api/v1/actuators/1/value?unit=si", NULL);
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+
+	printk("HTTP resource lookup with %s\n",
+	       IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_TREE) ? "a prefix tree" : "a linear scan");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = run_service(&service_16, 16);
+
+	if (ret == 0) {
+		ret = run_service(&service_64, 64);
+	}
+
+	if (ret == 0) {
+		ret = run_service(&service_256, 256);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the HTTP server serving static files to a
+ * keep-alive client over the loopback interface. The files live on a small
+ * file system in RAM which counts its accesses, standing for the flash reads
+ * of a real file system. Each scenario reports the time per request and the
+ * file system accesses per request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+#define SERVER_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT      8080
+#define MNT_POINT        "/ram"
+#define FS_TYPE          FS_TYPE_EXTERNAL_BASE
+
+struct ram_file {
+	const char *path;
+	size_t size;
+};
+
+struct ram_file_handle {
+	const struct ram_file *file;
+	size_t pos;
+};
+
+struct ram_fs_stats {
+	uint32_t stats;
+	uint32_t opens;
+	uint32_t reads;
+	uint32_t read_bytes;
+};
+
+static const struct ram_file ram_files[] = {
+	{ MNT_POINT "/index.html", 1024 },
+	{ MNT_POINT "/app.js", 3072 },
+};
+
+static struct ram_file_handle ram_handles[4];
+static struct ram_fs_stats ram_stats;
+
+static struct fs_mount_t ram_mnt = {
+	.type = FS_TYPE,
+	.mnt_point = MNT_POINT,
+};
+
+static uint16_t service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(bench_service, SERVER_IPV4_ADDR, &service_port, 1, 1, NULL, NULL);
+
+static struct http_resource_detail_static_fs static_fs_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+	},
+	.fs_path = MNT_POINT,
+};
+
+HTTP_RESOURCE_DEFINE(index_resource, bench_service, "/index.html", &static_fs_detail);
+HTTP_RESOURCE_DEFINE(app_resource, bench_service, "/app.js", &static_fs_detail);
+
+static const char *const paths[] = { "/index.html", "/app.js" };
+static char etags[ARRAY_SIZE(paths)][48];
+static char buf[4096 + 256];
+static int client_fd = -1;
+
+static const struct ram_file *ram_find(const char *path)
+{
+	for (int i = 0; i < ARRAY_SIZE(ram_files); i++) {
+		if (strcmp(ram_files[i].path, path) == 0) {
+			return &ram_files[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int ram_open(struct fs_file_t *filp, const char *path, fs_mode_t flags)
+{
+	const struct ram_file *file = ram_find(path);
+
+	ram_stats.opens++;
+
+	if (file == NULL) {
+		return -ENOENT;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ram_handles); i++) {
+		if (ram_handles[i].file == NULL) {
+			ram_handles[i].file = file;
+			ram_handles[i].pos = 0;
+			filp->filep = &ram_handles[i];
+			return 0;
+		}
+	}
+
+	return -ENFILE;
+}
+
+static ssize_t ram_read(struct fs_file_t *filp, void *dest, size_t nbytes)
+{
+	struct ram_file_handle *handle = filp->filep;
+	size_t len = MIN(nbytes, handle->file->size - handle->pos);
+
+	/* The content does not matter, only the reads do */
+	memset(dest, 'a' + (handle->pos % 26), len);
+	handle->pos += len;
+
+	ram_stats.reads++;
+	ram_stats.read_bytes += len;
+
+	return len;
+}
+
+static int ram_close(struct fs_file_t *filp)
+{
+	struct ram_file_handle *handle = filp->filep;
+
+	handle->file = NULL;
+
+	return 0;
+}
+
+static int ram_mount(struct fs_mount_t *mountp)
+{
+	ARG_UNUSED(mountp);
+
+	return 0;
+}
+
+static int ram_unmount(struct fs_mount_t *mountp)
+{
+	ARG_UNUSED(mountp);
+
+	return 0;
+}
+
+static int ram_stat(struct fs_mount_t *mountp, const char *path, struct fs_dirent *entry)
+{
+	const struct ram_file *file = ram_find(path);
+
+	ARG_UNUSED(mountp);
+
+	ram_stats.stats++;
+
+	if (file == NULL) {
+		return -ENOENT;
+	}
+
+	entry->type = FS_DIR_ENTRY_FILE;
+	entry->size = file->size;
+	strncpy(entry->name, strrchr(path, '/') + 1, sizeof(entry->name) - 1);
+
+	return 0;
+}
+
+static const struct fs_file_system_t ram_fs = {
+	.open = ram_open,
+	.read = ram_read,
+	.close = ram_close,
+	.mount = ram_mount,
+	.unmount = ram_unmount,
+	.stat = ram_stat,
+};
+
+/* Reads a response, returns its status code */
+static int read_response(int *status)
+{
+	size_t offset = 0;
+	size_t content_len = 0;
+	char *body;
+	char *hdr;
+	ssize_t ret;
+
+	do {
+		ret = zsock_recv(client_fd, buf + offset, sizeof(buf) - 1 - offset, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		offset += ret;
+		buf[offset] = '\0';
+		body = strstr(buf, "\r\n\r\n");
+	} while (body == NULL);
+
+	body += 4;
+
+	hdr = strstr(buf, "Content-Length: ");
+	if (hdr != NULL && hdr < body) {
+		content_len = strtoul(hdr + sizeof("Content-Length: ") - 1, NULL, 10);
+	}
+
+	while (offset < (body - buf) + content_len) {
+		ret = zsock_recv(client_fd, buf + offset, sizeof(buf) - 1 - offset, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		offset += ret;
+	}
+
+	*status = atoi(buf + sizeof("HTTP/1.1 ") - 1);
+
+	return 0;
+}
+
+static int get(int idx, bool conditional, int *status)
+{
+	char request[128];
+	char *etag;
+	int len;
+
+	if (conditional && etags[idx][0] != '\0') {
+		len = snprintf(request, sizeof(request),
+			       "GET %s HTTP/1.1\r\nIf-None-Match: %s\r\n\r\n", paths[idx],
+			       etags[idx]);
+	} else {
+		len = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\n\r\n", paths[idx]);
+	}
+
+	if (zsock_send(client_fd, request, len, 0) != len) {
+		return -EIO;
+	}
+
+	if (read_response(status) < 0) {
+		return -EIO;
+	}
+
+	/* Remember the entity tag for the conditional requests */
+	etag = strstr(buf, "ETag: ");
+	if (etag != NULL && !conditional) {
+		etag += sizeof("ETag: ") - 1;
+		len = strcspn(etag, "\r");
+		snprintf(etags[idx], sizeof(etags[idx]), "%.*s", len, etag);
+	}
+
+	return 0;
+}
+
+static int run_requests(const char *tag, const char *description, bool conditional)
+{
+	struct ram_fs_stats before = ram_stats;
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	int status;
+	int idx;
+
+	/* The first requests are not measured, they may fill the cache */
+	for (int i = 0; i < NUM_ITERATIONS + ARRAY_SIZE(paths); i++) {
+		if (i == ARRAY_SIZE(paths)) {
+			before = ram_stats;
+		}
+
+		idx = i % ARRAY_SIZE(paths);
+
+		start = timing_counter_get();
+		if (get(idx, conditional, &status) < 0) {
+			printk("%s: no response (%d)\n", tag, errno);
+			return -EIO;
+		}
+		end = timing_counter_get();
+
+		/* Only the cached files have an entity tag */
+		if (status != ((conditional && etags[idx][0] != '\0') ? 304 : 200)) {
+			printk("%s: unexpected status %d\n", tag, status);
+			return -EIO;
+		}
+
+		if (i >= ARRAY_SIZE(paths)) {
+			cycles += timing_cycles_get(&start, &end);
+		}
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / NUM_ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_ITERATIONS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, NUM_ITERATIONS);
+#endif
+
+	printk("%-74s: %u stat, %u open, %u read (%u bytes) per 100 requests\n", description,
+	       (ram_stats.stats - before.stats) * 100 / NUM_ITERATIONS,
+	       (ram_stats.opens - before.opens) * 100 / NUM_ITERATIONS,
+	       (ram_stats.reads - before.reads) * 100 / NUM_ITERATIONS,
+	       (ram_stats.read_bytes - before.read_bytes) * 100 / NUM_ITERATIONS);
+
+	return 0;
+}
+
+static int setup(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int ret;
+
+	ret = fs_register(FS_TYPE, &ram_fs);
+	if (ret < 0) {
+		printk("fs_register failed (%d)\n", ret);
+		return ret;
+	}
+
+	ret = fs_mount(&ram_mnt);
+	if (ret < 0) {
+		printk("fs_mount failed (%d)\n", ret);
+		return ret;
+	}
+
+	ret = http_server_start();
+	if (ret < 0) {
+		printk("http_server_start failed (%d)\n", ret);
+		return ret;
+	}
+
+	(void)zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr);
+
+	client_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (client_fd < 0) {
+		printk("socket failed (%d)\n", errno);
+		return -errno;
+	}
+
+	if (zsock_connect(client_fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+		printk("connect failed (%d)\n", errno);
+		return -errno;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+
+	ret = setup();
+
+	printk("HTTP static files %s\n", IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE) ?
+					 "with a cache" : "without a cache");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	if (ret == 0) {
+		ret = run_requests("http_static_fs.get", "GET", false);
+	}
+
+	if (ret == 0) {
+		ret = run_requests("http_static_fs.conditional_get", "Conditional GET", true);
+	}
+
+	timing_stop();
+
+	if (client_fd >= 0) {
+		(void)zsock_close(client_fd);
+	}
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark comparing json_obj_parse(), which needs the
+ * whole document in a mutable buffer, with the incremental parser fed with
+ * chunks of the document as they would be received from a socket. Both fill
+ * the same descriptors. Besides the time per parse, the benchmark reports
+ * the memory each of them needs to hold the data being parsed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/data/json.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_RECORDS    CONFIG_BENCHMARK_NUM_RECORDS
+#define CHUNK_SIZE     CONFIG_BENCHMARK_CHUNK_SIZE
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+/* Upper bound of the size of a record in the document */
+#define RECORD_SIZE    160
+
+struct reading {
+	const char *name;
+	int32_t id;
+	int32_t value;
+	bool ok;
+};
+
+struct report {
+	const char *device;
+	int32_t seq;
+	struct reading readings[NUM_RECORDS];
+	size_t num_readings;
+};
+
+static const struct json_obj_descr reading_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct reading, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct reading, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct reading, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct reading, ok, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr report_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct report, device, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct report, seq, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct report, readings, NUM_RECORDS, num_readings,
+				 reading_descr, ARRAY_SIZE(reading_descr)),
+};
+
+static char document[64 + NUM_RECORDS * RECORD_SIZE];
+static size_t document_len;
+
+/* json_obj_parse() works in place, on a copy of the document */
+static char payload[sizeof(document)];
+
+/* The incremental parser copies the decoded strings here */
+static char strings[32 + NUM_RECORDS * 16];
+
+static struct report report;
+static struct json_stream stream;
+
+static void build_document(void)
+{
+	size_t len;
+
+	len = snprintf(document, sizeof(document),
+		       "{\"device\":\"sensor-hub\",\"seq\":1234,\"readings\":[");
+
+	for (int i = 0; i < NUM_RECORDS; i++) {
+		/* The "meta" object isn't described, and thus skipped */
+		len += snprintf(&document[len], sizeof(document) - len,
+				"%s{\"id\":%d,\"name\":\"temp-%d\",\"value\":%d,\"ok\":%s,"
+				"\"meta\":{\"unit\":\"mC\",\"range\":[-40000,125000]}}",
+				(i == 0) ? "" : ",", i, i, 20000 + i * 37,
+				(i % 3 != 0) ? "true" : "false");
+	}
+
+	len += snprintf(&document[len], sizeof(document) - len, "]}");
+
+	__ASSERT(len < sizeof(document), "document too big");
+	document_len = len;
+}
+
+static size_t strings_size(const struct report *r)
+{
+	size_t size = strlen(r->device) + 1;
+
+	for (int i = 0; i < r->num_readings; i++) {
+		size += strlen(r->readings[i].name) + 1;
+	}
+
+	return size;
+}
+
+static int64_t parse_buffer(void)
+{
+	memcpy(payload, document, document_len);
+
+	return json_obj_parse(payload, document_len, report_descr, ARRAY_SIZE(report_descr),
+			      &report);
+}
+
+static int64_t parse_stream(void)
+{
+	json_stream_init(&stream, report_descr, ARRAY_SIZE(report_descr), &report,
+			 strings, sizeof(strings));
+
+	for (size_t pos = 0; pos < document_len; pos += CHUNK_SIZE) {
+		if (json_stream_feed(&stream, &document[pos],
+				     MIN(CHUNK_SIZE, document_len - pos)) != 0) {
+			break;
+		}
+	}
+
+	return json_stream_finish(&stream);
+}
+
+static int run_parser(const char *tag, const char *description,
+		      int64_t (*parse)(void), size_t ram)
+{
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	int64_t ret;
+	uint64_t ns;
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		memset(&report, 0, sizeof(report));
+
+		start = timing_counter_get();
+		ret = parse();
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+
+		if (ret != BIT64_MASK(ARRAY_SIZE(report_descr)) ||
+		    report.num_readings != NUM_RECORDS) {
+			printk("%s failed: %lld\n", tag, ret);
+			return -EINVAL;
+		}
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / NUM_ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_ITERATIONS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, NUM_ITERATIONS);
+#endif
+
+	ns = timing_cycles_to_ns(cycles);
+	printk("    %llu bytes/s, %zu bytes of RAM for the data being parsed\n",
+	       (ns != 0ULL) ? (document_len * NUM_ITERATIONS * 1000000000ULL) / ns : 0ULL,
+	       ram);
+
+	return 0;
+}
+
+int main(void)
+{
+	char description[120];
+	int ret;
+
+	timing_init();
+	build_document();
+
+	printk("JSON parsing of a %zu byte document with %d records\n", document_len,
+	       NUM_RECORDS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	/* The whole document has to be in a buffer */
+	ret = run_parser("json.parse.buffer", "json_obj_parse() of the whole document",
+			 parse_buffer, document_len);
+
+	/* One chunk at a time, plus the parser state and the decoded strings */
+	if (ret == 0) {
+		snprintf(description, sizeof(description),
+			 "json_stream_feed() of %d byte chunks", CHUNK_SIZE);
+		ret = run_parser("json.parse.stream", description, parse_stream,
+				 CHUNK_SIZE + sizeof(stream) + strings_size(&report));
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring the time taken to log a message in
+ * deferred mode and the number of messages processed per second, while a
+ * growing number of threads log at the same time. Each thread logs messages
+ * in bursts and sleeps in between, so that the logging thread processes the
+ * buffers and no message is dropped. On SMP systems the threads are pinned to
+ * different CPUs so that they contend on the log buffer, which
+ * CONFIG_LOG_PER_CPU_BUFFERS avoids.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include "benchmark_utils.h"
+#include <stdio.h>
+
+LOG_MODULE_REGISTER(benchmark, LOG_LEVEL_INF);
+
+#define MAX_THREADS  CONFIG_MP_MAX_NUM_CPUS
+#define NUM_MESSAGES CONFIG_BENCHMARK_NUM_MESSAGES
+#define BURST_SIZE   CONFIG_BENCHMARK_BURST_SIZE
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(log_stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread log_threads[MAX_THREADS];
+
+static uint64_t thread_cycles[MAX_THREADS];
+static uint32_t drops[MAX_THREADS];
+
+static atomic_t ready;
+
+/* Backend counting the messages and checking that they come in timestamp order */
+static uint32_t processed;
+static uint32_t unordered;
+static uint32_t dropped;
+static log_timestamp_t last_timestamp;
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	log_timestamp_t timestamp = log_msg_get_timestamp(&msg->log);
+
+	if (timestamp < last_timestamp) {
+		unordered++;
+	}
+
+	last_timestamp = timestamp;
+	processed++;
+}
+
+static void backend_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	dropped += cnt;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api count_api = {
+	.process = process,
+	.panic = panic,
+	.dropped = backend_dropped,
+};
+
+LOG_BACKEND_DEFINE(count_backend, count_api, true);
+
+static void log_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int num_threads = POINTER_TO_UINT(p2);
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	uint32_t i, j;
+
+	ARG_UNUSED(p3);
+
+	/* Wait for every thread so they all log at once */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < num_threads) {
+		k_yield();
+	}
+
+	for (i = 0; i < NUM_MESSAGES; i += BURST_SIZE) {
+		start = timing_counter_get();
+		for (j = i; j < MIN(i + BURST_SIZE, NUM_MESSAGES); j++) {
+			LOG_INF("thread %u message %u", id, j);
+		}
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+
+		k_msleep(1);
+	}
+
+	thread_cycles[id] = cycles;
+}
+
+static uint32_t cpu_dropped(unsigned int cpu)
+{
+	uint32_t cnt = 0;
+
+	(void)log_cpu_dropped_get(cpu, &cnt);
+
+	return cnt;
+}
+
+static void run_logging(unsigned int num_threads)
+{
+	unsigned int i;
+
+	atomic_set(&ready, 0);
+	processed = 0;
+
+	for (i = 0; i < MAX_THREADS; i++) {
+		drops[i] = cpu_dropped(i);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&log_threads[i], log_stacks[i],
+				STACK_SIZE, log_thread,
+				UINT_TO_POINTER(i), UINT_TO_POINTER(num_threads), NULL,
+				K_PRIO_COOP(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_pin(&log_threads[i], i % arch_num_cpus());
+#endif
+		k_thread_start(&log_threads[i]);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&log_threads[i], K_FOREVER);
+	}
+
+	/* Wait for the logging thread to process every message */
+	while (log_buffered_cnt() != 0) {
+		k_msleep(1);
+	}
+
+	for (i = 0; i < MAX_THREADS; i++) {
+		drops[i] = cpu_dropped(i) - drops[i];
+	}
+}
+
+static void report_logging(unsigned int num_threads)
+{
+	char tag[50];
+	char description[120];
+	uint64_t cycles = 0ULL;
+	uint64_t max_cycles = 0ULL;
+	uint32_t total_messages = num_threads * NUM_MESSAGES;
+	uint64_t ns;
+	unsigned int i;
+
+	for (i = 0; i < num_threads; i++) {
+		cycles += thread_cycles[i];
+		max_cycles = MAX(max_cycles, thread_cycles[i]);
+	}
+
+	snprintf(tag, sizeof(tag), "log.message.%uthread", num_threads);
+	snprintf(description, sizeof(description),
+		 "Log a message, %u thread(s) logging", num_threads);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / total_messages),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, total_messages));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, total_messages);
+#endif
+
+	/* All the threads log at once, the slowest one sets the pace */
+	ns = timing_cycles_to_ns(max_cycles);
+	printk("    %u thread(s): %u messages processed", num_threads, processed);
+	if (ns != 0ULL) {
+		printk(", %u messages/s while logging",
+		       (uint32_t)((uint64_t)total_messages * NSEC_PER_SEC / ns));
+	}
+	printk("\n");
+
+	if (IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) {
+		printk("    %u thread(s): messages dropped", num_threads);
+		for (i = 0; i < arch_num_cpus(); i++) {
+			printk(" cpu%u %u", i, drops[i]);
+		}
+		printk("\n");
+	}
+}
+
+int main(void)
+{
+	unsigned int num_threads;
+
+	timing_init();
+
+	printk("Logging throughput with %s\n",
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? "per-CPU buffers" : "a shared buffer");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	/* Don't let the first logging thread run before all are started */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	timing_start();
+
+	for (num_threads = 1; num_threads <= arch_num_cpus(); num_threads++) {
+		run_logging(num_threads);
+		report_logging(num_threads);
+	}
+
+	timing_stop();
+
+	printk("Messages dropped: %u, out of timestamp order: %u\n", dropped, unordered);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring how the system heap behind
+ * k_malloc() fragments over a long run. It keeps a set of allocations
+ * alive, most of them small, a few large, and keeps freeing and allocating
+ * them again in a pseudo-random order. A quarter of them are long lived,
+ * pinning the memory they were given while the others come and go around
+ * them. After each epoch the free memory of the heap is compared with the
+ * largest block it can still allocate, which CONFIG_HEAP_MEM_POOL_SLABS
+ * keeps close by moving the small blocks out of the heap.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include "benchmark_utils.h"
+#include <stdio.h>
+
+#define NUM_EPOCHS     CONFIG_BENCHMARK_NUM_EPOCHS
+#define OPS_PER_EPOCH  CONFIG_BENCHMARK_OPS_PER_EPOCH
+#define NUM_SLOTS      CONFIG_BENCHMARK_NUM_SLOTS
+#define LONG_SLOTS     (NUM_SLOTS / 4)
+#define SMALL_MAX_SIZE 128
+#define LARGE_MAX_SIZE 2048
+
+static void *slots[NUM_SLOTS];
+
+static uint64_t alloc_cycles;
+static uint64_t free_cycles;
+static uint32_t num_allocs;
+static uint32_t num_frees;
+static uint32_t failed_allocs;
+
+/* Same LCRNG as the sys_heap stress rig, for repeatable runs */
+static uint32_t rand32(void)
+{
+	static uint64_t state = 123456789; /* seed */
+
+	state = state * 2862933555777941757ULL + 3037000493ULL;
+
+	return (uint32_t)(state >> 32);
+}
+
+static size_t rand_size(void)
+{
+	if ((rand32() % 100) < CONFIG_BENCHMARK_LARGE_PERCENT) {
+		return SMALL_MAX_SIZE + 1 + (rand32() % (LARGE_MAX_SIZE - SMALL_MAX_SIZE));
+	}
+
+	return 1 + (rand32() % SMALL_MAX_SIZE);
+}
+
+static void run_epoch(void)
+{
+	timing_t start, end;
+	unsigned int slot;
+
+	for (int i = 0; i < OPS_PER_EPOCH; i++) {
+		slot = rand32() % NUM_SLOTS;
+
+		if (slots[slot] == NULL) {
+			size_t size = rand_size();
+
+			start = timing_counter_get();
+			slots[slot] = k_malloc(size);
+			end = timing_counter_get();
+
+			alloc_cycles += timing_cycles_get(&start, &end);
+			num_allocs++;
+			if (slots[slot] == NULL) {
+				failed_allocs++;
+			}
+			continue;
+		}
+
+		/* Long lived allocations are seldom freed */
+		if ((slot < LONG_SLOTS) && ((rand32() % 64) != 0)) {
+			continue;
+		}
+
+		start = timing_counter_get();
+		k_free(slots[slot]);
+		end = timing_counter_get();
+
+		free_cycles += timing_cycles_get(&start, &end);
+		num_frees++;
+		slots[slot] = NULL;
+	}
+}
+
+static unsigned int fragmentation_percent(const struct k_malloc_stats *stats)
+{
+	if (stats->heap_free_bytes == 0) {
+		return 0;
+	}
+
+	return 100 - (unsigned int)((stats->heap_largest_free_bytes * 100) /
+				    stats->heap_free_bytes);
+}
+
+static void report_epoch(int epoch)
+{
+	struct k_malloc_stats stats;
+
+	k_malloc_stats_get(&stats);
+
+	printk("    epoch %2d: %6zu bytes free, largest block %6zu bytes,"
+	       " fragmentation %3u%%, %u failed allocations\n",
+	       epoch, stats.heap_free_bytes, stats.heap_largest_free_bytes,
+	       fragmentation_percent(&stats), failed_allocs);
+}
+
+static void report_totals(void)
+{
+	struct k_malloc_stats stats;
+	uint32_t slab_requests;
+
+	k_malloc_stats_get(&stats);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", "malloc.fragmentation.alloc",
+	       "k_malloc() of a random size", (uint32_t)(alloc_cycles / num_allocs),
+	       (uint32_t)timing_cycles_to_ns_avg(alloc_cycles, num_allocs));
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", "malloc.fragmentation.free",
+	       "k_free() of a random size", (uint32_t)(free_cycles / num_frees),
+	       (uint32_t)timing_cycles_to_ns_avg(free_cycles, num_frees));
+#else
+	PRINT_STATS_AVG("k_malloc() of a random size", (uint32_t)alloc_cycles, num_allocs);
+	PRINT_STATS_AVG("k_free() of a random size", (uint32_t)free_cycles, num_frees);
+#endif
+
+	printk("    final fragmentation: %u%%, %u of %u allocations failed\n",
+	       fragmentation_percent(&stats), failed_allocs, num_allocs);
+
+	if (IS_ENABLED(CONFIG_HEAP_MEM_POOL_SLABS)) {
+		slab_requests = stats.slab_hits + stats.slab_misses;
+		printk("    slabs: %u hits, %u misses (%u%% hit rate), %u large allocations\n",
+		       stats.slab_hits, stats.slab_misses,
+		       (slab_requests != 0) ? (stats.slab_hits * 100) / slab_requests : 0,
+		       stats.large_allocs);
+	}
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Malloc fragmentation with %s\n",
+	       IS_ENABLED(CONFIG_HEAP_MEM_POOL_SLABS) ? "size class slabs" : "no slabs");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (int epoch = 0; epoch < NUM_EPOCHS; epoch++) {
+		run_epoch();
+		report_epoch(epoch);
+	}
+
+	report_totals();
+
+	timing_stop();
+
+	for (int i = 0; i < NUM_SLOTS; i++) {
+		k_free(slots[i]);
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
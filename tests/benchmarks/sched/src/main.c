@@ -27,10 +27,16 @@
  * It then iterates this many times, reporting timestamp latencies
  * between each numbered step and for the whole cycle, and a running
  * average for all cycles run.
+ *
+ * On SMP, it then measures how context switch throughput scales with
+ * the number of cores: two threads per CPU keep yielding to each
+ * other for SWITCH_RATE_MS, and the number of switches done on each
+ * CPU is reported along with the total.
  */
 
 #define N_RUNS 1000
 #define N_SETTLE 10
+#define SWITCH_RATE_MS 1000
 
 
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
@@ -43,6 +49,21 @@ static struct k_thread busy_thread[CONFIG_MP_MAX_NUM_CPUS - 1];
 
 static K_THREAD_STACK_ARRAY_DEFINE(busy_thread_stack, CONFIG_MP_MAX_NUM_CPUS - 1,
 				   BUSY_THREAD_STACK_SIZE);
+
+static volatile bool busy_done;
+
+#define N_YIELDERS (2 * CONFIG_MP_MAX_NUM_CPUS)
+
+static struct k_thread yield_thread[N_YIELDERS];
+static K_THREAD_STACK_ARRAY_DEFINE(yield_thread_stack, N_YIELDERS,
+				   BUSY_THREAD_STACK_SIZE);
+
+/* One counter per cache line, only ever written by its own CPU */
+static struct {
+	uint32_t count;
+} __aligned(64) switches[CONFIG_MP_MAX_NUM_CPUS];
+
+static volatile bool yield_done;
 #endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
 
 _wait_q_t waitq;
@@ -100,9 +121,61 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 #if (CONFIG_MP_MAX_NUM_CPUS > 1)
 static void busy_thread_entry(void *arg1, void *arg2, void *arg3)
 {
-	while (true) {
+	while (!busy_done) {
 	}
 }
+
+static void yield_thread_entry(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!yield_done) {
+		unsigned int key = arch_irq_lock();
+
+		switches[arch_curr_cpu()->id].count++;
+		arch_irq_unlock(key);
+
+		k_yield();
+	}
+}
+
+static void switch_rate(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t total = 0U;
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	busy_done = true;
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS - 1; i++) {
+		k_thread_join(&busy_thread[i], K_FOREVER);
+	}
+
+	/* The yielding threads run below our priority, so we get to
+	 * stop them once done sleeping.
+	 */
+	for (int i = 0; i < 2 * num_cpus; i++) {
+		k_thread_create(&yield_thread[i], yield_thread_stack[i],
+				BUSY_THREAD_STACK_SIZE, yield_thread_entry,
+				NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_MSEC(SWITCH_RATE_MS));
+	yield_done = true;
+
+	for (int i = 0; i < 2 * num_cpus; i++) {
+		k_thread_join(&yield_thread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		total += switches[i].count;
+		printk("cpu %d switch rate %u/s\n", i,
+		       (uint32_t)((uint64_t)switches[i].count * MSEC_PER_SEC / SWITCH_RATE_MS));
+	}
+	printk("total switch rate %u/s on %u cpus\n",
+	       (uint32_t)((uint64_t)total * MSEC_PER_SEC / SWITCH_RATE_MS), num_cpus);
+}
 #endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
 
 int main(void)
@@ -181,6 +254,11 @@ int main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+	switch_rate();
+#endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
+
 	printk("fin\n");
 	return 0;
 }
@@ -238,9 +238,11 @@ int main(void)
 
 	freq = timing_freq_get_mhz();
 
-	printk("Time Measurements for %s sched queues\n",
+	printk("Time Measurements for %s sched queues (%s)\n",
 	       IS_ENABLED(CONFIG_SCHED_SIMPLE) ? "simple" :
-	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
+	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq",
+	       IS_ENABLED(CONFIG_SCHED_RUNQ_WORK_STEALING) ? "per-CPU run queues" :
+	       "global run queue");
 	printk("Timing results: Clock frequency: %u MHz\n", freq);
 
 	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a test measuring the time required to arm and abort a
+ * kernel timeout while every CPU does the same at the same time. With a
+ * single global timeout queue all CPUs contend on its lock, while with
+ * CONFIG_TIMEOUT_QUEUE_PER_CPU each of them works on a queue of its own.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/atomic.h>
+#include "benchmark_utils.h"
+#include <timeout_q.h>
+#include <stdio.h>
+
+#define NUM_CPUS   CONFIG_MP_MAX_NUM_CPUS
+#define NUM_OPS    CONFIG_BENCHMARK_CONTENTION_OPS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(contention_stacks, NUM_CPUS, STACK_SIZE);
+static struct k_thread contention_threads[NUM_CPUS];
+
+static struct _timeout contention_timeouts[NUM_CPUS];
+static uint64_t contention_cycles[NUM_CPUS];
+
+static atomic_t ready;
+
+static void dummy_expiry(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	__ASSERT(false, "timeout expired during benchmark");
+}
+
+static void contention_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int num_threads = POINTER_TO_UINT(p2);
+	struct _timeout *to = &contention_timeouts[id];
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	ARG_UNUSED(p3);
+
+	z_init_timeout(to);
+
+	/* Spin until every CPU is ready so they all hit the queues at once */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < num_threads) {
+	}
+
+	start = timing_counter_get();
+	for (i = 0; i < NUM_OPS; i++) {
+		z_add_timeout(to, dummy_expiry, K_TICKS(10));
+		z_abort_timeout(to);
+	}
+	finish = timing_counter_get();
+
+	contention_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static void run_contention(unsigned int num_threads)
+{
+	unsigned int i;
+
+	atomic_set(&ready, 0);
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&contention_threads[i], contention_stacks[i],
+				STACK_SIZE, contention_thread,
+				UINT_TO_POINTER(i), UINT_TO_POINTER(num_threads), NULL,
+				K_PRIO_COOP(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_pin(&contention_threads[i], i);
+#endif
+		k_thread_start(&contention_threads[i]);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&contention_threads[i], K_FOREVER);
+	}
+}
+
+static void report_contention(unsigned int num_threads)
+{
+	char tag[50];
+	char description[120];
+	uint64_t total = 0ULL;
+	uint32_t average;
+	unsigned int i;
+
+	for (i = 0; i < num_threads; i++) {
+		total += contention_cycles[i];
+	}
+
+	average = (uint32_t)(total / num_threads);
+
+	snprintf(tag, sizeof(tag), "timeout.contention.%ucpu", num_threads);
+	snprintf(description, sizeof(description),
+		 "Arm and abort timeout, %u CPU(s) contending", num_threads);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       average / NUM_OPS, (uint32_t)timing_cycles_to_ns_avg(average, NUM_OPS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, average, NUM_OPS);
+#endif
+}
+
+void test_contention(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int num_threads;
+
+	printk("Contention on %s timeout queue(s)\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_PER_CPU) ? "per-CPU" : "global");
+
+	/* Measure with one CPU first, for a baseline without contention */
+	for (num_threads = 1; num_threads <= num_cpus; num_threads++) {
+		run_contention(num_threads);
+		report_contention(num_threads);
+	}
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that will measure the length of time required
+ * to arm and abort kernel timeouts while a varying number of timeouts are
+ * already armed. The timeouts are armed directly on the kernel timeout queue
+ * with durations long enough that none of them expires during the test, so
+ * that only the cost of the queue operations is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include "benchmark_utils.h"
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+#include <stdio.h>
+
+#define NUM_TIMEOUTS CONFIG_BENCHMARK_NUM_TIMEOUTS
+#define NUM_BUCKETS  10
+
+uint32_t tm_off;
+
+static struct _timeout timeouts[NUM_TIMEOUTS];
+static k_ticks_t durations[NUM_TIMEOUTS];
+static uint16_t expiry_order[NUM_TIMEOUTS];
+
+extern void test_contention(void);
+
+uint64_t add_cycles[NUM_TIMEOUTS];
+uint64_t abort_cycles[NUM_TIMEOUTS];
+
+static void dummy_expiry(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	__ASSERT(false, "timeout expired during benchmark");
+}
+
+/**
+ * Generate the pseudo-random duration of each timeout. A fixed seed keeps
+ * the runs comparable between the different timeout queue implementations.
+ * Also sort the timeouts by expiry, as they are all armed back to back.
+ */
+static void durations_init(unsigned int num_timeouts)
+{
+	uint32_t seed = 0x2545F491U;
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0; i < num_timeouts; i++) {
+		seed = (seed * 1103515245U) + 12345U;
+		durations[i] = 1 + ((seed >> 8) % CONFIG_BENCHMARK_MAX_TICKS);
+		z_init_timeout(&timeouts[i]);
+
+		for (j = i; (j > 0) && (durations[expiry_order[j - 1]] > durations[i]); j--) {
+			expiry_order[j] = expiry_order[j - 1];
+		}
+		expiry_order[j] = i;
+	}
+}
+
+static void cycles_reset(unsigned int num_timeouts)
+{
+	unsigned int i;
+
+	for (i = 0; i < num_timeouts; i++) {
+		add_cycles[i] = 0ULL;
+		abort_cycles[i] = 0ULL;
+	}
+}
+
+static void arm_timeouts(unsigned int num_timeouts)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < num_timeouts; i++) {
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], dummy_expiry, K_TICKS(durations[i]));
+		finish = timing_counter_get();
+
+		add_cycles[i] += timing_cycles_get(&start, &finish);
+	}
+}
+
+/**
+ * Abort the timeouts in the order they were armed, which for pseudo-random
+ * durations means from arbitrary positions in the queue.
+ */
+static void test_abort_in_order(unsigned int num_timeouts)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	arm_timeouts(num_timeouts);
+
+	for (i = 0; i < num_timeouts; i++) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[i]);
+		finish = timing_counter_get();
+
+		abort_cycles[num_timeouts - i - 1] += timing_cycles_get(&start, &finish);
+	}
+}
+
+/**
+ * Abort the timeout expiring next each time, which forces the queue to find
+ * a new earliest timeout and the system timer to be reprogrammed.
+ */
+static void test_abort_earliest(unsigned int num_timeouts)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	arm_timeouts(num_timeouts);
+
+	for (i = 0; i < num_timeouts; i++) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[expiry_order[i]]);
+		finish = timing_counter_get();
+
+		abort_cycles[num_timeouts - i - 1] += timing_cycles_get(&start, &finish);
+	}
+}
+
+static uint64_t sqrt_u64(uint64_t square)
+{
+	if (square > 1) {
+		uint64_t lo = sqrt_u64(square >> 2) << 1;
+		uint64_t hi = lo + 1;
+
+		return ((hi * hi) > square) ? lo : hi;
+	}
+
+	return square;
+}
+
+static void compute_and_report_stats(unsigned int num_timeouts, unsigned int num_iterations,
+				     uint64_t *cycles, const char *tag, const char *str)
+{
+	uint64_t minimum = cycles[0];
+	uint64_t maximum = cycles[0];
+	uint64_t total = cycles[0];
+	uint64_t average;
+	uint64_t std_dev = 0;
+	uint64_t tmp;
+	uint64_t diff;
+	unsigned int i;
+
+	for (i = 1; i < num_timeouts; i++) {
+		if (cycles[i] > maximum) {
+			maximum = cycles[i];
+		}
+
+		if (cycles[i] < minimum) {
+			minimum = cycles[i];
+		}
+
+		total += cycles[i];
+	}
+
+	minimum /= (uint64_t)num_iterations;
+	maximum /= (uint64_t)num_iterations;
+	average = total / (num_timeouts * num_iterations);
+
+	/* Calculate standard deviation */
+
+	for (i = 0; i < num_timeouts; i++) {
+		tmp = cycles[i] / num_iterations;
+		diff = (average > tmp) ? (average - tmp) : (tmp - average);
+
+		std_dev += (diff * diff);
+	}
+	std_dev /= num_timeouts;
+	std_dev = sqrt_u64(std_dev);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	int tag_len = strlen(tag);
+	int descr_len = strlen(str);
+	int stag_len = strlen(".stddev");
+	int sdescr_len = strlen(", stddev.");
+
+	stag_len = (tag_len + stag_len < 40) ? 40 - tag_len : stag_len;
+	sdescr_len = (descr_len + sdescr_len < 50) ? 50 - descr_len : sdescr_len;
+
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".min", str,
+	       sdescr_len, ", min.", minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".max", str,
+	       sdescr_len, ", max.", maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".avg", str,
+	       sdescr_len, ", avg.", average, (uint32_t)timing_cycles_to_ns(average));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".stddev", str,
+	       sdescr_len, ", stddev.", std_dev, (uint32_t)timing_cycles_to_ns(std_dev));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+	printk("    Std Deviation: %7llu cycles (%7u nsec)\n", std_dev,
+	       (uint32_t)timing_cycles_to_ns(std_dev));
+#endif
+}
+
+/**
+ * Report the average cost for each tenth of the range of armed timeouts,
+ * showing how the cost scales with the size of the timeout queue.
+ */
+static void report_by_queue_size(unsigned int num_timeouts, unsigned int num_iterations,
+				 uint64_t *cycles, const char *str)
+{
+	char description[120];
+	unsigned int bucket;
+	unsigned int first;
+	unsigned int last;
+	uint64_t total;
+	unsigned int i;
+
+	for (bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+		first = (num_timeouts * bucket) / NUM_BUCKETS;
+		last = (num_timeouts * (bucket + 1)) / NUM_BUCKETS;
+		if (first == last) {
+			continue;
+		}
+
+		total = 0ULL;
+		for (i = first; i < last; i++) {
+			total += cycles[i];
+		}
+
+		snprintf(description, sizeof(description),
+			 "%s with %5u - %5u armed", str, first, last - 1);
+		PRINT_STATS_AVG(description, (uint32_t)(total / (last - first)),
+				num_iterations);
+	}
+}
+
+static void report(unsigned int num_timeouts, unsigned int num_iterations,
+		   uint64_t *cycles, const char *tag, const char *str,
+		   const char *verbose_tag)
+{
+	compute_and_report_stats(num_timeouts, num_iterations, cycles, tag, str);
+	report_by_queue_size(num_timeouts, num_iterations, cycles, str);
+
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	char description[120];
+	char vtag[50];
+	unsigned int i;
+
+	for (i = 0; i < num_timeouts; i++) {
+		snprintf(vtag, sizeof(vtag), "%s.%05u.armed", verbose_tag, i);
+		snprintf(description, sizeof(description), "%-40s - %s", vtag, str);
+		PRINT_STATS_AVG(description, (uint32_t)cycles[i], num_iterations);
+	}
+#else
+	ARG_UNUSED(verbose_tag);
+#endif
+}
+
+int main(void)
+{
+	unsigned int i;
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timer wheel" : "list");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	durations_init(NUM_TIMEOUTS);
+
+	timing_start();
+
+	cycles_reset(NUM_TIMEOUTS);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		test_abort_in_order(NUM_TIMEOUTS);
+	}
+
+	report(NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS, add_cycles,
+	       "timeout.add", "Arm timeout", "TimeoutQ.add");
+	report(NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS, abort_cycles,
+	       "timeout.abort.any", "Abort timeout", "TimeoutQ.abort.any");
+
+	cycles_reset(NUM_TIMEOUTS);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		test_abort_earliest(NUM_TIMEOUTS);
+	}
+
+	report(NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS, abort_cycles,
+	       "timeout.abort.first", "Abort next expiring timeout",
+	       "TimeoutQ.abort.first");
+
+	if (IS_ENABLED(CONFIG_SMP)) {
+		test_contention();
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the TLS handshakes between a client and
+ * a server socket over the loopback interface, both backed by mbedTLS. Each
+ * handshake is measured from connect() to its completion on the client side,
+ * first without session resumption and then resuming the session stored by
+ * the previous handshake, either by session ID or by session ticket depending
+ * on the configuration.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/tls_credentials.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <mbedtls/ssl_ciphersuites.h>
+#include "benchmark_utils.h"
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+
+#define SERVER_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT      4243
+#define PSK_TAG          1
+
+#define SERVER_STACK_SIZE 8192
+
+static const unsigned char psk[] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+static const char psk_id[] = "benchmark_identity";
+
+static const sec_tag_t sec_tags[] = { PSK_TAG };
+static const int ciphersuites[] = { MBEDTLS_TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA256 };
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+static struct sockaddr_in server_addr;
+static int server_fd = -1;
+
+static int tls_socket(bool cache)
+{
+	int value = cache ? TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+	int fd;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	if (fd < 0) {
+		printk("socket failed (%d)\n", errno);
+		return -errno;
+	}
+
+	if (zsock_setsockopt(fd, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags, sizeof(sec_tags)) < 0 ||
+	    zsock_setsockopt(fd, SOL_TLS, TLS_CIPHERSUITE_LIST, ciphersuites,
+			     sizeof(ciphersuites)) < 0 ||
+	    zsock_setsockopt(fd, SOL_TLS, TLS_SESSION_CACHE, &value, sizeof(value)) < 0) {
+		printk("setsockopt failed (%d)\n", errno);
+		(void)zsock_close(fd);
+		return -EINVAL;
+	}
+
+	return fd;
+}
+
+/* The handshake takes place in accept(), the client closes first */
+static void server_entry(void *p1, void *p2, void *p3)
+{
+	uint8_t byte;
+	int fd;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		fd = zsock_accept(server_fd, NULL, NULL);
+		if (fd < 0) {
+			break;
+		}
+
+		(void)zsock_recv(fd, &byte, sizeof(byte), 0);
+		(void)zsock_close(fd);
+	}
+}
+
+static int run_handshakes(const char *tag, const char *description, bool resume)
+{
+	struct tls_session_cache_stats before = { 0 }, after = { 0 };
+	socklen_t optlen = sizeof(before);
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	int64_t uptime = 0;
+	int fd;
+
+	/* The first handshake is not measured, it stores the session to resume */
+	for (int i = 0; i < NUM_ITERATIONS + 1; i++) {
+		fd = tls_socket(resume);
+		if (fd < 0) {
+			return fd;
+		}
+
+		if (i == 1) {
+			(void)zsock_getsockopt(fd, SOL_TLS, TLS_SESSION_CACHE_STATS, &before,
+					       &optlen);
+			uptime = k_uptime_get();
+		}
+
+		start = timing_counter_get();
+		if (zsock_connect(fd, (struct sockaddr *)&server_addr,
+				  sizeof(server_addr)) < 0) {
+			printk("%s: handshake failed (%d)\n", tag, errno);
+			(void)zsock_close(fd);
+			return -EIO;
+		}
+		end = timing_counter_get();
+
+		if (i > 0) {
+			cycles += timing_cycles_get(&start, &end);
+		}
+
+		if (i == NUM_ITERATIONS) {
+			uptime = k_uptime_delta(&uptime);
+			(void)zsock_getsockopt(fd, SOL_TLS, TLS_SESSION_CACHE_STATS, &after,
+					       &optlen);
+		}
+
+		(void)zsock_close(fd);
+	}
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / NUM_ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, NUM_ITERATIONS));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, NUM_ITERATIONS);
+#endif
+
+	printk("%-74s: %u handshakes/s, %u resumed by ID, %u by ticket\n", description,
+	       (uint32_t)(NUM_ITERATIONS * MSEC_PER_SEC / MAX(uptime, 1)),
+	       after.server_hits - before.server_hits,
+	       after.tickets_accepted - before.tickets_accepted);
+
+	if (resume && after.server_hits - before.server_hits +
+		      after.tickets_accepted - before.tickets_accepted != NUM_ITERATIONS) {
+		printk("%s: sessions not resumed\n", tag);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int setup(void)
+{
+	int ret;
+
+	ret = tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK, psk, sizeof(psk));
+	if (ret == 0) {
+		ret = tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK_ID, psk_id,
+					 strlen(psk_id));
+	}
+
+	if (ret < 0) {
+		printk("Failed to add the PSK (%d)\n", ret);
+		return ret;
+	}
+
+	server_addr.sin_family = AF_INET;
+	server_addr.sin_port = htons(SERVER_PORT);
+	(void)zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &server_addr.sin_addr);
+
+	/* The server side cache is always enabled, the client decides */
+	server_fd = tls_socket(true);
+	if (server_fd < 0) {
+		return server_fd;
+	}
+
+	if (zsock_bind(server_fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0 ||
+	    zsock_listen(server_fd, 1) < 0) {
+		printk("Failed to listen (%d)\n", errno);
+		return -errno;
+	}
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+
+	ret = setup();
+
+	printk("TLS 1.2 ECDHE-PSK handshakes, resumed %s\n",
+	       IS_ENABLED(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS) ? "by session ticket" :
+								    "by session ID");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	if (ret == 0) {
+		ret = run_handshakes("tls_handshake.full", "Full handshake", false);
+	}
+
+	if (ret == 0) {
+		ret = run_handshakes("tls_handshake.resumed", "Resumed handshake", true);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
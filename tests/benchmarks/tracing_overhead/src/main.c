@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring the time taken to trace an event
+ * while a growing number of threads trace events at the same time. Each
+ * thread traces CTF named events in bursts and sleeps in between, so that
+ * the tracing thread drains the buffers and no packet is dropped. On SMP
+ * systems the threads are pinned to different CPUs so that they contend on
+ * the tracing lock and buffer, which CONFIG_TRACING_PER_CPU_BUFFERS avoids.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/tc_util.h>
+#include <tracing_core.h>
+#include "benchmark_utils.h"
+#include <stdio.h>
+
+#define MAX_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define NUM_EVENTS  CONFIG_BENCHMARK_NUM_EVENTS
+#define BURST_SIZE  CONFIG_BENCHMARK_BURST_SIZE
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(trace_stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread trace_threads[MAX_THREADS];
+
+static uint64_t thread_cycles[MAX_THREADS];
+static uint32_t drops[MAX_THREADS];
+
+static atomic_t ready;
+
+static void trace_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int num_threads = POINTER_TO_UINT(p2);
+	uint64_t cycles = 0ULL;
+	timing_t start, end;
+	uint32_t i, j;
+
+	ARG_UNUSED(p3);
+
+	/* Wait for every thread so they all trace at once */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < num_threads) {
+		k_yield();
+	}
+
+	for (i = 0; i < NUM_EVENTS; i += BURST_SIZE) {
+		start = timing_counter_get();
+		for (j = i; j < MIN(i + BURST_SIZE, NUM_EVENTS); j++) {
+			sys_trace_named_event("benchmark", id, j);
+		}
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+
+		k_msleep(1);
+	}
+
+	thread_cycles[id] = cycles;
+}
+
+static void run_tracing(unsigned int num_threads)
+{
+	unsigned int i;
+
+	atomic_set(&ready, 0);
+
+	for (i = 0; i < MAX_THREADS; i++) {
+		drops[i] = tracing_packet_drop_num_get(i);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&trace_threads[i], trace_stacks[i],
+				STACK_SIZE, trace_thread,
+				UINT_TO_POINTER(i), UINT_TO_POINTER(num_threads), NULL,
+				K_PRIO_COOP(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_pin(&trace_threads[i], i % arch_num_cpus());
+#endif
+		k_thread_start(&trace_threads[i]);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&trace_threads[i], K_FOREVER);
+	}
+
+	for (i = 0; i < MAX_THREADS; i++) {
+		drops[i] = tracing_packet_drop_num_get(i) - drops[i];
+	}
+}
+
+static void report_tracing(unsigned int num_threads)
+{
+	char tag[50];
+	char description[120];
+	uint64_t cycles = 0ULL;
+	uint32_t total_events = num_threads * NUM_EVENTS;
+	unsigned int i;
+
+	for (i = 0; i < num_threads; i++) {
+		cycles += thread_cycles[i];
+	}
+
+	snprintf(tag, sizeof(tag), "tracing.event.%uthread", num_threads);
+	snprintf(description, sizeof(description),
+		 "Trace an event, %u thread(s) tracing", num_threads);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7u cycles , %7u ns :\n", tag, description,
+	       (uint32_t)(cycles / total_events),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, total_events));
+#else
+	ARG_UNUSED(tag);
+
+	PRINT_STATS_AVG(description, (uint32_t)cycles, total_events);
+#endif
+
+	printk("    %u thread(s): packets dropped", num_threads);
+	for (i = 0; i < arch_num_cpus(); i++) {
+		printk(" cpu%u %u", i, drops[i]);
+	}
+	printk("\n");
+}
+
+int main(void)
+{
+	unsigned int num_threads;
+
+	timing_init();
+
+	printk("Tracing overhead with %s\n",
+	       IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS) ? "per-CPU buffers" : "a shared buffer");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	/* Don't let the first tracing thread run before all are started */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	timing_start();
+
+	for (num_threads = 1; num_threads <= arch_num_cpus(); num_threads++) {
+		run_tracing(num_threads);
+		report_tracing(num_threads);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
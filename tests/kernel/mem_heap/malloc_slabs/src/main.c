@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#define SLAB_MIN_SIZE  CONFIG_HEAP_MEM_POOL_SLAB_MIN_SIZE
+#define SLAB_MAX_SIZE  (SLAB_MIN_SIZE << (CONFIG_HEAP_MEM_POOL_SLAB_CLASSES - 1))
+#define MAX_BLOCKS     (CONFIG_HEAP_MEM_POOL_SLAB_SIZE / SLAB_MAX_SIZE)
+
+static struct k_malloc_stats get_stats(void)
+{
+	struct k_malloc_stats stats;
+
+	zassert_ok(k_malloc_stats_get(&stats));
+
+	return stats;
+}
+
+/**
+ * @brief Test that small allocations are served from the slabs
+ */
+ZTEST(malloc_slabs, test_small_alloc)
+{
+	struct k_malloc_stats before = get_stats();
+	struct k_malloc_stats after;
+	void *p;
+
+	p = k_malloc(SLAB_MIN_SIZE - 1);
+	zassert_not_null(p, "allocation failed");
+
+	after = get_stats();
+	zassert_equal(after.slab_hits, before.slab_hits + 1);
+	zassert_equal(after.slab_used_bytes, before.slab_used_bytes + SLAB_MIN_SIZE);
+	zassert_equal(after.heap_free_bytes, before.heap_free_bytes);
+
+	k_free(p);
+
+	after = get_stats();
+	zassert_equal(after.slab_used_bytes, before.slab_used_bytes);
+}
+
+/**
+ * @brief Test that allocations too big for any size class use the heap
+ */
+ZTEST(malloc_slabs, test_large_alloc)
+{
+	struct k_malloc_stats before = get_stats();
+	struct k_malloc_stats after;
+	void *p;
+
+	p = k_malloc(SLAB_MAX_SIZE + 1);
+	zassert_not_null(p, "allocation failed");
+
+	after = get_stats();
+	zassert_equal(after.large_allocs, before.large_allocs + 1);
+	zassert_equal(after.slab_used_bytes, before.slab_used_bytes);
+	zassert_true(after.heap_free_bytes < before.heap_free_bytes);
+
+	k_free(p);
+
+	after = get_stats();
+	zassert_equal(after.heap_free_bytes, before.heap_free_bytes);
+}
+
+/**
+ * @brief Test that allocations fall back to the heap when their slab is full
+ */
+ZTEST(malloc_slabs, test_slab_exhausted)
+{
+	struct k_malloc_stats before = get_stats();
+	struct k_malloc_stats after;
+	void *blocks[MAX_BLOCKS];
+	void *p;
+	int i;
+
+	for (i = 0; i < MAX_BLOCKS; i++) {
+		blocks[i] = k_malloc(SLAB_MAX_SIZE);
+		zassert_not_null(blocks[i], "allocation failed");
+	}
+
+	p = k_malloc(SLAB_MAX_SIZE);
+	zassert_not_null(p, "fallback allocation failed");
+
+	after = get_stats();
+	zassert_equal(after.slab_hits, before.slab_hits + MAX_BLOCKS);
+	zassert_equal(after.slab_misses, before.slab_misses + 1);
+	zassert_true(after.heap_free_bytes < before.heap_free_bytes);
+
+	k_free(p);
+	for (i = 0; i < MAX_BLOCKS; i++) {
+		k_free(blocks[i]);
+	}
+
+	after = get_stats();
+	zassert_equal(after.slab_used_bytes, before.slab_used_bytes);
+	zassert_equal(after.heap_free_bytes, before.heap_free_bytes);
+}
+
+/**
+ * @brief Test aligned allocations from the slabs
+ */
+ZTEST(malloc_slabs, test_aligned_alloc)
+{
+	struct k_malloc_stats before = get_stats();
+	struct k_malloc_stats after;
+	void *p;
+
+	p = k_aligned_alloc(SLAB_MAX_SIZE, 1);
+	zassert_not_null(p, "allocation failed");
+	zassert_equal((uintptr_t)p % SLAB_MAX_SIZE, 0, "misaligned memory at %p", p);
+
+	after = get_stats();
+	zassert_equal(after.slab_used_bytes, before.slab_used_bytes + SLAB_MAX_SIZE);
+
+	k_free(p);
+}
+
+/**
+ * @brief Test reallocating slab blocks
+ */
+ZTEST(malloc_slabs, test_realloc)
+{
+	struct k_malloc_stats before = get_stats();
+	struct k_malloc_stats after;
+	uint8_t *p, *p2;
+	int i;
+
+	p = k_malloc(SLAB_MIN_SIZE / 2);
+	zassert_not_null(p, "allocation failed");
+	for (i = 0; i < SLAB_MIN_SIZE; i++) {
+		p[i] = i;
+	}
+
+	/* Still fits the block */
+	p2 = k_realloc(p, SLAB_MIN_SIZE);
+	zassert_equal_ptr(p2, p, "block moved");
+
+	/* Moves the block to the heap */
+	p2 = k_realloc(p, SLAB_MAX_SIZE * 2);
+	zassert_not_null(p2, "reallocation failed");
+	for (i = 0; i < SLAB_MIN_SIZE; i++) {
+		zassert_equal(p2[i], i, "content not preserved");
+	}
+
+	after = get_stats();
+	zassert_equal(after.slab_used_bytes, before.slab_used_bytes);
+
+	k_free(p2);
+}
+
+ZTEST_SUITE(malloc_slabs, NULL, NULL, NULL, NULL, NULL);
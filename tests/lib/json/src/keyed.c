@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/data/json.h>
+
+/* More fields than json_obj_parse() can handle */
+#define WIDE_FIELDS 96
+
+/* As many fields as json_obj_parse() can handle */
+#define NARROW_FIELDS 62
+
+#define THROUGHPUT_ITERATIONS 200
+
+#define WIDE_FIELD(n, _) int32_t reading_##n
+#define WIDE_DESCR(n, struct_) JSON_OBJ_DESCR_PRIM(struct_, reading_##n, JSON_TOK_NUMBER)
+
+struct wide {
+	LISTIFY(WIDE_FIELDS, WIDE_FIELD, (;));
+	const char *name;
+};
+
+struct narrow {
+	LISTIFY(NARROW_FIELDS, WIDE_FIELD, (;));
+};
+
+static const struct json_obj_descr wide_descr[] = {
+	LISTIFY(WIDE_FIELDS, WIDE_DESCR, (,), struct wide),
+	JSON_OBJ_DESCR_PRIM(struct wide, name, JSON_TOK_STRING),
+};
+
+static const struct json_obj_descr narrow_descr[] = {
+	LISTIFY(NARROW_FIELDS, WIDE_DESCR, (,), struct narrow),
+};
+
+JSON_OBJ_KEY_TABLE_DEFINE(wide_keys, wide_descr);
+JSON_OBJ_KEY_TABLE_DEFINE(narrow_keys, narrow_descr);
+
+struct point {
+	int32_t x;
+	int32_t y;
+	bool valid;
+};
+
+struct shape {
+	const char *label;
+	struct point origin;
+	struct point points[4];
+	size_t num_points;
+};
+
+static const struct json_obj_descr point_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct point, x, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct point, y, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct point, valid, JSON_TOK_TRUE),
+};
+
+JSON_OBJ_KEY_TABLE_DEFINE(point_keys, point_descr);
+
+static const struct json_obj_descr shape_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct shape, label, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_KEYED_OBJECT(struct shape, origin, point_keys),
+	JSON_OBJ_DESCR_KEYED_OBJ_ARRAY(struct shape, points, 4, num_points, point_keys),
+};
+
+static char document[WIDE_FIELDS * 24 + 64];
+static char payload[sizeof(document)];
+
+/* Fields in reverse order, with an unknown one in the middle */
+static size_t build_document(size_t num_fields, bool with_name)
+{
+	size_t len = 0;
+
+	len += snprintf(&document[len], sizeof(document) - len, "{");
+
+	for (int i = num_fields - 1; i >= 0; i--) {
+		len += snprintf(&document[len], sizeof(document) - len, "\"reading_%d\":%d,",
+				i, i * 1000 - 7);
+
+		if (i == num_fields / 2) {
+			len += snprintf(&document[len], sizeof(document) - len,
+					"\"unknown\":{\"reading_0\":[1,2,3]},");
+		}
+	}
+
+	if (with_name) {
+		len += snprintf(&document[len], sizeof(document) - len, "\"name\":\"wide\",");
+	}
+
+	/* Drop the trailing comma */
+	len--;
+	len += snprintf(&document[len], sizeof(document) - len, "}");
+
+	zassert_true(len < sizeof(document), "document too big");
+
+	return len;
+}
+
+ZTEST(lib_json_test, test_json_keyed_wide)
+{
+	uint32_t decoded[DIV_ROUND_UP(ARRAY_SIZE(wide_descr), 32)];
+	struct wide wide;
+	const int32_t *values = &wide.reading_0;
+	size_t len;
+	int ret;
+
+	len = build_document(WIDE_FIELDS, true);
+	memcpy(payload, document, len);
+
+	memset(&wide, 0, sizeof(wide));
+	ret = json_obj_parse_keyed(payload, len, &wide_keys, &wide, decoded);
+	zassert_equal(ret, 0, "Parsing of a wide object failed: %d", ret);
+
+	for (int i = 0; i < WIDE_FIELDS; i++) {
+		zassert_equal(values[i], i * 1000 - 7, "reading_%d not decoded", i);
+	}
+
+	zassert_str_equal(wide.name, "wide", "name not decoded");
+
+	zassert_equal(decoded[0], UINT32_MAX, "Decoded fields not set");
+	zassert_equal(decoded[1], UINT32_MAX, "Decoded fields not set");
+	zassert_equal(decoded[2], UINT32_MAX, "Decoded fields not set");
+	zassert_equal(decoded[3], BIT(0), "Decoded fields not set");
+
+	/* Without the name, which is then left out of the decoded fields */
+	len = build_document(WIDE_FIELDS, false);
+	memcpy(payload, document, len);
+
+	ret = json_obj_parse_keyed(payload, len, &wide_keys, &wide, decoded);
+	zassert_equal(ret, 0, "Parsing of a wide object failed: %d", ret);
+	zassert_equal(decoded[3], 0, "Missing field marked as decoded");
+
+	/* Repeated keys keep their first value, like json_obj_parse() does */
+	strcpy(payload, "{\"reading_3\":3,\"name\":\"first\",\"reading_3\":4,"
+			"\"name\":{\"ignored\":true}}");
+	ret = json_obj_parse_keyed(payload, strlen(payload), &wide_keys, &wide, decoded);
+	zassert_equal(ret, 0, "Parsing of repeated keys failed: %d", ret);
+	zassert_equal(wide.reading_3, 3, "reading_3 not the first value");
+	zassert_str_equal(wide.name, "first", "name not the first value");
+	zassert_equal(decoded[0], BIT(3), "Decoded fields not set");
+	zassert_equal(decoded[3], BIT(0), "Decoded fields not set");
+
+	/* Errors are reported like json_obj_parse() does */
+	strcpy(payload, "{\"reading_3\":\"not a number\"}");
+	ret = json_obj_parse_keyed(payload, strlen(payload), &wide_keys, &wide, NULL);
+	zassert_equal(ret, -EINVAL, "Value of the wrong type not rejected");
+
+	strcpy(payload, "{\"reading_3\":3");
+	ret = json_obj_parse_keyed(payload, strlen(payload), &wide_keys, &wide, NULL);
+	zassert_equal(ret, -EINVAL, "Truncated object not rejected");
+}
+
+ZTEST(lib_json_test, test_json_keyed_nested)
+{
+	struct shape shape = {
+		.label = "triangle",
+		.origin = { .x = -5, .y = 12, .valid = true },
+		.points = {
+			{ .x = 0, .y = 0, .valid = true },
+			{ .x = 10, .y = 0, .valid = false },
+			{ .x = 0, .y = 10, .valid = true },
+		},
+		.num_points = 3,
+	};
+	const char *expected = "{\"label\":\"triangle\","
+			       "\"origin\":{\"x\":-5,\"y\":12,\"valid\":true},"
+			       "\"points\":[{\"x\":0,\"y\":0,\"valid\":true},"
+			       "{\"x\":10,\"y\":0,\"valid\":false},"
+			       "{\"x\":0,\"y\":10,\"valid\":true}]}";
+	char strings[16];
+	struct json_stream stream;
+	struct shape decoded;
+	char buffer[256];
+	int64_t ret;
+
+	ret = json_obj_encode_buf(shape_descr, ARRAY_SIZE(shape_descr), &shape, buffer,
+				  sizeof(buffer));
+	zassert_equal(ret, 0, "Encoding of keyed objects failed");
+	zassert_str_equal(buffer, expected, "Encoded keyed objects not as expected");
+
+	/* A keyed subobject keeps the first value of repeated keys, like other objects */
+	strcpy(buffer, "{\"points\":[{\"y\":1,\"x\":2,\"valid\":false}],"
+		       "\"origin\":{\"y\":4,\"x\":3,\"y\":5},\"label\":\"square\"}");
+
+	memset(&decoded, 0, sizeof(decoded));
+	ret = json_obj_parse(buffer, strlen(buffer), shape_descr, ARRAY_SIZE(shape_descr),
+			     &decoded);
+	zassert_equal(ret, BIT64_MASK(ARRAY_SIZE(shape_descr)), "Parsing failed: %lld", ret);
+	zassert_str_equal(decoded.label, "square", "label not decoded");
+	zassert_equal(decoded.origin.x, 3, "origin.x not decoded");
+	zassert_equal(decoded.origin.y, 4, "origin.y not the first value");
+	zassert_equal(decoded.num_points, 1, "points not decoded");
+	zassert_equal(decoded.points[0].x, 2, "points[0].x not decoded");
+	zassert_equal(decoded.points[0].y, 1, "points[0].y not decoded");
+
+	/* Same for the incremental parser */
+	strcpy(buffer, "{\"points\":[{\"y\":1,\"x\":2,\"valid\":false}],"
+		       "\"origin\":{\"y\":4,\"x\":3,\"y\":5},\"label\":\"square\"}");
+	memset(&decoded, 0, sizeof(decoded));
+	json_stream_init(&stream, shape_descr, ARRAY_SIZE(shape_descr), &decoded, strings,
+			 sizeof(strings));
+	ret = json_stream_feed(&stream, buffer, strlen(buffer));
+	zassert_true(ret >= 0, "Feeding failed: %lld", ret);
+	ret = json_stream_finish(&stream);
+	zassert_equal(ret, BIT64_MASK(ARRAY_SIZE(shape_descr)), "Parsing failed: %lld", ret);
+	zassert_equal(decoded.origin.x, 3, "origin.x not decoded");
+	zassert_equal(decoded.origin.y, 4, "origin.y not the first value");
+
+	/* Encoded objects, one byte at a time */
+	memset(&decoded, 0, sizeof(decoded));
+	json_stream_init(&stream, shape_descr, ARRAY_SIZE(shape_descr), &decoded, strings,
+			 sizeof(strings));
+
+	for (const char *pos = expected; *pos != '\0'; pos++) {
+		ret = json_stream_feed(&stream, pos, 1);
+		zassert_true(ret >= 0, "Feeding failed: %lld", ret);
+	}
+
+	ret = json_stream_finish(&stream);
+	zassert_equal(ret, BIT64_MASK(ARRAY_SIZE(shape_descr)), "Parsing failed: %lld", ret);
+	zassert_str_equal(decoded.label, "triangle", "label not decoded");
+	zassert_mem_equal(&decoded.origin, &shape.origin, sizeof(shape.origin),
+			  "origin not decoded");
+	zassert_equal(decoded.num_points, 3, "points not decoded");
+	zassert_mem_equal(decoded.points, shape.points, 3 * sizeof(shape.points[0]),
+			  "points not decoded");
+}
+
+/* Time per parse of the whole document, in cycles */
+static uint64_t parse_cycles(size_t len, bool keyed, void *val, size_t size)
+{
+	uint64_t cycles = 0ULL;
+	uint32_t start;
+	int64_t ret;
+
+	for (int i = 0; i < THROUGHPUT_ITERATIONS; i++) {
+		memcpy(payload, document, len);
+		memset(val, 0, size);
+
+		start = k_cycle_get_32();
+
+		if (keyed) {
+			ret = json_obj_parse_keyed(payload, len, &narrow_keys, val, NULL);
+		} else {
+			ret = json_obj_parse(payload, len, narrow_descr,
+					     ARRAY_SIZE(narrow_descr), val);
+		}
+
+		cycles += k_cycle_get_32() - start;
+
+		zassert_true(ret >= 0, "Parsing failed: %lld", ret);
+	}
+
+	return cycles;
+}
+
+ZTEST(lib_json_test, test_json_keyed_throughput)
+{
+	static struct narrow linear;
+	static struct narrow keyed;
+	uint64_t linear_cycles;
+	uint64_t keyed_cycles;
+	size_t len;
+
+	len = build_document(NARROW_FIELDS, false);
+
+	linear_cycles = parse_cycles(len, false, &linear, sizeof(linear));
+	keyed_cycles = parse_cycles(len, true, &keyed, sizeof(keyed));
+
+	zassert_mem_equal(&keyed, &linear, sizeof(keyed), "Keyed parse differs");
+
+	TC_PRINT("%d fields, %zu bytes: linear %llu cycles, keyed %llu cycles per parse\n",
+		 NARROW_FIELDS, len, linear_cycles / THROUGHPUT_ITERATIONS,
+		 keyed_cycles / THROUGHPUT_ITERATIONS);
+}
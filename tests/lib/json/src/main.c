@@ -1362,4 +1362,251 @@ ZTEST(lib_json_test, test_json_array_alignment)
 	zassert_equal(o.array[1].int3, 6, "Element 1 int3 not decoded correctly");
 }
 
+static int64_t stream_parse(const char *json, size_t len, size_t chunk_size,
+			    const struct json_obj_descr *descr, size_t descr_len,
+			    void *val, char *buf, size_t buf_size)
+{
+	struct json_stream stream;
+	int ret;
+
+	ret = json_stream_init(&stream, descr, descr_len, val, buf, buf_size);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (size_t pos = 0; pos < len; pos += chunk_size) {
+		ret = json_stream_feed(&stream, json + pos, MIN(chunk_size, len - pos));
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	return json_stream_finish(&stream);
+}
+
+static void assert_nested_equal(const struct test_nested *a, const struct test_nested *b)
+{
+	zassert_equal(a->nested_int, b->nested_int, "Nested integer not decoded correctly");
+	zassert_equal(a->nested_bool, b->nested_bool, "Nested boolean not decoded correctly");
+	zassert_str_equal(a->nested_string, b->nested_string,
+			  "Nested string not decoded correctly");
+	zassert_equal(a->nested_int64, b->nested_int64, "Nested int64 not decoded correctly");
+}
+
+ZTEST(lib_json_test, test_json_stream_decoding)
+{
+	static const char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_int\":\t42\n,"
+		"\"some_bool\":true    \t  "
+		"\n"
+		"\r   ,"
+		"\"some_int64\":-4611686018427387904,"
+		"\"another_int64\":-2147483648,"
+		"\"some_uint64\":18446744073709551615,"
+		"\"another_uint64\":0,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\","
+		"\"nested_int64\":9223372036854775807,"
+		"\"extra_nested_array\":[0,-1]},"
+		"\"extra_struct\":{\"nested_bool\":false,\"s\":\"}]\"},"
+		"\"extra_bool\":true,"
+		"\"some_array\":[11,22, 33,\t45,\n299],"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\","
+		"\"nested_int64\":-9223372036854775806},"
+		"\"nested_obj_array\":["
+		"{\"nested_int\":1,\"nested_bool\":true,\"nested_string\":\"true\"},"
+		"{\"nested_int\":0,\"nested_bool\":false,\"nested_string\":\"false\"}]"
+		"}\n";
+	const size_t chunk_sizes[] = { 1, 3, 16, sizeof(encoded) - 1 };
+	char payload[sizeof(encoded)];
+	struct test_struct expected;
+	struct test_struct ts;
+	char buf[128];
+	int64_t expected_ret;
+	int64_t ret;
+
+	memset(&expected, 0, sizeof(expected));
+	memcpy(payload, encoded, sizeof(encoded));
+	expected_ret = json_obj_parse(payload, sizeof(payload) - 1, test_descr,
+				      ARRAY_SIZE(test_descr), &expected);
+	zassert_equal(expected_ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+		      "Not all fields decoded correctly");
+
+	for (int i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		memset(&ts, 0, sizeof(ts));
+
+		ret = stream_parse(encoded, sizeof(encoded) - 1, chunk_sizes[i],
+				   test_descr, ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+		zassert_equal(ret, expected_ret, "Chunks of %zu: not all fields decoded",
+			      chunk_sizes[i]);
+
+		zassert_str_equal(ts.some_string, expected.some_string,
+				  "String not decoded correctly");
+		zassert_equal(ts.some_int, expected.some_int, "Integer not decoded correctly");
+		zassert_equal(ts.some_bool, expected.some_bool, "Boolean not decoded correctly");
+		zassert_equal(ts.some_int64, expected.some_int64, "int64 not decoded correctly");
+		zassert_equal(ts.another_int64, expected.another_int64,
+			      "int64 not decoded correctly");
+		zassert_equal(ts.some_uint64, expected.some_uint64,
+			      "uint64 not decoded correctly");
+		zassert_equal(ts.another_uint64, expected.another_uint64,
+			      "uint64 not decoded correctly");
+		assert_nested_equal(&ts.some_nested_struct, &expected.some_nested_struct);
+		zassert_equal(ts.some_array_len, expected.some_array_len,
+			      "Array doesn't have correct number of items");
+		zassert_mem_equal(ts.some_array, expected.some_array,
+				  expected.some_array_len * sizeof(ts.some_array[0]),
+				  "Array not decoded with expected values");
+		zassert_equal(ts.another_bxxl, expected.another_bxxl,
+			      "Named boolean (special chars) not decoded correctly");
+		zassert_equal(ts.if_, expected.if_,
+			      "Named boolean (reserved word) not decoded correctly");
+		zassert_equal(ts.another_array_len, expected.another_array_len,
+			      "Named array does not have correct number of items");
+		zassert_mem_equal(ts.another_array, expected.another_array,
+				  expected.another_array_len * sizeof(ts.another_array[0]),
+				  "Decoded named array not with expected values");
+		assert_nested_equal(&ts.xnother_nexx, &expected.xnother_nexx);
+		zassert_equal(ts.obj_array_len, expected.obj_array_len,
+			      "Array of objects does not have correct number of items");
+		for (int j = 0; j < expected.obj_array_len; j++) {
+			assert_nested_equal(&ts.nested_obj_array[j],
+					    &expected.nested_obj_array[j]);
+		}
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_2dim_obj_arr_decoding)
+{
+	static const char encoded[] = "{\"name\":\"athletes\",\"data\":["
+		"[{\"name\":\"Usain Bolt\",\"height\":195}],"
+		"[{\"name\":\"Muggsy Bogues\",\"height\":160},"
+		 "{\"name\":\"Hakeem Olajuwon\",\"height\":213}]"
+		"],\"val\":3}";
+	struct obj_array_2dim_extra oaa;
+	char buf[64];
+	int64_t ret;
+
+	ret = stream_parse(encoded, sizeof(encoded) - 1, 5, array_2dim_extra_named_descr,
+			   ARRAY_SIZE(array_2dim_extra_named_descr), &oaa, buf, sizeof(buf));
+
+	zassert_equal(ret, 7, "Not all fields decoded correctly");
+	zassert_str_equal(oaa.name, "athletes", "String not decoded correctly");
+	zassert_equal(oaa.val, 3, "Integer not decoded correctly");
+	zassert_equal(oaa.obj_array_2dim.objects_array_array_len, 2,
+		      "Number of subarrays not decoded correctly");
+	zassert_equal(oaa.obj_array_2dim.objects_array_array[0].num_elements, 1,
+		      "Number of object fields not decoded correctly");
+	zassert_equal(oaa.obj_array_2dim.objects_array_array[1].num_elements, 2,
+		      "Number of object fields not decoded correctly");
+	zassert_str_equal(oaa.obj_array_2dim.objects_array_array[1].elements[1].name,
+			  "Hakeem Olajuwon", "Element name not decoded correctly");
+	zassert_equal(oaa.obj_array_2dim.objects_array_array[1].elements[1].height, 213,
+		      "Element height not decoded correctly");
+}
+
+struct test_tokens {
+	struct json_obj_token flt;
+	struct json_obj_token opaque;
+	struct json_obj_token raw;
+};
+
+static const struct json_obj_descr tokens_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct test_tokens, flt, JSON_TOK_FLOAT),
+	JSON_OBJ_DESCR_PRIM(struct test_tokens, opaque, JSON_TOK_OPAQUE),
+	JSON_OBJ_DESCR_PRIM(struct test_tokens, raw, JSON_TOK_OBJ_ARRAY),
+};
+
+ZTEST(lib_json_test, test_json_stream_tokens)
+{
+	static const char encoded[] = "{\"flt\":-12.75,\"opaque\":\"a\\\"b\","
+				      "\"raw\":[{\"a\":\"]\"},[1, 2]]}";
+	struct test_tokens tokens;
+	char buf[64];
+	int64_t ret;
+
+	ret = stream_parse(encoded, sizeof(encoded) - 1, 2, tokens_descr,
+			   ARRAY_SIZE(tokens_descr), &tokens, buf, sizeof(buf));
+
+	zassert_equal(ret, 7, "Not all fields decoded correctly");
+	zassert_equal(tokens.flt.length, strlen("-12.75"), "Float not decoded correctly");
+	zassert_mem_equal(tokens.flt.start, "-12.75", tokens.flt.length,
+			  "Float not decoded correctly");
+	zassert_equal(tokens.opaque.length, strlen("a\\\"b"), "Opaque not decoded correctly");
+	zassert_mem_equal(tokens.opaque.start, "a\\\"b", tokens.opaque.length,
+			  "Opaque not decoded correctly");
+	zassert_equal(tokens.raw.length, strlen("[{\"a\":\"]\"},[1, 2]]"),
+		      "Object array not decoded correctly");
+	zassert_mem_equal(tokens.raw.start, "[{\"a\":\"]\"},[1, 2]]", tokens.raw.length,
+			  "Object array not decoded correctly");
+}
+
+ZTEST(lib_json_test, test_json_stream_errors)
+{
+	static const struct {
+		const char *str;
+		int result;
+	} encoded[] = {
+		{ "{\"some_string\":\"\\uA@@@\"}", -EINVAL },
+		{ "{\"some_bool\":truffle }", -EINVAL },
+		{ "{\"some_string\":null }", -EINVAL },
+		{ "{\"some_int\":- }", -EINVAL },
+		{ "{\"some_string\",}", -EINVAL },
+		{ "{\"some_string\":false}", -EINVAL },
+		{ "{\"some_int\":1,}", -EINVAL },
+		{ "[]", -EINVAL },
+		/* Truncated */
+		{ "{\"some_string\"", -EINVAL },
+		{ "{\"some_int\":1", -EINVAL },
+		/* Array too long */
+		{ "{\"another-array\":[1,2,3,4,5,6,7,8,9,10,11]}", -ENOSPC },
+		/* String buffer too small */
+		{ "{\"some_string\":\"0123456789abcdef\"}", -ENOMEM },
+		{ "{\"key_not_in_descr\":\"0123456789abcdef\"}", 0 },
+	};
+	struct test_struct ts;
+	char buf[16];
+	int64_t ret;
+
+	for (int i = 0; i < ARRAY_SIZE(encoded); i++) {
+		ret = stream_parse(encoded[i].str, strlen(encoded[i].str), 4, test_descr,
+				   ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+		zassert_equal(ret, encoded[i].result, "Decoding '%s' result %lld, expected %d",
+			      encoded[i].str, ret, encoded[i].result);
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_max_depth)
+{
+	char encoded[4 * CONFIG_JSON_STREAM_MAX_DEPTH + 32];
+	struct test_struct ts;
+	size_t len = 0;
+	int64_t ret;
+
+	/* Unknown values are skipped whatever their depth */
+	len += sprintf(encoded, "{\"unknown\":");
+	for (int i = 0; i < CONFIG_JSON_STREAM_MAX_DEPTH + 1; i++) {
+		encoded[len++] = '[';
+	}
+	for (int i = 0; i < CONFIG_JSON_STREAM_MAX_DEPTH + 1; i++) {
+		encoded[len++] = ']';
+	}
+	encoded[len++] = '}';
+
+	ret = stream_parse(encoded, len, 1, test_descr, ARRAY_SIZE(test_descr), &ts, NULL, 0);
+	zassert_equal(ret, 0, "Deeply nested unknown value not skipped");
+
+	/* Data following the object is ignored */
+	ret = stream_parse("{} trailing", strlen("{} trailing"), 1, test_descr,
+			   ARRAY_SIZE(test_descr), &ts, NULL, 0);
+	zassert_equal(ret, 0, "Data following the object not ignored");
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
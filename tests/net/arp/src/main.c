@@ -24,10 +24,14 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_ARP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/dummy.h>
+#include <zephyr/net/net_event.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/ipv4_route.h>
 #include <zephyr/ztest.h>
 #include <zephyr/random/random.h>
 
 #include "arp.h"
+#include "ipv4.h"
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
@@ -656,4 +660,200 @@ ZTEST(arp_fn_tests, test_arp)
 	}
 }
 
+/* Check that the ARP request for a far destination targets the given gateway */
+static void check_arp_gw(struct net_if *iface, struct in_addr *src,
+			 struct in_addr *dst, struct in_addr *gw)
+{
+	struct net_ipv4_hdr *ipv4;
+	struct net_arp_hdr *arp_hdr;
+	struct net_pkt *pkt;
+	struct net_pkt *req;
+
+	/* No pending request, so that a new one is always created */
+	net_arp_clear_cache(iface);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipv4_addr_copy_raw(ipv4->src, (uint8_t *)src);
+	net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)dst);
+	net_pkt_set_ll_proto_type(pkt, NET_ETH_PTYPE_IP);
+
+	req = net_arp_prepare(pkt, dst, NULL);
+	zassert_not_null(req, "No ARP request for %s", net_sprint_ipv4_addr(dst));
+	zassert_not_equal((void *)req, (void *)pkt, "ARP cache should be empty");
+
+	arp_hdr = NET_ARP_HDR(req);
+	zassert_true(net_ipv4_addr_cmp_raw(arp_hdr->dst_ipaddr, (uint8_t *)gw),
+		     "ARP request for %s, should be for %s",
+		     net_sprint_ipv4_addr(&arp_hdr->dst_ipaddr),
+		     net_sprint_ipv4_addr(gw));
+
+	net_pkt_unref(req);
+	net_arp_clear_cache(iface);
+	net_pkt_unref(pkt);
+}
+
+#if defined(CONFIG_NET_MGMT_EVENT_INFO)
+struct route_event {
+	uint32_t event;
+	struct net_event_ipv4_route info;
+};
+
+K_MSGQ_DEFINE(route_events, sizeof(struct route_event), 8, 4);
+
+static struct net_mgmt_event_callback route_event_cb;
+
+static void route_event_handler(struct net_mgmt_event_callback *cb,
+				uint32_t mgmt_event, struct net_if *iface)
+{
+	struct route_event ev = {
+		.event = mgmt_event,
+	};
+
+	ARG_UNUSED(iface);
+
+	if (mgmt_event != NET_EVENT_IPV4_ROUTE_ADD &&
+	    mgmt_event != NET_EVENT_IPV4_ROUTE_DEL) {
+		return;
+	}
+
+	if (cb->info_length == sizeof(ev.info)) {
+		memcpy(&ev.info, cb->info, sizeof(ev.info));
+	}
+
+	(void)k_msgq_put(&route_events, &ev, K_NO_WAIT);
+}
+
+static void check_route_event(uint32_t event, struct in_addr *prefix,
+			      uint8_t prefix_len, struct in_addr *gw)
+{
+	struct route_event ev;
+
+	zassert_ok(k_msgq_get(&route_events, &ev, K_SECONDS(1)), "No route event");
+	zassert_equal(ev.event, event, "Wrong route event 0x%08x", ev.event);
+	zassert_true(net_ipv4_addr_cmp(&ev.info.addr, prefix), "Wrong route prefix");
+	zassert_equal(ev.info.prefix_len, prefix_len, "Wrong route prefix length");
+	zassert_true(net_ipv4_addr_cmp(&ev.info.gw, gw), "Wrong route gateway");
+}
+#else
+#define check_route_event(...)
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+static void count_route_cb(const struct net_ipv4_route_info *route, void *user_data)
+{
+	int *count = user_data;
+
+	ARG_UNUSED(route);
+
+	(*count)++;
+}
+
+ZTEST(arp_fn_tests, test_arp_route)
+{
+	struct in_addr src = { { { 192, 0, 2, 1 } } };
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+	struct in_addr gw = { { { 192, 0, 2, 42 } } };
+	struct in_addr gw16 = { { { 192, 0, 2, 43 } } };
+	struct in_addr gw24 = { { { 192, 0, 2, 44 } } };
+	struct in_addr prefix16 = { { { 10, 11, 0, 0 } } };
+	struct in_addr prefix24 = { { { 10, 11, 12, 0 } } };
+	struct in_addr dst24 = { { { 10, 11, 12, 13 } } };
+	struct in_addr dst16 = { { { 10, 11, 99, 1 } } };
+	struct in_addr dst_far = { { { 172, 16, 14, 186 } } };
+	struct net_ipv4_route_info route;
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+	int count;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_IPV4_ROUTE);
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+
+#if defined(CONFIG_NET_MGMT_EVENT_INFO)
+	net_mgmt_init_event_callback(&route_event_cb, route_event_handler,
+				     NET_EVENT_IPV4_ROUTE_ADD | NET_EVENT_IPV4_ROUTE_DEL);
+	net_mgmt_add_event_callback(&route_event_cb);
+#endif
+
+	net_if_ipv4_set_gw(iface, &gw);
+
+	ifaddr = net_if_ipv4_addr_add(iface, &src, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add address");
+	ifaddr->addr_state = NET_ADDR_PREFERRED;
+
+	net_if_ipv4_set_netmask_by_addr(iface, &src, &netmask);
+
+	zassert_ok(net_ipv4_route_add(iface, &prefix16, 16, &gw16,
+				      NET_IPV4_ROUTE_INFINITE_LIFETIME), "Cannot add route");
+	check_route_event(NET_EVENT_IPV4_ROUTE_ADD, &prefix16, 16, &gw16);
+
+	zassert_ok(net_ipv4_route_add(iface, &dst24, 24, &gw24,
+				      NET_IPV4_ROUTE_INFINITE_LIFETIME), "Cannot add route");
+	check_route_event(NET_EVENT_IPV4_ROUTE_ADD, &prefix24, 24, &gw24);
+
+	/* The route is copied out with the host bits of its prefix cleared */
+	zassert_true(net_ipv4_route_lookup(iface, &dst24, &route), "No route found");
+	zassert_equal_ptr(route.iface, iface, "Wrong route interface");
+	zassert_true(net_ipv4_addr_cmp(&route.addr, &prefix24), "Wrong route prefix");
+	zassert_equal(route.prefix_len, 24, "Wrong route prefix length");
+	zassert_true(net_ipv4_addr_cmp(&route.gw, &gw24), "Wrong route gateway");
+	zassert_equal(route.lifetime, NET_IPV4_ROUTE_INFINITE_LIFETIME, "Wrong lifetime");
+	zassert_false(net_ipv4_route_lookup(iface, &dst_far, &route), "Route found");
+
+	/* The longest matching prefix wins, the others go to the interface
+	 * gateway.
+	 */
+	check_arp_gw(iface, &src, &dst24, &gw24);
+	check_arp_gw(iface, &src, &dst16, &gw16);
+	check_arp_gw(iface, &src, &dst_far, &gw);
+
+	/* Adding a route to the same prefix only updates its gateway */
+	zassert_ok(net_ipv4_route_add(iface, &prefix24, 24, &gw16,
+				      NET_IPV4_ROUTE_INFINITE_LIFETIME), "Cannot update route");
+	check_route_event(NET_EVENT_IPV4_ROUTE_ADD, &prefix24, 24, &gw16);
+	count = 0;
+	zassert_equal(net_ipv4_route_foreach(count_route_cb, &count), 2, "Wrong route count");
+	zassert_equal(count, 2, "Wrong route count");
+	check_arp_gw(iface, &src, &dst24, &gw16);
+
+	zassert_ok(net_ipv4_route_del(iface, &prefix24, 24));
+	check_route_event(NET_EVENT_IPV4_ROUTE_DEL, &prefix24, 24, &gw16);
+	zassert_equal(net_ipv4_route_del(iface, &prefix24, 24), -ENOENT);
+	check_arp_gw(iface, &src, &dst24, &gw16);
+
+	zassert_ok(net_ipv4_route_del(iface, &prefix16, 16));
+	check_route_event(NET_EVENT_IPV4_ROUTE_DEL, &prefix16, 16, &gw16);
+	check_arp_gw(iface, &src, &dst24, &gw);
+
+	/* A route goes away when its lifetime expires */
+	zassert_ok(net_ipv4_route_add(iface, &prefix16, 16, &gw16, 1), "Cannot add route");
+	check_route_event(NET_EVENT_IPV4_ROUTE_ADD, &prefix16, 16, &gw16);
+	zassert_true(net_ipv4_route_lookup(iface, &dst16, &route), "No route found");
+	zassert_true(route.lifetime <= 1U, "Wrong lifetime %u", route.lifetime);
+
+	k_sleep(K_MSEC(1500));
+
+	check_route_event(NET_EVENT_IPV4_ROUTE_DEL, &prefix16, 16, &gw16);
+	zassert_false(net_ipv4_route_lookup(iface, &dst16, &route), "Expired route found");
+	check_arp_gw(iface, &src, &dst16, &gw);
+
+	/* and when its interface goes down */
+	zassert_ok(net_ipv4_route_add(iface, &prefix16, 16, &gw16,
+				      NET_IPV4_ROUTE_INFINITE_LIFETIME), "Cannot add route");
+	check_route_event(NET_EVENT_IPV4_ROUTE_ADD, &prefix16, 16, &gw16);
+
+	zassert_ok(net_if_down(iface), "Cannot take the interface down");
+	check_route_event(NET_EVENT_IPV4_ROUTE_DEL, &prefix16, 16, &gw16);
+	zassert_false(net_ipv4_route_lookup(iface, &dst16, &route), "Route of a down interface");
+	zassert_ok(net_if_up(iface), "Cannot bring the interface up");
+
+#if defined(CONFIG_NET_MGMT_EVENT_INFO)
+	net_mgmt_del_event_callback(&route_event_cb);
+#endif
+}
+
 ZTEST_SUITE(arp_fn_tests, NULL, NULL, NULL, NULL, NULL);
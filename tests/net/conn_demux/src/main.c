@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_CONN_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/udp.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+#include "connection.h"
+
+#define LOCAL_PORT 4242
+#define PEER_PORT 1234
+#define DEMUX_ITERATIONS 2000
+
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr4 = { { { 192, 0, 2, 9 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x9 } } };
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static int num_handles;
+static void *matched;
+
+static enum net_verdict demux_cb(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 union net_proto_header *proto_hdr,
+				 void *user_data)
+{
+	matched = user_data;
+
+	/* The packet is kept for the next lookup */
+	return NET_OK;
+}
+
+static void *conn_add(uint8_t family, const void *remote, uint16_t remote_port,
+		      const void *local, uint16_t local_port)
+{
+	struct sockaddr remote_addr = { .sa_family = family };
+	struct sockaddr local_addr = { .sa_family = family };
+	void *user_data = INT_TO_POINTER(num_handles + 1);
+	int ret;
+
+	if (family == AF_INET6) {
+		if (remote != NULL) {
+			net_ipaddr_copy(&net_sin6(&remote_addr)->sin6_addr,
+					(const struct in6_addr *)remote);
+		}
+
+		if (local != NULL) {
+			net_ipaddr_copy(&net_sin6(&local_addr)->sin6_addr,
+					(const struct in6_addr *)local);
+		}
+	} else if (family == AF_INET) {
+		if (remote != NULL) {
+			net_ipaddr_copy(&net_sin(&remote_addr)->sin_addr,
+					(const struct in_addr *)remote);
+		}
+
+		if (local != NULL) {
+			net_ipaddr_copy(&net_sin(&local_addr)->sin_addr,
+					(const struct in_addr *)local);
+		}
+	}
+
+	ret = net_conn_register(IPPROTO_UDP, family,
+				remote != NULL ? &remote_addr : NULL,
+				local != NULL ? &local_addr : NULL,
+				remote_port, local_port, NULL, demux_cb, user_data,
+				&handles[num_handles]);
+	zassert_equal(ret, 0, "Cannot register connection (%d)", ret);
+
+	num_handles++;
+
+	return user_data;
+}
+
+static struct net_pkt *udp_pkt(uint8_t family, uint16_t src_port, uint16_t dst_port,
+			       union net_ip_header *ip_hdr,
+			       union net_proto_header *proto_hdr)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(), 0, family, IPPROTO_UDP,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "Out of mem");
+
+	if (family == AF_INET6) {
+		ret = net_ipv6_create(pkt, &peer_addr6, &my_addr6);
+	} else {
+		ret = net_ipv4_create(pkt, &peer_addr4, &my_addr4);
+	}
+
+	zassert_equal(ret, 0, "Cannot create IP header");
+
+	ret = net_udp_create(pkt, htons(src_port), htons(dst_port));
+	zassert_equal(ret, 0, "Cannot create UDP header");
+
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET6) {
+		net_ipv6_finalize(pkt, IPPROTO_UDP);
+		ip_hdr->ipv6 = NET_IPV6_HDR(pkt);
+		proto_hdr->udp = (struct net_udp_hdr *)(ip_hdr->ipv6 + 1);
+	} else {
+		net_ipv4_finalize(pkt, IPPROTO_UDP);
+		ip_hdr->ipv4 = NET_IPV4_HDR(pkt);
+		proto_hdr->udp = (struct net_udp_hdr *)(ip_hdr->ipv4 + 1);
+	}
+
+	return pkt;
+}
+
+/* Which connection gets a packet from the peer, NULL if none */
+static void *demux(uint8_t family, uint16_t src_port, uint16_t dst_port)
+{
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+
+	pkt = udp_pkt(family, src_port, dst_port, &ip_hdr, &proto_hdr);
+
+	matched = NULL;
+	verdict = net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	zassert_equal(verdict, matched != NULL ? NET_OK : NET_DROP, "Wrong verdict");
+
+	net_pkt_unref(pkt);
+
+	return matched;
+}
+
+static void conn_remove_all(void)
+{
+	while (num_handles > 0) {
+		(void)net_conn_unregister(handles[--num_handles]);
+	}
+}
+
+ZTEST(net_conn_demux, test_priority)
+{
+	struct sockaddr remote_addr = { .sa_family = AF_INET };
+	void *listener, *connected, *bound, *wildcard;
+	void *listener4, *listener_any, *connected6;
+	int ret;
+
+	listener = conn_add(AF_INET, NULL, 0, NULL, LOCAL_PORT);
+	connected = conn_add(AF_INET, &peer_addr4, PEER_PORT, NULL, LOCAL_PORT);
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT), connected,
+			  "Connected handler not preferred");
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT + 1, LOCAL_PORT), listener,
+			  "Listener not found");
+	zassert_is_null(demux(AF_INET, PEER_PORT, LOCAL_PORT + 1), "Wrong port matched");
+
+	/* A specified local address ranks above the remote end point */
+	bound = conn_add(AF_INET, NULL, 0, &my_addr4, LOCAL_PORT);
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT), bound,
+			  "Bound handler not preferred");
+
+	ret = net_conn_unregister(handles[--num_handles]);
+	zassert_equal(ret, 0, "Cannot unregister");
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT), connected,
+			  "Connected handler not found");
+
+	/* Identical handlers are refused */
+	net_sin(&remote_addr)->sin_addr = peer_addr4;
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, &remote_addr, NULL, PEER_PORT,
+				LOCAL_PORT, NULL, demux_cb, NULL, NULL);
+	zassert_equal(ret, -EADDRINUSE, "Identical handler registered");
+
+	/* The handler without ports gets the rest */
+	wildcard = conn_add(AF_UNSPEC, NULL, 0, NULL, 0);
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT + 1), wildcard,
+			  "Wildcard handler not found");
+	zassert_equal_ptr(demux(AF_INET6, PEER_PORT, LOCAL_PORT + 1), wildcard,
+			  "Wildcard handler not found");
+
+	/* Of equally ranked handlers, the newest wins */
+	listener4 = conn_add(AF_INET, NULL, 0, NULL, LOCAL_PORT + 2);
+	listener_any = conn_add(AF_UNSPEC, NULL, 0, NULL, LOCAL_PORT + 2);
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT + 2), listener_any,
+			  "Newest handler not preferred");
+	zassert_equal_ptr(demux(AF_INET6, PEER_PORT, LOCAL_PORT + 2), listener_any,
+			  "Handler of any family not found");
+
+	ret = net_conn_unregister(handles[--num_handles]);
+	zassert_equal(ret, 0, "Cannot unregister");
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT + 2), listener4,
+			  "Remaining handler not found");
+	zassert_equal_ptr(demux(AF_INET6, PEER_PORT, LOCAL_PORT + 2), wildcard,
+			  "IPv4 handler got an IPv6 packet");
+
+	/* IPv6 connected handler */
+	connected6 = conn_add(AF_INET6, &peer_addr6, PEER_PORT, &my_addr6, LOCAL_PORT);
+
+	zassert_equal_ptr(demux(AF_INET6, PEER_PORT, LOCAL_PORT), connected6,
+			  "IPv6 connected handler not found");
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT, LOCAL_PORT), connected,
+			  "IPv4 connected handler not found");
+
+	/* Connecting the listener moves it to its remote end point */
+	net_sin(&remote_addr)->sin_addr = peer_addr4;
+	ret = net_conn_update(handles[0], demux_cb, listener, &remote_addr, PEER_PORT + 3);
+	zassert_equal(ret, 0, "Cannot update handler");
+
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT + 3, LOCAL_PORT), listener,
+			  "Updated handler not found");
+	zassert_equal_ptr(demux(AF_INET, PEER_PORT + 1, LOCAL_PORT), wildcard,
+			  "Updated handler still listening");
+
+	conn_remove_all();
+}
+
+/* Cost of finding the oldest of a number of connected handlers, which is
+ * the last one a walk of all the handlers gets to.
+ */
+ZTEST(net_conn_demux, test_throughput)
+{
+	static const int counts[] = { 1, 16, 64, 128, CONFIG_NET_MAX_CONN };
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	struct net_pkt *pkt;
+	uint64_t cycles;
+	void *oldest;
+
+	pkt = udp_pkt(AF_INET, PEER_PORT, LOCAL_PORT, &ip_hdr, &proto_hdr);
+
+	oldest = conn_add(AF_INET, &peer_addr4, PEER_PORT, NULL, LOCAL_PORT);
+
+	ARRAY_FOR_EACH(counts, i) {
+		while (num_handles < counts[i]) {
+			conn_add(AF_INET, &peer_addr4, PEER_PORT + num_handles, NULL,
+				 LOCAL_PORT);
+		}
+
+		cycles = k_cycle_get_64();
+
+		for (int j = 0; j < DEMUX_ITERATIONS; j++) {
+			(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+		}
+
+		cycles = k_cycle_get_64() - cycles;
+
+		zassert_equal_ptr(matched, oldest, "Wrong handler found");
+
+		TC_PRINT("%3d connections: %llu cycles per packet\n", counts[i],
+			 cycles / DEMUX_ITERATIONS);
+	}
+
+	net_pkt_unref(pkt);
+	conn_remove_all();
+}
+
+ZTEST_SUITE(net_conn_demux, NULL, NULL, NULL, NULL, NULL);
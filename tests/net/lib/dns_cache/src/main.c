@@ -174,3 +174,73 @@ ZTEST(net_dns_cache_test, test_only_expected_type_returned)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type_b, &info_read, 1));
 	zassert_equal(AF_INET6, info_read.ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(-ENODATA,
+		      dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_equal(0, info_read.ai_family);
+	zassert_equal(1,
+		      dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA, &info_read, 1));
+	zassert_equal(AF_INET6, info_read.ai_family);
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_address_replaces_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_equal(AF_INET, info_read.ai_family);
+}
+
+ZTEST(net_dns_cache_test, test_many_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[16];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE * 2; i++) {
+		snprintk(query, sizeof(query), "host%zu.com", i);
+		net_sin(&info_write.ai_addr)->sin_port = i;
+		/* The older entries expire first */
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL + i),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE * 2; i++) {
+		snprintk(query, sizeof(query), "host%zu.com", i);
+		if (i < TEST_DNS_CACHE_SIZE) {
+			zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+							&info_read, 1));
+		} else {
+			zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+							&info_read, 1));
+			zassert_equal(i, net_sin(&info_read.ai_addr)->sin_port);
+		}
+	}
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "host20.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "host20.com", DNS_QUERY_TYPE_A,
+					&info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host21.com", DNS_QUERY_TYPE_A,
+					&info_read, 1));
+}
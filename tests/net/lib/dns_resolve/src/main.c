@@ -444,13 +444,15 @@ ZTEST(dns_resolve, test_dns_query_too_many)
 
 	timeout_query = true;
 
-	ret = dns_get_addr_info(NAME4,
-				DNS_QUERY_TYPE_A,
-				NULL,
-				dns_result_cb_timeout,
-				INT_TO_POINTER(expected_status),
-				DNS_TIMEOUT);
-	zassert_equal(ret, 0, "Cannot create IPv4 query");
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		ret = dns_get_addr_info(NAME4,
+					DNS_QUERY_TYPE_A,
+					NULL,
+					dns_result_cb_timeout,
+					INT_TO_POINTER(expected_status),
+					DNS_TIMEOUT);
+		zassert_equal(ret, 0, "Cannot create IPv4 query");
+	}
 
 	ret = dns_get_addr_info(NAME4,
 				DNS_QUERY_TYPE_A,
@@ -460,8 +462,10 @@ ZTEST(dns_resolve, test_dns_query_too_many)
 				DNS_TIMEOUT);
 	zassert_equal(ret, -EAGAIN, "Should have run out of space");
 
-	if (k_sem_take(&wait_data, WAIT_TIME)) {
-		zassert_true(false, "Timeout while waiting data");
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (k_sem_take(&wait_data, WAIT_TIME)) {
+			zassert_true(false, "Timeout while waiting data");
+		}
 	}
 
 	timeout_query = false;
@@ -663,6 +667,68 @@ ZTEST(dns_resolve, test_dns_query_ipv6)
 	}
 }
 
+/* A query for a name which is already being queried waits for the answer of
+ * the first one. Cancelling the first query does not cancel the second one,
+ * which is then sent by itself.
+ */
+ZTEST(dns_resolve, test_dns_query_shared_cancel)
+{
+	struct expected_status status = {
+		.status1 = DNS_EAI_INPROGRESS,
+		.status2 = DNS_EAI_ALLDONE,
+		.caller = __func__,
+	};
+	int expected_status = DNS_EAI_CANCELED;
+	uint16_t dns_id1, dns_id2;
+	int ret;
+
+	if (CONFIG_DNS_NUM_CONCUR_QUERIES < 2) {
+		ztest_test_skip();
+	}
+
+	timeout_query = true;
+
+	ret = dns_get_addr_info(NAME4,
+				DNS_QUERY_TYPE_A,
+				&dns_id1,
+				dns_result_cb_timeout,
+				INT_TO_POINTER(expected_status),
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create IPv4 query");
+
+	ret = dns_get_addr_info(NAME4,
+				DNS_QUERY_TYPE_A,
+				&dns_id2,
+				dns_result_cb,
+				&status,
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot create shared IPv4 query");
+	zassert_not_equal(dns_id1, dns_id2, "Shared query has the same id");
+
+	/* Let the network stack send the first query */
+	k_msleep(THREAD_SLEEP);
+
+	/* Answer the query of the second one only */
+	current_dns_id = dns_id2;
+	timeout_query = false;
+
+	ret = dns_cancel_addr_info(dns_id1);
+	zassert_equal(ret, 0, "Cannot cancel IPv4 query");
+
+	if (k_sem_take(&wait_data, WAIT_TIME)) {
+		zassert_true(false, "Timeout while waiting cancel");
+	}
+
+	/* Resolved and done */
+	for (int i = 0; i < 2; i++) {
+		if (k_sem_take(&wait_data2, WAIT_TIME)) {
+			zassert_true(false, "Timeout while waiting data");
+		}
+	}
+
+	verify_cancelled();
+}
+
 struct expected_addr_status {
 	struct sockaddr addr;
 	int status1;
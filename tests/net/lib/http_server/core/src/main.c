@@ -2495,6 +2495,7 @@ ZTEST(server_function_tests_no_init, test_parse_http_frames)
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/littlefs.h>
+#include <zephyr/sys/crc.h>
 
 FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(storage);
 
@@ -2672,9 +2673,36 @@ static int setup_fs(const char *file_ending)
 	zassert_equal(test_unmount(), TC_PASS, "Failed to unmount fs");
 	zassert_equal(test_mount(), TC_PASS, "Failed to mount fs");
 
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)) {
+		http_server_static_fs_cache_flush();
+	}
+
 	return test_mkdir(TEST_DIR_PATH, filename_buf);
 }
 
+/* Cached files come with an entity tag, the others only in answer to a conditional request */
+static const char *static_fs_etag_header(enum http_compression compression, bool conditional)
+{
+	static char etag_header[64];
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)) {
+		return "";
+	}
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	if (!conditional &&
+	    strlen(TEST_STATIC_FS_PAYLOAD) > CONFIG_HTTP_SERVER_STATIC_FS_CACHE_MAX_FILE_SIZE) {
+		return "";
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
+	snprintf(etag_header, sizeof(etag_header), "ETag: \"%08x-%x-%x\"\r\n",
+		 crc32_ieee(TEST_STATIC_FS_PAYLOAD, strlen(TEST_STATIC_FS_PAYLOAD)),
+		 (unsigned int)strlen(TEST_STATIC_FS_PAYLOAD), compression);
+
+	return etag_header;
+}
+
 ZTEST(server_function_tests, test_http1_static_fs)
 {
 	static const char http1_request[] =
@@ -2683,15 +2711,20 @@ ZTEST(server_function_tests, test_http1_static_fs)
 		"User-Agent: curl/7.68.0\r\n"
 		"Accept: */*\r\n"
 		"\r\n";
-	static const char expected_response[] =
-		"HTTP/1.1 200 OK\r\n"
-		"Content-Length: 30\r\n"
-		"Content-Type: text/html\r\n"
-		"\r\n"
-		TEST_STATIC_FS_PAYLOAD;
+	static char expected_response[128];
 	size_t offset = 0;
+	int expected_response_size;
 	int ret;
 
+	expected_response_size = snprintf(expected_response, sizeof(expected_response),
+					  "HTTP/1.1 200 OK\r\n"
+					  "Content-Length: 30\r\n"
+					  "Content-Type: text/html\r\n"
+					  "%s"
+					  "\r\n"
+					  TEST_STATIC_FS_PAYLOAD,
+					  static_fs_etag_header(HTTP_NONE, false));
+
 	ret = setup_fs("");
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
@@ -2700,10 +2733,70 @@ ZTEST(server_function_tests, test_http1_static_fs)
 
 	memset(buf, 0, sizeof(buf));
 
-	test_read_data(&offset, sizeof(expected_response) - 1);
-	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
+			  "Received data doesn't match expected response");
+}
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+ZTEST(server_function_tests, test_http1_static_fs_conditional)
+{
+#define HTTP1_CONDITIONAL_REQUEST                                                                  \
+	"GET /static_file.html HTTP/1.1\r\n"                                                       \
+	"Host: 127.0.0.1:8080\r\n"                                                                 \
+	"If-None-Match: %s\r\n"                                                                    \
+	"\r\n"
+
+	static char http1_request[sizeof(HTTP1_CONDITIONAL_REQUEST) + 64];
+	static char expected_response[128];
+	const char *etag_header = static_fs_etag_header(HTTP_NONE, true);
+	int etag_len = strcspn(etag_header, "\r") - (sizeof("ETag: ") - 1);
+	char etag[32];
+	size_t offset = 0;
+	int expected_response_size;
+	int ret;
+
+	snprintf(http1_request, sizeof(http1_request), HTTP1_CONDITIONAL_REQUEST,
+		 "\"0-0-0\", W/\"1-1-1\"");
+	expected_response_size = snprintf(expected_response, sizeof(expected_response),
+					  "HTTP/1.1 200 OK\r\n"
+					  "Content-Length: 30\r\n"
+					  "Content-Type: text/html\r\n"
+					  "%s"
+					  "\r\n"
+					  TEST_STATIC_FS_PAYLOAD,
+					  etag_header);
+
+	ret = setup_fs("");
+	zassert_equal(ret, TC_PASS, "Failed to mount fs");
+
+	/* Another version of the file is sent in full */
+	ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
+			  "Received data doesn't match expected response");
+
+	/* The same version of the file is not sent again */
+	snprintf(etag, sizeof(etag), "%.*s", etag_len, etag_header + sizeof("ETag: ") - 1);
+	snprintf(http1_request, sizeof(http1_request), HTTP1_CONDITIONAL_REQUEST, etag);
+	expected_response_size = snprintf(expected_response, sizeof(expected_response),
+					  "HTTP/1.1 304 Not Modified\r\n%s\r\n", etag_header);
+
+	ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+	offset = 0;
+
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
 			  "Received data doesn't match expected response");
 }
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 ZTEST(server_function_tests, test_http1_static_fs_compression)
 {
@@ -2719,13 +2812,14 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	"Content-Length: 30\r\n"                                                                   \
 	"Content-Type: text/html\r\n"                                                              \
 	"Content-Encoding: %s\r\n"                                                                 \
+	"%s"                                                                                       \
 	"\r\n" TEST_STATIC_FS_PAYLOAD
 
 	static const char mixed_compression_str[] = "gzip, deflate, br";
 	static char http1_request[sizeof(HTTP1_COMPRESSION_REQUEST) +
 				  ARRAY_SIZE(mixed_compression_str)] = {0};
 	static char expected_response[sizeof(HTTP1_COMPRESSION_RESPONSE) +
-				      HTTP_COMPRESSION_MAX_STRING_LEN] = {0};
+				      HTTP_COMPRESSION_MAX_STRING_LEN + 64] = {0};
 	static const char *const file_ending_map[] = {[HTTP_GZIP] = ".gz",
 						      [HTTP_COMPRESS] = ".lzw",
 						      [HTTP_DEFLATE] = ".zz",
@@ -2747,7 +2841,8 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 
 		sprintf(http1_request, HTTP1_COMPRESSION_REQUEST, http_compression_text(i));
 		expected_response_size = sprintf(expected_response, HTTP1_COMPRESSION_RESPONSE,
-						 http_compression_text(i));
+						 http_compression_text(i),
+						 static_fs_etag_header(i, false));
 
 		ret = setup_fs(file_ending_map[i]);
 		zassert_equal(ret, TC_PASS, "Failed to mount fs");
@@ -2766,7 +2861,8 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	TC_PRINT("Testing mixed compression...\n");
 	sprintf(http1_request, HTTP1_COMPRESSION_REQUEST, mixed_compression_str);
 	expected_response_size = sprintf(expected_response, HTTP1_COMPRESSION_RESPONSE,
-					 http_compression_text(HTTP_BR));
+					 http_compression_text(HTTP_BR),
+					 static_fs_etag_header(HTTP_BR, false));
 	ret = setup_fs(file_ending_map[HTTP_BR]);
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
@@ -2779,6 +2875,64 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	zassert_mem_equal(buf, expected_response, expected_response_size,
 			  "Received data doesn't match expected response");
 }
+
+ZTEST(server_function_tests, test_http1_static_fs_keep_alive)
+{
+	static const char http1_request_1[] =
+		"GET /static_file.html HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"User-Agent: curl/7.68.0\r\n"
+		"Accept: */*\r\n"
+		"\r\n";
+	static const char http1_request_2[] =
+		"GET /static_file.html HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"User-Agent: curl/7.68.0\r\n"
+		"Accept: */*\r\n"
+		"Connection: close\r\n"
+		"\r\n";
+	static char expected_response[128];
+	size_t offset = 0;
+	int expected_response_size;
+	int ret;
+
+	expected_response_size = snprintf(expected_response, sizeof(expected_response),
+					  "HTTP/1.1 200 OK\r\n"
+					  "Content-Length: 30\r\n"
+					  "Content-Type: text/html\r\n"
+					  "%s"
+					  "\r\n"
+					  TEST_STATIC_FS_PAYLOAD,
+					  static_fs_etag_header(HTTP_NONE, false));
+
+	ret = setup_fs("");
+	zassert_equal(ret, TC_PASS, "Failed to mount fs");
+
+	ret = zsock_send(client_fd, http1_request_1, strlen(http1_request_1), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
+			  "Received data doesn't match expected response");
+	test_consume_data(&offset, expected_response_size);
+
+	/* Nothing may follow the file body, the next response starts right
+	 * after it on the same connection.
+	 */
+	ret = zsock_send(client_fd, http1_request_2, strlen(http1_request_2), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
+			  "Received data doesn't match expected response");
+	test_consume_data(&offset, expected_response_size);
+	zassert_equal(offset, 0, "Unexpected data after the response");
+
+	ret = zsock_recv(client_fd, buf, sizeof(buf), 0);
+	zassert_equal(ret, 0, "Connection should've been closed");
+}
 #endif /* DT_HAS_COMPAT_STATUS_OKAY(zephyr_ram_disk) */
 
 static void http_server_tests_before(void *fixture)
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_ZPERF_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+
+#define ZPERF_PORT 5001
+#define UPLOAD_DURATION_MS 10000
+#define PACKET_SIZE 1024
+
+/* A link with a round trip time of 100 ms, dropping 0.5 % of the packets */
+#define LINK_DELAY_MS 50
+#define LINK_DROP_RATIO 0.005f
+
+/* The same link dropping bursts of 4 packets, 0.8 % of the packets overall */
+#define BURST_DROP_RATIO 0.002f
+#define BURST_LEN 4
+
+/* A 10 Mbit/s bottleneck towards the server with a round trip time of
+ * 40 ms, and a queue of twice the bandwidth delay product in front of it
+ */
+#define BOTTLENECK_DELAY_MS 20
+#define BOTTLENECK_KBPS 10000
+#define BOTTLENECK_QUEUE_SIZE 100000
+
+static K_SEM_DEFINE(session_done, 0, 1);
+static struct zperf_results download_results;
+static uint8_t upload_buf[PACKET_SIZE];
+
+static void download_cb(enum zperf_status status, struct zperf_results *result,
+			void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		download_results = *result;
+		k_sem_give(&session_done);
+	}
+}
+
+/* The zperf uploader paces itself on the POSIX architecture, so the data
+ * is sent from here as fast as the connection takes it, with the given
+ * congestion control algorithm unless NULL.
+ */
+static void upload(const char *algorithm)
+{
+	struct sockaddr_in peer = {
+		.sin_family = AF_INET,
+		.sin_port = htons(ZPERF_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	k_timepoint_t end;
+	int sock;
+	int ret;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	if (algorithm != NULL) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, algorithm,
+				       strlen(algorithm));
+		zassert_ok(ret, "Cannot set congestion control %s (%d)", algorithm, errno);
+	}
+
+	ret = zsock_connect(sock, (struct sockaddr *)&peer, sizeof(peer));
+	zassert_ok(ret, "Cannot connect (%d)", errno);
+
+	end = sys_timepoint_calc(K_MSEC(UPLOAD_DURATION_MS));
+
+	while (!sys_timepoint_expired(end)) {
+		ret = zsock_send(sock, upload_buf, sizeof(upload_buf), 0);
+		zassert_true(ret > 0, "Send failed (%d)", errno);
+	}
+
+	zassert_ok(zsock_close(sock), "Cannot close socket");
+}
+
+/* Throughput of a TCP upload to the zperf server over the loopback
+ * interface, as seen by the server, with and without SACK and window
+ * scaling depending on the configuration. The link drops burst packets in a
+ * row at the given rate.
+ */
+static void lossy_link_upload(float drop_ratio, int burst)
+{
+	struct zperf_download_params download_params = {
+		.port = ZPERF_PORT,
+		.addr.sa_family = AF_INET,
+	};
+	struct net_stats_tcp tcp_stats = { 0 };
+	net_stats_t rexmit;
+	int dropped;
+	int ret;
+
+	ret = zperf_tcp_download(&download_params, download_cb, NULL);
+	zassert_ok(ret, "Cannot start the TCP server (%d)", ret);
+
+	zassert_ok(net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &tcp_stats, sizeof(tcp_stats)),
+		   "Cannot get the TCP statistics");
+	rexmit = tcp_stats.rexmit;
+	dropped = loopback_get_num_dropped_packets();
+
+	zassert_ok(loopback_set_packet_delay(LINK_DELAY_MS), "Cannot set the delay");
+	zassert_ok(loopback_set_packet_drop_burst(burst), "Cannot set the drop burst");
+	zassert_ok(loopback_set_packet_drop_ratio(drop_ratio), "Cannot set the drop ratio");
+
+	upload(NULL);
+
+	zassert_ok(k_sem_take(&session_done, K_SECONDS(30)), "Session did not finish");
+
+	zassert_ok(loopback_set_packet_drop_ratio(0.0f), "Cannot clear the drop ratio");
+	zassert_ok(loopback_set_packet_drop_burst(1), "Cannot clear the drop burst");
+	zassert_ok(loopback_set_packet_delay(0), "Cannot clear the delay");
+	(void)zperf_tcp_download_stop();
+
+	zassert_ok(net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &tcp_stats, sizeof(tcp_stats)),
+		   "Cannot get the TCP statistics");
+
+	zassert_true(download_results.total_len > 0, "Nothing received");
+	zassert_true(download_results.time_in_us > 0, "No time elapsed");
+
+	TC_PRINT("SACK %s, window scale %s: %llu bytes in %llu ms, %llu kbps, "
+		 "%d packets dropped, %u segments retransmitted\n",
+		 IS_ENABLED(CONFIG_NET_TCP_SACK) ? "on" : "off",
+		 IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ? "on" : "off",
+		 download_results.total_len, download_results.time_in_us / USEC_PER_MSEC,
+		 download_results.total_len * 8U * USEC_PER_MSEC / download_results.time_in_us,
+		 loopback_get_num_dropped_packets() - dropped, tcp_stats.rexmit - rexmit);
+}
+
+ZTEST(net_zperf, test_tcp_lossy_link)
+{
+	Z_TEST_SKIP_IFDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	lossy_link_upload(LINK_DROP_RATIO, 1);
+}
+
+/* Several segments of a window lost at once, which takes one round trip
+ * per segment to recover from without SACK
+ */
+ZTEST(net_zperf, test_tcp_burst_loss)
+{
+	Z_TEST_SKIP_IFDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	lossy_link_upload(BURST_DROP_RATIO, BURST_LEN);
+}
+
+/* Goodput and queueing delay of an upload over a bottleneck, with each of
+ * the congestion control algorithms
+ */
+ZTEST(net_zperf, test_tcp_congestion)
+{
+	static const char *const algorithms[] = {
+		"reno",
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+		"cubic",
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_BBR
+		"bbr",
+#endif
+	};
+	struct zperf_download_params download_params = {
+		.port = ZPERF_PORT,
+		.addr.sa_family = AF_INET,
+	};
+	uint32_t avg_us, max_us;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	ret = zperf_tcp_download(&download_params, download_cb, NULL);
+	zassert_ok(ret, "Cannot start the TCP server (%d)", ret);
+
+	zassert_ok(loopback_set_packet_delay(BOTTLENECK_DELAY_MS), "Cannot set the delay");
+
+	/* One session of the server after the other */
+	ARRAY_FOR_EACH(algorithms, i) {
+		ret = loopback_set_bandwidth(BOTTLENECK_KBPS, BOTTLENECK_QUEUE_SIZE, ZPERF_PORT);
+		zassert_ok(ret, "Cannot set the bandwidth");
+
+		upload(algorithms[i]);
+
+		zassert_ok(k_sem_take(&session_done, K_SECONDS(30)), "Session did not finish");
+
+		(void)loopback_get_queue_delay(&avg_us, &max_us);
+
+		zassert_true(download_results.total_len > 0, "Nothing received");
+		zassert_true(download_results.time_in_us > 0, "No time elapsed");
+
+		TC_PRINT("%-5s: %llu bytes in %llu ms, %llu kbps, queueing delay "
+			 "%u ms average, %u ms max\n",
+			 algorithms[i], download_results.total_len,
+			 download_results.time_in_us / USEC_PER_MSEC,
+			 download_results.total_len * 8U * USEC_PER_MSEC /
+			 download_results.time_in_us,
+			 avg_us / USEC_PER_MSEC, max_us / USEC_PER_MSEC);
+	}
+
+	zassert_ok(loopback_set_bandwidth(0, 0, 0), "Cannot clear the bandwidth");
+	zassert_ok(loopback_set_packet_delay(0), "Cannot clear the delay");
+	(void)zperf_tcp_download_stop();
+}
+
+ZTEST_SUITE(net_zperf, NULL, NULL, NULL, NULL, NULL);
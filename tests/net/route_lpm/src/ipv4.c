@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_test, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ipv4_route.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+
+#define MAX_ROUTES CONFIG_NET_IPV4_MAX_ROUTES
+#define LOOKUP_CHECKS 4000
+#define LOOKUP_ITERATIONS 2000
+
+/* Routes are told apart by their prefix and prefix length */
+#define NO_ROUTE UINT64_MAX
+
+static struct net_if *iface;
+static struct in_addr prefixes[MAX_ROUTES];
+static uint8_t prefix_lens[MAX_ROUTES];
+static int num_routes;
+static uint32_t seed;
+
+static uint32_t next_rand(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed;
+}
+
+static inline uint32_t mask_of(uint8_t prefix_len)
+{
+	return prefix_len == 0U ? 0U : UINT32_MAX << (32U - prefix_len);
+}
+
+static inline uint64_t route_key(const struct in_addr *prefix, uint8_t prefix_len)
+{
+	return ((uint64_t)ntohl(prefix->s_addr) << 8) | prefix_len;
+}
+
+static uint64_t route_add(uint32_t prefix, uint8_t prefix_len)
+{
+	struct in_addr gw = { .s_addr = htonl(0xc0000201 + num_routes % 4) };
+	int ret;
+
+	prefixes[num_routes].s_addr = htonl(prefix & mask_of(prefix_len));
+	prefix_lens[num_routes] = prefix_len;
+
+	ret = net_ipv4_route_add(iface, &prefixes[num_routes], prefix_len, &gw,
+				 NET_IPV4_ROUTE_INFINITE_LIFETIME);
+	zassert_equal(ret, 0, "Cannot add route to %s/%u (%d)",
+		      net_sprint_ipv4_addr(&prefixes[num_routes]), prefix_len, ret);
+
+	num_routes++;
+
+	return route_key(&prefixes[num_routes - 1], prefix_len);
+}
+
+static void route_del_index(int i)
+{
+	zassert_equal(net_ipv4_route_del(iface, &prefixes[i], prefix_lens[i]), 0,
+		      "Cannot delete route");
+
+	num_routes--;
+	prefixes[i] = prefixes[num_routes];
+	prefix_lens[i] = prefix_lens[num_routes];
+}
+
+static void route_del(uint64_t key)
+{
+	for (int i = 0; i < num_routes; i++) {
+		if (route_key(&prefixes[i], prefix_lens[i]) == key) {
+			route_del_index(i);
+			return;
+		}
+	}
+
+	zassert_unreachable("Unknown route 0x%llx", key);
+}
+
+static void route_del_all(void)
+{
+	while (num_routes > 0) {
+		route_del_index(0);
+	}
+}
+
+static uint64_t lookup(uint32_t addr)
+{
+	struct in_addr dst = { .s_addr = htonl(addr) };
+	struct net_ipv4_route_info route;
+
+	if (!net_ipv4_route_lookup(iface, &dst, &route)) {
+		return NO_ROUTE;
+	}
+
+	return route_key(&route.addr, route.prefix_len);
+}
+
+/* The route a walk of all the routes finds */
+static uint64_t lookup_linear(uint32_t addr)
+{
+	uint64_t found = NO_ROUTE;
+	int longest_match = -1;
+
+	for (int i = 0; i < num_routes; i++) {
+		if (prefix_lens[i] > longest_match &&
+		    (addr & mask_of(prefix_lens[i])) == ntohl(prefixes[i].s_addr)) {
+			found = route_key(&prefixes[i], prefix_lens[i]);
+			longest_match = prefix_lens[i];
+		}
+	}
+
+	return found;
+}
+
+static void check_random_lookups(void)
+{
+	uint32_t addr;
+
+	for (int i = 0; i < LOOKUP_CHECKS; i++) {
+		/* Mostly addresses under one of the routes */
+		if (num_routes > 0 && (i % 8) != 0) {
+			int n = next_rand() % num_routes;
+			uint32_t mask = mask_of(prefix_lens[n]);
+
+			addr = (ntohl(prefixes[n].s_addr) & mask) | (next_rand() & ~mask);
+		} else {
+			addr = 0x0a000000 | (next_rand() & 0x00ffffff);
+		}
+
+		zassert_equal(lookup(addr), lookup_linear(addr),
+			      "Wrong route to 0x%08x", addr);
+	}
+}
+
+static void *route_lpm_ipv4_setup(void)
+{
+	iface = net_if_get_default();
+
+	return NULL;
+}
+
+static void route_lpm_ipv4_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	route_del_all();
+}
+
+ZTEST(net_route_lpm_ipv4, test_longest_match)
+{
+	uint64_t host, subnet, subnet2, site, half, all, def;
+
+	/* Unlike IPv6 routes, a route does not replace the ones with a
+	 * longer prefix, so the order does not matter.
+	 */
+	all = route_add(0x0a000000, 8);
+	host = route_add(0x0a010205, 32);
+	site = route_add(0x0a010000, 16);
+	subnet = route_add(0x0a010200, 24);
+	subnet2 = route_add(0x0a010300, 24);
+	half = route_add(0x0a800000, 9);
+
+	zassert_equal(lookup(0x0a010205), host, "Host route not found");
+	zassert_equal(lookup(0x0a010206), subnet, "Subnet route not found");
+	zassert_equal(lookup(0x0a010301), subnet2, "Subnet route not found");
+	zassert_equal(lookup(0x0a010401), site, "Site route not found");
+	zassert_equal(lookup(0x0a020001), all, "Covering route not found");
+	zassert_equal(lookup(0x0a810001), half, "Half route not found");
+	zassert_equal(lookup(0x0b000001), NO_ROUTE, "Route to unknown prefix found");
+
+	def = route_add(0, 0);
+
+	zassert_equal(lookup(0x0b000001), def, "Default route not found");
+	zassert_equal(lookup(0x0a010205), host, "Host route lost");
+
+	/* The other routes remain after a route in the middle is removed */
+	route_del(site);
+
+	zassert_equal(lookup(0x0a010401), all, "Covering route not found");
+	zassert_equal(lookup(0x0a010206), subnet, "Subnet route lost");
+	zassert_equal(lookup(0x0a010301), subnet2, "Subnet route lost");
+
+	route_del(all);
+
+	zassert_equal(lookup(0x0a010401), def, "Default route not found");
+	zassert_equal(lookup(0x0a810001), half, "Half route lost");
+
+	route_del(subnet);
+
+	zassert_equal(lookup(0x0a010206), def, "Default route not found");
+	zassert_equal(lookup(0x0a010205), host, "Host route lost");
+
+	route_del_all();
+
+	zassert_equal(lookup(0x0a010205), NO_ROUTE, "Deleted route found");
+}
+
+/* Compare the lookups with a walk of the routes while random prefixes come
+ * and go.
+ */
+ZTEST(net_route_lpm_ipv4, test_random_prefixes)
+{
+	seed = 0x0a000001;
+
+	for (int round = 0; round < 3; round++) {
+		while (num_routes < MAX_ROUTES) {
+			/* Short prefixes overlap often */
+			uint8_t len = 8 + (next_rand() % 25) * (next_rand() % 25) / 24;
+			uint32_t prefix = 0x0a000000 | (next_rand() & 0x00ffffff);
+			bool found = false;
+
+			for (int i = 0; i < num_routes; i++) {
+				if (prefix_lens[i] == len &&
+				    (prefix & mask_of(len)) == ntohl(prefixes[i].s_addr)) {
+					found = true;
+					break;
+				}
+			}
+
+			if (!found) {
+				route_add(prefix, len);
+			}
+		}
+
+		check_random_lookups();
+
+		/* Remove every other route */
+		for (int i = num_routes - 1; i >= 0; i -= 2) {
+			route_del_index(i);
+		}
+
+		check_random_lookups();
+
+		route_del_all();
+
+		check_random_lookups();
+	}
+}
+
+/* Lookups of an address under the first of a number of /24 routes */
+ZTEST(net_route_lpm_ipv4, test_throughput)
+{
+	static const int counts[] = { 1, 16, 64, 256, MAX_ROUTES };
+	uint64_t cycles;
+	uint64_t first;
+
+	ARRAY_FOR_EACH(counts, i) {
+		while (num_routes < counts[i]) {
+			route_add(0x0a000000 | (num_routes << 8), 24);
+		}
+
+		first = route_key(&prefixes[0], prefix_lens[0]);
+
+		cycles = k_cycle_get_64();
+
+		for (int j = 0; j < LOOKUP_ITERATIONS; j++) {
+			zassert_equal(lookup(0x0a000001), first, "Wrong route found");
+		}
+
+		cycles = k_cycle_get_64() - cycles;
+
+		TC_PRINT("%3d routes: %llu cycles per lookup, %llu lookups/s\n", counts[i],
+			 cycles / LOOKUP_ITERATIONS,
+			 cycles > 0 ? (uint64_t)LOOKUP_ITERATIONS *
+				      sys_clock_hw_cycles_per_sec() / cycles : 0);
+	}
+}
+
+ZTEST_SUITE(net_route_lpm_ipv4, NULL, route_lpm_ipv4_setup, NULL, route_lpm_ipv4_after, NULL);
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+#define MAX_ROUTES CONFIG_NET_MAX_ROUTES
+#define LOOKUP_CHECKS 4000
+#define LOOKUP_ITERATIONS 2000
+
+/* A neighbor can be the next hop of at most 254 routes */
+#define NEXTHOPS 4
+
+static struct in6_addr nexthops[NEXTHOPS];
+static struct net_linkaddr nexthop_lladdr = {
+	.addr = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+	.len = 6,
+};
+
+static struct net_if *iface;
+static struct net_route_entry *routes[MAX_ROUTES];
+static struct in6_addr prefixes[MAX_ROUTES];
+static uint8_t prefix_lens[MAX_ROUTES];
+static int num_routes;
+static uint32_t seed;
+
+/* Same sequence on every run, so that failures can be reproduced */
+static uint32_t next_rand(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed;
+}
+
+static void addr_set(struct in6_addr *addr, const char *str)
+{
+	zassert_equal(net_addr_pton(AF_INET6, str, addr), 0, "Invalid address %s", str);
+}
+
+/* Clear the address bits after the prefix */
+static void addr_mask(struct in6_addr *addr, uint8_t prefix_len)
+{
+	for (int i = 0; i < sizeof(addr->s6_addr); i++) {
+		if (prefix_len >= 8U) {
+			prefix_len -= 8U;
+			continue;
+		}
+
+		addr->s6_addr[i] &= (uint8_t)(0xff00 >> prefix_len);
+		prefix_len = 0U;
+	}
+}
+
+static struct net_route_entry *route_add(const char *str, uint8_t prefix_len)
+{
+	struct net_route_entry *route;
+
+	addr_set(&prefixes[num_routes], str);
+	prefix_lens[num_routes] = prefix_len;
+
+	route = net_route_add(iface, &prefixes[num_routes], prefix_len,
+			      &nexthops[num_routes % NEXTHOPS],
+			      NET_IPV6_ND_INFINITE_LIFETIME, NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route, "Cannot add route to %s/%u", str, prefix_len);
+
+	routes[num_routes++] = route;
+
+	return route;
+}
+
+static void route_del(struct net_route_entry *route)
+{
+	for (int i = 0; i < num_routes; i++) {
+		if (routes[i] != route) {
+			continue;
+		}
+
+		zassert_equal(net_route_del(route), 0, "Cannot delete route");
+
+		num_routes--;
+		routes[i] = routes[num_routes];
+		prefixes[i] = prefixes[num_routes];
+		prefix_lens[i] = prefix_lens[num_routes];
+
+		return;
+	}
+
+	zassert_unreachable("Unknown route %p", route);
+}
+
+static void route_del_all(void)
+{
+	while (num_routes > 0) {
+		route_del(routes[0]);
+	}
+}
+
+static struct net_route_entry *lookup(const char *str)
+{
+	struct in6_addr dst;
+
+	addr_set(&dst, str);
+
+	return net_route_lookup(iface, &dst);
+}
+
+/* The route a walk of all the routes finds */
+static struct net_route_entry *lookup_linear(struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+	int longest_match = -1;
+
+	for (int i = 0; i < num_routes; i++) {
+		if (prefix_lens[i] > longest_match &&
+		    net_ipv6_is_prefix(dst->s6_addr, prefixes[i].s6_addr, prefix_lens[i])) {
+			found = routes[i];
+			longest_match = prefix_lens[i];
+		}
+	}
+
+	return found;
+}
+
+static void check_random_lookups(void)
+{
+	struct in6_addr dst;
+
+	for (int i = 0; i < LOOKUP_CHECKS; i++) {
+		/* Mostly addresses under one of the routes */
+		if (num_routes > 0 && (i % 8) != 0) {
+			int n = next_rand() % num_routes;
+			uint8_t len = prefix_lens[n];
+
+			for (int j = 0; j < sizeof(dst.s6_addr); j++) {
+				dst.s6_addr[j] = next_rand();
+			}
+
+			for (int j = 0; j < len / 8; j++) {
+				dst.s6_addr[j] = prefixes[n].s6_addr[j];
+			}
+
+			if (len % 8 != 0) {
+				uint8_t mask = 0xff00 >> (len % 8);
+
+				dst.s6_addr[len / 8] = (prefixes[n].s6_addr[len / 8] & mask) |
+						       (dst.s6_addr[len / 8] & ~mask);
+			}
+		} else {
+			addr_set(&dst, "2001:db8::");
+
+			for (int j = 4; j < sizeof(dst.s6_addr); j++) {
+				dst.s6_addr[j] = next_rand();
+			}
+		}
+
+		zassert_equal_ptr(net_route_lookup(iface, &dst), lookup_linear(&dst),
+				  "Wrong route to %s", net_sprint_ipv6_addr(&dst));
+	}
+}
+
+static void *route_lpm_setup(void)
+{
+	struct net_nbr *nbr;
+
+	iface = net_if_get_default();
+
+	for (int i = 0; i < NEXTHOPS; i++) {
+		addr_set(&nexthops[i], "fe80::1");
+		nexthops[i].s6_addr[15] += i;
+		nexthop_lladdr.addr[5] = 0x01 + i;
+
+		nbr = net_ipv6_nbr_add(iface, &nexthops[i], &nexthop_lladdr, false,
+				       NET_IPV6_NBR_STATE_REACHABLE);
+		zassert_not_null(nbr, "Cannot add next hop to neighbor cache");
+	}
+
+	return NULL;
+}
+
+static void route_lpm_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	route_del_all();
+}
+
+ZTEST(net_route_lpm, test_longest_match)
+{
+	struct net_route_entry *host, *subnet, *subnet2, *site, *half, *all;
+
+	/* A route with the prefix of another one replaces it, so the longest
+	 * prefixes are added first.
+	 */
+	host = route_add("2001:db8:1:2::5", 128);
+	subnet = route_add("2001:db8:1:2::", 64);
+	subnet2 = route_add("2001:db8:1:3::", 64);
+	site = route_add("2001:db8:1::", 48);
+	half = route_add("2001:db8:8000::", 33);
+	all = route_add("2001:db8::", 32);
+
+	zassert_equal_ptr(lookup("2001:db8:1:2::5"), host, "Host route not found");
+	zassert_equal_ptr(lookup("2001:db8:1:2::6"), subnet, "Subnet route not found");
+	zassert_equal_ptr(lookup("2001:db8:1:3::1"), subnet2, "Subnet route not found");
+	zassert_equal_ptr(lookup("2001:db8:1:4::1"), site, "Site route not found");
+	zassert_equal_ptr(lookup("2001:db8:2::1"), all, "Covering route not found");
+	zassert_equal_ptr(lookup("2001:db8:8001::1"), half, "Half route not found");
+	zassert_is_null(lookup("2001:db9::1"), "Route to unknown prefix found");
+
+	/* The other routes remain after a route in the middle is removed */
+	route_del(site);
+
+	zassert_equal_ptr(lookup("2001:db8:1:4::1"), all, "Covering route not found");
+	zassert_equal_ptr(lookup("2001:db8:1:2::6"), subnet, "Subnet route lost");
+	zassert_equal_ptr(lookup("2001:db8:1:3::1"), subnet2, "Subnet route lost");
+
+	route_del(all);
+
+	zassert_is_null(lookup("2001:db8:1:4::1"), "Deleted route found");
+	zassert_equal_ptr(lookup("2001:db8:8001::1"), half, "Half route lost");
+
+	route_del(subnet);
+
+	zassert_is_null(lookup("2001:db8:1:2::6"), "Deleted route found");
+	zassert_equal_ptr(lookup("2001:db8:1:2::5"), host, "Host route lost");
+
+	route_del_all();
+
+	zassert_is_null(lookup("2001:db8:1:2::5"), "Deleted route found");
+}
+
+/* Compare the lookups with a walk of the routes while random prefixes come
+ * and go.
+ */
+ZTEST(net_route_lpm, test_random_prefixes)
+{
+	static struct in6_addr candidates[MAX_ROUTES];
+	static uint8_t candidate_lens[MAX_ROUTES];
+
+	seed = 0x2001db8;
+
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < MAX_ROUTES; i++) {
+			addr_set(&candidates[i], "2001:db8::");
+
+			for (int j = 4; j < sizeof(candidates[i].s6_addr); j++) {
+				candidates[i].s6_addr[j] = next_rand();
+			}
+
+			/* Short prefixes overlap often */
+			candidate_lens[i] = 32 + (next_rand() % 97) * (next_rand() % 97) / 96;
+			addr_mask(&candidates[i], candidate_lens[i]);
+		}
+
+		/* Longest prefixes first, a route with the prefix of another
+		 * one would replace it.
+		 */
+		for (int len = 128; len >= 32; len--) {
+			for (int i = 0; i < MAX_ROUTES && num_routes < MAX_ROUTES; i++) {
+				char str[NET_IPV6_ADDR_LEN];
+
+				if (candidate_lens[i] != len ||
+				    net_route_lookup(iface, &candidates[i]) != NULL) {
+					continue;
+				}
+
+				net_addr_ntop(AF_INET6, &candidates[i], str, sizeof(str));
+				route_add(str, len);
+			}
+		}
+
+		check_random_lookups();
+
+		/* Remove every other route */
+		for (int i = num_routes - 1; i >= 0; i -= 2) {
+			route_del(routes[i]);
+		}
+
+		check_random_lookups();
+
+		route_del_all();
+
+		check_random_lookups();
+	}
+}
+
+/* Lookups of an address under the oldest of a number of /48 routes */
+ZTEST(net_route_lpm, test_throughput)
+{
+	static const int counts[] = { 1, 16, 64, 256, MAX_ROUTES };
+	struct in6_addr dst;
+	uint64_t cycles;
+	void *oldest;
+
+	addr_set(&dst, "2001:db8:0:1::1");
+
+	ARRAY_FOR_EACH(counts, i) {
+		while (num_routes < counts[i]) {
+			char str[NET_IPV6_ADDR_LEN];
+
+			snprintk(str, sizeof(str), "2001:db8:%x::", num_routes);
+			route_add(str, 48);
+		}
+
+		oldest = routes[0];
+
+		cycles = k_cycle_get_64();
+
+		for (int j = 0; j < LOOKUP_ITERATIONS; j++) {
+			zassert_equal_ptr(net_route_lookup(iface, &dst), oldest,
+					  "Wrong route found");
+		}
+
+		cycles = k_cycle_get_64() - cycles;
+
+		TC_PRINT("%3d routes: %llu cycles per lookup, %llu lookups/s\n", counts[i],
+			 cycles / LOOKUP_ITERATIONS,
+			 cycles > 0 ? (uint64_t)LOOKUP_ITERATIONS *
+				      sys_clock_hw_cycles_per_sec() / cycles : 0);
+	}
+}
+
+ZTEST_SUITE(net_route_lpm, NULL, route_lpm_setup, NULL, route_lpm_after, NULL);
@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
 #include "ipv6.h"
 
 #include <zephyr/ztest.h>
+#include <zephyr/shell/shell_dummy.h>
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 #define DBG(fmt, ...) printk(fmt, ##__VA_ARGS__)
@@ -201,4 +202,46 @@ ZTEST(net_shell_test_suite, test_net_shell)
 	zassert_equal(ret, 1, "");
 }
 
+ZTEST(net_shell_test_suite, test_net_shell_ipv4_route)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	struct in_addr dst = { { { 10, 1, 2, 3 } } };
+	struct in_addr gw = { { { 192, 0, 2, 1 } } };
+	struct net_ipv4_route_info route = { 0 };
+	struct net_if *iface;
+	const char *output;
+	size_t output_len;
+	char cmd[64];
+	int idx;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_IPV4_ROUTE);
+
+	/* Output to the shell is dropped until it is ready */
+	WAIT_FOR(shell_ready(sh), 20000, k_msleep(1));
+	zassert_true(shell_ready(sh), "timed out waiting for dummy shell backend");
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	idx = net_if_get_by_iface(iface);
+
+	snprintk(cmd, sizeof(cmd), "net route add %d 10.1.0.0/16 192.0.2.1", idx);
+	zassert_equal(shell_execute_cmd(sh, cmd), 0, "Cannot add route");
+
+	zassert_true(net_ipv4_route_lookup(iface, &dst, &route), "No route found");
+	zassert_equal(route.prefix_len, 16, "Wrong prefix length");
+	zassert_true(net_ipv4_addr_cmp(&route.gw, &gw), "Wrong gateway");
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_equal(shell_execute_cmd(sh, "net route"), 0, "Cannot list routes");
+	output = shell_backend_dummy_get_output(sh, &output_len);
+	zassert_not_null(strstr(output, "10.1.0.0/16"), "Route not listed: %s", output);
+
+	/* Prefix lengths longer than 32 bits are refused */
+	snprintk(cmd, sizeof(cmd), "net route add %d 10.1.0.0/33 192.0.2.1", idx);
+	zassert_not_equal(shell_execute_cmd(sh, cmd), 0, "Invalid route added");
+
+	snprintk(cmd, sizeof(cmd), "net route del %d 10.1.0.0/16", idx);
+	zassert_equal(shell_execute_cmd(sh, cmd), 0, "Cannot delete route");
+	zassert_false(net_ipv4_route_lookup(iface, &dst, &route), "Deleted route found");
+}
+
 ZTEST_SUITE(net_shell_test_suite, NULL, test_setup, NULL, NULL, NULL);
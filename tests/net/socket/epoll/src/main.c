@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_service.h>
+#include <zephyr/zvfs/epoll.h>
+#include <zephyr/zvfs/eventfd.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define WAIT_TIME 100
+
+static int epfd = -1;
+static int efd = -1;
+
+static struct k_work_delayable write_work;
+
+static void write_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+}
+
+static void add_efd(uint32_t events)
+{
+	struct zvfs_epoll_event ev = {
+		.events = events,
+		.data.u32 = 42,
+	};
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd, &ev));
+}
+
+static int wait_events(struct zvfs_epoll_event *ev, int timeout)
+{
+	memset(ev, 0, sizeof(*ev));
+
+	return zvfs_epoll_wait(epfd, ev, 1, timeout);
+}
+
+static void drain_efd(void)
+{
+	zvfs_eventfd_t value;
+
+	zassert_ok(zvfs_eventfd_read(efd, &value));
+}
+
+ZTEST(net_socket_epoll, test_level_triggered)
+{
+	struct zvfs_epoll_event ev;
+	uint32_t tstamp;
+
+	add_efd(ZVFS_EPOLLIN);
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	tstamp = k_uptime_get_32();
+	zassert_equal(wait_events(&ev, WAIT_TIME), 0, "");
+	zassert_true(k_uptime_get_32() - tstamp >= WAIT_TIME, "");
+
+	/* Wake up a waiting thread */
+	k_work_schedule(&write_work, K_MSEC(WAIT_TIME / 2));
+
+	zassert_equal(wait_events(&ev, -1), 1, "");
+	zassert_equal(ev.events, ZVFS_EPOLLIN, "");
+	zassert_equal(ev.data.u32, 42, "");
+
+	/* Reported as long as it is ready */
+	zassert_equal(wait_events(&ev, 0), 1, "");
+	zassert_equal(ev.events, ZVFS_EPOLLIN, "");
+
+	drain_efd();
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+}
+
+ZTEST(net_socket_epoll, test_edge_triggered)
+{
+	struct zvfs_epoll_event ev;
+	zvfs_eventfd_t value;
+
+	add_efd(ZVFS_EPOLLIN | ZVFS_EPOLLET);
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+	zassert_equal(ev.events, ZVFS_EPOLLIN, "");
+
+	/* Not reported again until drained */
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	drain_efd();
+	zassert_equal(zvfs_eventfd_read(efd, &value), -1, "");
+	zassert_equal(errno, EAGAIN, "");
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	k_work_schedule(&write_work, K_MSEC(WAIT_TIME / 2));
+	zassert_equal(wait_events(&ev, -1), 1, "");
+	zassert_equal(ev.events, ZVFS_EPOLLIN, "");
+}
+
+ZTEST(net_socket_epoll, test_oneshot)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT,
+		.data.u32 = 43,
+	};
+
+	add_efd(ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT);
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	/* Enabled again by a modification */
+	ev.events = ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT;
+	ev.data.u32 = 43;
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, efd, &ev));
+
+	zassert_equal(wait_events(&ev, 0), 1, "");
+	zassert_equal(ev.data.u32, 43, "");
+}
+
+ZTEST(net_socket_epoll, test_ctl)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+	};
+	int fd;
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd, NULL), -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, efd, &ev), -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, epfd, &ev), -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	zassert_equal(zvfs_epoll_ctl(efd, ZVFS_EPOLL_CTL_ADD, epfd, &ev), -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	add_efd(ZVFS_EPOLLIN);
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd, &ev), -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd, NULL));
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	/* A closed descriptor is removed */
+	add_efd(ZVFS_EPOLLIN);
+	zassert_ok(zsock_close(efd));
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	fd = zvfs_eventfd(1, ZVFS_EFD_NONBLOCK);
+	zassert_equal(fd, efd, "");
+	add_efd(ZVFS_EPOLLIN);
+	zassert_equal(wait_events(&ev, 0), 1, "");
+}
+
+ZTEST(net_socket_epoll, test_socket)
+{
+	struct zvfs_epoll_event ev;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	char buf[10];
+	int c_sock;
+	int s_sock;
+	ssize_t len;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	zassert_ok(zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)));
+	zassert_ok(zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)));
+
+	ev.events = ZVFS_EPOLLIN | ZVFS_EPOLLET;
+	ev.data.fd = s_sock;
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, s_sock, &ev));
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+	zassert_equal(ev.events, ZVFS_EPOLLIN, "");
+	zassert_equal(ev.data.fd, s_sock, "");
+
+	len = zsock_recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	len = zsock_recv(s_sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, -1, "");
+	zassert_equal(errno, EAGAIN, "");
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+	zassert_equal(ev.data.fd, s_sock, "");
+
+	zassert_ok(zsock_close(c_sock));
+	zassert_ok(zsock_close(s_sock));
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+}
+
+/* A batch that drains the socket arms an edge triggered registration
+ * again, like a single receive does.
+ */
+ZTEST(net_socket_epoll, test_socket_recvmmsg)
+{
+	struct zvfs_epoll_event ev;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct mmsghdr msgs[4];
+	struct iovec iovs[4];
+	char bufs[4][10];
+	int c_sock;
+	int s_sock;
+	ssize_t len;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	zassert_ok(zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)));
+	zassert_ok(zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)));
+
+	ev.events = ZVFS_EPOLLIN | ZVFS_EPOLLET;
+	ev.data.fd = s_sock;
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, s_sock, &ev));
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iovs[i].iov_base = bufs[i];
+		iovs[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+		zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+	}
+
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "");
+	zassert_equal(ev.data.fd, s_sock, "");
+
+	/* Both datagrams, then EAGAIN */
+	zassert_equal(zsock_recvmmsg(s_sock, msgs, ARRAY_SIZE(msgs), ZSOCK_MSG_DONTWAIT,
+				     NULL), 2, "");
+	zassert_equal(msgs[1].msg_len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	zassert_equal(wait_events(&ev, 0), 0, "");
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	zassert_equal(wait_events(&ev, WAIT_TIME), 1, "Not armed again after the batch");
+	zassert_equal(ev.data.fd, s_sock, "");
+
+	zassert_ok(zsock_close(c_sock));
+	zassert_ok(zsock_close(s_sock));
+}
+
+static K_SEM_DEFINE(service_data, 0, 1);
+
+static void service_handler(struct net_socket_service_event *pev)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(pev->event.fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+	zassert_equal(pev->event.revents, ZSOCK_POLLIN, "");
+
+	k_sem_give(&service_data);
+}
+
+NET_SOCKET_SERVICE_SYNC_DEFINE_STATIC(udp_service, service_handler, 1);
+
+ZTEST(net_socket_epoll, test_service)
+{
+	struct zsock_pollfd sock = {
+		.events = ZSOCK_POLLIN,
+	};
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int c_sock;
+	int s_sock;
+	ssize_t len;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	zassert_ok(zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)));
+	zassert_ok(zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr)));
+
+	sock.fd = s_sock;
+	zassert_ok(net_socket_service_register(&udp_service, &sock, 1, NULL));
+
+	for (int i = 0; i < 3; i++) {
+		len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+		zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+		zassert_ok(k_sem_take(&service_data, K_MSEC(WAIT_TIME)));
+	}
+
+	zassert_ok(net_socket_service_unregister(&udp_service));
+
+	zassert_ok(zsock_close(c_sock));
+	zassert_ok(zsock_close(s_sock));
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	epfd = zvfs_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	efd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd failed (%d)", errno);
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)k_work_cancel_delayable(&write_work);
+
+	if (efd >= 0) {
+		(void)zsock_close(efd);
+		efd = -1;
+	}
+
+	if (epfd >= 0) {
+		(void)zsock_close(epfd);
+		epfd = -1;
+	}
+}
+
+static void *setup(void)
+{
+	k_work_init_delayable(&write_work, write_handler);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, setup, before, after, NULL);
@@ -2502,6 +2502,50 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_congestion_control)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	/* The default algorithm is used if none is selected. */
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, CONFIG_NET_TCP_CONGESTION_DEFAULT_NAME,
+			  "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	/* Select another algorithm, the name does not need to be terminated. */
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+			       "cubic", strlen("cubic"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+
+	/* Unknown algorithms are rejected and the selection is kept. */
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+			       "unknown", strlen("unknown"));
+	zassert_equal(ret, -1, "setsockopt should've failed");
+	zassert_equal(errno, ENOENT, "wrong errno value, %d", errno);
+
+	optlen = sizeof(name);
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
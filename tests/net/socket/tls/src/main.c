@@ -1165,6 +1165,198 @@ ZTEST(net_socket_tls, test_recv_eof_on_close)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+static void test_session_stats_get(int sock, struct tls_session_cache_stats *stats)
+{
+	socklen_t optlen = sizeof(*stats);
+	int ret;
+
+	ret = zsock_getsockopt(sock, SOL_TLS, TLS_SESSION_CACHE_STATS, stats, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+}
+
+static void test_session_cache_enable(int sock)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	int ret;
+
+	ret = zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+}
+
+/* The tests connect to the same server address, start without its sessions */
+static void test_session_cache_purge(int sock)
+{
+	int ret;
+
+	ret = zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE_PURGE, NULL, 0);
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+}
+
+/* Connect twice to a TLS server, the second connection resumes the session
+ * of the first one.
+ */
+static void test_tls_session_resume(struct tls_session_cache_stats *before,
+				    struct tls_session_cache_stats *after)
+{
+	struct connect_data test_data;
+	struct sockaddr c_saddr;
+	struct sockaddr s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock,
+			    (struct sockaddr_in *)&s_saddr, IPPROTO_TLS_1_2);
+	test_config_psk(s_sock, -1);
+	test_session_cache_enable(s_sock);
+	test_session_cache_purge(s_sock);
+
+	test_bind(s_sock, &s_saddr, sizeof(struct sockaddr_in));
+	test_listen(s_sock);
+
+	test_session_stats_get(s_sock, before);
+
+	for (int i = 0; i < 2; i++) {
+		prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock,
+				    (struct sockaddr_in *)&c_saddr, IPPROTO_TLS_1_2);
+		test_config_psk(-1, c_sock);
+		test_session_cache_enable(c_sock);
+
+		test_data.sock = c_sock;
+		test_data.addr = &s_saddr;
+		k_work_init_delayable(&test_data.work, client_connect_work_handler);
+		test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+		addrlen = sizeof(addr);
+		test_accept(s_sock, &new_sock, &addr, &addrlen);
+		test_work_wait(&test_data.work);
+
+		test_close(c_sock);
+		c_sock = -1;
+		test_close(new_sock);
+		new_sock = -1;
+
+		k_sleep(TCP_TEARDOWN_TIMEOUT);
+	}
+
+	test_session_stats_get(s_sock, after);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+/* The client offers its stored session, and the server resumes it from its
+ * session ticket when it issues them, or else from its session cache.
+ */
+static void test_session_resumed(const struct tls_session_cache_stats *before,
+				 const struct tls_session_cache_stats *after)
+{
+	zassert_equal(after->client_misses - before->client_misses, 1,
+		      "The first connection should not find a session");
+	zassert_equal(after->client_hits - before->client_hits, 1,
+		      "The second connection should offer the stored session");
+
+	if (IS_ENABLED(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)) {
+		zassert_equal(after->tickets_accepted - before->tickets_accepted, 1,
+			      "The server should resume the session from its ticket");
+		zassert_equal(after->server_hits - before->server_hits, 0,
+			      "The server should not look up its session cache");
+	} else {
+		zassert_equal(after->server_hits - before->server_hits, 1,
+			      "The server should resume the stored session");
+	}
+}
+
+ZTEST(net_socket_tls, test_session_resumption)
+{
+	struct tls_session_cache_stats before;
+	struct tls_session_cache_stats after;
+
+	test_tls_session_resume(&before, &after);
+	test_session_resumed(&before, &after);
+}
+
+ZTEST(net_socket_tls, test_session_ticket_resumption)
+{
+	struct tls_session_cache_stats before;
+	struct tls_session_cache_stats after;
+
+	if (!IS_ENABLED(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)) {
+		ztest_test_skip();
+	}
+
+	test_tls_session_resume(&before, &after);
+
+	zassert_true(after.tickets_issued - before.tickets_issued >= 1,
+		     "The server should issue a ticket on the first connection");
+	zassert_equal(after.tickets_accepted - before.tickets_accepted, 1,
+		      "The server should accept the ticket of the second connection");
+	zassert_equal(after.tickets_rejected - before.tickets_rejected, 0,
+		      "The server should not reject the ticket");
+}
+
+ZTEST(net_socket_tls, test_dtls_session_resumption)
+{
+	int role = TLS_DTLS_ROLE_SERVER;
+	struct tls_session_cache_stats before;
+	struct tls_session_cache_stats after;
+	struct connect_data test_data;
+	struct zsock_pollfd fds[1];
+	struct sockaddr c_saddr;
+	struct sockaddr s_saddr;
+	uint8_t rx_buf;
+	int ret;
+
+	prepare_sock_dtls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock,
+			     (struct sockaddr_in *)&s_saddr, IPPROTO_DTLS_1_2);
+	test_config_psk(s_sock, -1);
+	test_session_cache_enable(s_sock);
+	test_session_cache_purge(s_sock);
+
+	zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_DTLS_ROLE,
+				       &role, sizeof(role)),
+		      0, "setsockopt() failed");
+
+	test_bind(s_sock, &s_saddr, sizeof(struct sockaddr_in));
+
+	test_session_stats_get(s_sock, &before);
+
+	/* The server socket takes the next client once the previous one has
+	 * closed its connection, the second client resumes the session of the
+	 * first one.
+	 */
+	for (int i = 0; i < 2; i++) {
+		prepare_sock_dtls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock,
+				     (struct sockaddr_in *)&c_saddr, IPPROTO_DTLS_1_2);
+		test_config_psk(-1, c_sock);
+		test_session_cache_enable(c_sock);
+
+		test_data.sock = c_sock;
+		test_data.addr = &s_saddr;
+		k_work_init_delayable(&test_data.work, dtls_client_connect_send_work_handler);
+		test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+		fds[0].fd = s_sock;
+		fds[0].events = ZSOCK_POLLIN;
+		ret = zsock_poll(fds, 1, 1000);
+		zassert_equal(ret, 1, "poll() did not report data ready");
+
+		/* Also handles the close notification of the previous client */
+		ret = zsock_recv(s_sock, &rx_buf, sizeof(rx_buf), 0);
+		zassert_equal(ret, sizeof(rx_buf), "recv() failed");
+
+		test_work_wait(&test_data.work);
+
+		test_close(c_sock);
+		c_sock = -1;
+	}
+
+	test_session_stats_get(s_sock, &after);
+	test_session_resumed(&before, &after);
+
+	test_sockets_close();
+}
+
 #define TLS_RECORD_OVERHEAD 81
 
 ZTEST(net_socket_tls, test_send_non_block)
@@ -3106,6 +3106,136 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+#define MMSG_COUNT 4
+
+static ZTEST_BMEM char mmsg_rx_bufs[MMSG_COUNT][32];
+
+ZTEST_USER(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[MMSG_COUNT] = {
+		"one", "two", "three", "four",
+	};
+	struct mmsghdr msgvec[MMSG_COUNT];
+	struct iovec io_vector[MMSG_COUNT];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in peer_addr[MMSG_COUNT];
+	struct timespec timeout = { .tv_sec = 0, .tv_nsec = 100 * NSEC_PER_MSEC };
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr, sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* Nothing queued yet */
+	memset(msgvec, 0, sizeof(msgvec));
+	io_vector[0].iov_base = mmsg_rx_bufs[0];
+	io_vector[0].iov_len = sizeof(mmsg_rx_bufs[0]);
+	msgvec[0].msg_hdr.msg_iov = &io_vector[0];
+	msgvec[0].msg_hdr.msg_iovlen = 1;
+
+	rv = zsock_recvmmsg(server_sock, msgvec, 1, ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg succeeded on an empty socket");
+	zassert_equal(errno, EAGAIN, "Wrong errno (%d)", errno);
+
+	/* Send the whole batch in one call */
+	memset(msgvec, 0, sizeof(msgvec));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = (void *)payloads[i];
+		io_vector[i].iov_len = strlen(payloads[i]);
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg sent %d messages", rv);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(payloads[i]), "Wrong msg_len");
+	}
+
+	/* Receive all but the last one in one call, then the last one in a
+	 * second call, so that a batch stops at vlen while messages are still
+	 * queued.
+	 */
+	memset(msgvec, 0, sizeof(msgvec));
+	memset(mmsg_rx_bufs, 0, sizeof(mmsg_rx_bufs));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = mmsg_rx_bufs[i];
+		io_vector[i].iov_len = sizeof(mmsg_rx_bufs[i]);
+		msgvec[i].msg_hdr.msg_name = &peer_addr[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(peer_addr[i]);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT - 1, 0, &timeout);
+	zassert_equal(rv, MMSG_COUNT - 1, "recvmmsg received %d messages", rv);
+
+	rv = zsock_recvmmsg(server_sock, &msgvec[MMSG_COUNT - 1], 1,
+			    ZSOCK_MSG_WAITFORONE, NULL);
+	zassert_equal(rv, 1, "recvmmsg received %d messages", rv);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(payloads[i]), "Wrong msg_len");
+		zassert_mem_equal(mmsg_rx_bufs[i], payloads[i], strlen(payloads[i]),
+				  "Wrong data");
+		zassert_equal(msgvec[i].msg_hdr.msg_namelen, sizeof(struct sockaddr_in),
+			      "Wrong address length");
+		zassert_equal(peer_addr[i].sin_port, client_addr.sin_port, "Wrong peer port");
+	}
+
+	/* With WAITFORONE, a partial batch is returned once the queue is empty */
+	rv = zsock_sendmmsg(client_sock, msgvec, 0, 0);
+	zassert_equal(rv, 0, "Empty batch not accepted");
+
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT, ZSOCK_MSG_WAITFORONE, NULL);
+	zassert_equal(rv, 1, "recvmmsg received %d messages", rv);
+	zassert_equal(msgvec[0].msg_len, STRLEN(TEST_STR_SMALL), "Wrong msg_len");
+
+	/* Without it, the batch ends when the next receive times out */
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	rv = zsock_setsockopt(server_sock, SOL_SOCKET, SO_RCVTIMEO,
+			      &(struct timeval){ .tv_usec = 200 * USEC_PER_MSEC },
+			      sizeof(struct timeval));
+	zassert_equal(rv, 0, "setsockopt failed");
+
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT, 0, &timeout);
+	zassert_equal(rv, 1, "recvmmsg received %d messages", rv);
+
+	timeout.tv_nsec = NSEC_PER_SEC;
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT, 0, &timeout);
+	zassert_equal(rv, -1, "Invalid timeout accepted");
+	zassert_equal(errno, EINVAL, "Wrong errno (%d)", errno);
+
+	rv = zsock_sendmmsg(-1, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, -1, "sendmmsg succeeded on an invalid socket");
+	zassert_equal(errno, EBADF, "Wrong errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
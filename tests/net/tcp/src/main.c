@@ -114,6 +114,7 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_SERVER_SACK_WINDOW_SCALE = 19,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +139,7 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_server_sack_window_scale(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -248,7 +250,8 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+	     test_case_no == TEST_SERVER_SACK_WINDOW_SCALE) && (flags & SYN)) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -284,7 +287,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		th->th_off = 10U;
 	} else {
 		th->th_off = 5U;
@@ -303,7 +306,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -490,6 +493,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_SACK_WINDOW_SCALE:
+		handle_server_sack_window_scale(pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -2071,9 +2077,9 @@ struct out_of_order_check_struct {
 static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
-	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
-	{ 10, 10, 40, 0}, /* First sequence complete */
+	{ 10,  9, 0, 0}, /* Section with a gap, kept queued */
+	{ 0,  10, 19, 0},
+	{ 19, 11, 40, 0}, /* First sequence complete */
 	{ 50,  6, 40, 0},
 	{ 50,  3, 40, 0}, /* Discardable packet */
 	{ 55,  5, 40, 0},
@@ -2201,6 +2207,216 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+static struct tcphdr sack_th;
+static uint8_t sack_opts[40];
+
+static void handle_server_sack_window_scale(struct net_pkt *pkt)
+{
+	size_t opts_len;
+
+	zassert_ok(read_tcp_header(pkt, &sack_th), "Cannot read TCP header");
+
+	opts_len = (sack_th.th_off - 5) * 4;
+	memset(sack_opts, 0, sizeof(sack_opts));
+
+	net_pkt_set_overwrite(pkt, true);
+	zassert_ok(net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			       sizeof(struct tcphdr)), "Cannot skip TCP header");
+	zassert_ok(net_pkt_read(pkt, sack_opts, opts_len), "Cannot read TCP options");
+
+	test_sem_give();
+}
+
+/* Find an option of the segment last sent by the stack */
+static const uint8_t *sack_opt_find(uint8_t kind)
+{
+	size_t opts_len = (sack_th.th_off - 5) * 4;
+
+	for (size_t i = 0; i < opts_len && sack_opts[i] != NET_TCP_END_OPT; ) {
+		if (sack_opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (sack_opts[i] == kind) {
+			return &sack_opts[i];
+		}
+
+		i += sack_opts[i + 1];
+	}
+
+	return NULL;
+}
+
+static void sack_send(struct net_pkt *pkt)
+{
+	zassert_not_null(pkt, "Cannot create pkt");
+	zassert_ok(net_recv_data(net_iface, pkt), "recv data failed");
+}
+
+/* Send the 10 bytes at offset from seq and check the SACK blocks of the
+ * duplicate ACK, given as offsets from seq.
+ */
+static void sack_recv_check(const uint8_t *data, uint32_t offset,
+			    const uint32_t blocks[][2], int count)
+{
+	const uint8_t *opt;
+
+	seq += offset;
+	sack_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				      data + offset, 10));
+	test_sem_take(K_MSEC(1000), __LINE__);
+	seq -= offset;
+
+	zassert_equal(ntohl(sack_th.th_ack), seq, "Wrong duplicate ACK");
+
+	opt = sack_opt_find(NET_TCP_SACK_OPT);
+	zassert_not_null(opt, "No SACK block");
+	zassert_equal(opt[1], 2 + count * NET_TCP_SACK_BLOCK_SIZE, "Wrong SACK option length");
+
+	for (int i = 0; i < count; i++) {
+		uint32_t left = ntohl(UNALIGNED_GET((uint32_t *)(opt + 2 + 8 * i)));
+		uint32_t right = ntohl(UNALIGNED_GET((uint32_t *)(opt + 6 + 8 * i)));
+
+		zassert_equal(left, seq + blocks[i][0], "Wrong SACK block %d start", i);
+		zassert_equal(right, seq + blocks[i][1], "Wrong SACK block %d end", i);
+	}
+}
+
+/* Test case scenario IPv6
+ *   Send SYN with the SACK permitted and window scale options
+ *   expect SYN ACK with the same options,
+ *   send ACK,
+ *   send data after a gap,
+ *   expect duplicate ACK with a SACK block of the data,
+ *   send data after more gaps,
+ *   expect duplicate ACKs with a SACK block per run of data, most recent first,
+ *   send the missing data,
+ *   expect ACK of all the data without SACK block.
+ */
+ZTEST(net_tcp, test_server_sack_window_scale)
+{
+	const uint8_t *data = lorem_ipsum;
+	struct net_context *ctx;
+	const uint8_t *opt;
+	struct tcp *conn;
+	uint32_t left, right;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) && !IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	test_case_no = TEST_SERVER_SACK_WINDOW_SCALE;
+	seq = 0;
+	ack = 0;
+
+	zassert_ok(net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	zassert_ok(net_context_bind(ctx, (struct sockaddr *)&my_addr_v6_s,
+				    sizeof(struct sockaddr_in6)),
+		   "Failed to bind net_context");
+	zassert_ok(net_context_listen(ctx, 1), "Failed to listen on net_context");
+	zassert_ok(net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL),
+		   "Failed to set accept on net_context");
+
+	sack_send(prepare_syn_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	test_verify_flags(&sack_th, SYN | ACK);
+
+	opt = sack_opt_find(NET_TCP_WINDOW_SCALE_OPT);
+	zassert_equal(opt != NULL, IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE),
+		      "Wrong window scale option");
+
+	opt = sack_opt_find(NET_TCP_SACK_PERM_OPT);
+	zassert_equal(opt != NULL, IS_ENABLED(CONFIG_NET_TCP_SACK),
+		      "Wrong SACK permitted option");
+
+	seq++;
+	ack = ntohl(sack_th.th_seq) + 1U;
+
+	/* The accept callback gives the semaphore */
+	sack_send(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = accepted_ctx->tcp;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	/* The window of the SYN segment is not scaled, the later ones are */
+	zassert_equal(conn->send_win_shift, 7, "Wrong window shift");
+	zassert_equal(conn->send_win, MIN((uint32_t)ntohs(NET_IPV6_MTU) << 7,
+					  conn->send_win_max),
+		      "Window not scaled");
+#endif
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) || CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		goto out;
+	}
+
+	/* Data after a gap is reported in a SACK block */
+	seq += 10;
+	sack_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				      data + 10, 10));
+	test_sem_take(K_MSEC(1000), __LINE__);
+	seq -= 10;
+
+	zassert_equal(ntohl(sack_th.th_ack), seq, "Wrong duplicate ACK");
+
+	opt = sack_opt_find(NET_TCP_SACK_OPT);
+	zassert_not_null(opt, "No SACK block");
+	zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE, "Wrong SACK option length");
+
+	left = ntohl(UNALIGNED_GET((uint32_t *)(opt + 2)));
+	right = ntohl(UNALIGNED_GET((uint32_t *)(opt + 6)));
+	zassert_equal(left, seq + 10, "Wrong SACK block start");
+	zassert_equal(right, seq + 20, "Wrong SACK block end");
+
+	/* Every run of data is reported, the most recent one first */
+	sack_recv_check(data, 30, (const uint32_t[][2]){ { 30, 40 }, { 10, 20 } }, 2);
+	sack_recv_check(data, 50,
+			(const uint32_t[][2]){ { 50, 60 }, { 30, 40 }, { 10, 20 } }, 3);
+
+	/* Data joining two runs reports the joined run first */
+	sack_recv_check(data, 20, (const uint32_t[][2]){ { 10, 40 }, { 50, 60 } }, 2);
+
+	/* The runs up to the next gap are acknowledged, the rest stays */
+	sack_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				      data, 10));
+	test_sem_take(K_MSEC(1000), __LINE__);
+
+	zassert_equal(ntohl(sack_th.th_ack), seq + 40, "Data not acknowledged");
+
+	opt = sack_opt_find(NET_TCP_SACK_OPT);
+	zassert_not_null(opt, "No SACK block");
+	zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE, "Wrong SACK option length");
+
+	/* Once the last gap is filled, all the data is acknowledged */
+	seq += 40;
+	sack_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				      data + 40, 10));
+	test_sem_take(K_MSEC(1000), __LINE__);
+
+	zassert_equal(ntohl(sack_th.th_ack), seq + 20, "Data not acknowledged");
+	zassert_is_null(sack_opt_find(NET_TCP_SACK_OPT), "Stale SACK block");
+
+	seq += 20;
+
+out:
+	/* Abort the connection */
+	sack_send(prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th)
 {
 	switch (t_state) {
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/posix/aio.h>
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_FILE_SYSTEM_LITTLEFS
+#include <zephyr/fs/littlefs.h>
+#else
+#include <ff.h>
+#endif
+
+#define DISK_NAME  "RAM"
+#define TEST_MNTP  "/" DISK_NAME ":"
+#define TEST_FILE  TEST_MNTP "/aio.bin"
+
+#define NUM_FILES  4
+#define FILE_SIZE  4096
+#define CHUNK_SIZE 1024
+
+#ifdef CONFIG_FILE_SYSTEM_LITTLEFS
+/* littlefs on the same RAM disk, through the disk access API */
+static struct fs_littlefs lfs_data;
+
+static struct fs_mount_t test_mnt = {
+	.type = FS_LITTLEFS,
+	.mnt_point = TEST_MNTP,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)DISK_NAME,
+	.flags = FS_MOUNT_FLAG_USE_DISK_ACCESS,
+};
+#else
+static FATFS fat_fs;
+
+static struct fs_mount_t test_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = TEST_MNTP,
+	.fs_data = &fat_fs,
+};
+#endif
+
+static uint8_t pattern[FILE_SIZE];
+static uint8_t readback[FILE_SIZE];
+
+static K_SEM_DEFINE(notified, 0, K_SEM_MAX_LIMIT);
+
+static void notify(union sigval val)
+{
+	ARG_UNUSED(val);
+
+	k_sem_give(&notified);
+}
+
+static int open_file(const char *path)
+{
+	int fd = open(path, O_CREAT | O_RDWR);
+
+	zassert_true(fd >= 0, "open(%s) failed: %d", path, errno);
+
+	return fd;
+}
+
+static void init_aiocb(struct aiocb *cb, int fd, off_t offset, volatile void *buf, size_t len)
+{
+	memset(cb, 0, sizeof(*cb));
+	cb->aio_fildes = fd;
+	cb->aio_offset = offset;
+	cb->aio_buf = buf;
+	cb->aio_nbytes = len;
+	cb->aio_sigevent.sigev_notify = SIGEV_NONE;
+}
+
+static void wait_done(struct aiocb *cb)
+{
+	const struct aiocb *const list[] = {cb};
+
+	while (aio_error(cb) == EINPROGRESS) {
+		zassert_ok(aio_suspend(list, ARRAY_SIZE(list), NULL));
+	}
+}
+
+ZTEST(posix_aio, test_aio_write_read)
+{
+	struct aiocb cb;
+	int fd = open_file(TEST_FILE);
+
+	init_aiocb(&cb, fd, 0, pattern, sizeof(pattern));
+	zassert_ok(aio_write(&cb));
+	wait_done(&cb);
+	zassert_ok(aio_error(&cb));
+	zassert_equal(aio_return(&cb), sizeof(pattern));
+
+	/* Reads at an offset, unlike the position of the file descriptor */
+	memset(readback, 0, sizeof(readback));
+	init_aiocb(&cb, fd, CHUNK_SIZE, readback, CHUNK_SIZE);
+	zassert_ok(aio_read(&cb));
+	wait_done(&cb);
+	zassert_ok(aio_error(&cb));
+	zassert_equal(aio_return(&cb), CHUNK_SIZE);
+	zassert_mem_equal(readback, &pattern[CHUNK_SIZE], CHUNK_SIZE);
+
+	/* Short read at the end of the file */
+	init_aiocb(&cb, fd, FILE_SIZE - 16, readback, CHUNK_SIZE);
+	zassert_ok(aio_read(&cb));
+	wait_done(&cb);
+	zassert_equal(aio_return(&cb), 16);
+
+	init_aiocb(&cb, fd, 0, NULL, 0);
+	/* Zephyr doesn't define O_SYNC, and syncing a file flushes its metadata too */
+	zassert_ok(aio_fsync(0, &cb));
+	wait_done(&cb);
+	zassert_ok(aio_error(&cb));
+	zassert_ok(aio_return(&cb));
+
+	zassert_equal(aio_cancel(fd, NULL), AIO_ALLDONE);
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_aio_file_position)
+{
+	struct aiocb cb;
+	int fd = open_file(TEST_FILE);
+
+	zassert_equal(write(fd, pattern, CHUNK_SIZE), CHUNK_SIZE);
+
+	/* Transfers at their own offset leave the position of the file descriptor alone */
+	init_aiocb(&cb, fd, 0, pattern, sizeof(pattern));
+	zassert_ok(aio_write(&cb));
+	wait_done(&cb);
+	zassert_equal(aio_return(&cb), sizeof(pattern));
+	zassert_equal(lseek(fd, 0, SEEK_CUR), CHUNK_SIZE);
+
+	init_aiocb(&cb, fd, 0, readback, CHUNK_SIZE);
+	zassert_ok(aio_read(&cb));
+	wait_done(&cb);
+	zassert_equal(aio_return(&cb), CHUNK_SIZE);
+	zassert_equal(lseek(fd, 0, SEEK_CUR), CHUNK_SIZE);
+
+	memset(readback, 0, sizeof(readback));
+	zassert_equal(read(fd, readback, CHUNK_SIZE), CHUNK_SIZE);
+	zassert_mem_equal(readback, &pattern[CHUNK_SIZE], CHUNK_SIZE);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_aio_write_append)
+{
+	struct aiocb cb;
+	int fd = open_file(TEST_FILE);
+
+	init_aiocb(&cb, fd, 0, pattern, CHUNK_SIZE);
+	zassert_ok(aio_write(&cb));
+	wait_done(&cb);
+	zassert_equal(aio_return(&cb), CHUNK_SIZE);
+	zassert_ok(ftruncate(fd, CHUNK_SIZE));
+	zassert_ok(close(fd));
+
+	fd = open(TEST_FILE, O_RDWR | O_APPEND);
+	zassert_true(fd >= 0, "open(%s) failed: %d", TEST_FILE, errno);
+
+	/* With O_APPEND the data goes to the end of the file, whatever the offset */
+	init_aiocb(&cb, fd, 0, &pattern[CHUNK_SIZE], CHUNK_SIZE);
+	zassert_ok(aio_write(&cb));
+	wait_done(&cb);
+	zassert_equal(aio_return(&cb), CHUNK_SIZE);
+	zassert_ok(close(fd));
+
+	fd = open_file(TEST_FILE);
+	memset(readback, 0, sizeof(readback));
+	zassert_equal(read(fd, readback, sizeof(readback)), 2 * CHUNK_SIZE);
+	zassert_mem_equal(readback, pattern, 2 * CHUNK_SIZE);
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_aio_errors)
+{
+	const struct aiocb *const list[] = {NULL};
+	struct timespec timeout = {.tv_nsec = 10 * NSEC_PER_MSEC};
+	struct aiocb cb;
+	int fd = open_file(TEST_FILE);
+
+	init_aiocb(&cb, INT_MAX, 0, readback, CHUNK_SIZE);
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EBADF);
+
+	init_aiocb(&cb, fd, -1, readback, CHUNK_SIZE);
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	init_aiocb(&cb, fd, 0, readback, CHUNK_SIZE);
+	cb.aio_sigevent.sigev_notify = -1;
+	zassert_equal(aio_write(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(aio_cancel(INT_MAX, NULL), -1);
+	zassert_equal(errno, EBADF);
+
+	/* Nothing to wait for */
+	zassert_equal(aio_suspend(list, ARRAY_SIZE(list), &timeout), -1);
+	zassert_equal(errno, EAGAIN);
+
+	timeout.tv_nsec = NSEC_PER_SEC;
+	zassert_equal(aio_suspend(list, ARRAY_SIZE(list), &timeout), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_aio_max)
+{
+	struct aiocb cbs[AIO_MAX + 1];
+	int fd = open_file(TEST_FILE);
+	int queued = 0;
+
+	/* The test thread is cooperative, nothing completes until it waits */
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		init_aiocb(&cbs[i], fd, 0, pattern, CHUNK_SIZE);
+
+		if (aio_write(&cbs[i]) == 0) {
+			queued++;
+		} else {
+			zassert_equal(errno, EAGAIN);
+		}
+	}
+
+	zassert_equal(queued, AIO_MAX, "%d requests queued", queued);
+	zassert_equal(aio_error(&cbs[0]), EINPROGRESS);
+	zassert_equal(aio_return(&cbs[0]), -1, "result of a request in progress");
+	zassert_equal(errno, EINVAL);
+	zassert_equal(aio_cancel(fd, &cbs[0]), AIO_NOTCANCELED);
+
+	for (int i = 0; i < queued; i++) {
+		wait_done(&cbs[i]);
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+	}
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_lio_listio_wait)
+{
+	struct aiocb cbs[FILE_SIZE / CHUNK_SIZE];
+	struct aiocb *list[ARRAY_SIZE(cbs) + 1];
+	int fd = open_file(TEST_FILE);
+
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		init_aiocb(&cbs[i], fd, i * CHUNK_SIZE, &pattern[i * CHUNK_SIZE], CHUNK_SIZE);
+		cbs[i].aio_lio_opcode = LIO_WRITE;
+		list[i] = &cbs[i];
+	}
+
+	/* Empty entries are skipped */
+	list[ARRAY_SIZE(cbs)] = NULL;
+
+	zassert_ok(lio_listio(LIO_WAIT, list, ARRAY_SIZE(list), NULL));
+
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		zassert_ok(aio_error(&cbs[i]));
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+		cbs[i].aio_buf = &readback[i * CHUNK_SIZE];
+		cbs[i].aio_lio_opcode = LIO_READ;
+	}
+
+	memset(readback, 0, sizeof(readback));
+	zassert_ok(lio_listio(LIO_WAIT, list, ARRAY_SIZE(list), NULL));
+	zassert_mem_equal(readback, pattern, sizeof(pattern));
+
+	/* A bad entry fails the list, but not the other entries */
+	cbs[0].aio_lio_opcode = LIO_NOP;
+	cbs[1].aio_fildes = INT_MAX;
+	zassert_equal(lio_listio(LIO_WAIT, list, ARRAY_SIZE(list), NULL), -1);
+	zassert_equal(errno, EIO);
+	zassert_equal(aio_error(&cbs[1]), EBADF);
+	zassert_ok(aio_error(&cbs[2]));
+
+	zassert_equal(lio_listio(LIO_WAIT, list, AIO_LISTIO_MAX + 1, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_lio_listio_nowait)
+{
+	struct aiocb cbs[FILE_SIZE / CHUNK_SIZE];
+	struct aiocb *list[ARRAY_SIZE(cbs)];
+	struct sigevent sig = {
+		.sigev_notify = SIGEV_THREAD,
+		.sigev_notify_function = notify,
+	};
+	int fd = open_file(TEST_FILE);
+
+	k_sem_reset(&notified);
+
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		init_aiocb(&cbs[i], fd, i * CHUNK_SIZE, &readback[i * CHUNK_SIZE], CHUNK_SIZE);
+		cbs[i].aio_lio_opcode = LIO_READ;
+		cbs[i].aio_sigevent = sig;
+		list[i] = &cbs[i];
+	}
+
+	memset(readback, 0, sizeof(readback));
+	zassert_ok(lio_listio(LIO_NOWAIT, list, ARRAY_SIZE(list), &sig));
+
+	/* Once per request, and once for the whole list */
+	for (int i = 0; i <= ARRAY_SIZE(cbs); i++) {
+		zassert_ok(k_sem_take(&notified, K_SECONDS(5)), "notification %d missing", i);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		zassert_ok(aio_error(&cbs[i]));
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+	}
+
+	zassert_mem_equal(readback, pattern, sizeof(pattern));
+	zassert_equal(k_sem_count_get(&notified), 0, "too many notifications");
+
+	zassert_ok(close(fd));
+}
+
+/* Writes a few files one after the other, then all at once */
+ZTEST(posix_aio, test_aio_throughput)
+{
+	static struct aiocb cbs[NUM_FILES][FILE_SIZE / CHUNK_SIZE];
+	static struct aiocb *list[NUM_FILES * FILE_SIZE / CHUNK_SIZE];
+	int fds[NUM_FILES];
+	char path[32];
+	uint32_t sequential;
+	uint32_t overlapped;
+	uint32_t start;
+	int n = 0;
+
+	for (int i = 0; i < NUM_FILES; i++) {
+		snprintf(path, sizeof(path), TEST_MNTP "/aio%d.bin", i);
+		fds[i] = open_file(path);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < NUM_FILES; i++) {
+		for (int j = 0; j < FILE_SIZE / CHUNK_SIZE; j++) {
+			zassert_equal(write(fds[i], &pattern[j * CHUNK_SIZE], CHUNK_SIZE),
+				      CHUNK_SIZE);
+		}
+
+		zassert_ok(fsync(fds[i]));
+	}
+
+	sequential = k_cycle_get_32() - start;
+
+	/* Interleaved, so that each list spans all the files */
+	for (int j = 0; j < FILE_SIZE / CHUNK_SIZE; j++) {
+		for (int i = 0; i < NUM_FILES; i++) {
+			init_aiocb(&cbs[i][j], fds[i], j * CHUNK_SIZE, &pattern[j * CHUNK_SIZE],
+				   CHUNK_SIZE);
+			cbs[i][j].aio_lio_opcode = LIO_WRITE;
+			list[n++] = &cbs[i][j];
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ARRAY_SIZE(list); i += AIO_LISTIO_MAX) {
+		zassert_ok(lio_listio(LIO_WAIT, &list[i], MIN(AIO_LISTIO_MAX, n - i), NULL));
+	}
+
+	for (int i = 0; i < NUM_FILES; i++) {
+		init_aiocb(&cbs[i][0], fds[i], 0, NULL, 0);
+		zassert_ok(aio_fsync(0, &cbs[i][0]));
+	}
+
+	for (int i = 0; i < NUM_FILES; i++) {
+		wait_done(&cbs[i][0]);
+		zassert_ok(aio_return(&cbs[i][0]));
+	}
+
+	overlapped = k_cycle_get_32() - start;
+
+	TC_PRINT("%d files of %d bytes: sequential %u cycles, overlapped %u cycles\n",
+		 NUM_FILES, FILE_SIZE, sequential, overlapped);
+
+	for (int i = 0; i < NUM_FILES; i++) {
+		zassert_equal(lseek(fds[i], 0, SEEK_SET), 0);
+		zassert_equal(read(fds[i], readback, sizeof(readback)), sizeof(readback));
+		zassert_mem_equal(readback, pattern, sizeof(pattern));
+		zassert_ok(close(fds[i]));
+	}
+}
+
+static void *setup(void)
+{
+	for (int i = 0; i < sizeof(pattern); i++) {
+		pattern[i] = (uint8_t)(i * 7 + i / 256);
+	}
+
+	zassert_ok(fs_mount(&test_mnt));
+
+	return NULL;
+}
+
+static void teardown(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	zassert_ok(fs_unmount(&test_mnt));
+}
+
+ZTEST_SUITE(posix_aio, NULL, setup, NULL, NULL, teardown);
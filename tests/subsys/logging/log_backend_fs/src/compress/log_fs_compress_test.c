@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test compressed logging to file system
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fff.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/sys/byteorder.h>
+
+#define MAX_PATH_LEN (256 + 7)
+#define BLOCK_SIZE CONFIG_LOG_BACKEND_FS_COMPRESS_BLOCK_SIZE
+#define BLOCK_HDR_SIZE 8
+#define NUM_BLOCKS 4
+
+static const char *log_prefix = CONFIG_LOG_BACKEND_FS_FILE_PREFIX;
+static const struct log_backend *backend;
+
+static uint8_t written[NUM_BLOCKS * BLOCK_SIZE];
+static uint8_t file_data[CONFIG_LOG_BACKEND_FS_FILE_SIZE];
+static uint8_t decoded[NUM_BLOCKS * BLOCK_SIZE];
+
+DEFINE_FFF_GLOBALS;
+FAKE_VOID_FUNC(log_output_dropped_process, const struct log_output *, uint32_t);
+FAKE_VALUE_FUNC(log_format_func_t, log_format_func_t_get, uint32_t);
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx);
+
+static void write_log(uint8_t *data, size_t length)
+{
+	while (length > 0) {
+		int rc = write_log_to_file(data, length, NULL);
+
+		data += rc;
+		length -= rc;
+	}
+}
+
+static size_t lz4_length(const uint8_t **ip, size_t len)
+{
+	uint8_t byte;
+
+	if (len == 15) {
+		do {
+			byte = *(*ip)++;
+			len += byte;
+		} while (byte == 255);
+	}
+
+	return len;
+}
+
+/* Decode a block in the LZ4 block format, returns the decompressed length */
+static size_t lz4_decompress(const uint8_t *ip, size_t len, uint8_t *dst)
+{
+	const uint8_t *end = ip + len;
+	uint8_t *op = dst;
+	size_t n;
+
+	while (ip < end) {
+		uint8_t token = *ip++;
+
+		n = lz4_length(&ip, token >> 4);
+		memcpy(op, ip, n);
+		op += n;
+		ip += n;
+
+		if (ip >= end) {
+			break;
+		}
+
+		uint16_t offset = sys_get_le16(ip);
+
+		ip += 2;
+		n = lz4_length(&ip, token & 0xF) + 4;
+		for (; n > 0; n--, op++) {
+			*op = *(op - offset);
+		}
+	}
+
+	return op - dst;
+}
+
+/* Read the first log file, returns its length */
+static int log_file_read(void)
+{
+	struct fs_file_t file;
+	char fname[MAX_PATH_LEN];
+	int len;
+
+	fs_file_t_init(&file);
+
+	sprintf(fname, "%s/%s0000", CONFIG_LOG_BACKEND_FS_DIR, log_prefix);
+	zassert_equal(fs_open(&file, fname, FS_O_READ), 0, "Can not open log file.");
+	len = fs_read(&file, file_data, sizeof(file_data));
+	zassert_true(len > 0, "Can not read log file.");
+	zassert_equal(fs_close(&file), 0, "Can not close log file.");
+
+	return len;
+}
+
+/* Find the last block in the first len bytes of the log file data */
+static const uint8_t *last_block_get(int len)
+{
+	const uint8_t *blk = file_data;
+	const uint8_t *last = NULL;
+
+	while (blk < &file_data[len]) {
+		last = blk;
+		blk += BLOCK_HDR_SIZE + sys_get_le16(&blk[6]);
+	}
+
+	zassert_not_null(last, "No block found");
+	zassert_mem_equal(last, "ZL", 2, "Bad block header");
+
+	return last;
+}
+
+/* Decode a block, returns the decompressed length */
+static size_t block_decode(const uint8_t *blk, uint8_t *dst)
+{
+	uint16_t raw_len = sys_get_le16(&blk[4]);
+	uint16_t data_len = sys_get_le16(&blk[6]);
+
+	if (blk[2] == 1) {
+		zassert_equal(lz4_decompress(&blk[BLOCK_HDR_SIZE], data_len, dst), raw_len,
+			      "Bad compressed block");
+	} else {
+		zassert_equal(data_len, raw_len, "Bad stored block");
+		memcpy(dst, &blk[BLOCK_HDR_SIZE], raw_len);
+	}
+
+	return raw_len;
+}
+
+ZTEST(test_log_backend_fs_compress, test_log_fs_compressed_blocks)
+{
+	uint32_t rand = 1U;
+	size_t decoded_len = 0;
+	int num_compressed = 0;
+	int num_stored = 0;
+	int len;
+
+	/* Two blocks of text followed by two blocks of noise */
+	for (size_t i = 0; i < sizeof(written) / 2; i++) {
+		written[i] = "Correct Log 12\r\n"[i % 16];
+	}
+	for (size_t i = sizeof(written) / 2; i < sizeof(written); i++) {
+		rand = rand * 1103515245U + 12345U;
+		written[i] = rand >> 16;
+	}
+
+	write_log(written, sizeof(written));
+	/* Blocks are written when full and more data comes */
+	write_log(written, 1);
+	backend->api->notify(backend, LOG_BACKEND_EVT_PROCESS_THREAD_DONE, NULL);
+
+	len = log_file_read();
+	zassert_true(len < (int)sizeof(written), "Log file is not compressed (%d B)", len);
+
+	for (const uint8_t *blk = file_data; blk < &file_data[len];) {
+		uint16_t raw_len = sys_get_le16(&blk[4]);
+		uint16_t data_len = sys_get_le16(&blk[6]);
+
+		zassert_mem_equal(blk, "ZL", 2, "Bad block header");
+		zassert_equal(raw_len, BLOCK_SIZE, "Unexpected block length");
+		zassert_true(decoded_len + raw_len <= sizeof(decoded), "Too many blocks");
+
+		if (blk[2] == 1) {
+			zassert_true(data_len < raw_len, "Block is not compressed");
+			zassert_equal(lz4_decompress(&blk[BLOCK_HDR_SIZE], data_len,
+						     &decoded[decoded_len]),
+				      raw_len, "Bad compressed block");
+			num_compressed++;
+		} else {
+			zassert_equal(blk[2], 0, "Bad block type");
+			zassert_equal(data_len, raw_len, "Bad stored block");
+			memcpy(&decoded[decoded_len], &blk[BLOCK_HDR_SIZE], raw_len);
+			num_stored++;
+		}
+
+		decoded_len += raw_len;
+		blk += BLOCK_HDR_SIZE + data_len;
+	}
+
+	zassert_equal(num_compressed, NUM_BLOCKS / 2, "Text is not compressed");
+	zassert_equal(num_stored, NUM_BLOCKS / 2, "Noise is not stored");
+	zassert_mem_equal(decoded, written, sizeof(written), "Decoded log is not correct");
+}
+
+ZTEST(test_log_backend_fs_compress, test_log_fs_compressed_idle_flush)
+{
+	static const char msg[] = "Idle message\r\n";
+	size_t raw_len;
+	int len;
+
+	len = log_file_read();
+
+	write_log((uint8_t *)msg, strlen(msg));
+	/* Marks the end of a message, the dropped message output is a fake */
+	backend->api->dropped(backend, 1);
+	backend->api->notify(backend, LOG_BACKEND_EVT_PROCESS_THREAD_DONE, NULL);
+
+	zassert_equal(log_file_read(), len, "Block written before the flush timeout");
+
+	k_msleep(2 * CONFIG_LOG_BACKEND_FS_COMPRESS_FLUSH_TIMEOUT);
+
+	len = log_file_read();
+	raw_len = block_decode(last_block_get(len), decoded);
+	zassert_true(raw_len >= strlen(msg), "Idle block is too short");
+	zassert_mem_equal(&decoded[raw_len - strlen(msg)], msg, strlen(msg),
+			  "Idle block does not end with the message");
+}
+
+ZTEST(test_log_backend_fs_compress, test_log_fs_compressed_panic)
+{
+	static const char msg[] = "Panic message\r\n";
+	static const char partial[] = "Unfinished";
+	const uint8_t *blk;
+	size_t raw_len;
+
+	write_log((uint8_t *)msg, strlen(msg));
+	backend->api->dropped(backend, 1);
+	write_log((uint8_t *)partial, strlen(partial));
+
+	backend->api->panic(backend);
+
+	/* The complete messages are written first, then the rest */
+	blk = last_block_get(log_file_read());
+	raw_len = block_decode(blk, decoded);
+	zassert_equal(raw_len, strlen(partial), "Unexpected last block length");
+	zassert_mem_equal(decoded, partial, strlen(partial), "Bad last block");
+
+	raw_len = block_decode(last_block_get(blk - file_data), decoded);
+	zassert_true(raw_len >= strlen(msg), "Message block is too short");
+	zassert_mem_equal(&decoded[raw_len - strlen(msg)], msg, strlen(msg),
+			  "Message block does not end with the message");
+}
+
+static const struct log_backend *backend_find(char const *name)
+{
+	size_t slen = strlen(name);
+
+	STRUCT_SECTION_FOREACH(log_backend, backend) {
+		if (strncmp(name, backend->name, slen) == 0) {
+			return backend;
+		}
+	}
+
+	return NULL;
+}
+
+static void wipe_fs_logs(void)
+{
+	struct fs_dir_t dir;
+	char fname[MAX_PATH_LEN];
+	int rc;
+
+	fs_dir_t_init(&dir);
+
+	rc = fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR);
+	if (rc) {
+		/* log directory might not exist yet */
+		return;
+	}
+
+	while (1) {
+		struct fs_dirent ent = { 0 };
+
+		rc = fs_readdir(&dir, &ent);
+		zassert_equal(rc, 0, "Can not read directory.");
+		if (ent.name[0] == 0) {
+			break;
+		}
+		if (ent.type == FS_DIR_ENTRY_FILE &&
+		    strncmp(ent.name, log_prefix, strlen(log_prefix)) == 0) {
+			sprintf(fname, "%s/%s", CONFIG_LOG_BACKEND_FS_DIR, ent.name);
+			rc = fs_unlink(fname);
+			zassert_equal(rc, 0, "Can not remove file %s.", fname);
+		}
+	}
+
+	(void)fs_closedir(&dir);
+}
+
+void *suite_setup(void)
+{
+	backend = backend_find("log_backend_fs");
+	zassert_not_null(backend);
+
+	wipe_fs_logs();
+
+	return NULL;
+}
+
+ZTEST_SUITE(test_log_backend_fs_compress, NULL, suite_setup, NULL, NULL, NULL);
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Log output benchmark
+ *
+ * Measures how many messages per second are formatted and output by each
+ * backend, with only that backend active. A counting backend also reports
+ * how many times its output function is called per message.
+ */
+
+#include <zephyr/tc_util.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_std.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log.h>
+
+#define LOG_MODULE_NAME test
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+/* Messages logged per batch, a batch fits in the buffer in deferred mode */
+#define BATCH_SIZE 32
+#define NUM_BATCHES 8
+
+static uint32_t out_calls;
+static uint32_t out_bytes;
+
+static int count_out(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(ctx);
+
+	out_calls++;
+	out_bytes += length;
+
+	return length;
+}
+
+static uint8_t count_buf[128];
+LOG_OUTPUT_DEFINE(count_output, count_out, count_buf, sizeof(count_buf));
+
+static void process(struct log_backend const *const backend,
+		    union log_msg_generic *msg)
+{
+	log_output_msg_process(&count_output, &msg->log, log_backend_std_get_flags());
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	log_output_flush(&count_output);
+}
+
+const struct log_backend_api log_backend_count_api = {
+	.process = process,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(log_backend_count, log_backend_count_api, false);
+
+/* Keep only the given backend active. */
+static void backend_select(const struct log_backend *backend)
+{
+	STRUCT_SECTION_FOREACH(log_backend, b) {
+		if (b != backend && log_backend_is_active(b)) {
+			log_backend_disable(b);
+		}
+	}
+
+	if (!log_backend_is_active(backend)) {
+		log_backend_enable(backend, backend->cb->ctx, LOG_LEVEL_DBG);
+	}
+}
+
+static void log_batch(uint32_t batch)
+{
+	static const uint8_t data[24] = {
+		0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+		0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+		'l', 'o', 'g', ' ', 'd', 'a', 't', 'a',
+	};
+
+	for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+		if (i % 8 == 7) {
+			LOG_HEXDUMP_INF(data, sizeof(data), "hexdump");
+		} else {
+			LOG_INF("message %u of batch %u: %s 0x%08x", i, batch, "string", i * batch);
+		}
+	}
+}
+
+static void run_backend(const char *name)
+{
+	const struct log_backend *backend = log_backend_get_by_name(name);
+	uint32_t total_cyc = 0;
+	uint32_t cyc;
+	uint32_t us;
+
+	if (backend == NULL) {
+		PRINT("%s: not available\n", name);
+		return;
+	}
+
+	backend_select(backend);
+	out_calls = 0;
+	out_bytes = 0;
+
+	for (uint32_t batch = 0; batch < NUM_BATCHES; batch++) {
+		if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+			cyc = k_cycle_get_32();
+			log_batch(batch);
+			total_cyc += k_cycle_get_32() - cyc;
+		} else {
+			log_batch(batch);
+			cyc = k_cycle_get_32();
+			while (log_process()) {
+			}
+			total_cyc += k_cycle_get_32() - cyc;
+		}
+	}
+
+	us = k_cyc_to_us_ceil32(total_cyc);
+
+	if (us != 0) {
+		PRINT("%s: %u messages output in %u cycles (%u us), %u messages/s\n", name,
+		      BATCH_SIZE * NUM_BATCHES, total_cyc, us,
+		      (uint32_t)((uint64_t)BATCH_SIZE * NUM_BATCHES * USEC_PER_SEC / us));
+	} else {
+		/* Simulated time does not advance while the code runs */
+		PRINT("%s: %u messages output in no measurable time\n", name,
+		      BATCH_SIZE * NUM_BATCHES);
+	}
+
+	if (backend == &log_backend_count) {
+		PRINT("%s: %u output calls per message, %u bytes per call\n", name,
+		      out_calls / (BATCH_SIZE * NUM_BATCHES),
+		      out_calls != 0 ? out_bytes / out_calls : 0);
+	}
+}
+
+ZTEST(test_log_output_benchmark, test_uart)
+{
+	run_backend("log_backend_uart");
+}
+
+ZTEST(test_log_output_benchmark, test_native_posix)
+{
+	run_backend("log_backend_native_posix");
+}
+
+ZTEST(test_log_output_benchmark, test_output_calls)
+{
+	run_backend("log_backend_count");
+
+	zassert_true(out_bytes > 0, "Nothing was output");
+}
+
+static void *log_output_benchmark_setup(void)
+{
+	PRINT("LOGGING MODE:%s\n", IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) ? "DEFERRED" : "IMMEDIATE");
+#ifdef CONFIG_LOG_OUTPUT_IMMEDIATE_SPAN_SIZE
+	PRINT("\tSPAN_SIZE: %d\n", CONFIG_LOG_OUTPUT_IMMEDIATE_SPAN_SIZE);
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(test_log_output_benchmark, NULL, log_output_benchmark_setup, NULL, NULL, NULL);